@@ -15,8 +15,6 @@
  */
 #include "aodv-id-cache.h"
 
-#include <algorithm>
-
 namespace ns3
 {
 namespace aodv
@@ -25,29 +23,26 @@ bool
 IdCache::IsDuplicate(Ipv4Address addr, uint32_t id)
 {
     Purge();
-    for (auto i = m_idCache.begin(); i != m_idCache.end(); ++i)
+    const auto key = GetKey(addr, id);
+    if (m_idCache.Contains(key, Simulator::Now()))
     {
-        if (i->m_context == addr && i->m_id == id)
-        {
-            return true;
-        }
+        return true;
     }
-    UniqueId uniqueId = {addr, id, m_lifetime + Simulator::Now()};
-    m_idCache.push_back(uniqueId);
+    m_idCache.Insert(key, m_lifetime + Simulator::Now());
     return false;
 }
 
 void
 IdCache::Purge()
 {
-    m_idCache.erase(remove_if(m_idCache.begin(), m_idCache.end(), IsExpired()), m_idCache.end());
+    m_idCache.Purge(Simulator::Now());
 }
 
 uint32_t
 IdCache::GetSize()
 {
     Purge();
-    return m_idCache.size();
+    return m_idCache.GetSize();
 }
 
 } // namespace aodv
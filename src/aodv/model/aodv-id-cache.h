@@ -17,11 +17,10 @@
 #ifndef AODV_ID_CACHE_H
 #define AODV_ID_CACHE_H
 
+#include "ns3/expiring-set.h"
 #include "ns3/ipv4-address.h"
 #include "ns3/simulator.h"
 
-#include <vector>
-
 namespace ns3
 {
 namespace aodv
@@ -76,36 +75,19 @@ class IdCache
     }
 
   private:
-    /// Unique packet ID
-    struct UniqueId
-    {
-        /// ID is supposed to be unique in single address context (e.g. sender address)
-        Ipv4Address m_context;
-        /// The id
-        uint32_t m_id;
-        /// When record will expire
-        Time m_expire;
-    };
-
     /**
-     * @brief IsExpired structure
+     * Get the key identifying an entry in the cache
+     * @param addr the IP address, which is the context of the ID (e.g. sender address)
+     * @param id the ID, which is supposed to be unique in the address context
+     * @returns the key
      */
-    struct IsExpired
+    static uint64_t GetKey(Ipv4Address addr, uint32_t id)
     {
-        /**
-         * @brief Check if the entry is expired
-         *
-         * @param u UniqueId entry
-         * @return true if expired, false otherwise
-         */
-        bool operator()(const UniqueId& u) const
-        {
-            return (u.m_expire < Simulator::Now());
-        }
-    };
+        return (static_cast<uint64_t>(addr.Get()) << 32) | id;
+    }
 
     /// Already seen IDs
-    std::vector<UniqueId> m_idCache;
+    ExpiringSet<uint64_t> m_idCache;
     /// Default lifetime for ID records
     Time m_lifetime;
 };
@@ -277,6 +277,10 @@ RoutingTable::AddRoute(RoutingTableEntry& rt)
         rt.SetRreqCnt(0);
     }
     auto result = m_ipv4AddressEntry.insert(std::make_pair(rt.GetDestination(), rt));
+    if (result.second)
+    {
+        ScheduleExpiry(rt);
+    }
     return result.second;
 }
 
@@ -296,6 +300,7 @@ RoutingTable::Update(RoutingTableEntry& rt)
         NS_LOG_LOGIC("Route update to " << rt.GetDestination() << " set RreqCnt to 0");
         i->second.SetRreqCnt(0);
     }
+    ScheduleExpiry(i->second);
     return true;
 }
 
@@ -311,6 +316,8 @@ RoutingTable::SetEntryState(Ipv4Address id, RouteFlags state)
     }
     i->second.SetFlag(state);
     i->second.SetRreqCnt(0);
+    // an expired entry that was skipped while in search may have to be purged now
+    ScheduleExpiry(i->second);
     NS_LOG_LOGIC("Route set entry state to " << id << ": new state is " << state);
     return true;
 }
@@ -337,15 +344,14 @@ RoutingTable::InvalidateRoutesWithDst(const std::map<Ipv4Address, uint32_t>& unr
 {
     NS_LOG_FUNCTION(this);
     Purge();
-    for (auto i = m_ipv4AddressEntry.begin(); i != m_ipv4AddressEntry.end(); ++i)
+    for (auto j = unreachable.begin(); j != unreachable.end(); ++j)
     {
-        for (auto j = unreachable.begin(); j != unreachable.end(); ++j)
+        auto i = m_ipv4AddressEntry.find(j->first);
+        if ((i != m_ipv4AddressEntry.end()) && (i->second.GetFlag() == VALID))
         {
-            if ((i->first == j->first) && (i->second.GetFlag() == VALID))
-            {
-                NS_LOG_LOGIC("Invalidate route with destination address " << i->first);
-                i->second.Invalidate(m_badLinkLifetime);
-            }
+            NS_LOG_LOGIC("Invalidate route with destination address " << i->first);
+            i->second.Invalidate(m_badLinkLifetime);
+            ScheduleExpiry(i->second);
         }
     }
 }
@@ -377,36 +383,46 @@ void
 RoutingTable::Purge()
 {
     NS_LOG_FUNCTION(this);
-    if (m_ipv4AddressEntry.empty())
+    const Time now = Simulator::Now();
+    while (!m_expiryQueue.empty() && m_expiryQueue.top().first < now)
     {
-        return;
-    }
-    for (auto i = m_ipv4AddressEntry.begin(); i != m_ipv4AddressEntry.end();)
-    {
-        if (i->second.GetLifeTime().IsStrictlyNegative())
+        const auto [expiry, dst] = m_expiryQueue.top();
+        m_expiryQueue.pop();
+        auto i = m_ipv4AddressEntry.find(dst);
+        if (i == m_ipv4AddressEntry.end() || i->second.GetLifeTime() + now != expiry)
         {
-            if (i->second.GetFlag() == INVALID)
-            {
-                auto tmp = i;
-                ++i;
-                m_ipv4AddressEntry.erase(tmp);
-            }
-            else if (i->second.GetFlag() == VALID)
-            {
-                NS_LOG_LOGIC("Invalidate route with destination address " << i->first);
-                i->second.Invalidate(m_badLinkLifetime);
-                ++i;
-            }
-            else
-            {
-                ++i;
-            }
+            // the entry was deleted or its lifetime changed since the item was pushed
+            continue;
         }
-        else
+        if (i->second.GetFlag() == INVALID)
         {
-            ++i;
+            m_ipv4AddressEntry.erase(i);
+        }
+        else if (i->second.GetFlag() == VALID)
+        {
+            NS_LOG_LOGIC("Invalidate route with destination address " << i->first);
+            i->second.Invalidate(m_badLinkLifetime);
+            ScheduleExpiry(i->second);
+        }
+    }
+}
+
+void
+RoutingTable::ScheduleExpiry(const RoutingTableEntry& rt)
+{
+    if (m_expiryQueue.size() > 2 * m_ipv4AddressEntry.size() + 16)
+    {
+        // too many stale items, rebuild the queue from the routing table
+        std::vector<ExpiryItem> items;
+        items.reserve(m_ipv4AddressEntry.size());
+        for (const auto& [dst, entry] : m_ipv4AddressEntry)
+        {
+            items.emplace_back(entry.GetLifeTime() + Simulator::Now(), dst);
         }
+        m_expiryQueue = ExpiryQueue(std::greater<ExpiryItem>(), std::move(items));
+        return;
     }
+    m_expiryQueue.emplace(rt.GetLifeTime() + Simulator::Now(), rt.GetDestination());
 }
 
 void
@@ -465,7 +481,8 @@ RoutingTable::MarkLinkAsUnidirectional(Ipv4Address neighbor, Time blacklistTimeo
 void
 RoutingTable::Print(Ptr<OutputStreamWrapper> stream, Time::Unit unit /* = Time::S */) const
 {
-    std::map<Ipv4Address, RoutingTableEntry> table = m_ipv4AddressEntry;
+    std::map<Ipv4Address, RoutingTableEntry> table(m_ipv4AddressEntry.begin(),
+                                                   m_ipv4AddressEntry.end());
     Purge(table);
     std::ostream* os = stream->GetStream();
     // Copy the current ostream state
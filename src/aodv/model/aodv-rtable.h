@@ -23,9 +23,14 @@
 #include "ns3/timer.h"
 
 #include <cassert>
+#include <functional>
 #include <map>
+#include <queue>
 #include <stdint.h>
 #include <sys/types.h>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace ns3
 {
@@ -507,9 +512,15 @@ class RoutingTable
     void Clear()
     {
         m_ipv4AddressEntry.clear();
+        m_expiryQueue = ExpiryQueue();
     }
 
-    /// Delete all outdated entries and invalidate valid entry if Lifetime is expired
+    /**
+     * Delete all outdated entries and invalidate valid entry if Lifetime is expired.
+     *
+     * Only the entries whose lifetime has actually expired are visited, by
+     * popping them from an expiry-ordered queue.
+     */
     void Purge();
     /** Mark entry as unidirectional (e.g. add this neighbor to "blacklist" for blacklistTimeout
      * period)
@@ -526,8 +537,26 @@ class RoutingTable
     void Print(Ptr<OutputStreamWrapper> stream, Time::Unit unit = Time::S) const;
 
   private:
+    /// Expiry time and destination address of a routing table entry
+    typedef std::pair<Time, Ipv4Address> ExpiryItem;
+    /// Min-heap of the expiry times of the routing table entries
+    typedef std::priority_queue<ExpiryItem, std::vector<ExpiryItem>, std::greater<ExpiryItem>>
+        ExpiryQueue;
+
+    /**
+     * Push the current expiry time of the given entry into the expiry queue.
+     * Items whose expiry time does not match the one of the entry any longer
+     * are discarded lazily when popped. The queue is rebuilt from the routing
+     * table when it contains too many such stale items.
+     *
+     * @param rt the routing table entry
+     */
+    void ScheduleExpiry(const RoutingTableEntry& rt);
+
     /// The routing table
-    std::map<Ipv4Address, RoutingTableEntry> m_ipv4AddressEntry;
+    std::unordered_map<Ipv4Address, RoutingTableEntry, Ipv4AddressHash> m_ipv4AddressEntry;
+    /// Expiry times of the routing table entries, earliest first
+    ExpiryQueue m_expiryQueue;
     /// Deletion time for invalid routes
     Time m_badLinkLifetime;
     /**
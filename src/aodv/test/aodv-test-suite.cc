@@ -719,6 +719,122 @@ struct AodvRtableTest : public TestCase
     }
 };
 
+/**
+ * @ingroup aodv-test
+ *
+ * @brief Unit test for the expiry of routing table entries
+ */
+struct AodvRtablePurgeTest : public TestCase
+{
+    AodvRtablePurgeTest()
+        : TestCase("RtablePurge")
+    {
+    }
+
+    /// Number of routing table entries
+    static constexpr uint32_t N_ENTRIES = 1000;
+
+    /**
+     * Get the destination address of an entry
+     * @param i the index of the entry
+     * @return the destination address
+     */
+    static Ipv4Address GetDestination(uint32_t i)
+    {
+        return Ipv4Address(0x0a000000 + i);
+    }
+
+    /// Check that entries have been invalidated and deleted at the right times
+    void CheckEntries()
+    {
+        const auto now = Simulator::Now();
+        for (uint32_t i = 0; i < N_ENTRIES; ++i)
+        {
+            RoutingTableEntry rt;
+            // entry i expires at (i % 10 + 1) seconds, is invalidated by the first check
+            // following its expiry (1 ns later) and is deleted one second after that
+            const auto expiry = Seconds(i % 10 + 1);
+            const bool found = m_rtable.LookupRoute(GetDestination(i), rt);
+            if (now <= expiry)
+            {
+                NS_TEST_EXPECT_MSG_EQ(found, true, "Entry " << i << " should exist");
+                NS_TEST_EXPECT_MSG_EQ(rt.GetFlag(), VALID, "Entry " << i << " should be valid");
+            }
+            else if (now <= expiry + NanoSeconds(1) + Seconds(1))
+            {
+                NS_TEST_EXPECT_MSG_EQ(found, true, "Entry " << i << " should exist");
+                NS_TEST_EXPECT_MSG_EQ(rt.GetFlag(), INVALID, "Entry " << i << " should be invalid");
+            }
+            else
+            {
+                NS_TEST_EXPECT_MSG_EQ(found, false, "Entry " << i << " should be deleted");
+            }
+        }
+    }
+
+    void DoRun() override
+    {
+        Ptr<NetDevice> dev;
+        Ipv4InterfaceAddress iface;
+        for (uint32_t i = 0; i < N_ENTRIES; ++i)
+        {
+            RoutingTableEntry rt(/*output device*/ dev,
+                                 /*dst*/ GetDestination(i),
+                                 /*validSeqNo*/ true,
+                                 /*seqNo*/ 1,
+                                 /*interface*/ iface,
+                                 /*hop*/ 1,
+                                 /*next hop*/ GetDestination(i),
+                                 /*lifetime*/ Seconds(100));
+            NS_TEST_EXPECT_MSG_EQ(m_rtable.AddRoute(rt), true, "trivial");
+            // update the lifetime several times, leaving stale items in the expiry queue
+            rt.SetLifeTime(Seconds(50));
+            NS_TEST_EXPECT_MSG_EQ(m_rtable.Update(rt), true, "trivial");
+            rt.SetLifeTime(Seconds(i % 10 + 1));
+            NS_TEST_EXPECT_MSG_EQ(m_rtable.Update(rt), true, "trivial");
+        }
+        for (uint32_t t = 0; t < 25; ++t)
+        {
+            Simulator::Schedule(MilliSeconds(500 * t) + NanoSeconds(1),
+                                &AodvRtablePurgeTest::CheckEntries,
+                                this);
+        }
+
+        // an expired entry in search is neither invalidated nor deleted until its state changes
+        RoutingTableEntry rt(/*output device*/ dev,
+                             /*dst*/ Ipv4Address("1.2.3.4"),
+                             /*validSeqNo*/ false,
+                             /*seqNo*/ 0,
+                             /*interface*/ iface,
+                             /*hop*/ 1,
+                             /*next hop*/ Ipv4Address("1.2.3.4"),
+                             /*lifetime*/ Seconds(1));
+        rt.SetFlag(IN_SEARCH);
+        NS_TEST_EXPECT_MSG_EQ(m_rtable.AddRoute(rt), true, "trivial");
+        Simulator::Schedule(Seconds(20), [this]() {
+            RoutingTableEntry rt;
+            NS_TEST_EXPECT_MSG_EQ(m_rtable.LookupRoute(Ipv4Address("1.2.3.4"), rt),
+                                  true,
+                                  "Entry in search should not be purged");
+            NS_TEST_EXPECT_MSG_EQ(rt.GetFlag(), IN_SEARCH, "Entry should still be in search");
+            NS_TEST_EXPECT_MSG_EQ(m_rtable.SetEntryState(Ipv4Address("1.2.3.4"), INVALID),
+                                  true,
+                                  "trivial");
+        });
+        Simulator::Schedule(Seconds(21), [this]() {
+            RoutingTableEntry rt;
+            NS_TEST_EXPECT_MSG_EQ(m_rtable.LookupRoute(Ipv4Address("1.2.3.4"), rt),
+                                  false,
+                                  "Expired invalid entry should be purged");
+        });
+
+        Simulator::Run();
+        Simulator::Destroy();
+    }
+
+    RoutingTable m_rtable{Seconds(1)}; ///< the routing table
+};
+
 /**
  * @ingroup aodv-test
  *
@@ -740,6 +856,7 @@ class AodvTestSuite : public TestSuite
         AddTestCase(new AodvRqueueTest, TestCase::Duration::QUICK);
         AddTestCase(new AodvRtableEntryTest, TestCase::Duration::QUICK);
         AddTestCase(new AodvRtableTest, TestCase::Duration::QUICK);
+        AddTestCase(new AodvRtablePurgeTest, TestCase::Duration::QUICK);
     }
 } g_aodvTestSuite; ///< the test suite
 
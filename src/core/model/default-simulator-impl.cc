@@ -8,12 +8,18 @@
 
 #include "default-simulator-impl.h"
 
+#include "abort.h"
 #include "assert.h"
+#include "event-profiler.h"
 #include "log.h"
 #include "scheduler.h"
 #include "simulator.h"
+#include "string.h"
+#include "uinteger.h"
 
 #include <cmath>
+#include <fstream>
+#include <iostream>
 
 /**
  * @file
@@ -37,7 +43,21 @@ DefaultSimulatorImpl::GetTypeId()
     static TypeId tid = TypeId("ns3::DefaultSimulatorImpl")
                             .SetParent<SimulatorImpl>()
                             .SetGroupName("Core")
-                            .AddConstructor<DefaultSimulatorImpl>();
+                            .AddConstructor<DefaultSimulatorImpl>()
+                            .AddAttribute("EventProfile",
+                                          "Base name of the event profile files; if not empty, "
+                                          "the wall clock time of the events is accounted by "
+                                          "bound function and context, written to "
+                                          "<EventProfile>.folded and summarized on std::cout "
+                                          "at Simulator::Destroy (see EventProfiler).",
+                                          StringValue(""),
+                                          MakeStringAccessor(&DefaultSimulatorImpl::m_profileName),
+                                          MakeStringChecker())
+                            .AddAttribute("EventProfileTop",
+                                          "Number of bound functions in the event profile summary.",
+                                          UintegerValue(20),
+                                          MakeUintegerAccessor(&DefaultSimulatorImpl::m_profileTop),
+                                          MakeUintegerChecker<uint32_t>());
     return tid;
 }
 
@@ -60,6 +80,17 @@ DefaultSimulatorImpl::~DefaultSimulatorImpl()
     NS_LOG_FUNCTION(this);
 }
 
+void
+DefaultSimulatorImpl::NotifyConstructionCompleted()
+{
+    NS_LOG_FUNCTION(this);
+    if (!m_profileName.empty())
+    {
+        m_profiler = std::make_unique<EventProfiler>();
+    }
+    SimulatorImpl::NotifyConstructionCompleted();
+}
+
 void
 DefaultSimulatorImpl::DoDispose()
 {
@@ -89,6 +120,16 @@ DefaultSimulatorImpl::Destroy()
             ev->Invoke();
         }
     }
+
+    if (m_profiler)
+    {
+        const std::string fileName = m_profileName + ".folded";
+        std::ofstream os(fileName);
+        NS_ABORT_MSG_UNLESS(os.is_open(), "Cannot open the event profile file " << fileName);
+        m_profiler->WriteFoldedStacks(os);
+        m_profiler->PrintTopFunctions(std::cout, m_profileTop);
+        m_profiler = nullptr;
+    }
 }
 
 void
@@ -130,8 +171,15 @@ DefaultSimulatorImpl::ProcessOneEvent()
     m_currentTs = next.key.m_ts;
     m_currentContext = next.key.m_context;
     m_currentUid = next.key.m_uid;
-    next.impl->Invoke();
-    next.impl->Unref();
+    if (m_profiler)
+    {
+        m_profiler->Invoke(next.impl, m_currentContext);
+    }
+    else
+    {
+        next.impl->Invoke();
+        next.impl->Unref();
+    }
 
     ProcessEventsWithContext();
 }
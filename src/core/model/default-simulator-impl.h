@@ -12,7 +12,9 @@
 #include "simulator-impl.h"
 
 #include <list>
+#include <memory>
 #include <mutex>
+#include <string>
 #include <thread>
 
 /**
@@ -25,6 +27,7 @@ namespace ns3
 {
 
 // Forward
+class EventProfiler;
 class Scheduler;
 
 /**
@@ -69,6 +72,7 @@ class DefaultSimulatorImpl : public SimulatorImpl
 
   private:
     void DoDispose() override;
+    void NotifyConstructionCompleted() override;
 
     /** Process the next event. */
     void ProcessOneEvent();
@@ -125,6 +129,13 @@ class DefaultSimulatorImpl : public SimulatorImpl
 
     /** Main execution thread. */
     std::thread::id m_mainThreadId;
+
+    /** Base name of the event profile files, or empty to disable profiling. */
+    std::string m_profileName;
+    /** Number of bound functions printed in the event profile. */
+    uint32_t m_profileTop;
+    /** The event profiler, or nullptr if profiling is disabled. */
+    std::unique_ptr<EventProfiler> m_profiler;
 };
 
 } // namespace ns3
@@ -94,6 +94,9 @@ namespace ns3
  * \li Show the largest file, and total number of trace files: <br/>
  *   @code wc -l *.json | sort -n | tail -2 \endcode
  *
+ * The cost of the events, rather than their causality, is accounted by
+ * the EventProfiler, which also counts the memory allocations of the
+ * events when DES Metrics is enabled.
  */
 class DesMetrics : public Singleton<DesMetrics>
 {
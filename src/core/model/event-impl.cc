@@ -9,6 +9,9 @@
 #include "event-impl.h"
 
 #include "log.h"
+#include "valgrind.h"
+
+#include <new>
 
 /**
  * @file
@@ -21,6 +24,69 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("EventImpl");
 
+namespace
+{
+
+/// Size classes of the event pool are multiples of this size, in bytes.
+constexpr std::size_t EVENT_POOL_GRANULARITY = 16;
+/// Largest event allocated from the event pool, in bytes.
+constexpr std::size_t EVENT_POOL_MAX_SIZE = 256;
+/// Size of the slabs carved into events, in bytes.
+constexpr std::size_t EVENT_POOL_SLAB_SIZE = 64 * 1024;
+
+/// A free block of the event pool.
+struct EventPoolBlock
+{
+    EventPoolBlock* next; //!< Next free block of the same size class.
+};
+
+/**
+ * The event pool of a thread.
+ *
+ * The blocks are carved from slabs which are never released, so that an
+ * event created by a thread (e.g., with Simulator::ScheduleWithContext() from
+ * a real-time thread) can be safely destroyed and recycled by another one.
+ * The pool is zero-initialized and trivially destructible, so that accessing
+ * it does not need any thread-local initialization guard.
+ */
+struct EventPool
+{
+    /// Free blocks of each size class.
+    EventPoolBlock* freeBlocks[EVENT_POOL_MAX_SIZE / EVENT_POOL_GRANULARITY];
+    char* slab;           //!< Unused part of the current slab.
+    std::size_t slabLeft; //!< Size of the unused part of the current slab.
+    int state;            //!< 0 if not checked yet, 1 if enabled, -1 if bypassed.
+};
+
+/// The event pool of the current thread.
+thread_local EventPool g_eventPool;
+
+/**
+ * Check whether the event pool should be used for an event.
+ * @param [in] pool The event pool of the current thread.
+ * @param [in] size The size of the event.
+ * @returns true if the event should be allocated from the pool.
+ */
+inline bool
+UseEventPool(EventPool& pool, std::size_t size)
+{
+    if (pool.state == 0)
+    {
+        bool bypass = RUNNING_ON_VALGRIND;
+#if defined(__SANITIZE_ADDRESS__)
+        bypass = true;
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer)
+        bypass = true;
+#endif
+#endif
+        pool.state = bypass ? -1 : 1;
+    }
+    return pool.state > 0 && size <= EVENT_POOL_MAX_SIZE;
+}
+
+} // namespace
+
 EventImpl::~EventImpl()
 {
     NS_LOG_FUNCTION(this);
@@ -56,4 +122,50 @@ EventImpl::IsCancelled()
     return m_cancel;
 }
 
+void*
+EventImpl::operator new(std::size_t size)
+{
+    EventPool& pool = g_eventPool;
+    if (!UseEventPool(pool, size))
+    {
+        return ::operator new(size);
+    }
+    const std::size_t sizeClass = (size - 1) / EVENT_POOL_GRANULARITY;
+    EventPoolBlock* block = pool.freeBlocks[sizeClass];
+    if (block != nullptr)
+    {
+        pool.freeBlocks[sizeClass] = block->next;
+        return block;
+    }
+    const std::size_t blockSize = (sizeClass + 1) * EVENT_POOL_GRANULARITY;
+    if (pool.slabLeft < blockSize)
+    {
+        pool.slab = static_cast<char*>(::operator new(EVENT_POOL_SLAB_SIZE));
+        pool.slabLeft = EVENT_POOL_SLAB_SIZE;
+    }
+    void* p = pool.slab;
+    pool.slab += blockSize;
+    pool.slabLeft -= blockSize;
+    return p;
+}
+
+void
+EventImpl::operator delete(void* p, std::size_t size)
+{
+    if (p == nullptr)
+    {
+        return;
+    }
+    EventPool& pool = g_eventPool;
+    if (!UseEventPool(pool, size))
+    {
+        ::operator delete(p);
+        return;
+    }
+    const std::size_t sizeClass = (size - 1) / EVENT_POOL_GRANULARITY;
+    auto block = static_cast<EventPoolBlock*>(p);
+    block->next = pool.freeBlocks[sizeClass];
+    pool.freeBlocks[sizeClass] = block;
+}
+
 } // namespace ns3
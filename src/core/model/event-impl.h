@@ -10,6 +10,7 @@
 
 #include "simple-ref-count.h"
 
+#include <cstddef>
 #include <stdint.h>
 
 /**
@@ -30,6 +31,14 @@ namespace ns3
  * when it reaches the time associated to this event. Most subclasses
  * are usually created by one of the many Simulator::Schedule
  * methods.
+ *
+ * The events are allocated from a per-thread pool of fixed-size blocks
+ * rather than from the general-purpose heap: the memory of an event which
+ * has been destroyed is recycled for the next event of the same size class,
+ * which avoids a call to malloc and free per scheduled event and keeps the
+ * recently used events in the cache. The pool is bypassed when running
+ * under valgrind or the address sanitizer, so that these tools can still
+ * track the lifetime of each event.
  */
 class EventImpl : public SimpleRefCount<EventImpl>
 {
@@ -56,6 +65,19 @@ class EventImpl : public SimpleRefCount<EventImpl>
      */
     bool IsCancelled();
 
+    /**
+     * Allocate the memory of an event from the event pool.
+     * @param [in] size The size of the event.
+     * @returns The memory of the event.
+     */
+    static void* operator new(std::size_t size);
+    /**
+     * Return the memory of an event to the event pool.
+     * @param [in] p The memory of the event.
+     * @param [in] size The size of the event.
+     */
+    static void operator delete(void* p, std::size_t size);
+
   protected:
     /**
      * Implementation for Invoke().
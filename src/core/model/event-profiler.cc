@@ -0,0 +1,229 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+/**
+ * @file
+ * @ingroup simulator
+ * ns3::EventProfiler implementation.
+ */
+
+#include "event-profiler.h"
+
+#include "demangle.h"
+#include "event-impl.h"
+#include "simulator.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <map>
+#include <new>
+#include <vector>
+
+#ifdef ENABLE_DES_METRICS
+namespace
+{
+/** Number of memory allocations made by the current thread. */
+thread_local uint64_t g_allocations = 0;
+} // namespace
+
+/**
+ * Allocate memory, counting the allocations.
+ * @param [in] size The size of the memory block.
+ * @returns The memory block.
+ */
+void*
+operator new(std::size_t size)
+{
+    ++g_allocations;
+    while (true)
+    {
+        void* p = std::malloc(size == 0 ? 1 : size);
+        if (p != nullptr)
+        {
+            return p;
+        }
+        std::new_handler handler = std::get_new_handler();
+        if (handler == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+}
+
+/**
+ * Allocate memory, counting the allocations.
+ * @param [in] size The size of the memory block.
+ * @returns The memory block, or nullptr.
+ */
+void*
+operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    try
+    {
+        return operator new(size);
+    }
+    catch (...)
+    {
+        return nullptr;
+    }
+}
+#endif /* ENABLE_DES_METRICS */
+
+namespace ns3
+{
+
+namespace
+{
+
+/**
+ * Get the number of memory allocations made by the current thread.
+ * @returns The number of allocations, or zero if they are not counted.
+ */
+uint64_t
+GetAllocations()
+{
+#ifdef ENABLE_DES_METRICS
+    return g_allocations;
+#else
+    return 0;
+#endif
+}
+
+/**
+ * Get the name of a context.
+ * @param [in] context The context.
+ * @returns The name.
+ */
+std::string
+GetContextName(uint32_t context)
+{
+    if (context == Simulator::NO_CONTEXT)
+    {
+        return "no context";
+    }
+    return "context " + std::to_string(context);
+}
+
+} // namespace
+
+std::size_t
+EventProfiler::KeyHash::operator()(const Key& key) const
+{
+    return std::hash<const void*>()(key.first) ^ (std::hash<uint32_t>()(key.second) << 1);
+}
+
+EventProfiler::EventProfiler()
+{
+}
+
+void
+EventProfiler::Invoke(EventImpl* event, uint32_t context)
+{
+    Cost& cost = m_costs[{&typeid(*event), context}];
+    const uint64_t allocations = GetAllocations();
+    const auto start = std::chrono::steady_clock::now();
+    event->Invoke();
+    event->Unref();
+    const auto end = std::chrono::steady_clock::now();
+    cost.events++;
+    cost.time += std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    cost.allocations += GetAllocations() - allocations;
+}
+
+std::string
+EventProfiler::GetFunctionName(const std::type_info& type)
+{
+    const std::string name = Demangle(type.name());
+    // ns3::MakeEvent<T...>(F, Ts...)::Event...Impl, where F is the type of
+    // the bound function, method or lambda
+    const std::string prefix = "ns3::MakeEvent<";
+    if (name.compare(0, prefix.size(), prefix) != 0)
+    {
+        return name;
+    }
+    std::size_t i = prefix.size();
+    int depth = 1;
+    for (; i < name.size() && depth > 0; ++i)
+    {
+        depth += (name[i] == '<') - (name[i] == '>');
+    }
+    if (i == name.size() || name[i] != '(')
+    {
+        return name;
+    }
+    const std::size_t begin = ++i;
+    for (; i < name.size(); ++i)
+    {
+        const char c = name[i];
+        if (depth == 0 && (c == ',' || c == ')'))
+        {
+            return name.substr(begin, i - begin);
+        }
+        depth += (c == '(' || c == '<' || c == '{' || c == '[');
+        depth -= (c == ')' || c == '>' || c == '}' || c == ']');
+    }
+    return name;
+}
+
+void
+EventProfiler::WriteFoldedStacks(std::ostream& os) const
+{
+    // merge the types with the same name, e.g., from different libraries
+    std::map<std::pair<std::string, uint32_t>, uint64_t> times;
+    for (const auto& [key, cost] : m_costs)
+    {
+        times[{GetFunctionName(*key.first), key.second}] += cost.time;
+    }
+    for (const auto& [key, time] : times)
+    {
+        os << key.first << ";" << GetContextName(key.second) << " " << time << std::endl;
+    }
+}
+
+void
+EventProfiler::PrintTopFunctions(std::ostream& os, uint32_t n) const
+{
+    std::map<std::string, Cost> functions;
+    Cost total;
+    for (const auto& [key, cost] : m_costs)
+    {
+        Cost& function = functions[GetFunctionName(*key.first)];
+        function.events += cost.events;
+        function.time += cost.time;
+        function.allocations += cost.allocations;
+        total.events += cost.events;
+        total.time += cost.time;
+    }
+    std::vector<std::pair<std::string, Cost>> top(functions.begin(), functions.end());
+    std::stable_sort(top.begin(), top.end(), [](const auto& a, const auto& b) {
+        return a.second.time > b.second.time;
+    });
+    top.resize(std::min<std::size_t>(top.size(), n));
+
+    const auto flags = os.flags();
+    const auto precision = os.precision();
+    os << std::fixed << std::setprecision(2);
+    os << "Event profile: " << total.events << " events, " << total.time * 1e-6 << " ms"
+       << std::endl;
+    os << std::setw(11) << "Time (ms)" << std::setw(8) << "%" << std::setw(11) << "Events"
+       << std::setw(11) << "ns/event" << std::setw(14) << "Allocs/event"
+       << "  Function" << std::endl;
+    for (const auto& [name, cost] : top)
+    {
+        os << std::setw(11) << cost.time * 1e-6 << std::setw(8)
+           << (total.time > 0 ? 100.0 * cost.time / total.time : 0.0) << std::setw(11)
+           << cost.events << std::setw(11) << std::setprecision(1)
+           << static_cast<double>(cost.time) / cost.events << std::setw(14)
+           << std::setprecision(2) << static_cast<double>(cost.allocations) / cost.events << "  "
+           << name << std::endl;
+    }
+    os.flags(flags);
+    os.precision(precision);
+}
+
+} // namespace ns3
@@ -0,0 +1,129 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef EVENT_PROFILER_H
+#define EVENT_PROFILER_H
+
+/**
+ * @file
+ * @ingroup simulator
+ * ns3::EventProfiler declaration.
+ */
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <typeinfo>
+#include <unordered_map>
+#include <utility>
+
+namespace ns3
+{
+
+class EventImpl;
+
+/**
+ * @ingroup simulator
+ * @ingroup debugging
+ *
+ * @brief Account the wall clock time, the number and the memory
+ * allocations of the events executed by the simulator, by bound function
+ * and by context.
+ *
+ * The DefaultSimulatorImpl executes its events through an EventProfiler
+ * when its \c EventProfile attribute is not empty, e.g., with
+ * @verbatim
+   $ ./ns3 run "my-program --ns3::DefaultSimulatorImpl::EventProfile=my-program" \endverbatim
+ * At Simulator::Destroy(), it then writes the costs of the events in the
+ * folded stack format of the flame graph tools to \c my-program.folded,
+ * with one line per bound function and context:
+ * @verbatim
+   void (ns3::GenericBatteryModel::*)();context 3 5280431 \endverbatim
+ * giving the total wall clock time in nanoseconds, and prints the
+ * functions taking the most time to \c std::cout:
+ * @verbatim
+   Event profile: 1520334 events, 2318.52 ms
+      Time (ms)       %     Events   ns/event  Allocs/event  Function
+         905.14   39.04     262140     3452.9          4.00  void (*)(unsigned int, ...)
+   ... \endverbatim
+ *
+ * The bound function of an event is identified by the type of the
+ * function or method given to MakeEvent(), e.g., to Simulator::Schedule(),
+ * i.e., by its class and signature rather than by its name, or by the type
+ * of the lambda.
+ *
+ * The allocations are only counted if ns-3 was configured with
+ * \c --enable-des-metrics (see DesMetrics), which replaces the global
+ * \c operator \c new with a counting one; they are reported as zero
+ * otherwise.
+ */
+class EventProfiler
+{
+  public:
+    /** Constructor. */
+    EventProfiler();
+
+    /**
+     * Invoke an event and release it, and account its cost.
+     *
+     * @param [in] event The event.
+     * @param [in] context The context of the event.
+     */
+    void Invoke(EventImpl* event, uint32_t context);
+
+    /**
+     * Write the costs of the events in the folded stack format.
+     *
+     * @param [in] os The output stream.
+     */
+    void WriteFoldedStacks(std::ostream& os) const;
+
+    /**
+     * Print the bound functions taking the most time.
+     *
+     * @param [in] os The output stream.
+     * @param [in] n The maximum number of functions.
+     */
+    void PrintTopFunctions(std::ostream& os, uint32_t n) const;
+
+    /**
+     * Get the name of the bound function of an event.
+     *
+     * @param [in] type The type of the event implementation.
+     * @returns The type of the function, method or lambda given to
+     *          MakeEvent(), or the demangled type of the event
+     *          implementation if it was not made by MakeEvent().
+     */
+    static std::string GetFunctionName(const std::type_info& type);
+
+  private:
+    /** The costs of the events of a bound function and a context. */
+    struct Cost
+    {
+        uint64_t events = 0;      //!< Number of events.
+        uint64_t time = 0;        //!< Wall clock time, in nanoseconds.
+        uint64_t allocations = 0; //!< Number of memory allocations.
+    };
+
+    /** The event implementation type and the context. */
+    using Key = std::pair<const std::type_info*, uint32_t>;
+
+    /** Hash of a Key. */
+    struct KeyHash
+    {
+        /**
+         * Hash a Key.
+         * @param [in] key The key.
+         * @returns The hash.
+         */
+        std::size_t operator()(const Key& key) const;
+    };
+
+    /** The costs of the events. */
+    std::unordered_map<Key, Cost, KeyHash> m_costs;
+};
+
+} // namespace ns3
+
+#endif /* EVENT_PROFILER_H */
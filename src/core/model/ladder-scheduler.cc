@@ -0,0 +1,320 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ladder-scheduler.h"
+
+#include "assert.h"
+#include "event-impl.h"
+#include "log.h"
+#include "uinteger.h"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+/**
+ * @file
+ * @ingroup scheduler
+ * ns3::LadderScheduler implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("LadderScheduler");
+
+NS_OBJECT_ENSURE_REGISTERED(LadderScheduler);
+
+namespace
+{
+
+/**
+ * Compare two events in reverse chronological order.
+ * @param [in] a The first event.
+ * @param [in] b The second event.
+ * @returns \c true if \c a is after \c b.
+ */
+bool
+IsLater(const Scheduler::Event& a, const Scheduler::Event& b)
+{
+    return a.key > b.key;
+}
+
+} // namespace
+
+TypeId
+LadderScheduler::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::LadderScheduler")
+            .SetParent<Scheduler>()
+            .SetGroupName("Core")
+            .AddConstructor<LadderScheduler>()
+            .AddAttribute("Threshold",
+                          "The maximum number of events sorted at once; larger buckets "
+                          "are spread over a new rung.",
+                          UintegerValue(50),
+                          MakeUintegerAccessor(&LadderScheduler::m_threshold),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("MaxRungs",
+                          "The maximum number of rungs of the ladder.",
+                          UintegerValue(8),
+                          MakeUintegerAccessor(&LadderScheduler::m_maxRungs),
+                          MakeUintegerChecker<uint32_t>(1));
+    return tid;
+}
+
+LadderScheduler::LadderScheduler()
+    : m_topStart(0),
+      m_topMin(std::numeric_limits<uint64_t>::max()),
+      m_topMax(0),
+      m_nRungs(0),
+      m_size(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+LadderScheduler::~LadderScheduler()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+uint64_t
+LadderScheduler::CurrentStart(const Rung& rung)
+{
+    return rung.start + rung.current * rung.width;
+}
+
+std::size_t
+LadderScheduler::FindRung(uint64_t ts) const
+{
+    for (std::size_t i = 0; i < m_nRungs; ++i)
+    {
+        if (ts >= CurrentStart(m_rungs[i]))
+        {
+            return i;
+        }
+    }
+    return m_nRungs;
+}
+
+void
+LadderScheduler::Insert(const Event& ev)
+{
+    NS_LOG_FUNCTION(this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+    ++m_size;
+    const uint64_t ts = ev.key.m_ts;
+    if (ts >= m_topStart)
+    {
+        m_top.push_back(ev);
+        m_topMin = std::min(m_topMin, ts);
+        m_topMax = std::max(m_topMax, ts);
+    }
+    else if (std::size_t i = FindRung(ts); i < m_nRungs)
+    {
+        Rung& rung = m_rungs[i];
+        const std::size_t index = (ts - rung.start) / rung.width;
+        NS_ASSERT(index < rung.nBuckets);
+        rung.buckets[index].push_back(ev);
+        ++rung.count;
+    }
+    else
+    {
+        InsertBottom(ev);
+    }
+    if (m_bottom.empty())
+    {
+        Refill();
+    }
+}
+
+void
+LadderScheduler::InsertBottom(const Event& ev)
+{
+    NS_LOG_FUNCTION(this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+    m_bottom.insert(std::upper_bound(m_bottom.begin(), m_bottom.end(), ev, IsLater), ev);
+    if (m_bottom.size() <= m_threshold || m_nRungs >= m_maxRungs)
+    {
+        return;
+    }
+    // The bottom covers the time span up to the current bucket of the
+    // lowest rung, or up to the top if there is no rung.
+    const uint64_t end = m_nRungs > 0 ? CurrentStart(m_rungs[m_nRungs - 1]) : m_topStart;
+    const uint64_t start = m_bottom.back().key.m_ts;
+    if (end - start > 1)
+    {
+        NS_LOG_LOGIC("spread the bottom over a new rung");
+        SpawnRung(m_bottom, start, end - start);
+    }
+}
+
+void
+LadderScheduler::SpawnRung(Bucket& events, uint64_t start, uint64_t span)
+{
+    NS_LOG_FUNCTION(this << events.size() << start << span);
+    NS_ASSERT(m_nRungs < m_maxRungs);
+    if (m_rungs.size() <= m_nRungs)
+    {
+        m_rungs.resize(m_nRungs + 1);
+    }
+    Rung& rung = m_rungs[m_nRungs++];
+    const uint64_t n = events.size();
+    rung.width = std::max<uint64_t>(1, span / n + (span % n != 0 ? 1 : 0));
+    rung.nBuckets = span / rung.width + (span % rung.width != 0 ? 1 : 0);
+    if (rung.buckets.size() < rung.nBuckets)
+    {
+        // Never shrink, so that the buckets keep their storage for the next rungs
+        rung.buckets.resize(rung.nBuckets);
+    }
+    rung.start = start;
+    rung.current = 0;
+    rung.count = n;
+    for (const auto& ev : events)
+    {
+        const std::size_t index = (ev.key.m_ts - start) / rung.width;
+        NS_ASSERT(index < rung.nBuckets);
+        rung.buckets[index].push_back(ev);
+    }
+    events.clear();
+}
+
+void
+LadderScheduler::SortToBottom(Bucket& events)
+{
+    NS_LOG_FUNCTION(this << events.size());
+    NS_ASSERT(m_bottom.empty());
+    std::sort(events.begin(), events.end(), IsLater);
+    // Swap rather than copy, so that the bucket reuses the storage of the bottom.
+    std::swap(m_bottom, events);
+}
+
+void
+LadderScheduler::Refill()
+{
+    NS_LOG_FUNCTION(this);
+    while (m_bottom.empty() && (m_nRungs > 0 || !m_top.empty()))
+    {
+        if (m_nRungs == 0)
+        {
+            NS_LOG_LOGIC("spread the top over the ladder");
+            const uint64_t span = m_topMax - m_topMin + 1;
+            const uint64_t start = m_topMin;
+            m_topMin = std::numeric_limits<uint64_t>::max();
+            m_topMax = 0;
+            if (m_top.size() <= m_threshold || span == 1)
+            {
+                m_topStart = start + span;
+                SortToBottom(m_top);
+            }
+            else
+            {
+                SpawnRung(m_top, start, span);
+                const Rung& rung = m_rungs[0];
+                m_topStart = rung.start + rung.nBuckets * rung.width;
+            }
+            continue;
+        }
+
+        if (m_rungs.size() < m_maxRungs)
+        {
+            // Spawning a rung below must not move the bucket being spread
+            m_rungs.resize(m_maxRungs);
+        }
+        Rung& rung = m_rungs[m_nRungs - 1];
+        if (rung.count == 0)
+        {
+            --m_nRungs;
+            continue;
+        }
+        while (rung.buckets[rung.current].empty())
+        {
+            ++rung.current;
+        }
+        Bucket& bucket = rung.buckets[rung.current];
+        const uint64_t start = CurrentStart(rung);
+        ++rung.current;
+        rung.count -= bucket.size();
+        if (bucket.size() > m_threshold && rung.width > 1 && m_nRungs < m_maxRungs)
+        {
+            SpawnRung(bucket, start, rung.width);
+        }
+        else
+        {
+            SortToBottom(bucket);
+        }
+    }
+}
+
+bool
+LadderScheduler::IsEmpty() const
+{
+    NS_LOG_FUNCTION(this);
+    return m_size == 0;
+}
+
+Scheduler::Event
+LadderScheduler::PeekNext() const
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(!m_bottom.empty());
+    return m_bottom.back();
+}
+
+Scheduler::Event
+LadderScheduler::RemoveNext()
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(!m_bottom.empty());
+    Scheduler::Event ev = m_bottom.back();
+    m_bottom.pop_back();
+    --m_size;
+    if (m_bottom.empty())
+    {
+        Refill();
+    }
+    return ev;
+}
+
+void
+LadderScheduler::Remove(const Event& ev)
+{
+    NS_LOG_FUNCTION(this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+    const uint64_t ts = ev.key.m_ts;
+    Bucket* bucket = &m_bottom;
+    Rung* rung = nullptr;
+    if (ts >= m_topStart)
+    {
+        bucket = &m_top;
+    }
+    else if (std::size_t i = FindRung(ts); i < m_nRungs)
+    {
+        rung = &m_rungs[i];
+        bucket = &rung->buckets[(ts - rung->start) / rung->width];
+    }
+
+    if (bucket == &m_bottom)
+    {
+        auto it = std::lower_bound(m_bottom.begin(), m_bottom.end(), ev, IsLater);
+        NS_ASSERT_MSG(it != m_bottom.end() && *it == ev, "Event not found");
+        m_bottom.erase(it);
+    }
+    else
+    {
+        auto it = std::find(bucket->begin(), bucket->end(), ev);
+        NS_ASSERT_MSG(it != bucket->end(), "Event not found");
+        *it = bucket->back();
+        bucket->pop_back();
+        if (rung != nullptr)
+        {
+            --rung->count;
+        }
+    }
+    --m_size;
+    if (m_bottom.empty())
+    {
+        Refill();
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,164 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef LADDER_SCHEDULER_H
+#define LADDER_SCHEDULER_H
+
+#include "scheduler.h"
+
+#include <stdint.h>
+#include <vector>
+
+/**
+ * @file
+ * @ingroup scheduler
+ * ns3::LadderScheduler declaration.
+ */
+
+namespace ns3
+{
+
+/**
+ * @ingroup scheduler
+ * @brief a ladder queue event scheduler
+ *
+ * This event scheduler implements the ladder queue published in 2005 in
+ * ["Ladder Queue: An O(1) Priority Queue Structure for Large-Scale Discrete
+ * Event Simulation" by Wai Teng Tang, Rick Siow Mong Goh and Ian Li-Jin
+ * Thng][Tang].
+ *
+ * [Tang]: https://doi.org/10.1145/1103323.1103324 "Tang"
+ *
+ * The events are spread over three tiers:
+ *
+ *  - the _top_, an unsorted vector holding the events scheduled after
+ *    the time span covered by the ladder, e.g., the far-future timers;
+ *  - the _ladder_, a stack of _rungs_ of unsorted buckets, each rung
+ *    covering the time span of one bucket of the rung above it with
+ *    finer buckets;
+ *  - the _bottom_, a small sorted vector holding the next events.
+ *
+ * Events are inserted in the tier and bucket covering their timestamp,
+ * without any sorting except in the bottom.  When the bottom is empty,
+ * the next non-empty bucket of the lowest rung is moved to the bottom and
+ * sorted if it holds at most `Threshold` events; otherwise it is spread
+ * over a new rung, whose number of buckets is the number of events in the
+ * bucket.  When the ladder is empty, the top is spread over a new first
+ * rung, whose bucket width is the mean interval between the top events.
+ * The rungs hence adapt to the distribution of the event timestamps: the
+ * dense clusters of near-future events get finer rungs, while the sparse
+ * far-future events stay unsorted in the top until they get close.
+ *
+ * If the bottom grows over `Threshold` events, because many events are
+ * scheduled in the time span of the bucket being processed, its events
+ * are spread over a new lowest rung.
+ *
+ * @par Time Complexity
+ *
+ * Operation    | Amortized %Time | Reason
+ * :----------- | :-------------- | :-----
+ * Insert()     | ~Constant       | Append to bucket; bounded sorted bottom
+ * IsEmpty()    | Constant        | Explicit queue size
+ * PeekNext()   | Constant        | Bottom kept sorted and non-empty
+ * Remove()     | ~Constant       | Search within bucket
+ * RemoveNext() | ~Constant       | Bucket transfers amortized over its events
+ *
+ * @par Memory Complexity
+ *
+ * Category  | Memory                           | Reason
+ * :-------- | :------------------------------- | :-----
+ * Overhead  | 3 x `sizeof (*)` per bucket      | `std::vector` buckets
+ * Per Event | 0                                | Events stored in `std::vector` directly
+ */
+class LadderScheduler : public Scheduler
+{
+  public:
+    /**
+     *  Register this type.
+     *  @return The object TypeId.
+     */
+    static TypeId GetTypeId();
+
+    /** Constructor. */
+    LadderScheduler();
+    /** Destructor. */
+    ~LadderScheduler() override;
+
+    // Inherited
+    void Insert(const Scheduler::Event& ev) override;
+    bool IsEmpty() const override;
+    Scheduler::Event PeekNext() const override;
+    Scheduler::Event RemoveNext() override;
+    void Remove(const Scheduler::Event& ev) override;
+
+  private:
+    /** Unsorted bucket of events. */
+    typedef std::vector<Scheduler::Event> Bucket;
+
+    /** A rung of the ladder. */
+    struct Rung
+    {
+        std::vector<Bucket> buckets; //!< The buckets, including the unused ones.
+        std::size_t nBuckets;        //!< Number of buckets in use.
+        uint64_t start;              //!< Timestamp of the start of the first bucket.
+        uint64_t width;              //!< Time span of each bucket.
+        std::size_t current;         //!< Index of the first bucket not yet processed.
+        std::size_t count;           //!< Number of events in the rung.
+    };
+
+    /**
+     * Get the timestamp of the start of the first bucket of a rung not
+     * yet processed; the events before it are in the lower rungs or the bottom.
+     * @param [in] rung The rung.
+     * @returns The start of the current bucket.
+     */
+    static uint64_t CurrentStart(const Rung& rung);
+
+    /**
+     * Find the rung covering a timestamp.
+     * @param [in] ts The timestamp.
+     * @returns The index of the rung, or the number of rungs if the
+     *          timestamp is before the ladder.
+     */
+    std::size_t FindRung(uint64_t ts) const;
+
+    /**
+     * Insert an event in the bottom, spreading the bottom over a new
+     * rung if it becomes too large.
+     * @param [in] ev The event.
+     */
+    void InsertBottom(const Scheduler::Event& ev);
+
+    /**
+     * Add a rung below the existing ones, and spread events over it.
+     * @param [in] events The events, which are moved into the rung.
+     * @param [in] start The start of the time span of the rung.
+     * @param [in] span The duration of the time span of the rung.
+     */
+    void SpawnRung(Bucket& events, uint64_t start, uint64_t span);
+
+    /**
+     * Move the events in a bucket to the bottom and sort them.
+     * @param [in] events The events, which are moved to the bottom.
+     */
+    void SortToBottom(Bucket& events);
+
+    /** Refill the bottom, if it is empty, with the next events. */
+    void Refill();
+
+    uint32_t m_threshold;      //!< Maximum number of events sorted at once
+    uint32_t m_maxRungs;       //!< Maximum number of rungs
+    Bucket m_top;              //!< Events after the time span of the ladder
+    uint64_t m_topStart;       //!< Timestamp of the first event that goes to the top
+    uint64_t m_topMin;         //!< Smallest timestamp in the top
+    uint64_t m_topMax;         //!< Largest timestamp in the top
+    std::vector<Rung> m_rungs; //!< The rungs, including the unused ones
+    std::size_t m_nRungs;      //!< Number of rungs in use
+    Bucket m_bottom;           //!< Next events, sorted in reverse chronological order
+    std::size_t m_size;        //!< Number of events
+};
+
+} // namespace ns3
+
+#endif /* LADDER_SCHEDULER_H */
@@ -0,0 +1,842 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "multithreaded-simulator-impl.h"
+
+#include "assert.h"
+#include "fatal-error.h"
+#include "log.h"
+#include "simulator.h"
+#include "uinteger.h"
+
+#include <algorithm>
+#include <limits>
+
+/**
+ * @file
+ * @ingroup simulator
+ * ns3::MultithreadedSimulatorImpl implementation.
+ */
+
+namespace ns3
+{
+
+// Note:  Logging in this file is largely avoided due to the
+// number of calls that are made to these functions and the possibility
+// of causing recursions leading to stack overflow
+NS_LOG_COMPONENT_DEFINE("MultithreadedSimulatorImpl");
+
+NS_OBJECT_ENSURE_REGISTERED(MultithreadedSimulatorImpl);
+
+namespace
+{
+
+/**
+ * Flag of the provisional ranks, which are the indices of the events
+ * among the events executed by their logical process in the current window.
+ */
+constexpr uint64_t PROVISIONAL = 1ULL << 63;
+
+/** Timestamp meaning no event. */
+constexpr uint64_t NO_TS = std::numeric_limits<uint64_t>::max();
+
+/** Number of chunks of logical processes per thread in a window. */
+constexpr std::size_t CHUNKS_PER_THREAD = 8;
+
+/** Order the events by key, latest first, so that the heaps are min-heaps. */
+struct Later
+{
+    /**
+     * Compare two events.
+     * @param [in] a The first event.
+     * @param [in] b The second event.
+     * @returns true if the first event is after the second one.
+     */
+    template <typename E>
+    bool operator()(const E& a, const E& b) const
+    {
+        if (a.ts != b.ts)
+        {
+            return a.ts > b.ts;
+        }
+        if (a.parent != b.parent)
+        {
+            return a.parent > b.parent;
+        }
+        return a.seq > b.seq;
+    }
+};
+
+/**
+ * Push a message to a lock-free mailbox.
+ * @param [in] mailbox The mailbox.
+ * @param [in] message The message.
+ */
+template <typename M>
+void
+Push(std::atomic<M*>& mailbox, M* message)
+{
+    message->next = mailbox.load(std::memory_order_relaxed);
+    while (!mailbox.compare_exchange_weak(message->next,
+                                          message,
+                                          std::memory_order_release,
+                                          std::memory_order_relaxed))
+    {
+    }
+}
+
+} // namespace
+
+TypeId
+MultithreadedSimulatorImpl::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::MultithreadedSimulatorImpl")
+            .SetParent<SimulatorImpl>()
+            .SetGroupName("Core")
+            .AddConstructor<MultithreadedSimulatorImpl>()
+            .AddAttribute("Threads",
+                          "The number of threads executing the events, including the main "
+                          "thread, or 0 for the number of hardware threads.",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&MultithreadedSimulatorImpl::m_threads),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("Lookahead",
+                          "The minimum delay of the events scheduled for another context, "
+                          "which bounds the windows of events executed in parallel.  If zero, "
+                          "the events are executed one by one.",
+                          TimeValue(Time(0)),
+                          MakeTimeAccessor(&MultithreadedSimulatorImpl::m_lookahead),
+                          MakeTimeChecker(Time(0)));
+    return tid;
+}
+
+MultithreadedSimulatorImpl::MultithreadedSimulatorImpl()
+{
+    NS_LOG_FUNCTION(this);
+    m_orphans = nullptr;
+    m_cursor = 0;
+    m_chunk = 1;
+    m_windowEnd = 0;
+    m_parallel = false;
+    m_stepTs = NO_TS;
+    m_generation = 0;
+    m_busy = 0;
+    m_quit = false;
+    m_rank = 0;
+    m_currentTs = 0;
+    m_eventCount = 0;
+    m_windowCount = 0;
+    m_stop = false;
+    m_eventsWithContextEmpty = true;
+    m_threads = 0;
+    m_mainThreadId = std::this_thread::get_id();
+    // the global logical process, whose current event is the main program
+    GetProcess(Simulator::NO_CONTEXT);
+}
+
+MultithreadedSimulatorImpl::~MultithreadedSimulatorImpl()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+MultithreadedSimulatorImpl::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    ProcessEventsWithContext();
+
+    for (auto& lp : m_processes)
+    {
+        for (auto& ev : lp->events)
+        {
+            ev.impl->Unref();
+        }
+    }
+    m_processes.clear();
+    m_contexts.clear();
+    SimulatorImpl::DoDispose();
+}
+
+void
+MultithreadedSimulatorImpl::Destroy()
+{
+    NS_LOG_FUNCTION(this);
+    while (!m_destroyEvents.empty())
+    {
+        Ptr<EventImpl> ev = m_destroyEvents.front().PeekEventImpl();
+        m_destroyEvents.pop_front();
+        NS_LOG_LOGIC("handle destroy " << ev);
+        if (!ev->IsCancelled())
+        {
+            ev->Invoke();
+        }
+    }
+}
+
+void
+MultithreadedSimulatorImpl::SetScheduler(ObjectFactory schedulerFactory)
+{
+    NS_LOG_FUNCTION(this << schedulerFactory);
+    // The events are kept in the binary heaps of the logical processes
+}
+
+// System ID for non-distributed simulation is always zero
+uint32_t
+MultithreadedSimulatorImpl::GetSystemId() const
+{
+    return 0;
+}
+
+MultithreadedSimulatorImpl::LogicalProcess*&
+MultithreadedSimulatorImpl::Current()
+{
+    static thread_local LogicalProcess* current = nullptr;
+    return current;
+}
+
+MultithreadedSimulatorImpl::LogicalProcess*
+MultithreadedSimulatorImpl::GetProcess(uint32_t context)
+{
+    auto it = m_contexts.find(context);
+    if (it != m_contexts.end())
+    {
+        return it->second;
+    }
+    NS_LOG_LOGIC("new logical process for context " << context);
+    auto lp = std::make_unique<LogicalProcess>();
+    lp->index = m_processes.size();
+    lp->context = context;
+    lp->mailbox = nullptr;
+    lp->currentTs = m_currentTs;
+    lp->currentRank = 0;
+    lp->nextSeq = 0;
+    lp->currentImpl = nullptr;
+    lp->nextUid = EventId::UID::VALID;
+    lp->candidate = false;
+    m_processes.push_back(std::move(lp));
+    m_contexts[context] = m_processes.back().get();
+    return m_processes.back().get();
+}
+
+void
+MultithreadedSimulatorImpl::Insert(LogicalProcess* lp, const Event& ev)
+{
+    lp->events.push_back(ev);
+    std::push_heap(lp->events.begin(), lp->events.end(), Later());
+    if (ev.ts == m_stepTs && !lp->candidate)
+    {
+        lp->candidate = true;
+        m_candidates.push_back(lp);
+    }
+}
+
+EventId
+MultithreadedSimulatorImpl::DoSchedule(uint32_t context, const Time& delay, EventImpl* event)
+{
+    NS_ASSERT_MSG(delay.IsPositive(), "MultithreadedSimulatorImpl::Schedule(): Negative delay");
+    LogicalProcess* current = Current();
+    if (current == nullptr)
+    {
+        // the main program, which is the current event of the global logical process
+        current = m_processes.front().get();
+    }
+
+    Event ev;
+    ev.ts = current->currentTs + delay.GetTimeStep();
+    ev.parent = current->currentRank;
+    ev.seq = current->nextSeq++;
+    ev.impl = event;
+
+    LogicalProcess* target = current;
+    if (context != current->context)
+    {
+        if (m_parallel)
+        {
+            // another thread may be executing the events of the target
+            if (ev.ts < m_windowEnd)
+            {
+                NS_FATAL_ERROR("Event for context "
+                               << context << " scheduled by context " << current->context
+                               << " with a delay of " << delay.As(Time::S)
+                               << ", less than the lookahead of " << m_lookahead.As(Time::S));
+            }
+            ev.uid = EventId::UID::VALID;
+            auto message = new Message;
+            message->event = ev;
+            message->context = context;
+            message->source = current->index;
+            auto it = m_contexts.find(context);
+            Push(it != m_contexts.end() ? it->second->mailbox : m_orphans, message);
+            return EventId(event, ev.ts, context, ev.uid);
+        }
+        target = GetProcess(context);
+    }
+    ev.uid = target->nextUid++;
+    if (target->nextUid == EventId::UID::INVALID)
+    {
+        target->nextUid = EventId::UID::VALID;
+    }
+    Insert(target, ev);
+    return EventId(event, ev.ts, context, ev.uid);
+}
+
+void
+MultithreadedSimulatorImpl::Execute(LogicalProcess* lp, uint64_t rank)
+{
+    std::pop_heap(lp->events.begin(), lp->events.end(), Later());
+    Event next = lp->events.back();
+    lp->events.pop_back();
+
+    PreEventHook(EventId(next.impl, next.ts, lp->context, next.uid));
+
+    NS_ASSERT(next.ts >= lp->currentTs);
+    lp->currentTs = next.ts;
+    lp->currentRank = rank;
+    lp->nextSeq = 0;
+    lp->currentImpl = next.impl;
+    next.impl->Invoke();
+    // mark the event as expired, for the EventId still referencing it
+    next.impl->Cancel();
+    next.impl->Unref();
+    lp->currentImpl = nullptr;
+}
+
+bool
+MultithreadedSimulatorImpl::IsFinished() const
+{
+    if (m_stop)
+    {
+        return true;
+    }
+    for (const auto& lp : m_processes)
+    {
+        if (!lp->events.empty())
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void
+MultithreadedSimulatorImpl::ProcessEventsWithContext()
+{
+    if (m_eventsWithContextEmpty)
+    {
+        return;
+    }
+
+    // swap queues
+    EventsWithContext eventsWithContext;
+    {
+        std::unique_lock lock{m_eventsWithContextMutex};
+        m_eventsWithContext.swap(eventsWithContext);
+        m_eventsWithContextEmpty = true;
+    }
+    // the events are ordered as if they were scheduled by a new event
+    uint64_t rank = ++m_rank;
+    uint64_t seq = 0;
+    for (const auto& event : eventsWithContext)
+    {
+        LogicalProcess* lp = GetProcess(event.context);
+        Event ev;
+        ev.ts = m_currentTs + event.timestamp;
+        ev.parent = rank;
+        ev.seq = seq++;
+        ev.impl = event.event;
+        ev.uid = lp->nextUid++;
+        if (lp->nextUid == EventId::UID::INVALID)
+        {
+            lp->nextUid = EventId::UID::VALID;
+        }
+        Insert(lp, ev);
+    }
+}
+
+void
+MultithreadedSimulatorImpl::RunSequentialStep(uint64_t ts)
+{
+    m_stepTs = ts;
+    for (auto& lp : m_processes)
+    {
+        if (!lp->events.empty() && lp->events.front().ts == ts)
+        {
+            lp->candidate = true;
+            m_candidates.push_back(lp.get());
+        }
+    }
+    while (!m_stop)
+    {
+        // find the next event among the logical processes with events at this timestamp
+        LogicalProcess* next = nullptr;
+        for (std::size_t i = 0; i < m_candidates.size();)
+        {
+            LogicalProcess* lp = m_candidates[i];
+            if (lp->events.empty() || lp->events.front().ts != ts)
+            {
+                lp->candidate = false;
+                m_candidates[i] = m_candidates.back();
+                m_candidates.pop_back();
+                continue;
+            }
+            if (next == nullptr || Later()(next->events.front(), lp->events.front()))
+            {
+                next = lp;
+            }
+            ++i;
+        }
+        if (next == nullptr)
+        {
+            break;
+        }
+        Current() = next;
+        Execute(next, ++m_rank);
+        Current() = nullptr;
+        m_eventCount++;
+    }
+    for (auto lp : m_candidates)
+    {
+        lp->candidate = false;
+    }
+    m_candidates.clear();
+    m_stepTs = NO_TS;
+    m_currentTs = ts;
+}
+
+void
+MultithreadedSimulatorImpl::RunParallelWindow(uint64_t end)
+{
+    m_windowEnd = end;
+    m_active.clear();
+    for (auto& lp : m_processes)
+    {
+        if (!lp->events.empty() && lp->events.front().ts < end)
+        {
+            lp->executed.clear();
+            m_active.push_back(lp.get());
+        }
+    }
+    NS_LOG_LOGIC("window [" << m_active.front()->events.front().ts << ", " << end << ") of "
+                            << m_active.size() << " logical processes");
+
+    m_parallel = true;
+    m_cursor.store(0, std::memory_order_relaxed);
+    m_chunk = std::max<std::size_t>(
+        1,
+        m_active.size() / ((m_workers.size() + 1) * CHUNKS_PER_THREAD));
+    if (m_workers.empty() || m_active.size() == 1)
+    {
+        ProcessWindow();
+    }
+    else
+    {
+        m_busy.store(m_workers.size(), std::memory_order_relaxed);
+        m_generation.fetch_add(1, std::memory_order_release);
+        m_generation.notify_all();
+        ProcessWindow();
+        for (uint32_t busy = m_busy.load(std::memory_order_acquire); busy != 0;
+             busy = m_busy.load(std::memory_order_acquire))
+        {
+            m_busy.wait(busy, std::memory_order_acquire);
+        }
+    }
+    m_parallel = false;
+    m_windowCount++;
+    FinishWindow();
+}
+
+void
+MultithreadedSimulatorImpl::ProcessWindow()
+{
+    const std::size_t size = m_active.size();
+    for (std::size_t first = m_cursor.fetch_add(m_chunk, std::memory_order_relaxed); first < size;
+         first = m_cursor.fetch_add(m_chunk, std::memory_order_relaxed))
+    {
+        const std::size_t last = std::min(first + m_chunk, size);
+        for (std::size_t i = first; i < last; ++i)
+        {
+            LogicalProcess* lp = m_active[i];
+            Current() = lp;
+            while (!lp->events.empty() && lp->events.front().ts < m_windowEnd)
+            {
+                lp->executed.push_back(lp->events.front());
+                Execute(lp, PROVISIONAL | (lp->executed.size() - 1));
+            }
+            Current() = nullptr;
+        }
+    }
+}
+
+void
+MultithreadedSimulatorImpl::FinishWindow()
+{
+    // the final rank of an event whose parent was executed in the window
+    auto finalRank = [](const LogicalProcess* lp, uint64_t rank) {
+        return (rank & PROVISIONAL) ? lp->ranks[rank & ~PROVISIONAL] : rank;
+    };
+
+    /** The next executed event of a logical process, in the merge of the lists. */
+    struct Head
+    {
+        uint64_t ts;        //!< Timestamp.
+        uint64_t parent;    //!< Final rank of the parent.
+        uint64_t seq;       //!< Rank among the events scheduled by the parent.
+        LogicalProcess* lp; //!< The logical process.
+        std::size_t index;  //!< Index in the executed events of the logical process.
+    };
+
+    std::vector<Head> heads;
+    heads.reserve(m_active.size());
+    auto push = [&heads, &finalRank](LogicalProcess* lp, std::size_t index) {
+        const Event& ev = lp->executed[index];
+        heads.push_back({ev.ts, finalRank(lp, ev.parent), ev.seq, lp, index});
+        std::push_heap(heads.begin(), heads.end(), Later());
+    };
+    for (auto lp : m_active)
+    {
+        lp->ranks.resize(lp->executed.size());
+        push(lp, 0);
+    }
+    // rank the executed events in the order of their keys; the parent of an
+    // event executed in the window precedes it in the list of its process
+    while (!heads.empty())
+    {
+        std::pop_heap(heads.begin(), heads.end(), Later());
+        Head head = heads.back();
+        heads.pop_back();
+        head.lp->ranks[head.index] = ++m_rank;
+        m_currentTs = head.ts;
+        m_eventCount++;
+        if (head.index + 1 < head.lp->executed.size())
+        {
+            push(head.lp, head.index + 1);
+        }
+    }
+
+    // the final ranks preserve the order of the events of each process,
+    // and are above all the previous ranks, so the heaps stay valid
+    for (auto lp : m_active)
+    {
+        for (auto& ev : lp->events)
+        {
+            ev.parent = finalRank(lp, ev.parent);
+        }
+    }
+
+    auto deliver = [this, &finalRank](Message* message, LogicalProcess* lp) {
+        while (message != nullptr)
+        {
+            Message* next = message->next;
+            LogicalProcess* target = lp != nullptr ? lp : GetProcess(message->context);
+            Event ev = message->event;
+            ev.parent = finalRank(m_processes[message->source].get(), ev.parent);
+            ev.uid = target->nextUid++;
+            if (target->nextUid == EventId::UID::INVALID)
+            {
+                target->nextUid = EventId::UID::VALID;
+            }
+            Insert(target, ev);
+            delete message;
+            message = next;
+        }
+    };
+    for (std::size_t i = 0; i < m_processes.size(); ++i)
+    {
+        LogicalProcess* lp = m_processes[i].get();
+        deliver(lp->mailbox.exchange(nullptr, std::memory_order_acquire), lp);
+    }
+    deliver(m_orphans.exchange(nullptr, std::memory_order_acquire), nullptr);
+}
+
+void
+MultithreadedSimulatorImpl::RunWorker(uint64_t generation)
+{
+    while (true)
+    {
+        m_generation.wait(generation, std::memory_order_acquire);
+        generation = m_generation.load(std::memory_order_acquire);
+        if (m_quit)
+        {
+            return;
+        }
+        ProcessWindow();
+        if (m_busy.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            m_busy.notify_all();
+        }
+    }
+}
+
+void
+MultithreadedSimulatorImpl::StartWorkers()
+{
+    uint32_t threads = m_threads != 0 ? m_threads : std::thread::hardware_concurrency();
+    if (m_lookahead.IsZero() || threads <= 1)
+    {
+        return;
+    }
+    NS_LOG_LOGIC("start " << threads - 1 << " worker threads");
+    m_quit = false;
+    // the workers wait for the next window, even if started after it
+    const uint64_t generation = m_generation.load(std::memory_order_relaxed);
+    for (uint32_t i = 1; i < threads; ++i)
+    {
+        m_workers.emplace_back(&MultithreadedSimulatorImpl::RunWorker, this, generation);
+    }
+}
+
+void
+MultithreadedSimulatorImpl::StopWorkers()
+{
+    if (m_workers.empty())
+    {
+        return;
+    }
+    m_quit = true;
+    m_generation.fetch_add(1, std::memory_order_release);
+    m_generation.notify_all();
+    for (auto& worker : m_workers)
+    {
+        worker.join();
+    }
+    m_workers.clear();
+}
+
+void
+MultithreadedSimulatorImpl::Run()
+{
+    NS_LOG_FUNCTION(this);
+    // Set the current threadId as the main threadId
+    m_mainThreadId = std::this_thread::get_id();
+    ProcessEventsWithContext();
+    m_stop = false;
+    StartWorkers();
+
+    LogicalProcess* global = m_processes.front().get();
+    const uint64_t lookahead = m_lookahead.GetTimeStep();
+    while (!m_stop)
+    {
+        ProcessEventsWithContext();
+        uint64_t next = NO_TS;
+        for (const auto& lp : m_processes)
+        {
+            if (!lp->events.empty())
+            {
+                next = std::min(next, lp->events.front().ts);
+            }
+        }
+        if (next == NO_TS)
+        {
+            break;
+        }
+        const uint64_t nextGlobal = global->events.empty() ? NO_TS : global->events.front().ts;
+        if (lookahead == 0 || nextGlobal == next)
+        {
+            RunSequentialStep(next);
+        }
+        else
+        {
+            const uint64_t end = next > NO_TS - lookahead ? NO_TS : next + lookahead;
+            RunParallelWindow(std::min(end, nextGlobal));
+        }
+    }
+
+    StopWorkers();
+    // the events scheduled by the main program are ordered after the executed ones
+    global->currentTs = m_currentTs;
+    global->currentRank = ++m_rank;
+    global->nextSeq = 0;
+}
+
+void
+MultithreadedSimulatorImpl::Stop()
+{
+    NS_LOG_FUNCTION(this);
+    m_stop = true;
+}
+
+EventId
+MultithreadedSimulatorImpl::Stop(const Time& delay)
+{
+    NS_LOG_FUNCTION(this << delay.GetTimeStep());
+    return Simulator::Schedule(delay, &Simulator::Stop);
+}
+
+//
+// Schedule an event for a _relative_ time in the future.
+//
+EventId
+MultithreadedSimulatorImpl::Schedule(const Time& delay, EventImpl* event)
+{
+    NS_LOG_FUNCTION(this << delay.GetTimeStep() << event);
+    NS_ASSERT_MSG(Current() != nullptr || m_mainThreadId == std::this_thread::get_id(),
+                  "Simulator::Schedule Thread-unsafe invocation!");
+
+    return DoSchedule(GetContext(), delay, event);
+}
+
+void
+MultithreadedSimulatorImpl::ScheduleWithContext(uint32_t context,
+                                                const Time& delay,
+                                                EventImpl* event)
+{
+    NS_LOG_FUNCTION(this << context << delay.GetTimeStep() << event);
+
+    if (Current() != nullptr || m_mainThreadId == std::this_thread::get_id())
+    {
+        DoSchedule(context, delay, event);
+    }
+    else
+    {
+        EventWithContext ev;
+        ev.context = context;
+        // Current time added in ProcessEventsWithContext()
+        ev.timestamp = delay.GetTimeStep();
+        ev.event = event;
+        {
+            std::unique_lock lock{m_eventsWithContextMutex};
+            m_eventsWithContext.push_back(ev);
+            m_eventsWithContextEmpty = false;
+        }
+    }
+}
+
+EventId
+MultithreadedSimulatorImpl::ScheduleNow(EventImpl* event)
+{
+    NS_ASSERT_MSG(Current() != nullptr || m_mainThreadId == std::this_thread::get_id(),
+                  "Simulator::ScheduleNow Thread-unsafe invocation!");
+
+    return Schedule(Time(0), event);
+}
+
+EventId
+MultithreadedSimulatorImpl::ScheduleDestroy(EventImpl* event)
+{
+    NS_ASSERT_MSG(m_mainThreadId == std::this_thread::get_id() && !m_parallel,
+                  "Simulator::ScheduleDestroy Thread-unsafe invocation!");
+
+    EventId id(Ptr<EventImpl>(event, false), m_currentTs, 0xffffffff, 2);
+    m_destroyEvents.push_back(id);
+    return id;
+}
+
+Time
+MultithreadedSimulatorImpl::Now() const
+{
+    // Do not add function logging here, to avoid stack overflow
+    const LogicalProcess* current = Current();
+    return TimeStep(current != nullptr ? current->currentTs : m_currentTs);
+}
+
+Time
+MultithreadedSimulatorImpl::GetDelayLeft(const EventId& id) const
+{
+    if (IsExpired(id))
+    {
+        return TimeStep(0);
+    }
+    else
+    {
+        return TimeStep(id.GetTs()) - Now();
+    }
+}
+
+void
+MultithreadedSimulatorImpl::Remove(const EventId& id)
+{
+    if (id.GetUid() == EventId::UID::DESTROY)
+    {
+        // destroy events.
+        for (auto i = m_destroyEvents.begin(); i != m_destroyEvents.end(); i++)
+        {
+            if (*i == id)
+            {
+                m_destroyEvents.erase(i);
+                break;
+            }
+        }
+        return;
+    }
+    if (IsExpired(id))
+    {
+        return;
+    }
+    auto it = m_contexts.find(id.GetContext());
+    NS_ASSERT(it != m_contexts.end());
+    std::vector<Event>& events = it->second->events;
+    auto ev = std::find_if(events.begin(), events.end(), [&id](const Event& ev) {
+        return ev.impl == id.PeekEventImpl();
+    });
+    NS_ASSERT_MSG(ev != events.end(), "Event of another context removed in a parallel window");
+    *ev = events.back();
+    events.pop_back();
+    std::make_heap(events.begin(), events.end(), Later());
+    id.PeekEventImpl()->Cancel();
+    // whenever we remove an event from the event list, we have to unref it.
+    id.PeekEventImpl()->Unref();
+}
+
+void
+MultithreadedSimulatorImpl::Cancel(const EventId& id)
+{
+    if (!IsExpired(id))
+    {
+        id.PeekEventImpl()->Cancel();
+    }
+}
+
+bool
+MultithreadedSimulatorImpl::IsExpired(const EventId& id) const
+{
+    if (id.GetUid() == EventId::UID::DESTROY)
+    {
+        if (id.PeekEventImpl() == nullptr || id.PeekEventImpl()->IsCancelled())
+        {
+            return true;
+        }
+        // destroy events.
+        for (auto i = m_destroyEvents.begin(); i != m_destroyEvents.end(); i++)
+        {
+            if (*i == id)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+    // the executed events are marked as cancelled, except the current one
+    const LogicalProcess* current = Current();
+    return id.PeekEventImpl() == nullptr ||
+           (current != nullptr && id.PeekEventImpl() == current->currentImpl) ||
+           id.PeekEventImpl()->IsCancelled();
+}
+
+Time
+MultithreadedSimulatorImpl::GetMaximumSimulationTime() const
+{
+    return TimeStep(0x7fffffffffffffffLL);
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetContext() const
+{
+    const LogicalProcess* current = Current();
+    return current != nullptr ? current->context : Simulator::NO_CONTEXT;
+}
+
+uint64_t
+MultithreadedSimulatorImpl::GetEventCount() const
+{
+    return m_eventCount;
+}
+
+uint64_t
+MultithreadedSimulatorImpl::GetParallelWindowCount() const
+{
+    return m_windowCount;
+}
+
+} // namespace ns3
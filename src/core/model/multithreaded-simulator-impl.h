@@ -0,0 +1,312 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef MULTITHREADED_SIMULATOR_IMPL_H
+#define MULTITHREADED_SIMULATOR_IMPL_H
+
+#include "nstime.h"
+#include "simulator-impl.h"
+
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @file
+ * @ingroup simulator
+ * ns3::MultithreadedSimulatorImpl declaration.
+ */
+
+namespace ns3
+{
+
+/**
+ * @ingroup simulator
+ *
+ * @brief A conservative parallel simulator engine, executing the events of
+ * the different contexts on several threads of a single process.
+ *
+ * The events are partitioned by context, i.e., by node in the network
+ * models, into _logical processes_ which each have their own event list.
+ * The events without context (Simulator::NO_CONTEXT), e.g., those
+ * scheduled by the main program, belong to the _global_ logical process.
+ *
+ * The simulation advances by windows.  If `T` is the time of the earliest
+ * pending event, and `G` the time of the earliest global event, all the
+ * events before `min (T + Lookahead, G)` are executed in parallel: the
+ * logical processes with such events are distributed over the `Threads`
+ * threads, which each take the next few logical processes from a shared
+ * cursor when they are done with the previous ones, so that the load is
+ * balanced between the threads.  The threads then synchronize at a barrier.
+ * The events at time `G` are executed by the main thread, one by one, as
+ * well as all the events if `Lookahead` is zero.
+ *
+ * Within a window, an event can schedule events of its own context at any
+ * time, but the events of the other contexts must be scheduled at or after
+ * the end of the window, which holds as long as they are scheduled with a
+ * delay of at least `Lookahead`, e.g., the minimum propagation delay of the
+ * channels connecting the nodes.  They are pushed to lock-free mailboxes,
+ * which are emptied at the barrier.  Scheduling an event of another
+ * context earlier is a fatal error.
+ *
+ * The events are executed in the order of the DefaultSimulatorImpl.  Each
+ * event is keyed by its timestamp, the rank of the event which scheduled it
+ * in the global execution order, and its rank among the events scheduled
+ * by this event, which orders the events with the same timestamp as the
+ * unique ids of the DefaultSimulatorImpl do.  The ranks of the events
+ * executed in a window are only known at the barrier, where the lists of
+ * the events executed by the logical processes are merged: the keys of
+ * the events scheduled in the window use provisional ranks until then.
+ *
+ * A simulation hence produces the same results as with the
+ * DefaultSimulatorImpl, whatever the number of threads, provided that
+ * the events of a context do not access the state of the other contexts,
+ * and that the objects shared by several contexts, e.g., the packets
+ * copied to several receivers, are thread-safe.  This does not hold for
+ * most of the network models: this engine is meant for the models
+ * designed for it, and these conditions are not checked.  In particular:
+ *
+ *  - an event must only cancel or remove the events of its own context;
+ *  - Simulator::GetEventCount() is only updated at the barriers;
+ *  - Simulator::Stop() called by an event of a parallel window takes
+ *    effect at the end of the window;
+ *  - PreEventHook() is called by the threads executing the events.
+ *
+ * The events are kept in binary heaps rather than in the event scheduler
+ * set by SetScheduler(), which is not used.
+ */
+class MultithreadedSimulatorImpl : public SimulatorImpl
+{
+  public:
+    /**
+     *  Register this type.
+     *  @return The object TypeId.
+     */
+    static TypeId GetTypeId();
+
+    /** Constructor. */
+    MultithreadedSimulatorImpl();
+    /** Destructor. */
+    ~MultithreadedSimulatorImpl() override;
+
+    // Inherited
+    void Destroy() override;
+    bool IsFinished() const override;
+    void Stop() override;
+    EventId Stop(const Time& delay) override;
+    EventId Schedule(const Time& delay, EventImpl* event) override;
+    void ScheduleWithContext(uint32_t context, const Time& delay, EventImpl* event) override;
+    EventId ScheduleNow(EventImpl* event) override;
+    EventId ScheduleDestroy(EventImpl* event) override;
+    void Remove(const EventId& id) override;
+    void Cancel(const EventId& id) override;
+    bool IsExpired(const EventId& id) const override;
+    void Run() override;
+    Time Now() const override;
+    Time GetDelayLeft(const EventId& id) const override;
+    Time GetMaximumSimulationTime() const override;
+    void SetScheduler(ObjectFactory schedulerFactory) override;
+    uint32_t GetSystemId() const override;
+    uint32_t GetContext() const override;
+    uint64_t GetEventCount() const override;
+
+    /**
+     * Get the number of windows whose events were executed in parallel.
+     * @returns The number of parallel windows.
+     */
+    uint64_t GetParallelWindowCount() const;
+
+  private:
+    void DoDispose() override;
+
+    /** An event, keyed as explained in the class documentation. */
+    struct Event
+    {
+        uint64_t ts;     //!< Timestamp.
+        uint64_t parent; //!< Rank of the event which scheduled it.
+        uint64_t seq;    //!< Rank among the events scheduled by the same event.
+        EventImpl* impl; //!< The event implementation.
+        uint32_t uid;    //!< Uid of the EventId, unique within the context.
+    };
+
+    /** An event scheduled for another logical process during a window. */
+    struct Message
+    {
+        Event event;      //!< The event.
+        uint32_t context; //!< The context of the event.
+        uint32_t source;  //!< Index of the logical process which scheduled it.
+        Message* next;    //!< Next message in the mailbox.
+    };
+
+    /** A logical process. */
+    struct LogicalProcess
+    {
+        uint32_t index;                //!< Index in m_processes.
+        uint32_t context;              //!< Context of the events.
+        std::vector<Event> events;     //!< Event list, as a binary heap.
+        std::atomic<Message*> mailbox; //!< Lock-free stack of the messages received.
+        uint64_t currentTs;            //!< Timestamp of the current event.
+        uint64_t currentRank;          //!< Rank of the current event.
+        uint64_t nextSeq;              //!< Rank of the next event scheduled by the current one.
+        EventImpl* currentImpl;        //!< The current event, or nullptr.
+        uint32_t nextUid;              //!< Uid of the next EventId.
+        std::vector<Event> executed;   //!< Events executed in the current window.
+        std::vector<uint64_t> ranks;   //!< Final ranks of the events executed in the window.
+        bool candidate;                //!< Whether it has events at the current sequential step.
+    };
+
+    /**
+     * Get the logical process executing events on the calling thread.
+     * @returns The logical process, or nullptr.
+     */
+    static LogicalProcess*& Current();
+
+    /**
+     * Get the logical process of a context, creating it if needed.
+     * @param [in] context The context.
+     * @returns The logical process.
+     */
+    LogicalProcess* GetProcess(uint32_t context);
+
+    /**
+     * Insert an event in an event list.
+     * @param [in] lp The logical process.
+     * @param [in] ev The event.
+     */
+    void Insert(LogicalProcess* lp, const Event& ev);
+
+    /**
+     * Schedule an event from the main thread or from an event.
+     * @param [in] context The context of the event.
+     * @param [in] delay The delay of the event.
+     * @param [in] event The event implementation.
+     * @returns The EventId of the event.
+     */
+    EventId DoSchedule(uint32_t context, const Time& delay, EventImpl* event);
+
+    /**
+     * Execute the next event of a logical process.
+     * @param [in] lp The logical process.
+     * @param [in] rank The rank of the event.
+     */
+    void Execute(LogicalProcess* lp, uint64_t rank);
+
+    /** Move the events scheduled by other threads to the event lists. */
+    void ProcessEventsWithContext();
+
+    /**
+     * Execute all the events at a timestamp, one by one.
+     * @param [in] ts The timestamp.
+     */
+    void RunSequentialStep(uint64_t ts);
+
+    /**
+     * Execute the events before a time in parallel.
+     * @param [in] end The end of the window.
+     */
+    void RunParallelWindow(uint64_t end);
+
+    /** Execute the events of the window of the logical processes taken from the cursor. */
+    void ProcessWindow();
+
+    /**
+     * Assign the final ranks of the events executed in the window, and
+     * deliver the messages.
+     */
+    void FinishWindow();
+
+    /**
+     * Body of the worker threads.
+     * @param [in] generation The value of m_generation before the first window.
+     */
+    void RunWorker(uint64_t generation);
+
+    /** Start the worker threads. */
+    void StartWorkers();
+
+    /** Stop the worker threads. */
+    void StopWorkers();
+
+    /** Container type for the events to run at Simulator::Destroy() */
+    typedef std::list<EventId> DestroyEvents;
+    /** The container of events to run at Destroy. */
+    DestroyEvents m_destroyEvents;
+
+    /** The logical processes; the first one is the global one. */
+    std::vector<std::unique_ptr<LogicalProcess>> m_processes;
+    /** The logical processes, by context. */
+    std::unordered_map<uint32_t, LogicalProcess*> m_contexts;
+    /** Messages for the contexts without logical process yet. */
+    std::atomic<Message*> m_orphans;
+
+    /** The logical processes with events in the current window. */
+    std::vector<LogicalProcess*> m_active;
+    /** Index of the next logical process of m_active to take. */
+    std::atomic<std::size_t> m_cursor;
+    /** Number of logical processes taken from the cursor at once. */
+    std::size_t m_chunk;
+    /** End of the current window. */
+    uint64_t m_windowEnd;
+    /** Whether a parallel window is being executed. */
+    bool m_parallel;
+    /** The logical processes with events at the current sequential step. */
+    std::vector<LogicalProcess*> m_candidates;
+    /** Timestamp of the current sequential step. */
+    uint64_t m_stepTs;
+
+    /** The worker threads. */
+    std::vector<std::thread> m_workers;
+    /** Incremented to start a window, or to stop the worker threads. */
+    std::atomic<uint64_t> m_generation;
+    /** Number of worker threads still executing the window. */
+    std::atomic<uint32_t> m_busy;
+    /** Flag telling the worker threads to exit. */
+    bool m_quit;
+
+    /** Rank of the last event executed. */
+    uint64_t m_rank;
+    /** Timestamp of the last event executed. */
+    uint64_t m_currentTs;
+    /** The event count. */
+    uint64_t m_eventCount;
+    /** The number of parallel windows. */
+    uint64_t m_windowCount;
+    /** Flag calling for the end of the simulation. */
+    std::atomic<bool> m_stop;
+
+    /** Wrap an event with its execution context. */
+    struct EventWithContext
+    {
+        /** The event context. */
+        uint32_t context;
+        /** Event delay. */
+        uint64_t timestamp;
+        /** The event implementation. */
+        EventImpl* event;
+    };
+
+    /** Container type for the events from other threads. */
+    typedef std::list<EventWithContext> EventsWithContext;
+    /** The container of events from other threads. */
+    EventsWithContext m_eventsWithContext;
+    /** Flag \c true if all events from other threads have been moved to the event lists. */
+    std::atomic<bool> m_eventsWithContextEmpty;
+    /** Mutex to control access to the list of events from other threads. */
+    std::mutex m_eventsWithContextMutex;
+
+    /** Minimum delay of the events scheduled for another context. */
+    Time m_lookahead;
+    /** Number of threads executing the events, including the main thread. */
+    uint32_t m_threads;
+    /** Main execution thread. */
+    std::thread::id m_mainThreadId;
+};
+
+} // namespace ns3
+
+#endif /* MULTITHREADED_SIMULATOR_IMPL_H */
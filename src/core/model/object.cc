@@ -18,6 +18,7 @@
 #include <cstdlib>
 #include <cstring>
 #include <sstream>
+#include <unordered_map>
 #include <vector>
 
 /**
@@ -37,6 +38,15 @@ NS_LOG_COMPONENT_DEFINE("Object");
 
 NS_OBJECT_ENSURE_REGISTERED(Object);
 
+struct Object::GetObjectCache
+{
+    /**
+     * The aggregated Object found for each TypeId uid, or nullptr if
+     * none of them is of that TypeId.
+     */
+    std::unordered_map<uint16_t, Object*> objects;
+};
+
 Object::AggregateIterator::AggregateIterator()
     : m_object(nullptr),
       m_current(0)
@@ -102,6 +112,7 @@ Object::Object()
 {
     NS_LOG_FUNCTION(this);
     m_aggregates->n = 1;
+    m_aggregates->cache = nullptr;
     m_aggregates->buffer[0] = this;
 }
 
@@ -121,6 +132,8 @@ Object::~Object()
             m_aggregates->n--;
         }
     }
+    // the cache may refer to this object
+    ClearCache(m_aggregates);
     // finally, if all objects have been removed from the list,
     // delete the aggregate list
     if (m_aggregates->n == 0)
@@ -139,6 +152,7 @@ Object::Object(const Object& o)
       m_getObjectCount(0)
 {
     m_aggregates->n = 1;
+    m_aggregates->cache = nullptr;
     m_aggregates->buffer[0] = this;
 }
 
@@ -155,33 +169,47 @@ Object::DoGetObject(TypeId tid) const
     NS_LOG_FUNCTION(this << tid);
     NS_ASSERT(CheckLoose());
 
-    // First check if the object is in the normal aggregates.
-    uint32_t n = m_aggregates->n;
+    // First check if the object is in the normal aggregates. The result of
+    // the lookup, found or not, is cached for all of them until the list
+    // of aggregates changes.
+    if (m_aggregates->cache == nullptr)
+    {
+        m_aggregates->cache = new GetObjectCache;
+    }
+    auto [cached, inserted] = m_aggregates->cache->objects.try_emplace(tid.GetUid(), nullptr);
     TypeId objectTid = Object::GetTypeId();
-    for (uint32_t i = 0; i < n; i++)
+    if (inserted)
     {
-        Object* current = m_aggregates->buffer[i];
-        TypeId cur = current->GetInstanceTypeId();
-        while (cur != tid && cur != objectTid)
+        uint32_t n = m_aggregates->n;
+        for (uint32_t i = 0; i < n; i++)
         {
-            cur = cur.GetParent();
-        }
-        if (cur == tid)
-        {
-            // This is an attempt to 'cache' the result of this lookup.
-            // the idea is that if we perform a lookup for a TypeId on this object,
-            // we are likely to perform the same lookup later so, we make sure
-            // that the aggregate array is sorted by the number of accesses
-            // to each object.
-
-            // first, increment the access count
-            current->m_getObjectCount++;
-            // then, update the sort
-            UpdateSortedArray(m_aggregates, i);
-            // finally, return the match
-            return const_cast<Object*>(current);
+            Object* current = m_aggregates->buffer[i];
+            TypeId cur = current->GetInstanceTypeId();
+            while (cur != tid && cur != objectTid)
+            {
+                cur = cur.GetParent();
+            }
+            if (cur == tid)
+            {
+                // The array of aggregates is sorted by the number of accesses
+                // to each object, so that the first one, which GetObject()
+                // checks before calling this method, is likely to be the
+                // requested one.
+
+                // first, increment the access count
+                current->m_getObjectCount++;
+                // then, update the sort
+                UpdateSortedArray(m_aggregates, i);
+                // finally, cache the match
+                cached->second = current;
+                break;
+            }
         }
     }
+    if (cached->second != nullptr)
+    {
+        return cached->second;
+    }
 
     // Next check if it's a unidirectional aggregate
     for (auto& uniItem : m_unidirectionalAggregates)
@@ -294,6 +322,14 @@ Object::UpdateSortedArray(Aggregates* aggregates, uint32_t j) const
     }
 }
 
+void
+Object::ClearCache(Aggregates* aggregates)
+{
+    NS_LOG_FUNCTION(aggregates);
+    delete aggregates->cache;
+    aggregates->cache = nullptr;
+}
+
 void
 Object::AggregateObject(Ptr<Object> o)
 {
@@ -308,6 +344,7 @@ Object::AggregateObject(Ptr<Object> o)
     uint32_t total = m_aggregates->n + other->m_aggregates->n;
     auto aggregates = (Aggregates*)std::malloc(sizeof(Aggregates) + (total - 1) * sizeof(Object*));
     aggregates->n = total;
+    aggregates->cache = nullptr;
 
     // copy our buffer to the new buffer
     std::memcpy(&aggregates->buffer[0],
@@ -360,6 +397,8 @@ Object::AggregateObject(Ptr<Object> o)
     }
 
     // Now that we are done with them, we can free our old aggregate buffers
+    ClearCache(a);
+    ClearCache(b);
     std::free(a);
     std::free(b);
 }
@@ -427,6 +466,7 @@ Object::SetTypeId(TypeId tid)
     NS_LOG_FUNCTION(this << tid);
     NS_ASSERT(Check());
     m_tid = tid;
+    ClearCache(m_aggregates);
 }
 
 void
@@ -360,6 +360,9 @@ class Object : public SimpleRefCount<Object, ObjectBase, ObjectDeleter>
 
     /**@}*/
 
+    /** The results of the lookups of the aggregated Objects by TypeId. */
+    struct GetObjectCache;
+
     /**
      * The list of Objects aggregated to this one.
      *
@@ -376,10 +379,20 @@ class Object : public SimpleRefCount<Object, ObjectBase, ObjectDeleter>
     {
         /** The number of entries in \c buffer. */
         uint32_t n;
+        /** The results of the lookups in \c buffer, or nullptr. */
+        GetObjectCache* cache;
         /** The array of Objects. */
         Object* buffer[1];
     };
 
+    /**
+     * Delete the cache of the lookups of a list of aggregates, when it
+     * changes or is deleted.
+     *
+     * @param [in,out] aggregates The list of aggregated Objects.
+     */
+    static void ClearCache(Aggregates* aggregates);
+
     /**
      * Find an Object of TypeId tid in the aggregates of this Object.
      *
@@ -0,0 +1,450 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "replication-runner.h"
+
+#include "abort.h"
+#include "assert.h"
+#include "log.h"
+#include "rng-seed-manager.h"
+#include "simulator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <set>
+#include <thread>
+
+#ifndef __WIN32__
+#include <cerrno>
+#include <poll.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @file
+ * @ingroup core
+ * ns3::ReplicationRunner implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("ReplicationRunner");
+
+namespace
+{
+
+/**
+ * Evaluate the continued fraction of the regularized incomplete beta
+ * function with the modified Lentz's method.
+ * @param [in] a The first shape parameter.
+ * @param [in] b The second shape parameter.
+ * @param [in] x The point at which the function is evaluated, in (0, 1).
+ * @returns The value of the continued fraction.
+ */
+double
+BetaContinuedFraction(double a, double b, double x)
+{
+    const double tiny = 1e-300;
+    const auto clamp = [tiny](double v) { return (std::abs(v) < tiny) ? tiny : v; };
+
+    double c = 1;
+    double d = 1 / clamp(1 - (a + b) * x / (a + 1));
+    double h = d;
+    for (int m = 1; m <= 300; ++m)
+    {
+        const int m2 = 2 * m;
+        double aa = m * (b - m) * x / ((a - 1 + m2) * (a + m2));
+        d = 1 / clamp(1 + aa * d);
+        c = clamp(1 + aa / c);
+        h *= d * c;
+        aa = -(a + m) * (a + b + m) * x / ((a + m2) * (a + 1 + m2));
+        d = 1 / clamp(1 + aa * d);
+        c = clamp(1 + aa / c);
+        const double delta = d * c;
+        h *= delta;
+        if (std::abs(delta - 1) < 1e-15)
+        {
+            break;
+        }
+    }
+    return h;
+}
+
+/**
+ * Evaluate the regularized incomplete beta function.
+ * @param [in] a The first shape parameter.
+ * @param [in] b The second shape parameter.
+ * @param [in] x The point at which the function is evaluated.
+ * @returns The value of the function.
+ */
+double
+RegularizedIncompleteBeta(double a, double b, double x)
+{
+    if (x <= 0)
+    {
+        return 0;
+    }
+    if (x >= 1)
+    {
+        return 1;
+    }
+    const double front = std::exp(std::lgamma(a + b) - std::lgamma(a) - std::lgamma(b) +
+                                  a * std::log(x) + b * std::log1p(-x));
+    if (x < (a + 1) / (a + b + 2))
+    {
+        return front * BetaContinuedFraction(a, b, x) / a;
+    }
+    return 1 - front * BetaContinuedFraction(b, a, 1 - x) / b;
+}
+
+/**
+ * Compute a quantile of the Student's t-distribution.
+ * @param [in] p The probability, in [0.5, 1).
+ * @param [in] dof The number of degrees of freedom.
+ * @returns The quantile.
+ */
+double
+StudentTQuantile(double p, double dof)
+{
+    NS_ASSERT(p >= 0.5 && p < 1);
+    // P(T > t) = I(dof / (dof + t^2); dof / 2, 1 / 2) / 2, which decreases with t
+    const auto upperTail = [dof](double t) {
+        return 0.5 * RegularizedIncompleteBeta(dof / 2, 0.5, dof / (dof + t * t));
+    };
+    double low = 0;
+    double high = 1;
+    while (upperTail(high) > 1 - p)
+    {
+        high *= 2;
+    }
+    for (int i = 0; i < 200 && high - low > 1e-12 * high; ++i)
+    {
+        const double middle = (low + high) / 2;
+        if (upperTail(middle) > 1 - p)
+        {
+            low = middle;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+    return (low + high) / 2;
+}
+
+#ifndef __WIN32__
+
+/**
+ * Serialize metrics as a sequence of (name length, name, value) records.
+ * @param [in] metrics The metrics.
+ * @returns The serialized metrics.
+ */
+std::string
+SerializeMetrics(const ReplicationRunner::Metrics& metrics)
+{
+    std::string buffer;
+    for (const auto& [name, value] : metrics)
+    {
+        const auto length = static_cast<uint32_t>(name.size());
+        buffer.append(reinterpret_cast<const char*>(&length), sizeof(length));
+        buffer.append(name);
+        buffer.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+    return buffer;
+}
+
+/**
+ * Deserialize metrics serialized by SerializeMetrics().
+ * @param [in] buffer The serialized metrics.
+ * @param [out] metrics The metrics.
+ * @returns Whether the buffer is well formed.
+ */
+bool
+DeserializeMetrics(const std::string& buffer, ReplicationRunner::Metrics& metrics)
+{
+    std::size_t offset = 0;
+    while (offset < buffer.size())
+    {
+        uint32_t length;
+        double value;
+        if (buffer.size() - offset < sizeof(length))
+        {
+            return false;
+        }
+        std::memcpy(&length, buffer.data() + offset, sizeof(length));
+        offset += sizeof(length);
+        if (buffer.size() - offset < length + sizeof(value))
+        {
+            return false;
+        }
+        std::string name(buffer, offset, length);
+        offset += length;
+        std::memcpy(&value, buffer.data() + offset, sizeof(value));
+        offset += sizeof(value);
+        metrics[name] = value;
+    }
+    return true;
+}
+
+#endif // __WIN32__
+
+} // namespace
+
+ReplicationRunner::ReplicationRunner()
+    : m_replications(1),
+      m_firstRun(1),
+      m_parallelism(0),
+      m_confidenceLevel(0.95)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+ReplicationRunner::SetReplications(uint32_t count)
+{
+    NS_LOG_FUNCTION(this << count);
+    m_replications = count;
+}
+
+void
+ReplicationRunner::SetFirstRun(uint64_t run)
+{
+    NS_LOG_FUNCTION(this << run);
+    m_firstRun = run;
+}
+
+void
+ReplicationRunner::SetParallelism(uint32_t jobs)
+{
+    NS_LOG_FUNCTION(this << jobs);
+    m_parallelism = jobs;
+}
+
+void
+ReplicationRunner::SetConfidenceLevel(double level)
+{
+    NS_LOG_FUNCTION(this << level);
+    NS_ABORT_MSG_IF(level <= 0 || level >= 1, "Confidence level must be in (0, 1)");
+    m_confidenceLevel = level;
+}
+
+const std::vector<ReplicationRunner::Metrics>&
+ReplicationRunner::GetResults() const
+{
+    return m_results;
+}
+
+std::map<std::string, ReplicationRunner::Summary>
+ReplicationRunner::Run(Scenario scenario)
+{
+    NS_LOG_FUNCTION(this);
+    m_results.assign(m_replications, Metrics());
+#ifdef __WIN32__
+    RunSequential(scenario);
+#else
+    RunForked(scenario);
+#endif
+
+    std::set<std::string> names;
+    for (const auto& metrics : m_results)
+    {
+        for (const auto& [name, value] : metrics)
+        {
+            names.insert(name);
+        }
+    }
+    std::map<std::string, Summary> summaries;
+    for (const auto& name : names)
+    {
+        std::vector<double> samples;
+        for (const auto& metrics : m_results)
+        {
+            if (auto it = metrics.find(name); it != metrics.end())
+            {
+                samples.push_back(it->second);
+            }
+        }
+        summaries[name] = Summarize(samples, m_confidenceLevel);
+    }
+    return summaries;
+}
+
+ReplicationRunner::Summary
+ReplicationRunner::Summarize(const std::vector<double>& samples, double level)
+{
+    Summary summary;
+    summary.count = samples.size();
+    if (samples.empty())
+    {
+        return summary;
+    }
+    const auto [min, max] = std::minmax_element(samples.begin(), samples.end());
+    summary.min = *min;
+    summary.max = *max;
+
+    double sum = 0;
+    for (auto sample : samples)
+    {
+        sum += sample;
+    }
+    summary.mean = sum / samples.size();
+    if (samples.size() == 1)
+    {
+        summary.confidenceInterval = std::numeric_limits<double>::infinity();
+        return summary;
+    }
+
+    double squares = 0;
+    for (auto sample : samples)
+    {
+        squares += (sample - summary.mean) * (sample - summary.mean);
+    }
+    summary.stddev = std::sqrt(squares / (samples.size() - 1));
+    summary.confidenceInterval = StudentTQuantile((1 + level) / 2, samples.size() - 1) *
+                                 summary.stddev / std::sqrt(samples.size());
+    return summary;
+}
+
+void
+ReplicationRunner::RunSequential(const Scenario& scenario)
+{
+    NS_LOG_FUNCTION(this);
+    const auto run = RngSeedManager::GetRun();
+    for (uint32_t i = 0; i < m_replications; ++i)
+    {
+        RngSeedManager::SetRun(m_firstRun + i);
+        m_results[i] = scenario(m_firstRun + i);
+        Simulator::Destroy();
+        NS_LOG_INFO("Replication with run number " << m_firstRun + i << " done");
+    }
+    RngSeedManager::SetRun(run);
+}
+
+#ifndef __WIN32__
+
+void
+ReplicationRunner::RunForked(const Scenario& scenario)
+{
+    NS_LOG_FUNCTION(this);
+
+    /// A replication running in a child process
+    struct Child
+    {
+        pid_t pid;        //!< Process ID of the child
+        int fd;           //!< Read end of the pipe the child writes its metrics to
+        uint32_t index;   //!< Index of the replication
+        std::string data; //!< Data read so far from the pipe
+    };
+
+    uint32_t parallelism = m_parallelism;
+    if (parallelism == 0)
+    {
+        parallelism = std::max(std::thread::hardware_concurrency(), 1U);
+    }
+
+    std::vector<Child> running;
+    uint32_t next = 0;
+    while (next < m_replications || !running.empty())
+    {
+        while (next < m_replications && running.size() < parallelism)
+        {
+            int fds[2];
+            NS_ABORT_MSG_IF(pipe(fds) != 0, "Cannot create pipe: " << std::strerror(errno));
+            // do not let the children flush the output buffered so far
+            std::cout.flush();
+            std::cerr.flush();
+            std::fflush(nullptr);
+            const pid_t pid = fork();
+            NS_ABORT_MSG_IF(pid < 0, "Cannot fork: " << std::strerror(errno));
+            if (pid == 0)
+            {
+                close(fds[0]);
+                for (const auto& child : running)
+                {
+                    close(child.fd);
+                }
+                const uint64_t run = m_firstRun + next;
+                RngSeedManager::SetRun(run);
+                const auto buffer = SerializeMetrics(scenario(run));
+                std::cout.flush();
+                std::cerr.flush();
+                std::fflush(nullptr);
+                std::size_t written = 0;
+                while (written < buffer.size())
+                {
+                    const auto n = write(fds[1], buffer.data() + written, buffer.size() - written);
+                    if (n < 0 && errno != EINTR)
+                    {
+                        _exit(1);
+                    }
+                    written += std::max<ssize_t>(n, 0);
+                }
+                // skip the destructors of the state inherited from the parent
+                _exit(0);
+            }
+            close(fds[1]);
+            NS_LOG_INFO("Replication with run number " << m_firstRun + next
+                                                       << " started in process " << pid);
+            running.push_back({pid, fds[0], next, {}});
+            ++next;
+        }
+
+        std::vector<pollfd> fds;
+        for (const auto& child : running)
+        {
+            fds.push_back({child.fd, POLLIN, 0});
+        }
+        if (poll(fds.data(), fds.size(), -1) < 0)
+        {
+            NS_ABORT_MSG_IF(errno != EINTR, "Cannot poll: " << std::strerror(errno));
+            continue;
+        }
+        for (std::size_t i = fds.size(); i-- > 0;)
+        {
+            if (fds[i].revents == 0)
+            {
+                continue;
+            }
+            auto& child = running[i];
+            char buffer[4096];
+            const auto n = read(child.fd, buffer, sizeof(buffer));
+            if (n > 0)
+            {
+                child.data.append(buffer, n);
+                continue;
+            }
+            if (n < 0)
+            {
+                NS_ABORT_MSG_IF(errno != EINTR, "Cannot read: " << std::strerror(errno));
+                continue;
+            }
+            // end of file: the child is done
+            close(child.fd);
+            int status;
+            while (waitpid(child.pid, &status, 0) < 0)
+            {
+                NS_ABORT_MSG_IF(errno != EINTR, "Cannot wait: " << std::strerror(errno));
+            }
+            const uint64_t run = m_firstRun + child.index;
+            NS_ABORT_MSG_IF(!WIFEXITED(status) || WEXITSTATUS(status) != 0,
+                            "Replication with run number " << run << " failed");
+            NS_ABORT_MSG_IF(!DeserializeMetrics(child.data, m_results[child.index]),
+                            "Cannot read the metrics of the replication with run number "
+                                << run);
+            NS_LOG_INFO("Replication with run number " << run << " done");
+            running.erase(running.begin() + i);
+        }
+    }
+}
+
+#endif // __WIN32__
+
+} // namespace ns3
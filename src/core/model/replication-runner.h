@@ -0,0 +1,162 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef REPLICATION_RUNNER_H
+#define REPLICATION_RUNNER_H
+
+/**
+ * @file
+ * @ingroup core
+ * ns3::ReplicationRunner declaration.
+ */
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * @ingroup core
+ *
+ * Run independent replications of a scenario in parallel and aggregate
+ * the metrics they report.
+ *
+ * Each replication builds and runs its own simulation with a distinct
+ * RngSeedManager run number and returns a set of named metrics (e.g., the
+ * packet delivery ratio computed from a FlowMonitor, or the energy consumed
+ * by the nodes). The metrics of all the replications are then summarized
+ * by their mean and confidence interval.
+ *
+ * The simulator, the random number generators and the global state of ns-3
+ * (Config, Names, GlobalValue, the node list, ...) are process-wide, so each
+ * replication runs in a child process forked from the calling process, which
+ * isolates the replications without paying for a full program start-up. The
+ * children inherit the state of the calling process at the time Run() is
+ * called, e.g., the defaults set with Config::SetDefault() or from the command
+ * line. Run() must hence be called before any simulation object is created or
+ * scheduled, and while the calling process has a single thread.
+ *
+ * On platforms without fork(), the replications are run in turn in the
+ * calling process, which calls Simulator::Destroy() after each of them;
+ * the scenario must then not leave any other global state behind.
+ *
+ * @code
+ *   ReplicationRunner runner;
+ *   runner.SetReplications(10);
+ *   auto summary = runner.Run([](uint64_t run) {
+ *       // build the nodes, devices and applications, then
+ *       Simulator::Stop(Seconds(100));
+ *       Simulator::Run();
+ *       ReplicationRunner::Metrics metrics;
+ *       metrics["pdr"] = ...;
+ *       Simulator::Destroy();
+ *       return metrics;
+ *   });
+ *   std::cout << summary["pdr"].mean << " +/- " << summary["pdr"].confidenceInterval;
+ * @endcode
+ */
+class ReplicationRunner
+{
+  public:
+    /// Named metrics reported by a replication
+    using Metrics = std::map<std::string, double>;
+
+    /**
+     * Callback building and running a replication.
+     * The argument is the run number, which is already set with RngSeedManager::SetRun().
+     */
+    using Scenario = std::function<Metrics(uint64_t)>;
+
+    /// Summary of a metric over the replications reporting it
+    struct Summary
+    {
+        uint32_t count{0};            //!< Number of replications reporting the metric
+        double mean{0};               //!< Sample mean
+        double stddev{0};             //!< Sample standard deviation
+        double min{0};                //!< Minimum value
+        double max{0};                //!< Maximum value
+        double confidenceInterval{0}; //!< Half-width of the confidence interval of the mean,
+                                      //!< infinite with a single sample
+    };
+
+    ReplicationRunner();
+
+    /**
+     * Set the number of replications.
+     * @param [in] count The number of replications.
+     */
+    void SetReplications(uint32_t count);
+
+    /**
+     * Set the run number of the first replication; the following ones use
+     * the next run numbers.
+     * @param [in] run The first run number.
+     */
+    void SetFirstRun(uint64_t run);
+
+    /**
+     * Set the maximum number of replications running at the same time.
+     * @param [in] jobs The number of parallel replications, or 0 to use
+     *             the number of hardware threads.
+     */
+    void SetParallelism(uint32_t jobs);
+
+    /**
+     * Set the confidence level of the confidence intervals.
+     * @param [in] level The confidence level, in (0, 1).
+     */
+    void SetConfidenceLevel(double level);
+
+    /**
+     * Run the replications and summarize their metrics.
+     *
+     * Aborts the program if a replication fails.
+     *
+     * @param [in] scenario The callback building and running a replication.
+     * @returns The summary of each metric.
+     */
+    std::map<std::string, Summary> Run(Scenario scenario);
+
+    /**
+     * @returns The metrics reported by each replication of the last call to
+     * Run(), in the order of the run numbers.
+     */
+    const std::vector<Metrics>& GetResults() const;
+
+    /**
+     * Summarize a set of samples.
+     * @param [in] samples The samples.
+     * @param [in] level The confidence level of the confidence interval.
+     * @returns The summary, whose confidence interval is based on the
+     *          Student's t-distribution.
+     */
+    static Summary Summarize(const std::vector<double>& samples, double level);
+
+  private:
+    /**
+     * Run the replications in child processes.
+     * @param [in] scenario The callback building and running a replication.
+     */
+    void RunForked(const Scenario& scenario);
+
+    /**
+     * Run the replications in turn in the calling process.
+     * @param [in] scenario The callback building and running a replication.
+     */
+    void RunSequential(const Scenario& scenario);
+
+    uint32_t m_replications;        //!< Number of replications
+    uint64_t m_firstRun;            //!< Run number of the first replication
+    uint32_t m_parallelism;         //!< Maximum number of parallel replications
+    double m_confidenceLevel;       //!< Confidence level of the confidence intervals
+    std::vector<Metrics> m_results; //!< Metrics reported by each replication
+};
+
+} // namespace ns3
+
+#endif /* REPLICATION_RUNNER_H */
@@ -11,7 +11,10 @@
 
 #include "callback.h"
 
+#include <atomic>
+#include <cstdint>
 #include <list>
+#include <vector>
 
 /**
  * @file
@@ -36,6 +39,18 @@ namespace ns3
  * calling the \c operator() form with the appropriate
  * number of arguments.
  *
+ * The chain is a vector which is copied when a Callback is connected
+ * or disconnected, rather than modified in place, so that invoking the
+ * chain neither allocates memory nor is disturbed by a Callback which
+ * connects or disconnects Callbacks, or destroys the TracedCallback:
+ * such changes take effect at the next invocation.  The chain is
+ * reference counted, so that it is deleted by the last of the
+ * TracedCallback and the invocations in progress, possibly on different
+ * threads; connecting and disconnecting Callbacks must however not be
+ * concurrent with other uses of the TracedCallback.  An empty chain is
+ * a null pointer, so that invoking a TracedCallback with no Callback
+ * connected costs a single inlined test.
+ *
  * @tparam Ts \explicit Types of the functor arguments.
  */
 template <typename... Ts>
@@ -44,6 +59,34 @@ class TracedCallback
   public:
     /** Constructor. */
     TracedCallback();
+    /**
+     * Copy constructor.
+     *
+     * @param [in] o The TracedCallback to copy.
+     */
+    TracedCallback(const TracedCallback& o);
+    /**
+     * Copy assignment operator.
+     *
+     * @param [in] o The TracedCallback to copy.
+     * @returns This TracedCallback.
+     */
+    TracedCallback& operator=(const TracedCallback& o);
+    /**
+     * Move constructor.
+     *
+     * @param [in] o The TracedCallback to move, which is left empty.
+     */
+    TracedCallback(TracedCallback&& o) noexcept;
+    /**
+     * Move assignment operator.
+     *
+     * @param [in] o The TracedCallback to move, which is left empty.
+     * @returns This TracedCallback.
+     */
+    TracedCallback& operator=(TracedCallback&& o) noexcept;
+    /** Destructor. */
+    ~TracedCallback();
     /**
      * Append a Callback to the chain (without a context).
      *
@@ -102,9 +145,44 @@ class TracedCallback
      *
      * @tparam Ts \deduced Types of the functor arguments.
      */
-    typedef std::list<Callback<void, Ts...>> CallbackList;
-    /** The chain of Callbacks. */
-    CallbackList m_callbackList;
+    typedef std::vector<Callback<void, Ts...>> CallbackList;
+
+    /** A chain of Callbacks, which is never modified once created. */
+    struct Chain
+    {
+        CallbackList callbacks; //!< The Callbacks.
+        /** Number of references: the TracedCallback and the invocations in progress. */
+        mutable std::atomic<uint32_t> references = 1;
+    };
+
+    /**
+     * Replace the chain, and release the former one.
+     *
+     * @param [in] chain The new chain, or nullptr if it is empty.
+     */
+    void SetChain(Chain* chain);
+    /**
+     * Drop a reference to a chain, and delete it if it was the last one.
+     *
+     * @param [in] chain The chain, or nullptr.
+     */
+    static void Release(const Chain* chain);
+    /**
+     * Invoke the Callbacks of a non-empty chain.
+     *
+     * @param [in] chain The chain.
+     * @param [in] args The arguments to the Callbacks.
+     */
+    static void Invoke(const Chain* chain, const Ts&... args);
+    /**
+     * Append a Callback to the chain.
+     *
+     * @param [in] callback Callback to add to chain.
+     */
+    void Append(const Callback<void, Ts...>& callback);
+
+    /** The chain of Callbacks, or nullptr if it is empty. */
+    Chain* m_chain;
 };
 
 } // namespace ns3
@@ -118,8 +196,68 @@ namespace ns3
 
 template <typename... Ts>
 TracedCallback<Ts...>::TracedCallback()
-    : m_callbackList()
+    : m_chain(nullptr)
+{
+}
+
+template <typename... Ts>
+TracedCallback<Ts...>::TracedCallback(const TracedCallback& o)
+    : m_chain(o.m_chain ? new Chain{o.m_chain->callbacks} : nullptr)
+{
+}
+
+template <typename... Ts>
+TracedCallback<Ts...>&
+TracedCallback<Ts...>::operator=(const TracedCallback& o)
+{
+    if (this != &o)
+    {
+        SetChain(o.m_chain ? new Chain{o.m_chain->callbacks} : nullptr);
+    }
+    return *this;
+}
+
+template <typename... Ts>
+TracedCallback<Ts...>::TracedCallback(TracedCallback&& o) noexcept
+    : m_chain(o.m_chain)
 {
+    o.m_chain = nullptr;
+}
+
+template <typename... Ts>
+TracedCallback<Ts...>&
+TracedCallback<Ts...>::operator=(TracedCallback&& o) noexcept
+{
+    if (this != &o)
+    {
+        SetChain(o.m_chain);
+        o.m_chain = nullptr;
+    }
+    return *this;
+}
+
+template <typename... Ts>
+TracedCallback<Ts...>::~TracedCallback()
+{
+    Release(m_chain);
+}
+
+template <typename... Ts>
+void
+TracedCallback<Ts...>::SetChain(Chain* chain)
+{
+    Release(m_chain);
+    m_chain = chain;
+}
+
+template <typename... Ts>
+void
+TracedCallback<Ts...>::Release(const Chain* chain)
+{
+    if (chain != nullptr && chain->references.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+        delete chain;
+    }
 }
 
 template <typename... Ts>
@@ -131,7 +269,7 @@ TracedCallback<Ts...>::ConnectWithoutContext(const CallbackBase& callback)
     {
         NS_FATAL_ERROR_NO_MSG();
     }
-    m_callbackList.push_back(cb);
+    Append(cb);
 }
 
 template <typename... Ts>
@@ -144,24 +282,44 @@ TracedCallback<Ts...>::Connect(const CallbackBase& callback, std::string path)
         NS_FATAL_ERROR("when connecting to " << path);
     }
     Callback<void, Ts...> realCb = cb.Bind(path);
-    m_callbackList.push_back(realCb);
+    Append(realCb);
+}
+
+template <typename... Ts>
+void
+TracedCallback<Ts...>::Append(const Callback<void, Ts...>& callback)
+{
+    auto chain = new Chain;
+    if (m_chain)
+    {
+        chain->callbacks.reserve(m_chain->callbacks.size() + 1);
+        chain->callbacks.assign(m_chain->callbacks.begin(), m_chain->callbacks.end());
+    }
+    chain->callbacks.push_back(callback);
+    SetChain(chain);
 }
 
 template <typename... Ts>
 void
 TracedCallback<Ts...>::DisconnectWithoutContext(const CallbackBase& callback)
 {
-    for (auto i = m_callbackList.begin(); i != m_callbackList.end(); /* empty */)
+    if (!m_chain)
     {
-        if ((*i).IsEqual(callback))
-        {
-            i = m_callbackList.erase(i);
-        }
-        else
+        return;
+    }
+    CallbackList callbacks;
+    for (const auto& cb : m_chain->callbacks)
+    {
+        if (!cb.IsEqual(callback))
         {
-            i++;
+            callbacks.push_back(cb);
         }
     }
+    if (callbacks.size() == m_chain->callbacks.size())
+    {
+        return;
+    }
+    SetChain(callbacks.empty() ? nullptr : new Chain{std::move(callbacks)});
 }
 
 template <typename... Ts>
@@ -178,20 +336,34 @@ TracedCallback<Ts...>::Disconnect(const CallbackBase& callback, std::string path
 }
 
 template <typename... Ts>
-void
+inline void
 TracedCallback<Ts...>::operator()(Ts... args) const
 {
-    for (auto i = m_callbackList.begin(); i != m_callbackList.end(); i++)
+    if (m_chain)
+    {
+        Invoke(m_chain, args...);
+    }
+}
+
+template <typename... Ts>
+void
+TracedCallback<Ts...>::Invoke(const Chain* chain, const Ts&... args)
+{
+    // A Callback may replace the chain of the TracedCallback, or destroy
+    // it: the reference held by this invocation keeps the chain alive.
+    chain->references.fetch_add(1, std::memory_order_relaxed);
+    for (const auto& cb : chain->callbacks)
     {
-        (*i)(args...);
+        cb(args...);
     }
+    Release(chain);
 }
 
 template <typename... Ts>
 bool
 TracedCallback<Ts...>::IsEmpty() const
 {
-    return m_callbackList.empty();
+    return !m_chain;
 }
 
 } // namespace ns3
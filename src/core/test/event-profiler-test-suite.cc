@@ -0,0 +1,202 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/config.h"
+#include "ns3/event-impl.h"
+#include "ns3/event-profiler.h"
+#include "ns3/make-event.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+
+#include <fstream>
+#include <sstream>
+#include <string>
+
+/**
+ * @file
+ * @ingroup core-tests
+ * EventProfiler test suite.
+ */
+
+namespace ns3
+{
+
+namespace tests
+{
+
+/**
+ * @ingroup core-tests
+ * Check the accounting of the events by bound function and context.
+ */
+class EventProfilerTestCase : public TestCase
+{
+  public:
+    EventProfilerTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Method bound to the events.
+     * @param [in] n The value added to the count.
+     */
+    void Method(uint32_t n);
+
+    uint32_t m_count; ///< The sum of the values passed to Method.
+};
+
+/**
+ * Function bound to the events.
+ * @param [in] x The argument.
+ */
+static void
+EventProfilerTestFunction(double /* x */)
+{
+}
+
+EventProfilerTestCase::EventProfilerTestCase()
+    : TestCase("Check the accounting of the events")
+{
+}
+
+void
+EventProfilerTestCase::Method(uint32_t n)
+{
+    m_count += n;
+}
+
+void
+EventProfilerTestCase::DoRun()
+{
+    m_count = 0;
+    EventProfiler profiler;
+    profiler.Invoke(MakeEvent(&EventProfilerTestCase::Method, this, 1), 3);
+    profiler.Invoke(MakeEvent(&EventProfilerTestCase::Method, this, 2), 3);
+    profiler.Invoke(MakeEvent(&EventProfilerTestCase::Method, this, 4), Simulator::NO_CONTEXT);
+    profiler.Invoke(MakeEvent(&EventProfilerTestFunction, 1.0), 7);
+    NS_TEST_ASSERT_MSG_EQ(m_count, 7, "The events were not invoked");
+
+    EventImpl* event = MakeEvent(&EventProfilerTestCase::Method, this, 1);
+    NS_TEST_EXPECT_MSG_EQ(EventProfiler::GetFunctionName(typeid(*event)),
+                          "void (ns3::tests::EventProfilerTestCase::*)(unsigned int)",
+                          "Wrong name of a method");
+    event->Unref();
+    event = MakeEvent(&EventProfilerTestFunction, 1.0);
+    NS_TEST_EXPECT_MSG_EQ(EventProfiler::GetFunctionName(typeid(*event)),
+                          "void (*)(double)",
+                          "Wrong name of a function");
+    event->Unref();
+    NS_TEST_EXPECT_MSG_EQ(EventProfiler::GetFunctionName(typeid(int)),
+                          "int",
+                          "Wrong name of a type not made by MakeEvent");
+
+    std::ostringstream folded;
+    profiler.WriteFoldedStacks(folded);
+    std::istringstream lines(folded.str());
+    std::string line;
+    uint32_t count = 0;
+    while (std::getline(lines, line))
+    {
+        count++;
+        const auto semicolon = line.rfind(';');
+        const auto space = line.rfind(' ');
+        NS_TEST_ASSERT_MSG_NE(semicolon, std::string::npos, "No frames in " << line);
+        NS_TEST_ASSERT_MSG_GT(space, semicolon, "No value in " << line);
+        const std::string context = line.substr(semicolon + 1, space - semicolon - 1);
+        NS_TEST_EXPECT_MSG_EQ((context == "context 3" || context == "context 7" ||
+                               context == "no context"),
+                              true,
+                              "Unexpected context in " << line);
+    }
+    NS_TEST_EXPECT_MSG_EQ(count, 3, "Wrong number of function and context pairs");
+
+    std::ostringstream top;
+    profiler.PrintTopFunctions(top, 1);
+    NS_TEST_EXPECT_MSG_NE(top.str().find("Event profile: 4 events"),
+                          std::string::npos,
+                          "Wrong event count in " << top.str());
+    std::istringstream topLines(top.str());
+    count = 0;
+    while (std::getline(topLines, line))
+    {
+        count++;
+    }
+    NS_TEST_EXPECT_MSG_EQ(count, 3, "Wrong number of lines in " << top.str());
+}
+
+/**
+ * @ingroup core-tests
+ * Check that the DefaultSimulatorImpl writes the event profile at
+ * Simulator::Destroy() when the EventProfile attribute is set.
+ */
+class EventProfilerSimulatorTestCase : public TestCase
+{
+  public:
+    EventProfilerSimulatorTestCase();
+
+  private:
+    void DoRun() override;
+    void DoTeardown() override;
+};
+
+EventProfilerSimulatorTestCase::EventProfilerSimulatorTestCase()
+    : TestCase("Check the event profile of a simulation")
+{
+}
+
+void
+EventProfilerSimulatorTestCase::DoRun()
+{
+    const std::string name = CreateTempDirFilename("event-profile");
+    Simulator::Destroy();
+    Config::SetDefault("ns3::DefaultSimulatorImpl::EventProfile", StringValue(name));
+    for (uint32_t i = 0; i < 10; ++i)
+    {
+        Simulator::ScheduleWithContext(i % 2, Seconds(i), &EventProfilerTestFunction, 1.0);
+    }
+    Simulator::Run();
+    Simulator::Destroy();
+
+    std::ifstream is(name + ".folded");
+    NS_TEST_ASSERT_MSG_EQ(is.is_open(), true, "No event profile file");
+    std::string line;
+    uint32_t count = 0;
+    while (std::getline(is, line))
+    {
+        count++;
+        NS_TEST_EXPECT_MSG_EQ(line.compare(0, 17, "void (*)(double);"),
+                              0,
+                              "Unexpected function in " << line);
+    }
+    NS_TEST_EXPECT_MSG_EQ(count, 2, "Wrong number of lines in the event profile");
+}
+
+void
+EventProfilerSimulatorTestCase::DoTeardown()
+{
+    Config::SetDefault("ns3::DefaultSimulatorImpl::EventProfile", StringValue(""));
+}
+
+/**
+ * @ingroup core-tests
+ * EventProfiler test suite.
+ */
+class EventProfilerTestSuite : public TestSuite
+{
+  public:
+    EventProfilerTestSuite()
+        : TestSuite("event-profiler")
+    {
+        AddTestCase(new EventProfilerTestCase(), TestCase::Duration::QUICK);
+        AddTestCase(new EventProfilerSimulatorTestCase(), TestCase::Duration::QUICK);
+    }
+};
+
+/// Static variable for test initialization.
+static EventProfilerTestSuite g_eventProfilerTestSuite;
+
+} // namespace tests
+
+} // namespace ns3
@@ -0,0 +1,277 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/config.h"
+#include "ns3/multithreaded-simulator-impl.h"
+#include "ns3/nstime.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+
+#include <utility>
+#include <vector>
+
+/**
+ * @file
+ * @ingroup core-tests
+ * MultithreadedSimulatorImpl test suite.
+ */
+
+namespace ns3
+{
+
+namespace tests
+{
+
+/**
+ * @ingroup core-tests
+ * Check that the MultithreadedSimulatorImpl executes the events of a model
+ * in the order of the DefaultSimulatorImpl.
+ *
+ * The model is a set of nodes, each with a state owned by its context,
+ * which send each other messages with delays of at least MIN_DELAY
+ * microseconds.  The state of a node depends on the order of the messages
+ * it receives, and many messages are received at the same time.  A global event regularly
+ * records the states of all the nodes and sends a message to one of them.
+ */
+class MultithreadedSimulatorOrderTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor.
+     * @param [in] threads The number of threads.
+     * @param [in] lookahead The lookahead.
+     */
+    MultithreadedSimulatorOrderTestCase(uint32_t threads, Time lookahead);
+
+  private:
+    void DoRun() override;
+    void DoTeardown() override;
+
+    /// A node of the model.
+    struct Node
+    {
+        uint64_t state;                                ///< The state.
+        std::vector<std::pair<int64_t, uint64_t>> log; ///< The time and state after each event.
+        EventId timer;                                 ///< The timer.
+    };
+
+    /// The logs of the model.
+    struct Logs
+    {
+        std::vector<std::vector<std::pair<int64_t, uint64_t>>> nodes; ///< The logs of the nodes.
+        std::vector<uint64_t> global;                                 ///< The log of the reports.
+        uint64_t events;                                              ///< The event count.
+    };
+
+    /**
+     * Run the model with a simulator engine.
+     * @param [in] simulatorType The simulator engine.
+     * @returns The logs.
+     */
+    Logs RunModel(std::string simulatorType);
+
+    /**
+     * Update the state of a node.
+     * @param [in] node The node.
+     * @param [in] value The value mixed into the state.
+     */
+    void Update(uint32_t node, uint64_t value);
+
+    /**
+     * Receive a message.
+     * @param [in] node The receiving node.
+     * @param [in] value The message.
+     */
+    void Receive(uint32_t node, uint64_t value);
+
+    /**
+     * Handle the expiration of the timer of a node.
+     * @param [in] node The node.
+     */
+    void Timeout(uint32_t node);
+
+    /** Record the states of the nodes and send a message to one of them. */
+    void Report();
+
+    /// Number of nodes.
+    static const uint32_t NODES = 16;
+    /// Minimum delay of the messages, in microseconds.
+    static const int64_t MIN_DELAY = 10;
+
+    uint32_t m_threads;              ///< The number of threads.
+    Time m_lookahead;                ///< The lookahead.
+    std::vector<Node> m_nodes;       ///< The nodes.
+    std::vector<uint64_t> m_reports; ///< The log of the reports.
+};
+
+MultithreadedSimulatorOrderTestCase::MultithreadedSimulatorOrderTestCase(uint32_t threads,
+                                                                         Time lookahead)
+    : TestCase("Check the event order with " + std::to_string(threads) +
+               " threads and a lookahead of " + std::to_string(lookahead.GetMicroSeconds()) +
+               " us"),
+      m_threads(threads),
+      m_lookahead(lookahead)
+{
+}
+
+void
+MultithreadedSimulatorOrderTestCase::Update(uint32_t node, uint64_t value)
+{
+    Node& n = m_nodes[node];
+    n.state = n.state * 6364136223846793005ULL + value + 1442695040888963407ULL;
+    n.log.emplace_back(Simulator::Now().GetTimeStep(), n.state);
+}
+
+void
+MultithreadedSimulatorOrderTestCase::Receive(uint32_t node, uint64_t value)
+{
+    NS_ASSERT(Simulator::GetContext() == node);
+    Update(node, value);
+    Node& n = m_nodes[node];
+    if (n.timer.IsPending())
+    {
+        n.timer.Cancel();
+    }
+    n.timer = Simulator::Schedule(MicroSeconds((n.state >> 33) % 4),
+                                  &MultithreadedSimulatorOrderTestCase::Timeout,
+                                  this,
+                                  node);
+}
+
+void
+MultithreadedSimulatorOrderTestCase::Timeout(uint32_t node)
+{
+    NS_ASSERT(Simulator::GetContext() == node);
+    Node& n = m_nodes[node];
+    // the current event is not pending anymore
+    Update(node, n.timer.IsPending());
+    uint32_t dst = (n.state >> 40) % NODES;
+    Simulator::ScheduleWithContext(dst,
+                                   MicroSeconds(MIN_DELAY + (n.state >> 20) % 3),
+                                   &MultithreadedSimulatorOrderTestCase::Receive,
+                                   this,
+                                   dst,
+                                   n.state);
+}
+
+void
+MultithreadedSimulatorOrderTestCase::Report()
+{
+    uint64_t sum = 0;
+    for (const auto& n : m_nodes)
+    {
+        sum = sum * 31 + n.state;
+    }
+    m_reports.push_back(sum);
+    uint32_t dst = m_reports.size() % NODES;
+    Simulator::ScheduleWithContext(dst,
+                                   Time(0),
+                                   &MultithreadedSimulatorOrderTestCase::Receive,
+                                   this,
+                                   dst,
+                                   sum);
+    Simulator::Schedule(MicroSeconds(50), &MultithreadedSimulatorOrderTestCase::Report, this);
+}
+
+MultithreadedSimulatorOrderTestCase::Logs
+MultithreadedSimulatorOrderTestCase::RunModel(std::string simulatorType)
+{
+    Config::SetGlobal("SimulatorImplementationType", StringValue(simulatorType));
+    Config::SetDefault("ns3::MultithreadedSimulatorImpl::Threads", UintegerValue(m_threads));
+    Config::SetDefault("ns3::MultithreadedSimulatorImpl::Lookahead", TimeValue(m_lookahead));
+
+    m_nodes.assign(NODES, Node());
+    m_reports.clear();
+    for (uint32_t i = 0; i < NODES; ++i)
+    {
+        m_nodes[i].state = i;
+        // several messages at the same time
+        Simulator::ScheduleWithContext(i,
+                                       MicroSeconds(i % 3),
+                                       &MultithreadedSimulatorOrderTestCase::Receive,
+                                       this,
+                                       i,
+                                       i);
+        Simulator::ScheduleWithContext(i,
+                                       MicroSeconds(i % 3),
+                                       &MultithreadedSimulatorOrderTestCase::Receive,
+                                       this,
+                                       i,
+                                       i * i);
+    }
+    Simulator::Schedule(MicroSeconds(50), &MultithreadedSimulatorOrderTestCase::Report, this);
+    Simulator::Stop(MilliSeconds(5));
+    Simulator::Run();
+
+    auto mt = DynamicCast<MultithreadedSimulatorImpl>(Simulator::GetImplementation());
+    if (mt && m_lookahead.IsStrictlyPositive())
+    {
+        NS_TEST_EXPECT_MSG_GT(mt->GetParallelWindowCount(), 0, "No parallel window");
+    }
+
+    Logs logs;
+    for (const auto& n : m_nodes)
+    {
+        logs.nodes.push_back(n.log);
+    }
+    logs.global = m_reports;
+    logs.events = Simulator::GetEventCount();
+    Simulator::Destroy();
+    return logs;
+}
+
+void
+MultithreadedSimulatorOrderTestCase::DoRun()
+{
+    Logs expected = RunModel("ns3::DefaultSimulatorImpl");
+    Logs logs = RunModel("ns3::MultithreadedSimulatorImpl");
+
+    NS_TEST_ASSERT_MSG_GT(expected.events, 1000, "Too few events to test the engine");
+    for (uint32_t i = 0; i < NODES; ++i)
+    {
+        NS_TEST_EXPECT_MSG_EQ((logs.nodes[i] == expected.nodes[i]),
+                              true,
+                              "Different events at node " << i);
+    }
+    NS_TEST_EXPECT_MSG_EQ((logs.global == expected.global), true, "Different global events");
+    NS_TEST_EXPECT_MSG_EQ(logs.events, expected.events, "Different event count");
+}
+
+void
+MultithreadedSimulatorOrderTestCase::DoTeardown()
+{
+    Config::SetGlobal("SimulatorImplementationType", StringValue("ns3::DefaultSimulatorImpl"));
+    Config::SetDefault("ns3::MultithreadedSimulatorImpl::Threads", UintegerValue(0));
+    Config::SetDefault("ns3::MultithreadedSimulatorImpl::Lookahead", TimeValue(Time(0)));
+}
+
+/**
+ * @ingroup core-tests
+ * MultithreadedSimulatorImpl test suite.
+ */
+class MultithreadedSimulatorTestSuite : public TestSuite
+{
+  public:
+    MultithreadedSimulatorTestSuite()
+        : TestSuite("multithreaded-simulator")
+    {
+        AddTestCase(new MultithreadedSimulatorOrderTestCase(1, Time(0)),
+                    TestCase::Duration::QUICK);
+        AddTestCase(new MultithreadedSimulatorOrderTestCase(1, MicroSeconds(10)),
+                    TestCase::Duration::QUICK);
+        AddTestCase(new MultithreadedSimulatorOrderTestCase(4, MicroSeconds(10)),
+                    TestCase::Duration::QUICK);
+        AddTestCase(new MultithreadedSimulatorOrderTestCase(4, MicroSeconds(3)),
+                    TestCase::Duration::QUICK);
+    }
+};
+
+/// Static variable for test initialization.
+static MultithreadedSimulatorTestSuite g_multithreadedSimulatorTestSuite;
+
+} // namespace tests
+
+} // namespace ns3
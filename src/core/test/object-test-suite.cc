@@ -521,6 +521,66 @@ UnidirectionalAggregateObjectTestCase::DoRun()
                           "Can GetObject (through baseB) for BaseA Object");
 }
 
+/**
+ * @ingroup object-tests
+ * Test the cache of the lookups of the aggregated Objects.
+ */
+class AggregateObjectCacheTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    AggregateObjectCacheTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+AggregateObjectCacheTestCase::AggregateObjectCacheTestCase()
+    : TestCase("Check the cache of the aggregated Object lookups")
+{
+}
+
+void
+AggregateObjectCacheTestCase::DoRun()
+{
+    Ptr<BaseA> baseA = CreateObject<BaseA>();
+    Ptr<DerivedB> derivedB = CreateObject<DerivedB>();
+
+    //
+    // A failed lookup is cached, but the cache must be invalidated by the
+    // aggregation.
+    //
+    NS_TEST_ASSERT_MSG_EQ(baseA->GetObject<BaseB>(), nullptr, "Unexpected BaseB Object");
+    NS_TEST_ASSERT_MSG_EQ(baseA->GetObject<BaseB>(), nullptr, "Unexpected cached BaseB Object");
+    NS_TEST_ASSERT_MSG_EQ(derivedB->GetObject<BaseA>(), nullptr, "Unexpected BaseA Object");
+
+    baseA->AggregateObject(derivedB);
+
+    NS_TEST_ASSERT_MSG_EQ(baseA->GetObject<BaseB>(),
+                          derivedB,
+                          "Cannot GetObject (through baseA) for BaseB after the aggregation");
+    NS_TEST_ASSERT_MSG_EQ(baseA->GetObject<DerivedB>(),
+                          derivedB,
+                          "Cannot GetObject (through baseA) for DerivedB after the aggregation");
+    NS_TEST_ASSERT_MSG_EQ(derivedB->GetObject<BaseA>(),
+                          baseA,
+                          "Cannot GetObject (through derivedB) for BaseA after the aggregation");
+
+    //
+    // The cache is shared by the aggregated Objects, but the unidirectional
+    // aggregates are not.
+    //
+    NS_TEST_ASSERT_MSG_EQ(baseA->GetObject<DerivedA>(), nullptr, "Unexpected DerivedA Object");
+    Ptr<DerivedA> derivedA = CreateObject<DerivedA>();
+    baseA->UnidirectionalAggregateObject(derivedA);
+    NS_TEST_ASSERT_MSG_EQ(baseA->GetObject<DerivedA>(),
+                          derivedA,
+                          "Cannot GetObject (through baseA) for the unidirectional DerivedA");
+    NS_TEST_ASSERT_MSG_EQ(derivedB->GetObject<DerivedA>(),
+                          nullptr,
+                          "Can GetObject (through derivedB) for the unidirectional DerivedA");
+}
+
 /**
  * @ingroup object-tests
  * Test an Object factory can create Objects
@@ -623,6 +683,7 @@ ObjectTestSuite::ObjectTestSuite()
     AddTestCase(new CreateObjectTestCase);
     AddTestCase(new AggregateObjectTestCase);
     AddTestCase(new UnidirectionalAggregateObjectTestCase);
+    AddTestCase(new AggregateObjectCacheTestCase);
     AddTestCase(new ObjectFactoryTestCase);
 }
 
@@ -0,0 +1,179 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/random-variable-stream.h"
+#include "ns3/replication-runner.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+#include <cmath>
+
+/**
+ * @file
+ * @ingroup core-tests
+ * ReplicationRunner test suite.
+ */
+
+namespace ns3
+{
+
+namespace tests
+{
+
+/**
+ * @ingroup core-tests
+ * Check the summary of a set of samples.
+ */
+class ReplicationSummaryTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    ReplicationSummaryTestCase();
+    void DoRun() override;
+};
+
+ReplicationSummaryTestCase::ReplicationSummaryTestCase()
+    : TestCase("Check the summary of the replication metrics")
+{
+}
+
+void
+ReplicationSummaryTestCase::DoRun()
+{
+    auto summary = ReplicationRunner::Summarize({1, 2, 3, 4, 5}, 0.95);
+    NS_TEST_EXPECT_MSG_EQ(summary.count, 5, "Unexpected number of samples");
+    NS_TEST_EXPECT_MSG_EQ_TOL(summary.mean, 3, 1e-12, "Unexpected mean");
+    NS_TEST_EXPECT_MSG_EQ_TOL(summary.stddev, std::sqrt(2.5), 1e-12, "Unexpected stddev");
+    NS_TEST_EXPECT_MSG_EQ(summary.min, 1, "Unexpected min");
+    NS_TEST_EXPECT_MSG_EQ(summary.max, 5, "Unexpected max");
+    // t(0.975, 4) = 2.776445
+    NS_TEST_EXPECT_MSG_EQ_TOL(summary.confidenceInterval,
+                              2.776445 * std::sqrt(2.5) / std::sqrt(5),
+                              1e-5,
+                              "Unexpected confidence interval");
+
+    // t(0.995, 1) = 63.656741
+    summary = ReplicationRunner::Summarize({0, 1}, 0.99);
+    NS_TEST_EXPECT_MSG_EQ_TOL(summary.confidenceInterval,
+                              63.656741 * std::sqrt(0.5) / std::sqrt(2),
+                              1e-4,
+                              "Unexpected confidence interval");
+
+    // t(0.95, 30) = 1.697261
+    std::vector<double> samples;
+    for (uint32_t i = 0; i < 31; ++i)
+    {
+        samples.push_back(i % 2);
+    }
+    summary = ReplicationRunner::Summarize(samples, 0.9);
+    NS_TEST_EXPECT_MSG_EQ_TOL(summary.confidenceInterval,
+                              1.697261 * summary.stddev / std::sqrt(31),
+                              1e-5,
+                              "Unexpected confidence interval");
+
+    summary = ReplicationRunner::Summarize({42}, 0.95);
+    NS_TEST_EXPECT_MSG_EQ(summary.mean, 42, "Unexpected mean");
+    NS_TEST_EXPECT_MSG_EQ(std::isinf(summary.confidenceInterval),
+                          true,
+                          "Confidence interval should be infinite with a single sample");
+}
+
+/**
+ * @ingroup core-tests
+ * Check that the replications run independently with their own run number.
+ */
+class ReplicationRunnerTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    ReplicationRunnerTestCase();
+    void DoRun() override;
+};
+
+ReplicationRunnerTestCase::ReplicationRunnerTestCase()
+    : TestCase("Check that the replications run with their own run number")
+{
+}
+
+void
+ReplicationRunnerTestCase::DoRun()
+{
+    auto scenario = [](uint64_t run) {
+        ReplicationRunner::Metrics metrics;
+        auto rv = CreateObject<UniformRandomVariable>();
+        Simulator::Schedule(Seconds(run), [&metrics, rv]() {
+            metrics["time"] = Simulator::Now().GetSeconds();
+            metrics["value"] = rv->GetValue();
+        });
+        Simulator::Run();
+        metrics["run"] = RngSeedManager::GetRun();
+        if (run % 2 == 0)
+        {
+            metrics["even"] = run;
+        }
+        Simulator::Destroy();
+        return metrics;
+    };
+
+    const auto run = RngSeedManager::GetRun();
+    ReplicationRunner runner;
+    runner.SetReplications(6);
+    runner.SetFirstRun(10);
+    runner.SetParallelism(3);
+    auto summary = runner.Run(scenario);
+    NS_TEST_EXPECT_MSG_EQ(RngSeedManager::GetRun(), run, "Run number of the caller changed");
+
+    const auto& results = runner.GetResults();
+    NS_TEST_ASSERT_MSG_EQ(results.size(), 6, "Unexpected number of results");
+    for (uint32_t i = 0; i < results.size(); ++i)
+    {
+        NS_TEST_EXPECT_MSG_EQ(results[i].at("run"), 10 + i, "Unexpected run number");
+        NS_TEST_EXPECT_MSG_EQ(results[i].at("time"), 10 + i, "Unexpected simulation time");
+        if (i > 0)
+        {
+            NS_TEST_EXPECT_MSG_NE(results[i].at("value"),
+                                  results[i - 1].at("value"),
+                                  "Replications should draw different values");
+        }
+    }
+    NS_TEST_EXPECT_MSG_EQ(summary["run"].count, 6, "Unexpected number of samples");
+    NS_TEST_EXPECT_MSG_EQ_TOL(summary["run"].mean, 12.5, 1e-12, "Unexpected mean");
+    NS_TEST_EXPECT_MSG_EQ(summary["even"].count, 3, "Unexpected number of samples");
+    NS_TEST_EXPECT_MSG_EQ_TOL(summary["even"].mean, 12, 1e-12, "Unexpected mean");
+
+    // the same run number gives the same results
+    RngSeedManager::SetRun(12);
+    const auto metrics = scenario(12);
+    RngSeedManager::SetRun(run);
+    NS_TEST_EXPECT_MSG_EQ(metrics.at("value"), results[2].at("value"), "Results differ");
+}
+
+/**
+ * @ingroup core-tests
+ * ReplicationRunner test suite.
+ */
+class ReplicationRunnerTestSuite : public TestSuite
+{
+  public:
+    /** Constructor. */
+    ReplicationRunnerTestSuite();
+};
+
+ReplicationRunnerTestSuite::ReplicationRunnerTestSuite()
+    : TestSuite("replication-runner", Type::UNIT)
+{
+    AddTestCase(new ReplicationSummaryTestCase());
+    AddTestCase(new ReplicationRunnerTestCase());
+}
+
+/**
+ * @ingroup core-tests
+ * ReplicationRunnerTestSuite instance variable.
+ */
+static ReplicationRunnerTestSuite g_replicationRunnerTestSuite;
+
+} // namespace tests
+
+} // namespace ns3
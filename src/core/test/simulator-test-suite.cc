@@ -7,12 +7,17 @@
  */
 #include "ns3/calendar-scheduler.h"
 #include "ns3/heap-scheduler.h"
+#include "ns3/ladder-scheduler.h"
 #include "ns3/list-scheduler.h"
 #include "ns3/map-scheduler.h"
 #include "ns3/priority-queue-scheduler.h"
+#include "ns3/random-variable-stream.h"
 #include "ns3/simulator.h"
 #include "ns3/test.h"
 
+#include <set>
+#include <vector>
+
 using namespace ns3;
 
 /**
@@ -200,6 +205,100 @@ SimulatorEventsTestCase::DoRun()
     NS_TEST_EXPECT_MSG_EQ(m_destroy, true, "Event should have run");
 }
 
+/**
+ * @ingroup simulator-tests
+ *
+ * @brief Check that a scheduler returns the events in order with a skewed
+ * distribution of event times.
+ *
+ * Most events are scheduled shortly after the current time, some at the
+ * same time, and a few far in the future, like the propagation delays and
+ * the protocol timers of a wireless simulation. Some pending events are
+ * removed. The events returned by the scheduler are checked against a
+ * sorted set of the pending events.
+ */
+class SchedulerOrderTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor.
+     * @param schedulerFactory Scheduler factory.
+     */
+    SchedulerOrderTestCase(ObjectFactory schedulerFactory);
+    void DoRun() override;
+
+  private:
+    ObjectFactory m_schedulerFactory; //!< Scheduler factory.
+};
+
+SchedulerOrderTestCase::SchedulerOrderTestCase(ObjectFactory schedulerFactory)
+    : TestCase("Check the order of the events with a skewed distribution with " +
+               schedulerFactory.GetTypeId().GetName()),
+      m_schedulerFactory(schedulerFactory)
+{
+}
+
+void
+SchedulerOrderTestCase::DoRun()
+{
+    auto scheduler = m_schedulerFactory.Create<Scheduler>();
+    auto rng = CreateObject<UniformRandomVariable>();
+    rng->SetStream(1);
+    std::set<Scheduler::EventKey> pending;
+    std::vector<Scheduler::EventKey> keys;
+    uint32_t uid = 0;
+    uint64_t now = 0;
+
+    for (uint32_t i = 0; i < 20000; ++i)
+    {
+        // Keep about 1000 pending events
+        const uint32_t inserts = pending.size() < 1000 ? 2 : 1;
+        for (uint32_t j = 0; j < inserts; ++j)
+        {
+            const double draw = rng->GetValue();
+            uint64_t delay = 0;
+            if (draw < 0.8)
+            {
+                delay = rng->GetInteger(1, 1000);
+            }
+            else if (draw < 0.9)
+            {
+                delay = rng->GetInteger(1000000, 2000000000);
+            }
+            Scheduler::EventKey key{now + delay, uid++, 0};
+            scheduler->Insert(Scheduler::Event{nullptr, key});
+            pending.insert(key);
+            keys.push_back(key);
+        }
+
+        if (rng->GetValue() < 0.05)
+        {
+            // Remove a random pending event
+            const auto key = keys[rng->GetInteger(0, keys.size() - 1)];
+            if (pending.erase(key) != 0)
+            {
+                scheduler->Remove(Scheduler::Event{nullptr, key});
+            }
+        }
+
+        NS_TEST_ASSERT_MSG_EQ(scheduler->IsEmpty(), false, "Scheduler should not be empty");
+        const auto next = scheduler->PeekNext().key;
+        NS_TEST_ASSERT_MSG_EQ(next.m_uid, pending.begin()->m_uid, "Unexpected next event");
+        const auto ev = scheduler->RemoveNext();
+        NS_TEST_ASSERT_MSG_EQ(ev.key.m_uid, next.m_uid, "Unexpected removed event");
+        pending.erase(pending.begin());
+        now = ev.key.m_ts;
+    }
+
+    while (!pending.empty())
+    {
+        const auto ev = scheduler->RemoveNext();
+        NS_TEST_ASSERT_MSG_EQ(ev.key.m_uid, pending.begin()->m_uid, "Unexpected removed event");
+        pending.erase(pending.begin());
+    }
+    NS_TEST_EXPECT_MSG_EQ(scheduler->IsEmpty(), true, "Scheduler should be empty");
+}
+
 /**
  * @ingroup simulator-tests
  *
@@ -663,6 +762,19 @@ class SimulatorTestSuite : public TestSuite
         AddTestCase(new SimulatorEventsTestCase(factory), TestCase::Duration::QUICK);
         factory.SetTypeId(PriorityQueueScheduler::GetTypeId());
         AddTestCase(new SimulatorEventsTestCase(factory), TestCase::Duration::QUICK);
+        factory.SetTypeId(LadderScheduler::GetTypeId());
+        AddTestCase(new SimulatorEventsTestCase(factory), TestCase::Duration::QUICK);
+
+        for (const auto& typeId : {ListScheduler::GetTypeId(),
+                                   MapScheduler::GetTypeId(),
+                                   HeapScheduler::GetTypeId(),
+                                   CalendarScheduler::GetTypeId(),
+                                   PriorityQueueScheduler::GetTypeId(),
+                                   LadderScheduler::GetTypeId()})
+        {
+            factory.SetTypeId(typeId);
+            AddTestCase(new SchedulerOrderTestCase(factory), TestCase::Duration::QUICK);
+        }
     }
 };
 
@@ -7,6 +7,8 @@
 #include "ns3/test.h"
 #include "ns3/traced-callback.h"
 
+#include <memory>
+
 using namespace ns3;
 
 /**
@@ -122,6 +124,149 @@ BasicTracedCallbackTestCase::DoRun()
     NS_TEST_ASSERT_MSG_EQ(m_two, true, "Callback CbTwo not called");
 }
 
+/**
+ * @ingroup tracedcallback-tests
+ *
+ * TracedCallback Test case, check that the Callbacks can connect and
+ * disconnect Callbacks, and destroy the TracedCallback, while it is invoked.
+ */
+class ReentrantTracedCallbackTestCase : public TestCase
+{
+  public:
+    ReentrantTracedCallbackTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Callback which disconnects itself.
+     * @param a The parameter.
+     */
+    void CbDisconnect(int a);
+    /**
+     * Callback which connects CbCount.
+     * @param a The parameter.
+     */
+    void CbConnect(int a);
+    /**
+     * Callback which destroys the TracedCallback.
+     * @param a The parameter.
+     */
+    void CbDestroy(int a);
+    /**
+     * Callback which counts its calls.
+     * @param a The parameter.
+     */
+    void CbCount(int a);
+
+    std::unique_ptr<TracedCallback<int>> m_trace; //!< The TracedCallback.
+    uint32_t m_disconnect;                        //!< Number of calls of CbDisconnect.
+    uint32_t m_count;                             //!< Number of calls of CbCount.
+};
+
+ReentrantTracedCallbackTestCase::ReentrantTracedCallbackTestCase()
+    : TestCase("Check TracedCallback changes while it is invoked")
+{
+}
+
+void
+ReentrantTracedCallbackTestCase::CbDisconnect(int /* a */)
+{
+    m_disconnect++;
+    m_trace->DisconnectWithoutContext(
+        MakeCallback(&ReentrantTracedCallbackTestCase::CbDisconnect, this));
+}
+
+void
+ReentrantTracedCallbackTestCase::CbConnect(int /* a */)
+{
+    m_trace->ConnectWithoutContext(MakeCallback(&ReentrantTracedCallbackTestCase::CbCount, this));
+}
+
+void
+ReentrantTracedCallbackTestCase::CbDestroy(int /* a */)
+{
+    m_trace.reset();
+}
+
+void
+ReentrantTracedCallbackTestCase::CbCount(int /* a */)
+{
+    m_count++;
+}
+
+void
+ReentrantTracedCallbackTestCase::DoRun()
+{
+    m_trace = std::make_unique<TracedCallback<int>>();
+    m_disconnect = 0;
+    m_count = 0;
+
+    //
+    // A Callback which disconnects itself is called once, and the
+    // following Callbacks are still called.
+    //
+    m_trace->ConnectWithoutContext(
+        MakeCallback(&ReentrantTracedCallbackTestCase::CbDisconnect, this));
+    m_trace->ConnectWithoutContext(MakeCallback(&ReentrantTracedCallbackTestCase::CbCount, this));
+    (*m_trace)(1);
+    (*m_trace)(2);
+    NS_TEST_ASSERT_MSG_EQ(m_disconnect, 1, "CbDisconnect not disconnected");
+    NS_TEST_ASSERT_MSG_EQ(m_count, 2, "CbCount not called by each invocation");
+
+    //
+    // A Callback connected by a Callback is called from the next invocation.
+    //
+    m_trace->ConnectWithoutContext(MakeCallback(&ReentrantTracedCallbackTestCase::CbConnect, this));
+    m_count = 0;
+    (*m_trace)(3);
+    NS_TEST_ASSERT_MSG_EQ(m_count, 1, "CbCount connected by CbConnect called too early");
+    m_count = 0;
+    (*m_trace)(4);
+    NS_TEST_ASSERT_MSG_EQ(m_count, 2, "CbCount connected by CbConnect not called");
+
+    //
+    // A Callback can destroy the TracedCallback, the following Callbacks are
+    // still called.
+    //
+    m_trace = std::make_unique<TracedCallback<int>>();
+    m_trace->ConnectWithoutContext(MakeCallback(&ReentrantTracedCallbackTestCase::CbDestroy, this));
+    m_trace->ConnectWithoutContext(MakeCallback(&ReentrantTracedCallbackTestCase::CbCount, this));
+    m_count = 0;
+    TracedCallback<int>* trace = m_trace.get();
+    (*trace)(5);
+    NS_TEST_ASSERT_MSG_EQ((m_trace == nullptr), true, "TracedCallback not destroyed");
+    NS_TEST_ASSERT_MSG_EQ(m_count, 1, "CbCount not called after CbDestroy");
+
+    //
+    // A copy of a TracedCallback has its own chain.
+    //
+    TracedCallback<int> original;
+    original.ConnectWithoutContext(MakeCallback(&ReentrantTracedCallbackTestCase::CbCount, this));
+    TracedCallback<int> copy = original;
+    original.DisconnectWithoutContext(
+        MakeCallback(&ReentrantTracedCallbackTestCase::CbCount, this));
+    m_count = 0;
+    original(6);
+    copy(7);
+    NS_TEST_ASSERT_MSG_EQ(original.IsEmpty(), true, "Callback not disconnected");
+    NS_TEST_ASSERT_MSG_EQ(m_count, 1, "Callback of the copy not called");
+
+    //
+    // A moved TracedCallback takes the chain and leaves an empty one.
+    //
+    TracedCallback<int> moved = std::move(copy);
+    m_count = 0;
+    copy(8);
+    moved(9);
+    NS_TEST_ASSERT_MSG_EQ(copy.IsEmpty(), true, "Chain of the moved TracedCallback not taken");
+    NS_TEST_ASSERT_MSG_EQ(m_count, 1, "Callback of the moved TracedCallback not called");
+    original = std::move(moved);
+    original(10);
+    NS_TEST_ASSERT_MSG_EQ(moved.IsEmpty(), true, "Chain of the moved TracedCallback not taken");
+    NS_TEST_ASSERT_MSG_EQ(m_count, 2, "Callback of the move-assigned TracedCallback not called");
+}
+
 /**
  * @ingroup tracedcallback-tests
  *
@@ -137,6 +282,7 @@ TracedCallbackTestSuite::TracedCallbackTestSuite()
     : TestSuite("traced-callback", Type::UNIT)
 {
     AddTestCase(new BasicTracedCallbackTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new ReentrantTracedCallbackTestCase, TestCase::Duration::QUICK);
 }
 
 static TracedCallbackTestSuite
@@ -89,5 +89,84 @@ DsdvHeader::Print(std::ostream& os) const
     os << "DestinationIpv4: " << m_dst << " Hopcount: " << m_hopCount
        << " SequenceNumber: " << m_dstSeqNo;
 }
+
+NS_OBJECT_ENSURE_REGISTERED(DsdvRouteListHeader);
+
+DsdvRouteListHeader::DsdvRouteListHeader()
+{
+}
+
+DsdvRouteListHeader::~DsdvRouteListHeader()
+{
+}
+
+TypeId
+DsdvRouteListHeader::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::dsdv::DsdvRouteListHeader")
+                            .SetParent<Header>()
+                            .SetGroupName("Dsdv")
+                            .AddConstructor<DsdvRouteListHeader>();
+    return tid;
+}
+
+TypeId
+DsdvRouteListHeader::GetInstanceTypeId() const
+{
+    return GetTypeId();
+}
+
+uint32_t
+DsdvRouteListHeader::GetSerializedSize() const
+{
+    return m_routes.size() * 12;
+}
+
+void
+DsdvRouteListHeader::Serialize(Buffer::Iterator i) const
+{
+    for (auto route = m_routes.rbegin(); route != m_routes.rend(); ++route)
+    {
+        WriteTo(i, route->GetDst());
+        i.WriteHtonU32(route->GetHopCount());
+        i.WriteHtonU32(route->GetDstSeqno());
+    }
+}
+
+uint32_t
+DsdvRouteListHeader::Deserialize(Buffer::Iterator start)
+{
+    NS_FATAL_ERROR("This variant should not be called on a variable-sized header");
+    return 0;
+}
+
+uint32_t
+DsdvRouteListHeader::Deserialize(Buffer::Iterator start, Buffer::Iterator end)
+{
+    Buffer::Iterator i = start;
+    uint32_t n = start.GetDistanceFrom(end) / 12;
+    m_routes.resize(n);
+    for (auto route = m_routes.rbegin(); route != m_routes.rend(); ++route)
+    {
+        Ipv4Address dst;
+        ReadFrom(i, dst);
+        route->SetDst(dst);
+        route->SetHopCount(i.ReadNtohU32());
+        route->SetDstSeqno(i.ReadNtohU32());
+    }
+
+    uint32_t dist = i.GetDistanceFrom(start);
+    NS_ASSERT(dist == GetSerializedSize());
+    return dist;
+}
+
+void
+DsdvRouteListHeader::Print(std::ostream& os) const
+{
+    for (uint32_t i = 0; i < m_routes.size(); ++i)
+    {
+        os << (i > 0 ? " " : "") << "[" << GetRoute(i) << "]";
+    }
+}
 } // namespace dsdv
 } // namespace ns3
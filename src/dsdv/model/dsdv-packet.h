@@ -25,6 +25,7 @@
 #include "ns3/nstime.h"
 
 #include <iostream>
+#include <vector>
 
 namespace ns3
 {
@@ -135,6 +136,75 @@ operator<<(std::ostream& os, const DsdvHeader& packet)
     packet.Print(os);
     return os;
 }
+
+/**
+ * @ingroup dsdv
+ * @brief DSDV Update Packet holding a list of route advertisements
+ *
+ * The advertisements are laid out back to back, each in the format of a
+ * DsdvHeader, so that the packet is the same as if each advertisement was
+ * added to it as a DsdvHeader.  Adding all of them at once to the packet
+ * grows its buffer and metadata only once, and removing all of them at once
+ * parses them in a single pass.
+ */
+class DsdvRouteListHeader : public Header
+{
+  public:
+    DsdvRouteListHeader();
+    ~DsdvRouteListHeader() override;
+    /**
+     * @brief Get the type ID.
+     * @return the object TypeId
+     */
+    static TypeId GetTypeId();
+    TypeId GetInstanceTypeId() const override;
+    uint32_t GetSerializedSize() const override;
+    void Serialize(Buffer::Iterator start) const override;
+    uint32_t Deserialize(Buffer::Iterator start) override;
+    uint32_t Deserialize(Buffer::Iterator start, Buffer::Iterator end) override;
+    void Print(std::ostream& os) const override;
+
+    /**
+     * Reserve room for a number of route advertisements
+     * @param n the number of route advertisements
+     */
+    void Reserve(uint32_t n)
+    {
+        m_routes.reserve(n);
+    }
+
+    /**
+     * Add a route advertisement before the ones already in the list, as
+     * Packet::AddHeader does for a DsdvHeader
+     * @param route the route advertisement
+     */
+    void PrependRoute(const DsdvHeader& route)
+    {
+        m_routes.push_back(route);
+    }
+
+    /**
+     * Get the number of route advertisements
+     * @returns the number of route advertisements
+     */
+    uint32_t GetNRoutes() const
+    {
+        return m_routes.size();
+    }
+
+    /**
+     * Get a route advertisement
+     * @param i the index of the route advertisement, in the packet order
+     * @returns the route advertisement
+     */
+    const DsdvHeader& GetRoute(uint32_t i) const
+    {
+        return m_routes[m_routes.size() - 1 - i];
+    }
+
+  private:
+    std::vector<DsdvHeader> m_routes; ///< Route advertisements, last one in the packet first
+};
 } // namespace dsdv
 } // namespace ns3
 
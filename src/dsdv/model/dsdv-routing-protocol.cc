@@ -564,13 +564,13 @@ RoutingProtocol::RecvDsdv(Ptr<Socket> socket)
     uint32_t packetSize = packet->GetSize();
     NS_LOG_FUNCTION(m_mainAddress << " received dsdv packet of size: " << packetSize
                                   << " and packet id: " << packet->GetUid());
+    DsdvRouteListHeader routeList;
+    packet->RemoveHeader(routeList, packetSize);
     uint32_t count = 0;
-    for (; packetSize > 0; packetSize = packetSize - 12)
+    for (uint32_t n = 0; n < routeList.GetNRoutes(); ++n)
     {
         count = 0;
-        DsdvHeader dsdvHeader;
-        DsdvHeader tempDsdvHeader;
-        packet->RemoveHeader(dsdvHeader);
+        const DsdvHeader& dsdvHeader = routeList.GetRoute(n);
         NS_LOG_DEBUG("Processing new update for " << dsdvHeader.GetDst());
         /*Verifying if the packets sent by me were returned back to me. If yes, discarding them!*/
         for (auto j = m_socketAddresses.begin(); j != m_socketAddresses.end(); ++j)
@@ -822,7 +822,8 @@ RoutingProtocol::SendTriggeredUpdate()
         DsdvHeader dsdvHeader;
         Ptr<Socket> socket = j->first;
         Ipv4InterfaceAddress iface = j->second;
-        Ptr<Packet> packet = Create<Packet>();
+        DsdvRouteListHeader routeList;
+        routeList.Reserve(allRoutes.size() + 1);
         for (auto i = allRoutes.begin(); i != allRoutes.end(); ++i)
         {
             NS_LOG_LOGIC("Destination: " << i->second.GetDestination()
@@ -842,7 +843,7 @@ RoutingProtocol::SendTriggeredUpdate()
                 {
                     m_routingTable.Update(temp);
                 }
-                packet->AddHeader(dsdvHeader);
+                routeList.PrependRoute(dsdvHeader);
                 m_advRoutingTable.DeleteRoute(temp.GetDestination());
                 NS_LOG_DEBUG("Deleted this route from the advertised table");
             }
@@ -855,7 +856,7 @@ RoutingProtocol::SendTriggeredUpdate()
                                         << " has not expired, waiting in adv table");
             }
         }
-        if (packet->GetSize() >= 12)
+        if (routeList.GetNRoutes() > 0)
         {
             RoutingTableEntry temp2;
             m_routingTable.LookupRoute(m_ipv4->GetAddress(1, 0).GetBroadcast(), temp2);
@@ -863,7 +864,9 @@ RoutingProtocol::SendTriggeredUpdate()
             dsdvHeader.SetDstSeqno(temp2.GetSeqNo());
             dsdvHeader.SetHopCount(temp2.GetHop() + 1);
             NS_LOG_DEBUG("Adding my update as well to the packet");
-            packet->AddHeader(dsdvHeader);
+            routeList.PrependRoute(dsdvHeader);
+            Ptr<Packet> packet = Create<Packet>();
+            packet->AddHeader(routeList);
             // Send to all-hosts broadcast if on /32 addr, subnet-directed otherwise
             Ipv4Address destination;
             if (iface.GetMask() == Ipv4Mask::GetOnes())
@@ -903,7 +906,8 @@ RoutingProtocol::SendPeriodicUpdate()
     {
         Ptr<Socket> socket = j->first;
         Ipv4InterfaceAddress iface = j->second;
-        Ptr<Packet> packet = Create<Packet>();
+        DsdvRouteListHeader routeList;
+        routeList.Reserve(allRoutes.size() + removedAddresses.size());
         for (auto i = allRoutes.begin(); i != allRoutes.end(); ++i)
         {
             DsdvHeader dsdvHeader;
@@ -916,14 +920,14 @@ RoutingProtocol::SendPeriodicUpdate()
                 m_routingTable.LookupRoute(m_ipv4->GetAddress(1, 0).GetBroadcast(), ownEntry);
                 ownEntry.SetSeqNo(dsdvHeader.GetDstSeqno());
                 m_routingTable.Update(ownEntry);
-                packet->AddHeader(dsdvHeader);
+                routeList.PrependRoute(dsdvHeader);
             }
             else
             {
                 dsdvHeader.SetDst(i->second.GetDestination());
                 dsdvHeader.SetDstSeqno(i->second.GetSeqNo());
                 dsdvHeader.SetHopCount(i->second.GetHop() + 1);
-                packet->AddHeader(dsdvHeader);
+                routeList.PrependRoute(dsdvHeader);
             }
             NS_LOG_DEBUG("Forwarding the update for " << i->first);
             NS_LOG_DEBUG("Forwarding details are, Destination: "
@@ -937,11 +941,13 @@ RoutingProtocol::SendPeriodicUpdate()
             removedHeader.SetDst(rmItr->second.GetDestination());
             removedHeader.SetDstSeqno(rmItr->second.GetSeqNo() + 1);
             removedHeader.SetHopCount(rmItr->second.GetHop() + 1);
-            packet->AddHeader(removedHeader);
+            routeList.PrependRoute(removedHeader);
             NS_LOG_DEBUG("Update for removed record is: Destination: "
                          << removedHeader.GetDst() << " SeqNo:" << removedHeader.GetDstSeqno()
                          << " HopCount:" << removedHeader.GetHopCount());
         }
+        Ptr<Packet> packet = Create<Packet>();
+        packet->AddHeader(routeList);
         socket->Send(packet);
         // Send to all-hosts broadcast if on /32 addr, subnet-directed otherwise
         Ipv4Address destination;
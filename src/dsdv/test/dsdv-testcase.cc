@@ -97,6 +97,70 @@ DsdvHeaderTestCase::DoRun()
     }
 }
 
+/**
+ * @ingroup dsdv-test
+ *
+ * @brief DSDV test case to verify the DSDV route list header
+ *
+ */
+class DsdvRouteListHeaderTestCase : public TestCase
+{
+  public:
+    DsdvRouteListHeaderTestCase();
+    ~DsdvRouteListHeaderTestCase() override;
+    void DoRun() override;
+};
+
+DsdvRouteListHeaderTestCase::DsdvRouteListHeaderTestCase()
+    : TestCase("Verifying the DSDV route list header")
+{
+}
+
+DsdvRouteListHeaderTestCase::~DsdvRouteListHeaderTestCase()
+{
+}
+
+void
+DsdvRouteListHeaderTestCase::DoRun()
+{
+    Ptr<Packet> headers = Create<Packet>();
+    dsdv::DsdvRouteListHeader routeList;
+    for (uint32_t i = 1; i <= 5; ++i)
+    {
+        dsdv::DsdvHeader hdr(Ipv4Address(0x0a010100 + i), i, 2 * i);
+        headers->AddHeader(hdr);
+        routeList.PrependRoute(hdr);
+    }
+    Ptr<Packet> packet = Create<Packet>();
+    packet->AddHeader(routeList);
+    NS_TEST_ASSERT_MSG_EQ(packet->GetSize(), 60, "001");
+
+    // same wire format as the DSDV headers added one by one
+    std::vector<uint8_t> expected(headers->GetSize());
+    std::vector<uint8_t> actual(packet->GetSize());
+    headers->CopyData(expected.data(), expected.size());
+    packet->CopyData(actual.data(), actual.size());
+    NS_TEST_ASSERT_MSG_EQ((actual == expected), true, "002");
+
+    // parse the DSDV headers added one by one
+    dsdv::DsdvRouteListHeader parsed;
+    NS_TEST_ASSERT_MSG_EQ(headers->RemoveHeader(parsed, headers->GetSize()), 60, "003");
+    NS_TEST_ASSERT_MSG_EQ(parsed.GetNRoutes(), 5, "004");
+    NS_TEST_ASSERT_MSG_EQ(headers->GetSize(), 0, "005");
+    for (uint32_t i = 0; i < 5; ++i)
+    {
+        const dsdv::DsdvHeader& hdr = parsed.GetRoute(i);
+        NS_TEST_EXPECT_MSG_EQ(hdr.GetDst(), Ipv4Address(0x0a010105 - i), "006");
+        NS_TEST_EXPECT_MSG_EQ(hdr.GetHopCount(), 5 - i, "007");
+        NS_TEST_EXPECT_MSG_EQ(hdr.GetDstSeqno(), 2 * (5 - i), "008");
+    }
+
+    // the first route is the first DSDV header
+    dsdv::DsdvHeader first;
+    packet->RemoveHeader(first);
+    NS_TEST_EXPECT_MSG_EQ(first.GetDst(), Ipv4Address("10.1.1.5"), "009");
+}
+
 /**
  * @ingroup dsdv-test
  *
@@ -210,6 +274,7 @@ class DsdvTestSuite : public TestSuite
         : TestSuite("routing-dsdv", Type::UNIT)
     {
         AddTestCase(new DsdvHeaderTestCase(), TestCase::Duration::QUICK);
+        AddTestCase(new DsdvRouteListHeaderTestCase(), TestCase::Duration::QUICK);
         AddTestCase(new DsdvTableTestCase(), TestCase::Duration::QUICK);
     }
 } g_dsdvTestSuite; ///< the test suite
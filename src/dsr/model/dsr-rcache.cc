@@ -34,6 +34,7 @@
 #include <functional>
 #include <iomanip>
 #include <iostream>
+#include <limits>
 #include <list>
 #include <map>
 #include <vector>
@@ -145,6 +146,9 @@ DsrRouteCache::DsrRouteCache()
     : m_vector(0),
       m_maxEntriesEachDst(3),
       m_isLinkCache(false),
+      m_treeSource(0),
+      m_fullRebuild(true),
+      m_linkExpiry(Time::Max()),
       m_ntimer(Timer::CANCEL_ON_DESTROY),
       m_delay(MilliSeconds(100))
 {
@@ -303,117 +307,266 @@ DsrRouteCache::IsLinkCache()
     return m_isLinkCache;
 }
 
+DsrRouteCache::NodeIndex
+DsrRouteCache::GetGraphIndex(Ipv4Address address)
+{
+    auto [it, inserted] = m_graphIndex.emplace(address, m_graphNodes.size());
+    if (inserted)
+    {
+        m_graphNodes.push_back(address);
+        m_graphEdges.emplace_back();
+    }
+    return it->second;
+}
+
 void
-DsrRouteCache::RebuildBestRouteTable(Ipv4Address source)
+DsrRouteCache::AddGraphLink(const Link& link)
 {
-    NS_LOG_FUNCTION(this << source);
-    /**
-     * @brief The following are initialize-single-source
+    NS_LOG_FUNCTION(this << link.m_low << link.m_high);
+    // Here the weight is set as 1
+    /// @todo May need to set different weight for different link here later
+    uint32_t weight = 1;
+    NodeIndex low = GetGraphIndex(link.m_low);
+    NodeIndex high = GetGraphIndex(link.m_high);
+    m_graphEdges[low].push_back({high, weight});
+    m_graphEdges[high].push_back({low, weight});
+    m_addedLinks.emplace_back(low, high);
+}
+
+void
+DsrRouteCache::RemoveGraphLink(const Link& link)
+{
+    NS_LOG_FUNCTION(this << link.m_low << link.m_high);
+    NodeIndex low = m_graphIndex.at(link.m_low);
+    NodeIndex high = m_graphIndex.at(link.m_high);
+    for (auto [from, to] : {std::make_pair(low, high), std::make_pair(high, low)})
+    {
+        auto& edges = m_graphEdges[from];
+        auto edge = std::find_if(edges.begin(), edges.end(), [to = to](const GraphEdge& e) {
+            return e.node == to;
+        });
+        NS_ASSERT(edge != edges.end());
+        *edge = edges.back();
+        edges.pop_back();
+    }
+    m_brokenLinks.emplace_back(low, high);
+    // Past a point, recomputing the best routes from scratch is cheaper than repairing them
+    if (m_brokenLinks.size() > m_graphNodes.size())
+    {
+        m_fullRebuild = true;
+        m_addedLinks.clear();
+        m_brokenLinks.clear();
+    }
+}
+
+bool
+DsrRouteCache::Relax(NodeIndex from, NodeIndex to, uint32_t weight)
+{
+    if (m_distance[from] == std::numeric_limits<uint32_t>::max())
+    {
+        return false;
+    }
+    uint32_t distance = m_distance[from] + weight;
+    if (distance < m_distance[to])
+    {
+        m_distance[to] = distance;
+        m_predecessor[to] = from;
+        return true;
+    }
+    /*
+     *  Selects the shortest-length route that has the longest expected lifetime
+     *  (highest minimum timeout of any link in the route)
+     *  For the computation overhead and complexity
+     *  Here I just implement kind of greedy strategy to select link with the longest
+     * expected lifetime when there is two options
      */
-    // @d shortest-path estimate
-    std::map<Ipv4Address, uint32_t> d;
-    // @pre preceding node
-    std::map<Ipv4Address, Ipv4Address> pre;
-    for (auto i = m_netGraph.begin(); i != m_netGraph.end(); ++i)
+    if (distance == m_distance[to] && m_predecessor[to] != from &&
+        m_predecessor[to] != std::numeric_limits<NodeIndex>::max())
     {
-        if (i->second.find(source) != i->second.end())
+        auto oldlink = m_linkCache.find(Link(m_graphNodes[to], m_graphNodes[m_predecessor[to]]));
+        auto newlink = m_linkCache.find(Link(m_graphNodes[to], m_graphNodes[from]));
+        if (oldlink != m_linkCache.end() && newlink != m_linkCache.end())
         {
-            d[i->first] = i->second[source];
-            pre[i->first] = source;
+            if (oldlink->second.GetLinkStability() < newlink->second.GetLinkStability())
+            {
+                NS_LOG_INFO("Select the link with longest expected lifetime");
+                m_predecessor[to] = from;
+            }
         }
         else
         {
-            d[i->first] = MAXWEIGHT;
-            pre[i->first] = Ipv4Address("255.255.255.255");
+            NS_LOG_INFO("Link Stability Info Corrupt");
         }
     }
-    d[source] = 0;
-    /**
-     * @brief The following is the core of Dijkstra algorithm
-     */
-    // the node set which shortest distance has been calculated, if true calculated
-    std::map<Ipv4Address, bool> s;
-    double temp = MAXWEIGHT;
-    Ipv4Address tempip("255.255.255.255");
-    for (uint32_t i = 0; i < m_netGraph.size(); i++)
-    {
-        temp = MAXWEIGHT;
-        for (auto j = d.begin(); j != d.end(); ++j)
+    return false;
+}
+
+void
+DsrRouteCache::RunDijkstra(GraphQueue& queue)
+{
+    NS_LOG_FUNCTION(this << queue.size());
+    // Visit the closest node first and, among the closest ones, the highest address first
+    auto later = [this](const GraphQueue::value_type& a, const GraphQueue::value_type& b) {
+        return a.first > b.first ||
+               (a.first == b.first && m_graphNodes[a.second] < m_graphNodes[b.second]);
+    };
+    std::make_heap(queue.begin(), queue.end(), later);
+    while (!queue.empty())
+    {
+        std::pop_heap(queue.begin(), queue.end(), later);
+        auto [distance, node] = queue.back();
+        queue.pop_back();
+        if (distance != m_distance[node])
         {
-            Ipv4Address ip = j->first;
-            if (s.find(ip) == s.end())
+            // The node was queued again since with a shorter distance
+            continue;
+        }
+        for (const auto& edge : m_graphEdges[node])
+        {
+            if (Relax(node, edge.node, edge.weight))
             {
-                /*
-                 * @brief The following are for comparison
-                 */
-                if (j->second <= temp)
-                {
-                    temp = j->second;
-                    tempip = ip;
-                }
+                queue.emplace_back(m_distance[edge.node], edge.node);
+                std::push_heap(queue.begin(), queue.end(), later);
             }
         }
-        if (!tempip.IsBroadcast())
+    }
+}
+
+void
+DsrRouteCache::RebuildBestRouteTable(Ipv4Address source)
+{
+    NS_LOG_FUNCTION(this << source);
+    m_treeSource = GetGraphIndex(source);
+    m_distance.assign(m_graphNodes.size(), std::numeric_limits<uint32_t>::max());
+    m_predecessor.assign(m_graphNodes.size(), std::numeric_limits<NodeIndex>::max());
+    m_addedLinks.clear();
+    m_brokenLinks.clear();
+    m_fullRebuild = false;
+
+    m_distance[m_treeSource] = 0;
+    GraphQueue queue{{0, m_treeSource}};
+    RunDijkstra(queue);
+}
+
+void
+DsrRouteCache::RepairBrokenLink(NodeIndex a, NodeIndex b)
+{
+    NS_LOG_FUNCTION(this << m_graphNodes[a] << m_graphNodes[b]);
+    NodeIndex root;
+    if (m_predecessor[b] == a)
+    {
+        root = b;
+    }
+    else if (m_predecessor[a] == b)
+    {
+        root = a;
+    }
+    else
+    {
+        NS_LOG_LOGIC("The link was not used by the best routes");
+        return;
+    }
+
+    // Find the nodes whose best route goes through the link, i.e., the subtree of its far end
+    enum : uint8_t
+    {
+        UNKNOWN,
+        AFFECTED,
+        UNAFFECTED
+    };
+
+    std::vector<uint8_t> state(m_graphNodes.size(), UNKNOWN);
+    state[root] = AFFECTED;
+    std::vector<NodeIndex> path;
+    for (NodeIndex i = 0; i < m_graphNodes.size(); ++i)
+    {
+        NodeIndex j = i;
+        while (state[j] == UNKNOWN && m_predecessor[j] != std::numeric_limits<NodeIndex>::max())
+        {
+            path.push_back(j);
+            j = m_predecessor[j];
+        }
+        if (state[j] == UNKNOWN)
+        {
+            state[j] = UNAFFECTED;
+        }
+        for (auto k : path)
         {
-            s[tempip] = true;
-            for (auto k = m_netGraph[tempip].begin(); k != m_netGraph[tempip].end(); ++k)
+            state[k] = state[j];
+        }
+        path.clear();
+    }
+
+    for (NodeIndex i = 0; i < m_graphNodes.size(); ++i)
+    {
+        if (state[i] == AFFECTED)
+        {
+            m_distance[i] = std::numeric_limits<uint32_t>::max();
+            m_predecessor[i] = std::numeric_limits<NodeIndex>::max();
+        }
+    }
+    // Reattach the affected nodes to their unaffected neighbors, and go on from there
+    GraphQueue queue;
+    for (NodeIndex i = 0; i < m_graphNodes.size(); ++i)
+    {
+        if (state[i] != AFFECTED)
+        {
+            continue;
+        }
+        for (const auto& edge : m_graphEdges[i])
+        {
+            if (state[edge.node] == UNAFFECTED)
             {
-                if (s.find(k->first) == s.end() && d[k->first] > d[tempip] + k->second)
-                {
-                    d[k->first] = d[tempip] + k->second;
-                    pre[k->first] = tempip;
-                }
-                /*
-                 *  Selects the shortest-length route that has the longest expected lifetime
-                 *  (highest minimum timeout of any link in the route)
-                 *  For the computation overhead and complexity
-                 *  Here I just implement kind of greedy strategy to select link with the longest
-                 * expected lifetime when there is two options
-                 */
-                else if (d[k->first] == d[tempip] + k->second)
-                {
-                    auto oldlink = m_linkCache.find(Link(k->first, pre[k->first]));
-                    auto newlink = m_linkCache.find(Link(k->first, tempip));
-                    if (oldlink != m_linkCache.end() && newlink != m_linkCache.end())
-                    {
-                        if (oldlink->second.GetLinkStability() < newlink->second.GetLinkStability())
-                        {
-                            NS_LOG_INFO("Select the link with longest expected lifetime");
-                            d[k->first] = d[tempip] + k->second;
-                            pre[k->first] = tempip;
-                        }
-                    }
-                    else
-                    {
-                        NS_LOG_INFO("Link Stability Info Corrupt");
-                    }
-                }
+                Relax(edge.node, i, edge.weight);
             }
         }
+        if (m_distance[i] != std::numeric_limits<uint32_t>::max())
+        {
+            queue.emplace_back(m_distance[i], i);
+        }
     }
-    // clean the best route table
-    m_bestRoutesTable_link.clear();
-    for (auto i = pre.begin(); i != pre.end(); ++i)
-    {
-        // loop for all vertices
-        DsrRouteCacheEntry::IP_VECTOR route;
-        Ipv4Address iptemp = i->first;
+    RunDijkstra(queue);
+}
 
-        if (!i->second.IsBroadcast() && iptemp != source)
+void
+DsrRouteCache::UpdateBestRouteTable(Ipv4Address source)
+{
+    NS_LOG_FUNCTION(this << source);
+    if (m_fullRebuild || m_distance.empty() || m_graphNodes[m_treeSource] != source)
+    {
+        RebuildBestRouteTable(source);
+        return;
+    }
+    NS_LOG_LOGIC("Update the best routes for " << m_addedLinks.size() << " added and "
+                                               << m_brokenLinks.size() << " broken links");
+    m_distance.resize(m_graphNodes.size(), std::numeric_limits<uint32_t>::max());
+    m_predecessor.resize(m_graphNodes.size(), std::numeric_limits<NodeIndex>::max());
+    for (auto [a, b] : m_brokenLinks)
+    {
+        RepairBrokenLink(a, b);
+    }
+    GraphQueue queue;
+    for (auto [a, b] : m_addedLinks)
+    {
+        for (const auto& edge : m_graphEdges[a])
         {
-            while (iptemp != source)
+            if (edge.node == b)
             {
-                route.push_back(iptemp);
-                iptemp = pre[iptemp];
+                if (Relax(a, b, edge.weight))
+                {
+                    queue.emplace_back(m_distance[b], b);
+                }
+                if (Relax(b, a, edge.weight))
+                {
+                    queue.emplace_back(m_distance[a], a);
+                }
+                break;
             }
-            route.push_back(source);
-            // Reverse the route
-            DsrRouteCacheEntry::IP_VECTOR reverseroute(route.rbegin(), route.rend());
-            NS_LOG_LOGIC("Add newly calculated best routes");
-            PrintVector(reverseroute);
-            m_bestRoutesTable_link[i->first] = reverseroute;
         }
     }
+    RunDijkstra(queue);
+    m_addedLinks.clear();
+    m_brokenLinks.clear();
 }
 
 bool
@@ -422,24 +575,28 @@ DsrRouteCache::LookupRoute_Link(Ipv4Address id, DsrRouteCacheEntry& rt)
     NS_LOG_FUNCTION(this << id);
     /// We need to purge the link node cache
     PurgeLinkNode();
-    auto i = m_bestRoutesTable_link.find(id);
-    if (i == m_bestRoutesTable_link.end())
+    auto i = m_graphIndex.find(id);
+    if (i == m_graphIndex.end() || i->second >= m_predecessor.size() ||
+        m_predecessor[i->second] == std::numeric_limits<NodeIndex>::max())
     {
         NS_LOG_INFO("No route find to " << id);
         return false;
     }
 
-    if (i->second.size() < 2)
+    DsrRouteCacheEntry::IP_VECTOR route;
+    for (NodeIndex node = i->second; node != m_treeSource; node = m_predecessor[node])
     {
-        NS_LOG_LOGIC("Route to " << id << " error");
-        return false;
+        route.push_back(m_graphNodes[node]);
     }
+    route.push_back(m_graphNodes[m_treeSource]);
+    // Reverse the route
+    std::reverse(route.begin(), route.end());
 
     DsrRouteCacheEntry newEntry; // Create the route entry
-    newEntry.SetVector(i->second);
+    newEntry.SetVector(route);
     newEntry.SetDestination(id);
     newEntry.SetExpireTime(RouteCacheTimeout);
-    NS_LOG_INFO("Route to " << id << " found with the length " << i->second.size());
+    NS_LOG_INFO("Route to " << id << " found with the length " << route.size());
     rt = newEntry;
     std::vector<Ipv4Address> path = rt.GetVector();
     PrintVector(path);
@@ -450,18 +607,26 @@ void
 DsrRouteCache::PurgeLinkNode()
 {
     NS_LOG_FUNCTION(this);
-    for (auto i = m_linkCache.begin(); i != m_linkCache.end();)
+    // No link expired if the earliest expiration time is not passed yet
+    if (m_linkExpiry < Simulator::Now())
     {
-        NS_LOG_DEBUG("The link stability " << i->second.GetLinkStability().As(Time::S));
-        auto itmp = i;
-        if (i->second.GetLinkStability().IsNegative())
-        {
-            ++i;
-            m_linkCache.erase(itmp);
-        }
-        else
+        m_linkExpiry = Time::Max();
+        for (auto i = m_linkCache.begin(); i != m_linkCache.end();)
         {
-            ++i;
+            NS_LOG_DEBUG("The link stability " << i->second.GetLinkStability().As(Time::S));
+            auto itmp = i;
+            if (i->second.GetLinkStability().IsNegative())
+            {
+                ++i;
+                RemoveGraphLink(itmp->first);
+                m_linkCache.erase(itmp);
+            }
+            else
+            {
+                m_linkExpiry =
+                    std::min(m_linkExpiry, Simulator::Now() + i->second.GetLinkStability());
+                ++i;
+            }
         }
     }
     /// may need to remove them after verify
@@ -485,15 +650,15 @@ void
 DsrRouteCache::UpdateNetGraph()
 {
     NS_LOG_FUNCTION(this);
-    m_netGraph.clear();
+    for (auto& edges : m_graphEdges)
+    {
+        edges.clear();
+    }
     for (auto i = m_linkCache.begin(); i != m_linkCache.end(); ++i)
     {
-        // Here the weight is set as 1
-        /// @todo May need to set different weight for different link here later
-        uint32_t weight = 1;
-        m_netGraph[i->first.m_low][i->first.m_high] = weight;
-        m_netGraph[i->first.m_high][i->first.m_low] = weight;
+        AddGraphLink(i->first);
     }
+    m_fullRebuild = true;
 }
 
 bool
@@ -584,14 +749,18 @@ DsrRouteCache::AddRoute_Link(DsrRouteCacheEntry::IP_VECTOR nodelist, Ipv4Address
             /// Set the link stability as the m)minLifeTime, default is 1 second
             stab.SetLinkStability(m_minLifeTime);
         }
+        if (m_linkCache.find(link) == m_linkCache.end())
+        {
+            AddGraphLink(link);
+        }
         m_linkCache[link] = stab;
+        m_linkExpiry = std::min(m_linkExpiry, Simulator::Now() + stab.GetLinkStability());
         NS_LOG_DEBUG("Add a new link");
         link.Print();
         NS_LOG_DEBUG("Link Info");
         stab.Print();
     }
-    UpdateNetGraph();
-    RebuildBestRouteTable(source);
+    UpdateBestRouteTable(source);
     return true;
 }
 
@@ -779,10 +948,16 @@ DsrRouteCache::DeleteAllRoutesIncludeLink(Ipv4Address errorSrc,
         Link link2(unreachNode, errorSrc);
         // erase the two kind of links to make sure the link is removed from the link cache
         NS_LOG_DEBUG("Erase the route");
-        m_linkCache.erase(link1);
+        if (m_linkCache.erase(link1) > 0)
+        {
+            RemoveGraphLink(link1);
+        }
         /// @todo get rid of this one
         NS_LOG_DEBUG("The link cache size " << m_linkCache.size());
-        m_linkCache.erase(link2);
+        if (m_linkCache.erase(link2) > 0)
+        {
+            RemoveGraphLink(link2);
+        }
         NS_LOG_DEBUG("The link cache size " << m_linkCache.size());
 
         auto i = m_nodeCache.find(errorSrc);
@@ -803,8 +978,7 @@ DsrRouteCache::DeleteAllRoutesIncludeLink(Ipv4Address errorSrc,
         {
             DecStability(i->first);
         }
-        UpdateNetGraph();
-        RebuildBestRouteTable(node);
+        UpdateBestRouteTable(node);
     }
     else
     {
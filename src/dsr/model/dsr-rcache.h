@@ -43,6 +43,7 @@
 #include <map>
 #include <stdint.h>
 #include <sys/types.h>
+#include <unordered_map>
 #include <vector>
 
 namespace ns3
@@ -786,16 +787,36 @@ class DsrRouteCache : public Object
  * when the weight is calculated we normalized them: 100*weight/max of Weight
  */
 #define MAXWEIGHT 0xFFFF;
+    /// Index of a node in the network graph
+    typedef uint32_t NodeIndex;
+
+    /// Link from a node of the network graph to one of its neighbors
+    struct GraphEdge
+    {
+        NodeIndex node;  ///< index of the neighbor
+        uint32_t weight; ///< weight of the link
+    };
+
+    /// Binary heap of the nodes to visit, with their distance to the source
+    typedef std::vector<std::pair<uint32_t, NodeIndex>> GraphQueue;
+
     /**
-     * Current network graph state for this node, double is weight, which is calculated by the node
-     * information and link information, any time some changes of link cache and node cache change
-     * the weight and then recompute the best choice for each node
+     * Current network graph state for this node, kept in sync with the link cache. The nodes
+     * are identified by their index in m_graphNodes, which never changes once assigned, and
+     * m_graphEdges holds the links of each node, indexed the same way
      */
-    std::map<Ipv4Address, std::map<Ipv4Address, uint32_t>> m_netGraph;
+    std::unordered_map<Ipv4Address, NodeIndex, Ipv4AddressHash> m_graphIndex;
+    std::vector<Ipv4Address> m_graphNodes;             ///< address of each node of the graph
+    std::vector<std::vector<GraphEdge>> m_graphEdges;  ///< links of each node of the graph
+    std::vector<uint32_t> m_distance;                  ///< distance of each node to the source
+    std::vector<NodeIndex> m_predecessor;              ///< preceding node in the best routes
+    NodeIndex m_treeSource;                            ///< source of the best routes
+    bool m_fullRebuild;                                ///< recompute the best routes from scratch
+    std::vector<std::pair<NodeIndex, NodeIndex>> m_addedLinks;  ///< links added since then
+    std::vector<std::pair<NodeIndex, NodeIndex>> m_brokenLinks; ///< links removed since then
 
-    std::map<Ipv4Address, DsrRouteCacheEntry::IP_VECTOR>
-        m_bestRoutesTable_link;                     ///< for link route cache
     std::map<Link, DsrLinkStab> m_linkCache;        ///< The data structure to store link info
+    Time m_linkExpiry; ///< Lower bound of the expiration time of the links in the link cache
     std::map<Ipv4Address, DsrNodeStab> m_nodeCache; ///< The data structure to store node info
     /**
      * @brief used by LookupRoute when LinkCache
@@ -816,11 +837,54 @@ class DsrRouteCache : public Object
      * @return true if success
      */
     bool DecStability(Ipv4Address node);
+    /**
+     * @brief get the index of a node in the network graph, adding the node if needed
+     * @param address the ip address of the node
+     * @return the index of the node
+     */
+    NodeIndex GetGraphIndex(Ipv4Address address);
+    /**
+     * @brief add a link newly inserted in the link cache to the network graph
+     * @param link the link
+     */
+    void AddGraphLink(const Link& link);
+    /**
+     * @brief remove a link erased from the link cache from the network graph
+     * @param link the link
+     */
+    void RemoveGraphLink(const Link& link);
+    /**
+     * @brief relax a link of the network graph for the best routes
+     *
+     * When both routes have the same length, selects the link with the longest
+     * expected lifetime.
+     * @param from the node at the start of the link
+     * @param to the node at the end of the link
+     * @param weight the weight of the link
+     * @return true if the distance to the end of the link decreased
+     */
+    bool Relax(NodeIndex from, NodeIndex to, uint32_t weight);
+    /**
+     * @brief run the Dijkstra algorithm from the nodes in a queue
+     * @param queue the nodes whose distance decreased, emptied on return
+     */
+    void RunDijkstra(GraphQueue& queue);
+    /**
+     * @brief recompute the best routes that used a link removed from the network graph
+     * @param a the node at one end of the link
+     * @param b the node at the other end of the link
+     */
+    void RepairBrokenLink(NodeIndex a, NodeIndex b);
+    /**
+     * @brief update the best routes after the links in the network graph changed,
+     * incrementally if only a few links changed since the last update
+     * @param source The source address used for computing the routes
+     */
+    void UpdateBestRouteTable(Ipv4Address source);
 
   public:
     /**
-     * @brief Dijsktra algorithm to get the best route from m_netGraph and update the
-     * m_bestRoutesTable_link when current graph information has changed
+     * @brief Set the type of the cache
      * @param type The type of the cache
      */
     void SetCacheType(std::string type);
@@ -837,9 +901,7 @@ class DsrRouteCache : public Object
      */
     bool AddRoute_Link(DsrRouteCacheEntry::IP_VECTOR nodelist, Ipv4Address node);
     /**
-     * @brief Rebuild the best route table
-     * @note Use MAXWEIGHT to represent maximum weight, use the IPv4 broadcast
-     *       address of 255.255.255.255 to represent a null preceding address
+     * @brief Rebuild the best route table from scratch
      * @param source The source address used for computing the routes
      */
     void RebuildBestRouteTable(Ipv4Address source);
@@ -857,7 +919,8 @@ class DsrRouteCache : public Object
      */
     void UseExtends(DsrRouteCacheEntry::IP_VECTOR rt);
     /**
-     * @brief Update the Net Graph for the link and node cache has changed
+     * @brief Rebuild the Net Graph from the link cache; the next update of the best route
+     * table recomputes it from scratch
      */
     void UpdateNetGraph();
     //---------------------------------------------------------------------------------------
@@ -30,11 +30,15 @@
 #include "ns3/ipv4-route.h"
 #include "ns3/mesh-helper.h"
 #include "ns3/ptr.h"
+#include "ns3/random-variable-stream.h"
 #include "ns3/simulator.h"
 #include "ns3/string.h"
 #include "ns3/test.h"
 #include "ns3/uinteger.h"
 
+#include <algorithm>
+#include <map>
+#include <set>
 #include <vector>
 
 using namespace ns3;
@@ -607,6 +611,205 @@ DsrRreqTableTest::DoRun()
     NS_TEST_EXPECT_MSG_EQ(rt.m_reqNo, 2, "trivial");
 }
 
+// -----------------------------------------------------------------------------
+/**
+ * @ingroup dsr-test
+ * @ingroup tests
+ *
+ * @class DsrLinkCacheTest
+ * @brief Unit test for the best routes of the DSR link cache
+ */
+class DsrLinkCacheTest : public TestCase
+{
+  public:
+    DsrLinkCacheTest();
+    ~DsrLinkCacheTest() override;
+    void DoRun() override;
+
+  private:
+    /**
+     * Create a route cache using the link cache
+     * @return the route cache
+     */
+    Ptr<dsr::DsrRouteCache> CreateLinkCache();
+    /**
+     * Check that the best routes are shortest routes over the links
+     * @param rcache the route cache
+     * @param source the source of the routes
+     * @param nodes the nodes
+     * @param links the links, with the lowest address first
+     */
+    void CheckRoutes(Ptr<dsr::DsrRouteCache> rcache,
+                     Ipv4Address source,
+                     const std::vector<Ipv4Address>& nodes,
+                     const std::set<std::pair<Ipv4Address, Ipv4Address>>& links);
+};
+
+DsrLinkCacheTest::DsrLinkCacheTest()
+    : TestCase("DSR LinkCache")
+{
+}
+
+DsrLinkCacheTest::~DsrLinkCacheTest()
+{
+}
+
+Ptr<dsr::DsrRouteCache>
+DsrLinkCacheTest::CreateLinkCache()
+{
+    Ptr<dsr::DsrRouteCache> rcache = CreateObject<dsr::DsrRouteCache>();
+    rcache->SetCacheType("LinkCache");
+    rcache->SetInitStability(Seconds(25));
+    rcache->SetMinLifeTime(Seconds(1));
+    rcache->SetStabilityDecrFactor(2);
+    rcache->SetStabilityIncrFactor(4);
+    rcache->SetUseExtends(Seconds(120));
+    return rcache;
+}
+
+void
+DsrLinkCacheTest::CheckRoutes(Ptr<dsr::DsrRouteCache> rcache,
+                              Ipv4Address source,
+                              const std::vector<Ipv4Address>& nodes,
+                              const std::set<std::pair<Ipv4Address, Ipv4Address>>& links)
+{
+    // breadth-first search of the hop counts
+    std::map<Ipv4Address, uint32_t> hops{{source, 0}};
+    std::vector<Ipv4Address> queue{source};
+    for (std::size_t i = 0; i < queue.size(); ++i)
+    {
+        for (const auto& [low, high] : links)
+        {
+            for (auto [from, to] : {std::make_pair(low, high), std::make_pair(high, low)})
+            {
+                if (from == queue[i] && hops.find(to) == hops.end())
+                {
+                    hops[to] = hops[from] + 1;
+                    queue.push_back(to);
+                }
+            }
+        }
+    }
+
+    for (const auto& node : nodes)
+    {
+        if (node == source)
+        {
+            continue;
+        }
+        dsr::DsrRouteCacheEntry entry;
+        bool found = rcache->LookupRoute(node, entry);
+        auto it = hops.find(node);
+        NS_TEST_ASSERT_MSG_EQ(found, it != hops.end(), "Unexpected route to " << node);
+        if (!found)
+        {
+            continue;
+        }
+        auto route = entry.GetVector();
+        NS_TEST_ASSERT_MSG_EQ(route.size(), it->second + 1, "Not a shortest route to " << node);
+        NS_TEST_EXPECT_MSG_EQ(route.front(), source, "Route does not start at the source");
+        NS_TEST_EXPECT_MSG_EQ(route.back(), node, "Route does not end at the destination");
+        for (std::size_t i = 0; i + 1 < route.size(); ++i)
+        {
+            auto link = std::minmax(route[i], route[i + 1]);
+            NS_TEST_EXPECT_MSG_EQ(links.count(link), 1, "Route uses a missing link");
+        }
+    }
+}
+
+void
+DsrLinkCacheTest::DoRun()
+{
+    Ipv4Address s("10.0.0.1");
+    Ipv4Address a("10.0.0.2");
+    Ipv4Address b("10.0.0.3");
+    Ipv4Address d("10.0.0.4");
+    Ipv4Address x("10.0.0.5");
+    dsr::DsrRouteCacheEntry entry;
+
+    // the routes of same length through a and b are selected by the stability of their links,
+    // whatever the order in which they are learnt
+    for (bool stableFirst : {false, true})
+    {
+        Ptr<dsr::DsrRouteCache> rcache = CreateLinkCache();
+        // decrease the stability of a, and hence of the links learnt later through it
+        rcache->AddRoute_Link({s, a}, s);
+        rcache->DeleteAllRoutesIncludeLink(a, x, s);
+        if (stableFirst)
+        {
+            rcache->AddRoute_Link({s, b, d}, s);
+        }
+        rcache->AddRoute_Link({s, a, d}, s);
+        rcache->AddRoute_Link({s, b, d}, s);
+        NS_TEST_ASSERT_MSG_EQ(rcache->LookupRoute(d, entry), true, "No route to d");
+        NS_TEST_EXPECT_MSG_EQ(entry.GetVector().size(), 3, "Not a shortest route");
+        NS_TEST_EXPECT_MSG_EQ(entry.GetVector()[1], b, "Not the most stable route");
+        rcache->RebuildBestRouteTable(s);
+        NS_TEST_ASSERT_MSG_EQ(rcache->LookupRoute(d, entry), true, "No route to d");
+        NS_TEST_EXPECT_MSG_EQ(entry.GetVector()[1], b, "Not the most stable route");
+
+        // a broken link reroutes through the other route
+        rcache->DeleteAllRoutesIncludeLink(b, d, s);
+        NS_TEST_ASSERT_MSG_EQ(rcache->LookupRoute(d, entry), true, "No route to d");
+        NS_TEST_EXPECT_MSG_EQ(entry.GetVector()[1], a, "Not rerouted");
+        rcache->DeleteAllRoutesIncludeLink(a, d, s);
+        NS_TEST_EXPECT_MSG_EQ(rcache->LookupRoute(d, entry), false, "Unexpected route to d");
+        NS_TEST_EXPECT_MSG_EQ(rcache->LookupRoute(b, entry), true, "No route to b");
+    }
+
+    // the expired links are purged from the best routes
+    Ptr<dsr::DsrRouteCache> expiring = CreateLinkCache();
+    expiring->AddRoute_Link({s, a, d}, s);
+    Simulator::Schedule(Seconds(30), [=, this]() {
+        dsr::DsrRouteCacheEntry entry;
+        expiring->AddRoute_Link({s, b}, s);
+        NS_TEST_EXPECT_MSG_EQ(expiring->LookupRoute(b, entry), true, "No route to b");
+        NS_TEST_EXPECT_MSG_EQ(expiring->LookupRoute(d, entry), false, "Route through expired link");
+    });
+    Simulator::Run();
+    Simulator::Destroy();
+
+    // random sequence of learnt routes and broken links, updating the best routes incrementally
+    Ptr<dsr::DsrRouteCache> rcache = CreateLinkCache();
+    Ptr<UniformRandomVariable> rv = CreateObject<UniformRandomVariable>();
+    rv->SetStream(1);
+    std::vector<Ipv4Address> nodes;
+    for (uint32_t i = 1; i <= 60; ++i)
+    {
+        nodes.emplace_back(0x0a000000 + i);
+    }
+    Ipv4Address source = nodes[0];
+    std::set<std::pair<Ipv4Address, Ipv4Address>> links;
+    for (uint32_t step = 0; step < 300; ++step)
+    {
+        if (links.empty() || rv->GetInteger(0, 2) > 0)
+        {
+            std::vector<Ipv4Address> route{source};
+            for (uint32_t hops = rv->GetInteger(1, 5); route.size() <= hops;)
+            {
+                Ipv4Address next = nodes[rv->GetInteger(0, nodes.size() - 1)];
+                if (std::find(route.begin(), route.end(), next) == route.end())
+                {
+                    links.insert(std::minmax(route.back(), next));
+                    route.push_back(next);
+                }
+            }
+            rcache->AddRoute_Link(route, source);
+        }
+        else
+        {
+            auto link = links.begin();
+            std::advance(link, rv->GetInteger(0, links.size() - 1));
+            rcache->DeleteAllRoutesIncludeLink(link->first, link->second, source);
+            links.erase(link);
+        }
+        CheckRoutes(rcache, source, nodes, links);
+    }
+    // the routes rebuilt from scratch have the same lengths
+    rcache->RebuildBestRouteTable(source);
+    CheckRoutes(rcache, source, nodes, links);
+}
+
 // -----------------------------------------------------------------------------
 /**
  * @ingroup dsr-test
@@ -630,5 +833,6 @@ class DsrTestSuite : public TestSuite
         AddTestCase(new DsrAckHeaderTest, TestCase::Duration::QUICK);
         AddTestCase(new DsrCacheEntryTest, TestCase::Duration::QUICK);
         AddTestCase(new DsrSendBuffTest, TestCase::Duration::QUICK);
+        AddTestCase(new DsrLinkCacheTest, TestCase::Duration::QUICK);
     }
 } g_dsrTestSuite;
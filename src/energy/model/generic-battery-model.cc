@@ -12,11 +12,13 @@
 #include "generic-battery-model.h"
 
 #include "ns3/assert.h"
+#include "ns3/boolean.h"
 #include "ns3/double.h"
 #include "ns3/log.h"
 #include "ns3/simulator.h"
 #include "ns3/trace-source-accessor.h"
 
+#include <algorithm>
 #include <cmath>
 
 namespace ns3
@@ -92,6 +94,15 @@ GenericBatteryModel::GetTypeId()
                           MakeTimeAccessor(&GenericBatteryModel::SetEnergyUpdateInterval,
                                            &GenericBatteryModel::GetEnergyUpdateInterval),
                           MakeTimeChecker())
+            .AddAttribute("EventDrivenUpdates",
+                          "If true, the battery state is updated only when it is notified by "
+                          "the device models (e.g., on radio state changes) and an event is "
+                          "scheduled at the predicted time the cutoff voltage is reached, "
+                          "instead of updating the battery periodically. The drained capacity "
+                          "and the exponential zone voltage are then integrated analytically.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&GenericBatteryModel::m_eventDriven),
+                          MakeBooleanChecker())
             .AddAttribute("BatteryType",
                           "Indicates the battery type used by the model",
                           EnumValue(LION_LIPO),
@@ -114,7 +125,10 @@ GenericBatteryModel::GenericBatteryModel()
       m_currentFiltered(0),
       m_entn(0),
       m_expZone(0),
-      m_lastUpdateTime()
+      m_lastUpdateTime(),
+      m_currentA(0),
+      m_depleted(false),
+      m_charged(false)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -197,6 +211,18 @@ GenericBatteryModel::UpdateEnergySource()
         return;
     }
 
+    if (m_eventDriven)
+    {
+        UpdateState();
+        if (!m_currentUpdateEvent.IsPending())
+        {
+            // the device model notifying the battery may change its current afterwards
+            m_currentUpdateEvent =
+                Simulator::ScheduleNow(&GenericBatteryModel::UpdateCurrent, this);
+        }
+        return;
+    }
+
     m_energyUpdateEvent.Cancel();
 
     CalculateRemainingEnergy();
@@ -220,6 +246,205 @@ GenericBatteryModel::UpdateEnergySource()
         Simulator::Schedule(m_energyUpdateInterval, &GenericBatteryModel::UpdateEnergySource, this);
 }
 
+void
+GenericBatteryModel::UpdateState()
+{
+    NS_LOG_FUNCTION(this);
+
+    const auto state = CalculateState(Simulator::Now());
+    m_drainedCapacity = state.drainedCapacity;
+    m_currentFiltered = state.currentFiltered;
+    m_expZone = state.expZone;
+    m_supplyVoltageV = state.voltage;
+    m_lastUpdateTime = Simulator::Now();
+    m_remainingEnergyJ = (m_qMax - m_drainedCapacity) * m_supplyVoltageV * 3600;
+
+    NS_LOG_DEBUG(Simulator::Now().As(Time::S)
+                 << "| i " << m_currentA << " | it " << m_drainedCapacity << " | ExpZone "
+                 << m_expZone << " | i* " << m_currentFiltered << " | V " << m_supplyVoltageV
+                 << " | rmnEnergy " << m_remainingEnergyJ << "J | SoC " << GetStateOfCharge()
+                 << "% ");
+
+    // notify the device models only once per threshold crossing
+    if (m_supplyVoltageV <= m_cutoffVoltage || m_drainedCapacity >= m_qMax)
+    {
+        if (!m_depleted)
+        {
+            m_depleted = true;
+            BatteryDepletedEvent();
+        }
+    }
+    else
+    {
+        m_depleted = false;
+    }
+
+    if (m_supplyVoltageV >= m_vFull)
+    {
+        if (!m_charged)
+        {
+            m_charged = true;
+            BatteryChargedEvent();
+        }
+    }
+    else
+    {
+        m_charged = false;
+    }
+}
+
+void
+GenericBatteryModel::UpdateCurrent()
+{
+    NS_LOG_FUNCTION(this);
+
+    const double currentA = CalculateTotalCurrent();
+    if (currentA == m_currentA)
+    {
+        return;
+    }
+
+    // the past interval is accounted with the previous current
+    UpdateState();
+    m_currentA = currentA;
+    UpdateState();
+    ScheduleThresholdEvent();
+}
+
+void
+GenericBatteryModel::ThresholdReached()
+{
+    NS_LOG_FUNCTION(this);
+
+    UpdateState();
+    // the update may be slightly early if the state was updated in the meantime
+    ScheduleThresholdEvent();
+}
+
+void
+GenericBatteryModel::ScheduleThresholdEvent()
+{
+    NS_LOG_FUNCTION(this);
+
+    m_energyUpdateEvent.Cancel();
+
+    const bool discharging = (m_currentA > 0);
+    if ((discharging && m_depleted) || (!discharging && (m_charged || m_currentA == 0)))
+    {
+        return;
+    }
+
+    auto reached = [this, discharging](Time time) {
+        const auto state = CalculateState(time);
+        return discharging
+                   ? (state.voltage <= m_cutoffVoltage || state.drainedCapacity >= m_qMax)
+                   : (state.voltage >= m_vFull);
+    };
+
+    // upper bound: the time at which the battery is empty (discharge) or full (charge)
+    const Time now = Simulator::Now();
+    const double hours =
+        discharging ? (m_qMax - m_drainedCapacity) / m_currentA : m_drainedCapacity / -m_currentA;
+    Time high = now + Hours(std::clamp(hours, 0.0, 1e6)) + TimeStep(1);
+    if (!reached(high))
+    {
+        NS_LOG_DEBUG("Threshold voltage not reached when the battery is "
+                     << (discharging ? "empty" : "full"));
+        return;
+    }
+
+    // the voltage is monotonic with a constant current: find the first time step
+    // at which the threshold is reached by bisection
+    Time low = now;
+    while (high - low > TimeStep(1))
+    {
+        const Time middle = TimeStep((low.GetTimeStep() + high.GetTimeStep()) / 2);
+        if (reached(middle))
+        {
+            high = middle;
+        }
+        else
+        {
+            low = middle;
+        }
+    }
+    NS_LOG_DEBUG("Threshold voltage predicted at " << high.As(Time::S));
+    m_energyUpdateEvent =
+        Simulator::Schedule(high - now, &GenericBatteryModel::ThresholdReached, this);
+}
+
+GenericBatteryModel::BatteryState
+GenericBatteryModel::CalculateState(Time time) const
+{
+    NS_ASSERT(time >= m_lastUpdateTime);
+    const Time lapse = time - m_lastUpdateTime;
+    const double i = m_currentA;
+
+    // empirical factors
+    double A = m_vFull - m_vExp;
+    double B = 3 / m_qExp;
+
+    BatteryState state;
+    state.drainedCapacity = m_drainedCapacity + (i * lapse).GetHours();
+    state.currentFiltered = i * (1 - 1 / (std::exp((time / Seconds(30)).GetDouble())));
+
+    if (m_batteryType == LION_LIPO)
+    {
+        state.expZone = A * std::exp(-B * state.drainedCapacity);
+    }
+    else
+    {
+        // d(expZone)/dt = B |i| (A - expZone) when charging and -B |i| expZone when
+        // discharging (t in hours), which the periodic updates integrate step by step
+        const double expZone = (m_expZone == 0) ? A * std::exp(-B * m_drainedCapacity) : m_expZone;
+        const double decay = std::exp(-B * std::abs(i) * lapse.GetHours());
+        state.expZone = (i < 0) ? A + (expZone - A) * decay : expZone * decay;
+    }
+
+    state.voltage =
+        CalculateVoltage(i, state.drainedCapacity, state.currentFiltered, state.expZone);
+    return state;
+}
+
+double
+GenericBatteryModel::CalculateVoltage(double i,
+                                      double it,
+                                      double currentFiltered,
+                                      double expZone) const
+{
+    // empirical factors
+    double A = m_vFull - m_vExp;
+    double B = 3 / m_qExp;
+
+    // voltage constant
+    double E0 = m_vFull + m_internalResistance * m_typicalCurrent - A;
+
+    // voltage of exponential zone when battery is fully charged
+    double expZoneFull = A * std::exp(-B * m_qNom);
+
+    // Obtain the voltage|resistance polarization constant
+    double K = (E0 - m_vNom - (m_internalResistance * m_typicalCurrent) + expZoneFull) /
+               (m_qMax / (m_qMax - m_qNom) * (m_qNom + m_typicalCurrent));
+
+    double polResistance;
+    double polVoltage = K * m_qMax / (m_qMax - it);
+    if (i >= 0)
+    {
+        polResistance = polVoltage;
+    }
+    else if (m_batteryType == NIMH_NICD)
+    {
+        polResistance = K * m_qMax / (std::abs(it) + 0.1 * m_qMax);
+    }
+    else
+    {
+        polResistance = K * m_qMax / (it + 0.1 * m_qMax);
+    }
+
+    return E0 - (m_internalResistance * i) - (polResistance * currentFiltered) -
+           (polVoltage * it) + expZone;
+}
+
 void
 GenericBatteryModel::DoInitialize()
 {
@@ -230,6 +455,8 @@ void
 GenericBatteryModel::DoDispose()
 {
     NS_LOG_FUNCTION(this);
+    m_energyUpdateEvent.Cancel();
+    m_currentUpdateEvent.Cancel();
     BreakDeviceEnergyModelRefCycle();
 }
 
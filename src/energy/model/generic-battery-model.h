@@ -274,6 +274,64 @@ class GenericBatteryModel : public EnergySource
      */
     double GetChargeVoltage(double current);
 
+    /// State of the battery at a given time, used in event-driven mode
+    struct BatteryState
+    {
+        double drainedCapacity; //!< Capacity drained from the battery, in Ah
+        double currentFiltered; //!< The step response (a.k.a. low pass filter)
+        double expZone;         //!< Voltage value of the exponential zone
+        double voltage;         //!< Voltage of the battery
+    };
+
+    /**
+     * Compute the state of the battery at the given time, assuming that the
+     * current drawn from the battery did not change since the last update.
+     * In contrast to the periodic updates, the drained capacity and the
+     * exponential zone voltage are integrated analytically.
+     *
+     * @param time The time, not earlier than the last update.
+     * @return The state of the battery.
+     */
+    BatteryState CalculateState(Time time) const;
+
+    /**
+     * Compute the battery voltage with the formulas of GetVoltage() (i >= 0)
+     * and GetChargeVoltage() (i < 0), without altering the model state.
+     *
+     * @param i The current drawn from the battery (A).
+     * @param it The capacity drained from the battery (Ah).
+     * @param currentFiltered The filtered current (A).
+     * @param expZone The voltage of the exponential zone (V).
+     * @return The voltage of the battery.
+     */
+    double CalculateVoltage(double i, double it, double currentFiltered, double expZone) const;
+
+    /**
+     * Update the state of the battery up to the current time and notify the
+     * device models if the battery got depleted or charged. Used in event-driven mode.
+     */
+    void UpdateState();
+
+    /**
+     * Handle a possible change of the total current drawn from the battery.
+     * It is scheduled to run after the device models that notified the
+     * battery have updated their state. If the current changed, the time at
+     * which the cutoff (or full) voltage is reached is predicted again.
+     */
+    void UpdateCurrent();
+
+    /**
+     * Handle the predicted time at which the cutoff (or full) voltage is reached.
+     */
+    void ThresholdReached();
+
+    /**
+     * Schedule ThresholdReached() at the first time step at which the cutoff
+     * voltage (when discharging) or the full voltage (when charging) is predicted
+     * to be reached with the current drawn from the battery.
+     */
+    void ScheduleThresholdEvent();
+
   private:
     TracedValue<double> m_remainingEnergyJ; //!< Remaining energy, in Joules
     double m_drainedCapacity;               //!< Capacity drained from the battery, in Ah
@@ -298,6 +356,11 @@ class GenericBatteryModel : public EnergySource
     double m_typicalCurrent;      //!< Typical discharge current used to fit the curves
     double m_cutoffVoltage; //!< The threshold voltage where the battery is considered depleted
     GenericBatteryType m_batteryType; //!< Indicates the battery type used by the model
+    bool m_eventDriven; //!< Whether the battery is updated on current changes only
+    double m_currentA;  //!< Current drawn since the last update (A), in event-driven mode
+    bool m_depleted;    //!< Whether the depletion was notified, in event-driven mode
+    bool m_charged;     //!< Whether the full charge was notified, in event-driven mode
+    EventId m_currentUpdateEvent; //!< Event to handle current changes, in event-driven mode
 };
 
 } // namespace energy
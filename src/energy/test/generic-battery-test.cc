@@ -10,6 +10,8 @@
 #include "ns3/core-module.h"
 #include "ns3/energy-module.h"
 
+#include <tuple>
+
 using namespace ns3;
 using namespace ns3::energy;
 
@@ -70,6 +72,130 @@ DischargeBatteryTestCase::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @ingroup energy-tests
+ *
+ * @brief Device energy model recording the time the battery got depleted
+ */
+class DepletionRecorder : public SimpleDeviceEnergyModel
+{
+  public:
+    void HandleEnergyDepletion() override
+    {
+        if (m_depletionTime.IsZero())
+        {
+            m_depletionTime = Simulator::Now();
+        }
+    }
+
+    Time m_depletionTime; //!< Time the battery got depleted
+};
+
+/**
+ * @ingroup energy-tests
+ *
+ * @brief Compare the event-driven updates of the battery with the periodic ones
+ */
+class EventDrivenBatteryTestCase : public TestCase
+{
+  public:
+    EventDrivenBatteryTestCase();
+
+    void DoRun() override;
+
+  private:
+    /// Results of a discharge
+    struct Result
+    {
+        Time depletionTime;     //!< Time the battery got depleted
+        uint32_t nUpdates;      //!< Number of updates of the remaining energy
+        double remainingEnergy; //!< Remaining energy at the time of the current change
+    };
+
+    /**
+     * Discharge a battery
+     * @param eventDriven whether the battery uses event-driven updates
+     * @param preset the battery preset
+     * @param current1 the current drawn during the first 1000 seconds (A)
+     * @param current2 the current drawn afterwards (A)
+     * @return the results of the discharge
+     */
+    Result Discharge(bool eventDriven, BatteryModel preset, double current1, double current2);
+};
+
+EventDrivenBatteryTestCase::EventDrivenBatteryTestCase()
+    : TestCase("Compare the event-driven and periodic updates of the generic battery model")
+{
+}
+
+EventDrivenBatteryTestCase::Result
+EventDrivenBatteryTestCase::Discharge(bool eventDriven,
+                                      BatteryModel preset,
+                                      double current1,
+                                      double current2)
+{
+    Ptr<Node> node = CreateObject<Node>();
+    GenericBatteryModelHelper batteryHelper;
+    batteryHelper.Set("EventDrivenUpdates", BooleanValue(eventDriven));
+    batteryHelper.Set("PeriodicEnergyUpdateInterval", TimeValue(MilliSeconds(100)));
+    Ptr<GenericBatteryModel> batteryModel =
+        DynamicCast<GenericBatteryModel>(batteryHelper.Install(node, preset));
+
+    Ptr<DepletionRecorder> recorder = CreateObject<DepletionRecorder>();
+    recorder->SetEnergySource(batteryModel);
+    batteryModel->AppendDeviceEnergyModel(recorder);
+    recorder->SetNode(node);
+
+    Result result{Time(), 0, 0};
+    batteryModel->TraceConnectWithoutContext(
+        "RemainingEnergy",
+        Callback<void, double, double>([&result](double, double) { result.nUpdates++; }));
+
+    batteryModel->UpdateEnergySource();
+    recorder->SetCurrentA(current1);
+    Simulator::Schedule(Seconds(1000), [&]() {
+        result.remainingEnergy = batteryModel->GetRemainingEnergy();
+        recorder->SetCurrentA(current2);
+    });
+
+    Simulator::Stop(Hours(5));
+    Simulator::Run();
+    result.depletionTime = recorder->m_depletionTime;
+
+    node->Dispose();
+    recorder->Dispose();
+    batteryModel->Dispose();
+    Simulator::Destroy();
+    return result;
+}
+
+void
+EventDrivenBatteryTestCase::DoRun()
+{
+    // the periodic updates detect the depletion up to one interval late and account for
+    // the current set by the device model over the whole previous interval
+    for (const auto& [preset, current1, current2] :
+         {std::tuple{PANASONIC_CGR18650DA_LION, 2.33, 2.33},
+          std::tuple{PANASONIC_CGR18650DA_LION, 1.0, 3.0},
+          std::tuple{PANASONIC_HHR650D_NIMH, 6.5, 6.5},
+          std::tuple{CSB_GP1272_LEADACID, 3.0, 7.0}})
+    {
+        const auto periodic = Discharge(false, preset, current1, current2);
+        const auto eventDriven = Discharge(true, preset, current1, current2);
+
+        NS_TEST_ASSERT_MSG_EQ(periodic.depletionTime.IsZero(), false, "Battery not depleted");
+        NS_TEST_EXPECT_MSG_EQ_TOL(eventDriven.depletionTime.GetSeconds(),
+                                  periodic.depletionTime.GetSeconds(),
+                                  0.2,
+                                  "Unexpected depletion time for preset " << preset);
+        NS_TEST_EXPECT_MSG_EQ_TOL(eventDriven.remainingEnergy,
+                                  periodic.remainingEnergy,
+                                  periodic.remainingEnergy * 1e-3,
+                                  "Unexpected remaining energy for preset " << preset);
+        NS_TEST_EXPECT_MSG_LT(eventDriven.nUpdates, 10, "Too many updates in event-driven mode");
+    }
+}
+
 /**
  * @ingroup energy-tests
  *
@@ -85,6 +211,7 @@ GenericBatteryTestSuite::GenericBatteryTestSuite()
     : TestSuite("generic-battery-test", Type::UNIT)
 {
     AddTestCase(new DischargeBatteryTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new EventDrivenBatteryTestCase, TestCase::Duration::QUICK);
 }
 
 /// create an instance of the test suite
@@ -8,9 +8,14 @@
 
 #include "flow-monitor.h"
 
+#include "ns3/abort.h"
+#include "ns3/boolean.h"
 #include "ns3/double.h"
 #include "ns3/log.h"
 #include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/trace-source-accessor.h"
+#include "ns3/uinteger.h"
 
 #include <fstream>
 #include <limits>
@@ -70,10 +75,166 @@ FlowMonitor::GetTypeId()
                 ("The minimum inter-arrival time that is considered a flow interruption."),
                 TimeValue(Seconds(0.5)),
                 MakeTimeAccessor(&FlowMonitor::m_flowInterruptionsMinTime),
-                MakeTimeChecker());
+                MakeTimeChecker())
+            .AddAttribute("EnableHistograms",
+                          ("Whether to fill the delay, jitter, packetSize and flowInterruptions "
+                           "histograms of the flows.  Disabling them saves their memory and "
+                           "update cost when only the summary statistics are needed."),
+                          BooleanValue(true),
+                          MakeBooleanAccessor(&FlowMonitor::m_enableHistograms),
+                          MakeBooleanChecker())
+            .AddAttribute("TrackedPacketsCapacity",
+                          ("The number of in-flight packets the table of the tracked packets "
+                           "is initially sized for; the table grows when needed."),
+                          UintegerValue(1024),
+                          MakeUintegerAccessor(&FlowMonitor::m_trackedPacketsCapacity),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("StreamingInterval",
+                          ("The interval of the reports of the statistics of the flows over "
+                           "the last interval, after which the statistics are reset; "
+                           "zero disables the reports."),
+                          TimeValue(Seconds(0)),
+                          MakeTimeAccessor(&FlowMonitor::m_streamingInterval),
+                          MakeTimeChecker(Seconds(0)))
+            .AddAttribute("StreamingFileName",
+                          ("The name of the XML file where the reports of the statistics are "
+                           "written, if StreamingInterval is not zero; empty to only fire the "
+                           "FlowStatsDelta trace."),
+                          StringValue(""),
+                          MakeStringAccessor(&FlowMonitor::m_streamingFile),
+                          MakeStringChecker())
+            .AddTraceSource("FlowStatsDelta",
+                            "The statistics of a flow over the last StreamingInterval, for "
+                            "each flow with packets sent, received or lost in the interval.",
+                            MakeTraceSourceAccessor(&FlowMonitor::m_flowStatsDeltaTrace),
+                            "ns3::FlowMonitor::FlowStatsDeltaCallback");
     return tid;
 }
 
+FlowMonitor::TrackedPacketTable::TrackedPacketTable()
+    : m_size(0),
+      m_shift(64)
+{
+}
+
+std::size_t
+FlowMonitor::TrackedPacketTable::GetHome(FlowId flowId, FlowPacketId packetId) const
+{
+    // Fibonacci hashing: the top bits of the product mix all the bits of the key
+    uint64_t key = (static_cast<uint64_t>(flowId) << 32) | packetId;
+    return (key * 0x9e3779b97f4a7c15ULL) >> m_shift;
+}
+
+void
+FlowMonitor::TrackedPacketTable::Reserve(std::size_t n)
+{
+    // Keep the load factor below 1/2, so that the probe sequences stay short
+    std::size_t capacity = 8;
+    while (capacity < 2 * n)
+    {
+        capacity *= 2;
+    }
+    if (capacity > m_slots.size())
+    {
+        Rehash(capacity);
+    }
+}
+
+void
+FlowMonitor::TrackedPacketTable::Rehash(std::size_t capacity)
+{
+    std::vector<Slot> slots(capacity);
+    std::swap(slots, m_slots);
+    m_shift = 64;
+    while (capacity > 1)
+    {
+        capacity /= 2;
+        --m_shift;
+    }
+    const std::size_t mask = m_slots.size() - 1;
+    for (const auto& slot : slots)
+    {
+        if (slot.used)
+        {
+            std::size_t i = GetHome(slot.flowId, slot.packetId);
+            while (m_slots[i].used)
+            {
+                i = (i + 1) & mask;
+            }
+            m_slots[i] = slot;
+        }
+    }
+}
+
+FlowMonitor::TrackedPacketTable::Slot*
+FlowMonitor::TrackedPacketTable::Find(FlowId flowId, FlowPacketId packetId)
+{
+    if (m_size == 0)
+    {
+        return nullptr;
+    }
+    const std::size_t mask = m_slots.size() - 1;
+    for (std::size_t i = GetHome(flowId, packetId); m_slots[i].used; i = (i + 1) & mask)
+    {
+        if (m_slots[i].flowId == flowId && m_slots[i].packetId == packetId)
+        {
+            return &m_slots[i];
+        }
+    }
+    return nullptr;
+}
+
+FlowMonitor::TrackedPacketTable::Slot&
+FlowMonitor::TrackedPacketTable::Insert(FlowId flowId, FlowPacketId packetId)
+{
+    if (2 * (m_size + 1) > m_slots.size())
+    {
+        Reserve(m_size + 1);
+    }
+    const std::size_t mask = m_slots.size() - 1;
+    std::size_t i = GetHome(flowId, packetId);
+    for (; m_slots[i].used; i = (i + 1) & mask)
+    {
+        if (m_slots[i].flowId == flowId && m_slots[i].packetId == packetId)
+        {
+            return m_slots[i];
+        }
+    }
+    Slot& slot = m_slots[i];
+    slot.flowId = flowId;
+    slot.packetId = packetId;
+    slot.used = true;
+    ++m_size;
+    return slot;
+}
+
+void
+FlowMonitor::TrackedPacketTable::Erase(Slot& slot)
+{
+    // Backward shift deletion: move back the next slots of the cluster whose
+    // probe sequence passes through the hole, so that no tombstone is needed
+    const std::size_t mask = m_slots.size() - 1;
+    std::size_t hole = &slot - m_slots.data();
+    for (std::size_t i = (hole + 1) & mask; m_slots[i].used; i = (i + 1) & mask)
+    {
+        std::size_t home = GetHome(m_slots[i].flowId, m_slots[i].packetId);
+        // move the slot if its home is not in the cyclic range (hole, i]
+        if (((i - home) & mask) >= ((i - hole) & mask))
+        {
+            m_slots[hole] = m_slots[i];
+            hole = i;
+        }
+    }
+    m_slots[hole].used = false;
+    --m_size;
+}
+
+std::size_t
+FlowMonitor::TrackedPacketTable::GetSize() const
+{
+    return m_size;
+}
+
 FlowMonitor::FlowMonitor()
     : m_enabled(false)
 {
@@ -86,6 +247,12 @@ FlowMonitor::DoDispose()
     NS_LOG_FUNCTION(this);
     Simulator::Cancel(m_startEvent);
     Simulator::Cancel(m_stopEvent);
+    Simulator::Cancel(m_streamingEvent);
+    if (m_streamingOs.is_open())
+    {
+        m_streamingOs << "</FlowMonitorStream>\n";
+        m_streamingOs.close();
+    }
     for (auto iter = m_classifiers.begin(); iter != m_classifiers.end(); iter++)
     {
         *iter = nullptr;
@@ -142,7 +309,7 @@ FlowMonitor::ReportFirstTx(Ptr<FlowProbe> probe,
         return;
     }
     Time now = Simulator::Now();
-    TrackedPacket& tracked = m_trackedPackets[std::make_pair(flowId, packetId)];
+    TrackedPacket& tracked = m_trackedPackets.Insert(flowId, packetId).packet;
     tracked.firstSeenTime = now;
     tracked.lastSeenTime = tracked.firstSeenTime;
     tracked.timesForwarded = 0;
@@ -173,19 +340,18 @@ FlowMonitor::ReportForwarding(Ptr<FlowProbe> probe,
         NS_LOG_DEBUG("FlowMonitor not enabled; returning");
         return;
     }
-    std::pair<FlowId, FlowPacketId> key(flowId, packetId);
-    auto tracked = m_trackedPackets.find(key);
-    if (tracked == m_trackedPackets.end())
+    auto tracked = m_trackedPackets.Find(flowId, packetId);
+    if (tracked == nullptr)
     {
         NS_LOG_WARN("Received packet forward report (flowId="
                     << flowId << ", packetId=" << packetId << ") but not known to be transmitted.");
         return;
     }
 
-    tracked->second.timesForwarded++;
-    tracked->second.lastSeenTime = Simulator::Now();
+    tracked->packet.timesForwarded++;
+    tracked->packet.lastSeenTime = Simulator::Now();
 
-    Time delay = (Simulator::Now() - tracked->second.firstSeenTime);
+    Time delay = (Simulator::Now() - tracked->packet.firstSeenTime);
     probe->AddPacketStats(flowId, packetSize, delay);
 }
 
@@ -201,8 +367,8 @@ FlowMonitor::ReportLastRx(Ptr<FlowProbe> probe,
         NS_LOG_DEBUG("FlowMonitor not enabled; returning");
         return;
     }
-    auto tracked = m_trackedPackets.find(std::make_pair(flowId, packetId));
-    if (tracked == m_trackedPackets.end())
+    auto tracked = m_trackedPackets.Find(flowId, packetId);
+    if (tracked == nullptr)
     {
         NS_LOG_WARN("Received packet last-tx report (flowId="
                     << flowId << ", packetId=" << packetId << ") but not known to be transmitted.");
@@ -210,25 +376,26 @@ FlowMonitor::ReportLastRx(Ptr<FlowProbe> probe,
     }
 
     Time now = Simulator::Now();
-    Time delay = (now - tracked->second.firstSeenTime);
+    Time delay = (now - tracked->packet.firstSeenTime);
     probe->AddPacketStats(flowId, packetSize, delay);
 
     FlowStats& stats = GetStatsForFlow(flowId);
+    // when streaming, the jitter and the inter-arrival time of the first packet
+    // of an interval are computed from the last packet of the previous intervals
+    const bool received = stats.rxPackets > 0 || m_rxFlows.count(flowId) > 0;
     stats.delaySum += delay;
-    stats.delayHistogram.AddValue(delay.GetSeconds());
-    if (stats.rxPackets > 0)
+    if (m_enableHistograms)
     {
-        Time jitter = stats.lastDelay - delay;
-        if (jitter.IsStrictlyPositive())
+        stats.delayHistogram.AddValue(delay.GetSeconds());
+    }
+    if (received)
+    {
+        Time jitter = Abs(stats.lastDelay - delay);
+        stats.jitterSum += jitter;
+        if (m_enableHistograms)
         {
-            stats.jitterSum += jitter;
             stats.jitterHistogram.AddValue(jitter.GetSeconds());
         }
-        else
-        {
-            stats.jitterSum -= jitter;
-            stats.jitterHistogram.AddValue(-jitter.GetSeconds());
-        }
     }
     stats.lastDelay = delay;
     if (delay > stats.maxDelay)
@@ -241,28 +408,31 @@ FlowMonitor::ReportLastRx(Ptr<FlowProbe> probe,
     }
 
     stats.rxBytes += packetSize;
-    stats.packetSizeHistogram.AddValue((double)packetSize);
+    if (m_enableHistograms)
+    {
+        stats.packetSizeHistogram.AddValue((double)packetSize);
+    }
     stats.rxPackets++;
     if (stats.rxPackets == 1)
     {
         stats.timeFirstRxPacket = now;
     }
-    else
+    if (received)
     {
         // measure possible flow interruptions
         Time interArrivalTime = now - stats.timeLastRxPacket;
-        if (interArrivalTime > m_flowInterruptionsMinTime)
+        if (interArrivalTime > m_flowInterruptionsMinTime && m_enableHistograms)
         {
             stats.flowInterruptionsHistogram.AddValue(interArrivalTime.GetSeconds());
         }
     }
     stats.timeLastRxPacket = now;
-    stats.timesForwarded += tracked->second.timesForwarded;
+    stats.timesForwarded += tracked->packet.timesForwarded;
 
     NS_LOG_DEBUG("ReportLastTx: removing tracked packet (flowId=" << flowId << ", packetId="
                                                                   << packetId << ").");
 
-    m_trackedPackets.erase(tracked); // we don't need to track this packet anymore
+    m_trackedPackets.Erase(*tracked); // we don't need to track this packet anymore
 }
 
 void
@@ -293,14 +463,14 @@ FlowMonitor::ReportDrop(Ptr<FlowProbe> probe,
     NS_LOG_DEBUG("++stats.packetsDropped["
                  << reasonCode << "]; // becomes: " << stats.packetsDropped[reasonCode]);
 
-    auto tracked = m_trackedPackets.find(std::make_pair(flowId, packetId));
-    if (tracked != m_trackedPackets.end())
+    auto tracked = m_trackedPackets.Find(flowId, packetId);
+    if (tracked != nullptr)
     {
         // we don't need to track this packet anymore
         // FIXME: this will not necessarily be true with broadcast/multicast
         NS_LOG_DEBUG("ReportDrop: removing tracked packet (flowId=" << flowId << ", packetId="
                                                                     << packetId << ").");
-        m_trackedPackets.erase(tracked);
+        m_trackedPackets.Erase(*tracked);
     }
 }
 
@@ -316,23 +486,19 @@ FlowMonitor::CheckForLostPackets(Time maxDelay)
     NS_LOG_FUNCTION(this << maxDelay.As(Time::S));
     Time now = Simulator::Now();
 
-    for (auto iter = m_trackedPackets.begin(); iter != m_trackedPackets.end();)
-    {
-        if (now - iter->second.lastSeenTime >= maxDelay)
-        {
-            // packet is considered lost, add it to the loss statistics
-            auto flow = m_flowStats.find(iter->first.first);
-            NS_ASSERT(flow != m_flowStats.end());
-            flow->second.lostPackets++;
-
-            // we won't track it anymore
-            m_trackedPackets.erase(iter++);
-        }
-        else
+    m_trackedPackets.EraseIf([this, now, maxDelay](const TrackedPacketTable::Slot& slot) {
+        if (now - slot.packet.lastSeenTime < maxDelay)
         {
-            iter++;
+            return false;
         }
-    }
+        // packet is considered lost, add it to the loss statistics
+        auto flow = m_flowStats.find(slot.flowId);
+        NS_ASSERT(flow != m_flowStats.end());
+        flow->second.lostPackets++;
+
+        // we won't track it anymore
+        return true;
+    });
 }
 
 void
@@ -352,7 +518,55 @@ void
 FlowMonitor::NotifyConstructionCompleted()
 {
     Object::NotifyConstructionCompleted();
+    m_trackedPackets.Reserve(m_trackedPacketsCapacity);
     Simulator::Schedule(PERIODIC_CHECK_INTERVAL, &FlowMonitor::PeriodicCheckForLostPackets, this);
+    if (m_streamingInterval.IsStrictlyPositive())
+    {
+        if (!m_streamingFile.empty())
+        {
+            m_streamingOs.open(m_streamingFile, std::ios::out);
+            NS_ABORT_MSG_UNLESS(m_streamingOs.is_open(),
+                                "Could not open the file " << m_streamingFile);
+            m_streamingOs << "<?xml version=\"1.0\" ?>\n<FlowMonitorStream>\n";
+        }
+        m_streamingStart = Simulator::Now();
+        m_streamingEvent =
+            Simulator::Schedule(m_streamingInterval, &FlowMonitor::StreamFlowStats, this);
+    }
+}
+
+void
+FlowMonitor::StreamFlowStats()
+{
+    NS_LOG_FUNCTION(this);
+    CheckForLostPackets();
+    Time now = Simulator::Now();
+    if (m_streamingOs.is_open())
+    {
+        m_streamingOs << "  <Interval start=\"" << m_streamingStart.As(Time::NS) << "\" end=\""
+                      << now.As(Time::NS) << "\">\n";
+    }
+    for (const auto& [flowId, flowStats] : m_flowStats)
+    {
+        if (flowStats.txPackets == 0 && flowStats.rxPackets == 0 && flowStats.lostPackets == 0)
+        {
+            continue;
+        }
+        m_flowStatsDeltaTrace(m_streamingStart, flowId, flowStats);
+        if (m_streamingOs.is_open())
+        {
+            SerializeFlowStatsToXmlStream(m_streamingOs, 4, flowId, flowStats, m_enableHistograms);
+        }
+    }
+    if (m_streamingOs.is_open())
+    {
+        m_streamingOs << "  </Interval>\n";
+        m_streamingOs.flush();
+    }
+    ResetIntervalStats();
+    m_streamingStart = now;
+    m_streamingEvent =
+        Simulator::Schedule(m_streamingInterval, &FlowMonitor::StreamFlowStats, this);
 }
 
 void
@@ -421,6 +635,64 @@ FlowMonitor::AddFlowClassifier(Ptr<FlowClassifier> classifier)
     m_classifiers.push_back(classifier);
 }
 
+void
+FlowMonitor::SerializeFlowStatsToXmlStream(std::ostream& os,
+                                           uint16_t indent,
+                                           FlowId flowId,
+                                           const FlowStats& flowStats,
+                                           bool enableHistograms)
+{
+    os << std::string(indent, ' ');
+#define ATTRIB(name) " " #name "=\"" << flowStats.name << "\""
+#define ATTRIB_TIME(name) " " #name "=\"" << flowStats.name.As(Time::NS) << "\""
+    os << "<Flow";
+    os << " flowId=\"" << flowId << "\"";
+    os << ATTRIB_TIME(timeFirstTxPacket);
+    os << ATTRIB_TIME(timeFirstRxPacket);
+    os << ATTRIB_TIME(timeLastTxPacket);
+    os << ATTRIB_TIME(timeLastRxPacket);
+    os << ATTRIB_TIME(delaySum);
+    os << ATTRIB_TIME(jitterSum);
+    os << ATTRIB_TIME(lastDelay);
+    os << ATTRIB_TIME(maxDelay);
+    os << ATTRIB_TIME(minDelay);
+    os << ATTRIB(txBytes);
+    os << ATTRIB(rxBytes);
+    os << ATTRIB(txPackets);
+    os << ATTRIB(rxPackets);
+    os << ATTRIB(lostPackets);
+    os << ATTRIB(timesForwarded);
+    os << ">\n";
+#undef ATTRIB_TIME
+#undef ATTRIB
+
+    indent += 2;
+    for (uint32_t reasonCode = 0; reasonCode < flowStats.packetsDropped.size(); reasonCode++)
+    {
+        os << std::string(indent, ' ');
+        os << "<packetsDropped reasonCode=\"" << reasonCode << "\""
+           << " number=\"" << flowStats.packetsDropped[reasonCode] << "\" />\n";
+    }
+    for (uint32_t reasonCode = 0; reasonCode < flowStats.bytesDropped.size(); reasonCode++)
+    {
+        os << std::string(indent, ' ');
+        os << "<bytesDropped reasonCode=\"" << reasonCode << "\""
+           << " bytes=\"" << flowStats.bytesDropped[reasonCode] << "\" />\n";
+    }
+    if (enableHistograms)
+    {
+        flowStats.delayHistogram.SerializeToXmlStream(os, indent, "delayHistogram");
+        flowStats.jitterHistogram.SerializeToXmlStream(os, indent, "jitterHistogram");
+        flowStats.packetSizeHistogram.SerializeToXmlStream(os, indent, "packetSizeHistogram");
+        flowStats.flowInterruptionsHistogram.SerializeToXmlStream(os,
+                                                                  indent,
+                                                                  "flowInterruptionsHistogram");
+    }
+    indent -= 2;
+
+    os << std::string(indent, ' ') << "</Flow>\n";
+}
+
 void
 FlowMonitor::SerializeToXmlStream(std::ostream& os,
                                   uint16_t indent,
@@ -436,55 +708,7 @@ FlowMonitor::SerializeToXmlStream(std::ostream& os,
     indent += 2;
     for (const auto& [flowId, flowStats] : m_flowStats)
     {
-        os << std::string(indent, ' ');
-#define ATTRIB(name) " " #name "=\"" << flowStats.name << "\""
-#define ATTRIB_TIME(name) " " #name "=\"" << flowStats.name.As(Time::NS) << "\""
-        os << "<Flow";
-        os << " flowId=\"" << flowId << "\"";
-        os << ATTRIB_TIME(timeFirstTxPacket);
-        os << ATTRIB_TIME(timeFirstRxPacket);
-        os << ATTRIB_TIME(timeLastTxPacket);
-        os << ATTRIB_TIME(timeLastRxPacket);
-        os << ATTRIB_TIME(delaySum);
-        os << ATTRIB_TIME(jitterSum);
-        os << ATTRIB_TIME(lastDelay);
-        os << ATTRIB_TIME(maxDelay);
-        os << ATTRIB_TIME(minDelay);
-        os << ATTRIB(txBytes);
-        os << ATTRIB(rxBytes);
-        os << ATTRIB(txPackets);
-        os << ATTRIB(rxPackets);
-        os << ATTRIB(lostPackets);
-        os << ATTRIB(timesForwarded);
-        os << ">\n";
-#undef ATTRIB_TIME
-#undef ATTRIB
-
-        indent += 2;
-        for (uint32_t reasonCode = 0; reasonCode < flowStats.packetsDropped.size(); reasonCode++)
-        {
-            os << std::string(indent, ' ');
-            os << "<packetsDropped reasonCode=\"" << reasonCode << "\""
-               << " number=\"" << flowStats.packetsDropped[reasonCode] << "\" />\n";
-        }
-        for (uint32_t reasonCode = 0; reasonCode < flowStats.bytesDropped.size(); reasonCode++)
-        {
-            os << std::string(indent, ' ');
-            os << "<bytesDropped reasonCode=\"" << reasonCode << "\""
-               << " bytes=\"" << flowStats.bytesDropped[reasonCode] << "\" />\n";
-        }
-        if (enableHistograms)
-        {
-            flowStats.delayHistogram.SerializeToXmlStream(os, indent, "delayHistogram");
-            flowStats.jitterHistogram.SerializeToXmlStream(os, indent, "jitterHistogram");
-            flowStats.packetSizeHistogram.SerializeToXmlStream(os, indent, "packetSizeHistogram");
-            flowStats.flowInterruptionsHistogram.SerializeToXmlStream(os,
-                                                                      indent,
-                                                                      "flowInterruptionsHistogram");
-        }
-        indent -= 2;
-
-        os << std::string(indent, ' ') << "</Flow>\n";
+        SerializeFlowStatsToXmlStream(os, indent, flowId, flowStats, enableHistograms);
     }
     indent -= 2;
     os << std::string(indent, ' ') << "</FlowStats>\n";
@@ -534,14 +758,31 @@ FlowMonitor::ResetAllStats()
 {
     NS_LOG_FUNCTION(this);
 
+    for (auto& iter : m_flowStats)
+    {
+        iter.second.lastDelay = Seconds(0);
+    }
+    ResetIntervalStats();
+    // the first packets received after the reset have no jitter
+    m_rxFlows.clear();
+}
+
+void
+FlowMonitor::ResetIntervalStats()
+{
+    NS_LOG_FUNCTION(this);
+
     for (auto& iter : m_flowStats)
     {
         auto& flowStat = iter.second;
+        if (flowStat.rxPackets > 0)
+        {
+            m_rxFlows.insert(iter.first);
+        }
         flowStat.delaySum = Seconds(0);
         flowStat.jitterSum = Seconds(0);
-        flowStat.lastDelay = Seconds(0);
         flowStat.maxDelay = Seconds(0);
-        flowStat.minDelay = Seconds(std::numeric_limits<double>::max());
+        flowStat.minDelay = Time::Max();
         flowStat.txBytes = 0;
         flowStat.rxBytes = 0;
         flowStat.txPackets = 0;
@@ -17,10 +17,15 @@
 #include "ns3/nstime.h"
 #include "ns3/object.h"
 #include "ns3/ptr.h"
+#include "ns3/traced-callback.h"
 
+#include <fstream>
 #include <map>
+#include <set>
 #include <vector>
 
+class FlowMonitorTrackedPacketTableTest;
+
 namespace ns3
 {
 
@@ -39,6 +44,9 @@ namespace ns3
  */
 class FlowMonitor : public Object
 {
+    /// allow FlowMonitorTrackedPacketTableTest class access
+    friend class ::FlowMonitorTrackedPacketTableTest;
+
   public:
     /// @brief Structure that represents the measured metrics of an individual packet flow
     struct FlowStats
@@ -103,7 +111,8 @@ class FlowMonitor : public Object
         /// forwarded, summed for all received packets in the flow
         uint32_t timesForwarded;
 
-        /// Histogram of the packet delays
+        /// Histogram of the packet delays; the histograms stay empty, and hence
+        /// do not allocate any bin, unless the EnableHistograms attribute is true
         Histogram delayHistogram;
         /// Histogram of the packet jitters
         Histogram jitterHistogram;
@@ -269,6 +278,15 @@ class FlowMonitor : public Object
     /// Reset all the statistics
     void ResetAllStats();
 
+    /**
+     * TracedCallback signature for the statistics of the flows over an interval.
+     *
+     * @param [in] start The start of the interval.
+     * @param [in] flowId The flow identification.
+     * @param [in] stats The statistics of the flow over the interval.
+     */
+    typedef void (*FlowStatsDeltaCallback)(Time start, FlowId flowId, const FlowStats& stats);
+
   protected:
     void NotifyConstructionCompleted() override;
     void DoDispose() override;
@@ -282,12 +300,103 @@ class FlowMonitor : public Object
         uint32_t timesForwarded; //!< number of times the packet was reportedly forwarded
     };
 
+    /// Open addressing hash table of the tracked packets, with linear probing
+    class TrackedPacketTable
+    {
+        /// allow FlowMonitorTrackedPacketTableTest class access
+        friend class ::FlowMonitorTrackedPacketTableTest;
+
+      public:
+        /// Slot of the table
+        struct Slot
+        {
+            TrackedPacket packet;  //!< the tracked packet
+            FlowId flowId;         //!< flow of the packet
+            FlowPacketId packetId; //!< identification of the packet in the flow
+            bool used;             //!< whether the slot holds a packet
+        };
+
+        TrackedPacketTable();
+
+        /// Allocate the slots for a number of packets
+        /// @param n the number of packets
+        void Reserve(std::size_t n);
+        /// Find a packet
+        /// @param flowId the flow of the packet
+        /// @param packetId the identification of the packet in the flow
+        /// @returns the slot of the packet, or nullptr if not found
+        Slot* Find(FlowId flowId, FlowPacketId packetId);
+        /// Find a packet, or insert it if not found
+        /// @param flowId the flow of the packet
+        /// @param packetId the identification of the packet in the flow
+        /// @returns the slot of the packet, whose other slots may have moved
+        Slot& Insert(FlowId flowId, FlowPacketId packetId);
+        /// Remove a packet, moving other slots
+        /// @param slot the slot of the packet
+        void Erase(Slot& slot);
+
+        /// Remove the packets matching a predicate
+        /// @param pred the predicate, called with each slot in use
+        template <typename Predicate>
+        void EraseIf(Predicate pred)
+        {
+            for (std::size_t i = 0; i < m_slots.size();)
+            {
+                // Erasing moves the next slots of the same cluster to i, which
+                // must then be checked again
+                if (m_slots[i].used && pred(m_slots[i]))
+                {
+                    Erase(m_slots[i]);
+                }
+                else
+                {
+                    ++i;
+                }
+            }
+        }
+
+        /// @returns the number of tracked packets
+        std::size_t GetSize() const;
+
+      private:
+        /// Get the index of the first slot to probe for a packet
+        /// @param flowId the flow of the packet
+        /// @param packetId the identification of the packet in the flow
+        /// @returns the slot index
+        std::size_t GetHome(FlowId flowId, FlowPacketId packetId) const;
+        /// Reallocate the slots
+        /// @param capacity the number of slots, a power of two
+        void Rehash(std::size_t capacity);
+
+        std::vector<Slot> m_slots; //!< the slots
+        std::size_t m_size;        //!< number of slots in use
+        uint32_t m_shift;          //!< shift of the hash giving the home slot index
+    };
+
+    /// Write the statistics of a flow in XML format
+    /// @param os the output stream
+    /// @param indent number of spaces to use as base indentation level
+    /// @param flowId the flow identification
+    /// @param flowStats the flow statistics
+    /// @param enableHistograms if true, include also the histograms in the output
+    static void SerializeFlowStatsToXmlStream(std::ostream& os,
+                                              uint16_t indent,
+                                              FlowId flowId,
+                                              const FlowStats& flowStats,
+                                              bool enableHistograms);
+
+    /// Report the statistics accumulated since the previous interval, and reset them
+    void StreamFlowStats();
+
+    /// Reset the statistics accumulated over the current interval, keeping the
+    /// delay and the time of the last packet received by each flow
+    void ResetIntervalStats();
+
     /// FlowId --> FlowStats
     FlowStatsContainer m_flowStats;
 
-    /// (FlowId,PacketId) --> TrackedPacket
-    typedef std::map<std::pair<FlowId, FlowPacketId>, TrackedPacket> TrackedPacketMap;
-    TrackedPacketMap m_trackedPackets; //!< Tracked packets
+    TrackedPacketTable m_trackedPackets; //!< Tracked packets
+    uint32_t m_trackedPacketsCapacity;   //!< Initial capacity of the tracked packet table
     Time m_maxPerHopDelay;             //!< Minimum per-hop delay
     FlowProbeContainer m_flowProbes;   //!< all the FlowProbes
 
@@ -302,6 +411,18 @@ class FlowMonitor : public Object
     double m_packetSizeBinWidth;        //!< packet size bin width (for histograms)
     double m_flowInterruptionsBinWidth; //!< Flow interruptions bin width (for histograms)
     Time m_flowInterruptionsMinTime;    //!< Flow interruptions minimum time
+    bool m_enableHistograms;            //!< Fill the histograms of the flows
+
+    Time m_streamingInterval;    //!< Interval of the reports of the statistics, 0 if disabled
+    std::string m_streamingFile; //!< Name of the file of the reports of the statistics
+    std::ofstream m_streamingOs; //!< Output stream of the reports of the statistics
+    Time m_streamingStart;       //!< Start of the current streaming interval
+    EventId m_streamingEvent;    //!< Next report of the statistics
+    /// Flows that received packets before the current interval
+    std::set<FlowId> m_rxFlows;
+
+    /// Statistics of the flows over an interval, when streaming
+    TracedCallback<Time, FlowId, const FlowStats&> m_flowStatsDeltaTrace;
 
     /// Get the stats for a given flow
     /// @param flowId the Flow identification
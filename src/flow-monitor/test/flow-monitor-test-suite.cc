@@ -0,0 +1,429 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/double.h"
+#include "ns3/flow-monitor.h"
+#include "ns3/flow-probe.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+
+#include <fstream>
+#include <map>
+#include <set>
+#include <string>
+#include <unordered_map>
+
+/**
+ * @defgroup flow-monitor-test FlowMonitor module tests
+ * @ingroup flow-monitor
+ * @ingroup tests
+ */
+
+using namespace ns3;
+
+/**
+ * @ingroup flow-monitor-test
+ *
+ * @brief Check the table of the tracked packets of FlowMonitor against a std::unordered_map
+ *
+ * Packets are randomly inserted, updated and erased, one at a time and through EraseIf, in a
+ * table that starts with 8 slots and is hence rehashed several times. The few packet
+ * identifiers make the clusters of slots wrap around the end of the table, which is checked.
+ */
+class FlowMonitorTrackedPacketTableTest : public TestCase
+{
+  public:
+    FlowMonitorTrackedPacketTableTest();
+
+  private:
+    void DoRun() override;
+
+    /// The table of the tracked packets
+    using Table = FlowMonitor::TrackedPacketTable;
+    /// The reference of the table: the number of times each packet was forwarded
+    using Reference = std::unordered_map<uint64_t, uint32_t>;
+
+    /**
+     * @param flowId the flow of the packet
+     * @param packetId the identification of the packet in the flow
+     * @return the key of the packet in the reference
+     */
+    static uint64_t GetKey(FlowId flowId, FlowPacketId packetId);
+
+    /**
+     * Check that the table holds the same packets as the reference
+     * @param table the table
+     * @param reference the reference
+     * @param step the number of operations so far
+     */
+    void Check(Table& table, const Reference& reference, uint32_t step);
+
+    static constexpr uint32_t N_FLOWS = 3;    //!< number of flows
+    static constexpr uint32_t N_PACKETS = 40; //!< number of packets per flow
+};
+
+FlowMonitorTrackedPacketTableTest::FlowMonitorTrackedPacketTableTest()
+    : TestCase("Check the tracked packet table against a std::unordered_map")
+{
+}
+
+uint64_t
+FlowMonitorTrackedPacketTableTest::GetKey(FlowId flowId, FlowPacketId packetId)
+{
+    return (static_cast<uint64_t>(flowId) << 32) | packetId;
+}
+
+void
+FlowMonitorTrackedPacketTableTest::Check(Table& table, const Reference& reference, uint32_t step)
+{
+    NS_TEST_ASSERT_MSG_EQ(table.GetSize(), reference.size(), "Unexpected size at step " << step);
+    for (FlowId flowId = 1; flowId <= N_FLOWS; ++flowId)
+    {
+        for (FlowPacketId packetId = 0; packetId < N_PACKETS; ++packetId)
+        {
+            auto slot = table.Find(flowId, packetId);
+            auto it = reference.find(GetKey(flowId, packetId));
+            NS_TEST_ASSERT_MSG_EQ((slot != nullptr),
+                                  (it != reference.end()),
+                                  "Packet " << packetId << " of flow " << flowId
+                                            << " unexpectedly (not) found at step " << step);
+            if (slot != nullptr)
+            {
+                NS_TEST_ASSERT_MSG_EQ(slot->packet.timesForwarded,
+                                      it->second,
+                                      "Unexpected packet at step " << step);
+            }
+        }
+    }
+}
+
+void
+FlowMonitorTrackedPacketTableTest::DoRun()
+{
+    auto rng = CreateObject<UniformRandomVariable>();
+    rng->SetStream(1);
+
+    Table table;
+    table.Reserve(4);
+    Reference reference;
+    uint32_t wraparounds = 0;
+    uint32_t rehashes = 0;
+    uint32_t eraseIfs = 0;
+
+    for (uint32_t step = 0; step < 20000; ++step)
+    {
+        const FlowId flowId = rng->GetInteger(1, N_FLOWS);
+        const FlowPacketId packetId = rng->GetInteger(0, N_PACKETS - 1);
+        const auto op = rng->GetInteger(0, 99);
+        const auto capacity = table.m_slots.size();
+
+        if (op == 0)
+        {
+            // erase the packets forwarded an odd number of times
+            auto odd = [](uint32_t timesForwarded) { return timesForwarded % 2 == 1; };
+            table.EraseIf(
+                [odd](const Table::Slot& slot) { return odd(slot.packet.timesForwarded); });
+            std::erase_if(reference, [odd](const auto& item) { return odd(item.second); });
+            ++eraseIfs;
+        }
+        else if (op < 60)
+        {
+            // insert a packet, or update it if it is already tracked
+            auto& slot = table.Insert(flowId, packetId);
+            auto [it, inserted] = reference.try_emplace(GetKey(flowId, packetId), 0);
+            slot.packet.timesForwarded = inserted ? 0 : slot.packet.timesForwarded + 1;
+            it->second = inserted ? 0 : it->second + 1;
+        }
+        else
+        {
+            auto slot = table.Find(flowId, packetId);
+            if (slot != nullptr)
+            {
+                table.Erase(*slot);
+            }
+            reference.erase(GetKey(flowId, packetId));
+        }
+
+        if (table.m_slots.size() != capacity)
+        {
+            ++rehashes;
+        }
+        if (table.m_slots.front().used && table.m_slots.back().used)
+        {
+            ++wraparounds;
+        }
+        Check(table, reference, step);
+    }
+
+    NS_TEST_EXPECT_MSG_GT(rehashes, 1, "The table should have been rehashed");
+    NS_TEST_EXPECT_MSG_GT(wraparounds, 0, "No cluster wrapped around the end of the table");
+    NS_TEST_EXPECT_MSG_GT(eraseIfs, 0, "EraseIf should have been called");
+}
+
+/**
+ * @ingroup flow-monitor-test
+ *
+ * @brief A probe reporting packets to a FlowMonitor on request
+ */
+class FlowMonitorTestProbe : public FlowProbe
+{
+  public:
+    /**
+     * Constructor
+     * @param flowMonitor the FlowMonitor the probe reports to
+     */
+    FlowMonitorTestProbe(Ptr<FlowMonitor> flowMonitor)
+        : FlowProbe(flowMonitor)
+    {
+    }
+};
+
+/**
+ * @ingroup flow-monitor-test
+ *
+ * @brief Check that the statistics streamed over intervals add up to the statistics of a run
+ * without streaming
+ *
+ * The same packets, with varying delays and some losses, are reported to a FlowMonitor with
+ * a streaming interval and to one without. The sums of the statistics reported through the
+ * FlowStatsDelta trace and of the statistics of the last partial interval must be those of the
+ * monitor without streaming, including the jitter of the first packet of each interval, and the
+ * streamed XML file must have one element per interval.
+ */
+class FlowMonitorStreamingTest : public TestCase
+{
+  public:
+    FlowMonitorStreamingTest();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Send a packet, reported to both monitors
+     * @param flowId the flow of the packet
+     * @param packetId the identification of the packet in the flow
+     * @param delay the delay of the packet, or a negative delay if the packet is dropped
+     */
+    void Send(FlowId flowId, FlowPacketId packetId, Time delay);
+
+    /**
+     * Receive a packet, reported to both monitors
+     * @param flowId the flow of the packet
+     * @param packetId the identification of the packet in the flow
+     */
+    void Receive(FlowId flowId, FlowPacketId packetId);
+
+    /**
+     * Drop a packet, reported to both monitors
+     * @param flowId the flow of the packet
+     * @param packetId the identification of the packet in the flow
+     */
+    void Drop(FlowId flowId, FlowPacketId packetId);
+
+    /**
+     * Accumulate the statistics of a flow over an interval
+     * @param start the start of the interval
+     * @param flowId the flow identification
+     * @param stats the statistics of the flow over the interval
+     */
+    void FlowStatsDelta(Time start, FlowId flowId, const FlowMonitor::FlowStats& stats);
+
+    /**
+     * Add the statistics of a flow over an interval to the sum of the intervals
+     * @param flowId the flow identification
+     * @param stats the statistics of the flow over the interval
+     */
+    void Accumulate(FlowId flowId, const FlowMonitor::FlowStats& stats);
+
+    static constexpr uint32_t PACKET_SIZE = 100; //!< size of the packets
+
+    Ptr<FlowMonitor> m_streaming;    //!< the monitor with a streaming interval
+    Ptr<FlowMonitor> m_total;        //!< the monitor without streaming
+    Ptr<FlowProbe> m_streamingProbe; //!< the probe of the monitor with streaming
+    Ptr<FlowProbe> m_totalProbe;     //!< the probe of the monitor without streaming
+    std::map<FlowId, FlowMonitor::FlowStats> m_sums; //!< the sums of the streamed statistics
+    std::set<Time> m_intervals;                      //!< the start of the streamed intervals
+};
+
+FlowMonitorStreamingTest::FlowMonitorStreamingTest()
+    : TestCase("Check that the streamed statistics add up to the total statistics")
+{
+}
+
+void
+FlowMonitorStreamingTest::Send(FlowId flowId, FlowPacketId packetId, Time delay)
+{
+    m_streaming->ReportFirstTx(m_streamingProbe, flowId, packetId, PACKET_SIZE);
+    m_total->ReportFirstTx(m_totalProbe, flowId, packetId, PACKET_SIZE);
+    if (delay.IsNegative())
+    {
+        Simulator::Schedule(MilliSeconds(1),
+                            &FlowMonitorStreamingTest::Drop,
+                            this,
+                            flowId,
+                            packetId);
+    }
+    else
+    {
+        Simulator::Schedule(delay, &FlowMonitorStreamingTest::Receive, this, flowId, packetId);
+    }
+}
+
+void
+FlowMonitorStreamingTest::Receive(FlowId flowId, FlowPacketId packetId)
+{
+    m_streaming->ReportLastRx(m_streamingProbe, flowId, packetId, PACKET_SIZE);
+    m_total->ReportLastRx(m_totalProbe, flowId, packetId, PACKET_SIZE);
+}
+
+void
+FlowMonitorStreamingTest::Drop(FlowId flowId, FlowPacketId packetId)
+{
+    m_streaming->ReportDrop(m_streamingProbe, flowId, packetId, PACKET_SIZE, 0);
+    m_total->ReportDrop(m_totalProbe, flowId, packetId, PACKET_SIZE, 0);
+}
+
+void
+FlowMonitorStreamingTest::FlowStatsDelta(Time start,
+                                         FlowId flowId,
+                                         const FlowMonitor::FlowStats& stats)
+{
+    m_intervals.insert(start);
+    Accumulate(flowId, stats);
+}
+
+void
+FlowMonitorStreamingTest::Accumulate(FlowId flowId, const FlowMonitor::FlowStats& stats)
+{
+    auto [it, inserted] = m_sums.try_emplace(flowId, stats);
+    if (inserted)
+    {
+        return;
+    }
+    auto& sum = it->second;
+    sum.delaySum += stats.delaySum;
+    sum.jitterSum += stats.jitterSum;
+    sum.maxDelay = Max(sum.maxDelay, stats.maxDelay);
+    sum.minDelay = Min(sum.minDelay, stats.minDelay);
+    sum.txBytes += stats.txBytes;
+    sum.rxBytes += stats.rxBytes;
+    sum.txPackets += stats.txPackets;
+    sum.rxPackets += stats.rxPackets;
+    sum.lostPackets += stats.lostPackets;
+    sum.lastDelay = stats.rxPackets > 0 ? stats.lastDelay : sum.lastDelay;
+    sum.timeLastRxPacket = stats.rxPackets > 0 ? stats.timeLastRxPacket : sum.timeLastRxPacket;
+}
+
+void
+FlowMonitorStreamingTest::DoRun()
+{
+    const auto fileName = CreateTempDirFilename("flow-monitor-streaming.xml");
+    m_streaming = CreateObjectWithAttributes<FlowMonitor>("StreamingInterval",
+                                                          TimeValue(Seconds(1)),
+                                                          "StreamingFileName",
+                                                          StringValue(fileName));
+    m_total = CreateObject<FlowMonitor>();
+    m_streamingProbe = CreateObject<FlowMonitorTestProbe>(m_streaming);
+    m_totalProbe = CreateObject<FlowMonitorTestProbe>(m_total);
+    m_streaming->TraceConnectWithoutContext(
+        "FlowStatsDelta",
+        MakeCallback(&FlowMonitorStreamingTest::FlowStatsDelta, this));
+
+    // two flows with varying delays, whose packets cross the boundaries of the intervals;
+    // every tenth packet of the second flow is dropped
+    auto rng = CreateObject<UniformRandomVariable>();
+    rng->SetStream(2);
+    for (FlowPacketId packetId = 0; packetId < 400; ++packetId)
+    {
+        const auto delay1 = MicroSeconds(rng->GetInteger(1000, 50000));
+        Simulator::Schedule(MilliSeconds(25 * packetId),
+                            &FlowMonitorStreamingTest::Send,
+                            this,
+                            1,
+                            packetId,
+                            delay1);
+    }
+    for (FlowPacketId packetId = 0; packetId < 250; ++packetId)
+    {
+        const auto delay2 =
+            packetId % 10 == 9 ? MicroSeconds(-1) : MicroSeconds(rng->GetInteger(1000, 50000));
+        Simulator::Schedule(MilliSeconds(40 * packetId + 7),
+                            &FlowMonitorStreamingTest::Send,
+                            this,
+                            2,
+                            packetId,
+                            delay2);
+    }
+
+    Simulator::Stop(Seconds(10.5));
+    Simulator::Run();
+
+    // the statistics of the last partial interval
+    for (const auto& [flowId, stats] : m_streaming->GetFlowStats())
+    {
+        Accumulate(flowId, stats);
+    }
+    NS_TEST_EXPECT_MSG_EQ(m_intervals.size(), 10, "Unexpected number of intervals");
+
+    const auto& totals = m_total->GetFlowStats();
+    NS_TEST_ASSERT_MSG_EQ(m_sums.size(), totals.size(), "Unexpected number of flows");
+    for (const auto& [flowId, total] : totals)
+    {
+        const auto& sum = m_sums[flowId];
+        NS_TEST_EXPECT_MSG_EQ(sum.txPackets, total.txPackets, "Flow " << flowId);
+        NS_TEST_EXPECT_MSG_EQ(sum.rxPackets, total.rxPackets, "Flow " << flowId);
+        NS_TEST_EXPECT_MSG_EQ(sum.lostPackets, total.lostPackets, "Flow " << flowId);
+        NS_TEST_EXPECT_MSG_EQ(sum.txBytes, total.txBytes, "Flow " << flowId);
+        NS_TEST_EXPECT_MSG_EQ(sum.rxBytes, total.rxBytes, "Flow " << flowId);
+        NS_TEST_EXPECT_MSG_EQ(sum.delaySum, total.delaySum, "Flow " << flowId);
+        NS_TEST_EXPECT_MSG_EQ(sum.jitterSum, total.jitterSum, "Flow " << flowId);
+        NS_TEST_EXPECT_MSG_EQ(sum.maxDelay, total.maxDelay, "Flow " << flowId);
+        NS_TEST_EXPECT_MSG_EQ(sum.minDelay, total.minDelay, "Flow " << flowId);
+        NS_TEST_EXPECT_MSG_EQ(sum.lastDelay, total.lastDelay, "Flow " << flowId);
+        NS_TEST_EXPECT_MSG_EQ(sum.timeLastRxPacket, total.timeLastRxPacket, "Flow " << flowId);
+    }
+    NS_TEST_EXPECT_MSG_EQ(totals.at(2).lostPackets, 25, "Unexpected number of dropped packets");
+
+    m_streaming->Dispose();
+    m_total->Dispose();
+    m_streaming = nullptr;
+    m_total = nullptr;
+    m_streamingProbe = nullptr;
+    m_totalProbe = nullptr;
+    Simulator::Destroy();
+
+    // one element per interval in the streamed file
+    std::ifstream file(fileName);
+    NS_TEST_ASSERT_MSG_EQ(file.is_open(), true, "Could not open " << fileName);
+    std::string line;
+    uint32_t intervals = 0;
+    uint32_t flows = 0;
+    while (std::getline(file, line))
+    {
+        intervals += line.find("<Interval ") != std::string::npos;
+        flows += line.find("<Flow ") != std::string::npos;
+    }
+    NS_TEST_EXPECT_MSG_EQ(intervals, 10, "Unexpected number of intervals in the file");
+    NS_TEST_EXPECT_MSG_EQ(flows, 20, "Unexpected number of flows in the file");
+}
+
+/**
+ * @ingroup flow-monitor-test
+ *
+ * @brief FlowMonitor TestSuite
+ */
+class FlowMonitorTestSuite : public TestSuite
+{
+  public:
+    FlowMonitorTestSuite()
+        : TestSuite("flow-monitor", Type::UNIT)
+    {
+        AddTestCase(new FlowMonitorTrackedPacketTableTest(), TestCase::Duration::QUICK);
+        AddTestCase(new FlowMonitorStreamingTest(), TestCase::Duration::QUICK);
+    }
+};
+
+static FlowMonitorTestSuite g_flowMonitorTestSuite; //!< Static variable for test initialization
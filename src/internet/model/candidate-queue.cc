@@ -47,20 +47,22 @@ operator<<(std::ostream& os, const SPFVertex::VertexType& t)
 std::ostream&
 operator<<(std::ostream& os, const CandidateQueue& q)
 {
-    const CandidateQueue::CandidateList_t& list = q.m_candidates;
+    auto list = q.m_heap;
+    std::sort(list.begin(), list.end(), &CandidateQueue::Before);
 
     os << "*** CandidateQueue Begin (<id, distance, LSA-type>) ***" << std::endl;
-    for (auto iter = list.begin(); iter != list.end(); iter++)
+    for (const auto& c : list)
     {
-        os << "<" << (*iter)->GetVertexId() << ", " << (*iter)->GetDistanceFromRoot() << ", "
-           << (*iter)->GetVertexType() << ">" << std::endl;
+        os << "<" << c.vertex->GetVertexId() << ", " << c.vertex->GetDistanceFromRoot() << ", "
+           << c.vertex->GetVertexType() << ">" << std::endl;
     }
     os << "*** CandidateQueue End ***";
     return os;
 }
 
 CandidateQueue::CandidateQueue()
-    : m_candidates()
+    : m_heap(),
+      m_positions()
 {
     NS_LOG_FUNCTION(this);
 }
@@ -75,12 +77,12 @@ void
 CandidateQueue::Clear()
 {
     NS_LOG_FUNCTION(this);
-    while (!m_candidates.empty())
+    for (const auto& c : m_heap)
     {
-        SPFVertex* p = Pop();
-        delete p;
-        p = nullptr;
+        delete c.vertex;
     }
+    m_heap.clear();
+    m_positions.clear();
 }
 
 void
@@ -88,24 +90,31 @@ CandidateQueue::Push(SPFVertex* vNew)
 {
     NS_LOG_FUNCTION(this << vNew);
 
-    auto i = std::upper_bound(m_candidates.begin(),
-                              m_candidates.end(),
-                              vNew,
-                              &CandidateQueue::CompareSPFVertex);
-    m_candidates.insert(i, vNew);
+    NS_ASSERT_MSG(m_positions.find(vNew->GetVertexId()) == m_positions.end(),
+                  "Vertex " << vNew->GetVertexId() << " already in the candidate queue");
+    m_heap.push_back({vNew, m_order++});
+    m_positions[vNew->GetVertexId()] = m_heap.size() - 1;
+    SiftUp(m_heap.size() - 1);
 }
 
 SPFVertex*
 CandidateQueue::Pop()
 {
     NS_LOG_FUNCTION(this);
-    if (m_candidates.empty())
+    if (m_heap.empty())
     {
         return nullptr;
     }
 
-    SPFVertex* v = m_candidates.front();
-    m_candidates.pop_front();
+    SPFVertex* v = m_heap.front().vertex;
+    m_positions.erase(v->GetVertexId());
+    Candidate last = m_heap.back();
+    m_heap.pop_back();
+    if (!m_heap.empty())
+    {
+        Place(0, last);
+        SiftDown(0);
+    }
     return v;
 }
 
@@ -113,44 +122,49 @@ SPFVertex*
 CandidateQueue::Top() const
 {
     NS_LOG_FUNCTION(this);
-    if (m_candidates.empty())
+    if (m_heap.empty())
     {
         return nullptr;
     }
 
-    return m_candidates.front();
+    return m_heap.front().vertex;
 }
 
 bool
 CandidateQueue::Empty() const
 {
     NS_LOG_FUNCTION(this);
-    return m_candidates.empty();
+    return m_heap.empty();
 }
 
 uint32_t
 CandidateQueue::Size() const
 {
     NS_LOG_FUNCTION(this);
-    return m_candidates.size();
+    return m_heap.size();
 }
 
 SPFVertex*
 CandidateQueue::Find(const Ipv4Address addr) const
 {
     NS_LOG_FUNCTION(this);
-    auto i = m_candidates.begin();
-
-    for (; i != m_candidates.end(); i++)
+    auto it = m_positions.find(addr);
+    if (it == m_positions.end())
     {
-        SPFVertex* v = *i;
-        if (v->GetVertexId() == addr)
-        {
-            return v;
-        }
+        return nullptr;
     }
+    return m_heap[it->second].vertex;
+}
 
-    return nullptr;
+void
+CandidateQueue::Update(SPFVertex* v)
+{
+    NS_LOG_FUNCTION(this << v);
+    auto it = m_positions.find(v->GetVertexId());
+    NS_ASSERT_MSG(it != m_positions.end() && m_heap[it->second].vertex == v,
+                  "Vertex " << v->GetVertexId() << " not in the candidate queue");
+    m_heap[it->second].order = m_order++;
+    SiftUp(it->second);
 }
 
 void
@@ -158,11 +172,64 @@ CandidateQueue::Reorder()
 {
     NS_LOG_FUNCTION(this);
 
-    m_candidates.sort(&CandidateQueue::CompareSPFVertex);
+    for (uint32_t pos = m_heap.size() / 2; pos-- > 0;)
+    {
+        SiftDown(pos);
+    }
     NS_LOG_LOGIC("After reordering the CandidateQueue");
     NS_LOG_LOGIC(*this);
 }
 
+void
+CandidateQueue::SiftUp(uint32_t pos)
+{
+    Candidate c = m_heap[pos];
+    while (pos > 0)
+    {
+        uint32_t parent = (pos - 1) / 2;
+        if (!Before(c, m_heap[parent]))
+        {
+            break;
+        }
+        Place(pos, m_heap[parent]);
+        pos = parent;
+    }
+    Place(pos, c);
+}
+
+void
+CandidateQueue::SiftDown(uint32_t pos)
+{
+    Candidate c = m_heap[pos];
+    const uint32_t size = m_heap.size();
+    while (true)
+    {
+        uint32_t child = 2 * pos + 1;
+        if (child >= size)
+        {
+            break;
+        }
+        if (child + 1 < size && Before(m_heap[child + 1], m_heap[child]))
+        {
+            child++;
+        }
+        if (!Before(m_heap[child], c))
+        {
+            break;
+        }
+        Place(pos, m_heap[child]);
+        pos = child;
+    }
+    Place(pos, c);
+}
+
+void
+CandidateQueue::Place(uint32_t pos, const Candidate& c)
+{
+    m_heap[pos] = c;
+    m_positions[c.vertex->GetVertexId()] = pos;
+}
+
 /*
  * In this implementation, SPFVertex follows the ordering where
  * a vertex is ranked first if its GetDistanceFromRoot () is smaller;
@@ -191,4 +258,14 @@ CandidateQueue::CompareSPFVertex(const SPFVertex* v1, const SPFVertex* v2)
     return result;
 }
 
+bool
+CandidateQueue::Before(const Candidate& c1, const Candidate& c2)
+{
+    if (CompareSPFVertex(c1.vertex, c2.vertex))
+    {
+        return true;
+    }
+    return !CompareSPFVertex(c2.vertex, c1.vertex) && c1.order < c2.order;
+}
+
 } // namespace ns3
@@ -11,8 +11,9 @@
 
 #include "ns3/ipv4-address.h"
 
-#include <list>
 #include <stdint.h>
+#include <unordered_map>
+#include <vector>
 
 namespace ns3
 {
@@ -34,9 +35,12 @@ class SPFVertex;
  * priority queue.
  *
  * Although a STL priority_queue almost does what we want, the requirement
- * for a Find () operation, the dynamic nature of the data and the derived
- * requirement for a Reorder () operation led us to implement this simple
- * enhanced priority queue.
+ * for a Find () operation and the dynamic nature of the data led us to
+ * implement this enhanced priority queue: a binary heap whose vertices are
+ * indexed by their IP address, so that Push (), Pop () and Update () take a
+ * logarithmic time and Find () a constant time.  Vertices at the same
+ * distance from the root are popped in the order they were pushed (or
+ * updated), networks first.
  */
 class CandidateQueue
 {
@@ -133,6 +137,18 @@ class CandidateQueue
      */
     SPFVertex* Find(const Ipv4Address addr) const;
 
+    /**
+     * @brief Restore the position of a vertex of the queue whose field
+     * m_distanceFromRoot has decreased.
+     *
+     * The vertex is ranked after the vertices already at the same distance
+     * from the root.
+     *
+     * @see SPFVertex
+     * @param v The Shortest Path First Vertex, which must be in the queue.
+     */
+    void Update(SPFVertex* v);
+
     /**
      * @brief Reorders the Candidate Queue according to the priority scheme.
      *
@@ -142,7 +158,8 @@ class CandidateQueue
      * increasing distance.
      *
      * This method is provided in case the values of m_distanceFromRoot change
-     * during the routing calculations.
+     * during the routing calculations.  Update () should be preferred when the
+     * distance of a single vertex decreases.
      *
      * @see SPFVertex
      */
@@ -162,8 +179,50 @@ class CandidateQueue
      */
     static bool CompareSPFVertex(const SPFVertex* v1, const SPFVertex* v2);
 
-    typedef std::list<SPFVertex*> CandidateList_t; //!< container of SPFVertex pointers
-    CandidateList_t m_candidates;                  //!< SPFVertex candidates
+    /// A vertex of the heap
+    struct Candidate
+    {
+        SPFVertex* vertex; //!< the vertex
+        uint64_t order;    //!< the rank of the vertex among the vertices at the same distance
+    };
+
+    /**
+     * @brief return true if c1 should be popped before c2
+     *
+     * @param c1 first operand
+     * @param c2 second operand
+     * @return True if c1 should be popped before c2; false otherwise
+     */
+    static bool Before(const Candidate& c1, const Candidate& c2);
+
+    /**
+     * @brief Move the candidate at the given position of the heap to the top
+     * as long as it should be popped before its parent.
+     *
+     * @param pos the position of the candidate
+     */
+    void SiftUp(uint32_t pos);
+
+    /**
+     * @brief Move the candidate at the given position of the heap to the bottom
+     * as long as one of its children should be popped before it.
+     *
+     * @param pos the position of the candidate
+     */
+    void SiftDown(uint32_t pos);
+
+    /**
+     * @brief Store a candidate at the given position of the heap.
+     *
+     * @param pos the position
+     * @param c the candidate
+     */
+    void Place(uint32_t pos, const Candidate& c);
+
+    std::vector<Candidate> m_heap; //!< SPFVertex candidates, as a binary heap
+    std::unordered_map<Ipv4Address, uint32_t, Ipv4AddressHash>
+        m_positions;     //!< the positions of the candidates in the heap, by vertex ID
+    uint64_t m_order{0}; //!< the rank of the next vertex pushed or updated
 
     /**
      * @brief Stream insertion operator.
@@ -0,0 +1,215 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef EXPIRING_SET_H
+#define EXPIRING_SET_H
+
+#include "ns3/assert.h"
+#include "ns3/nstime.h"
+
+#include <algorithm>
+#include <deque>
+#include <functional>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * @ingroup ipv4Routing
+ *
+ * @brief A set of keys that expire, suitable for duplicate detection in routing protocols.
+ *
+ * Each key is associated with an expiration time and, optionally, with a value.
+ * Keys are stored in a hash table, hence lookups take constant time regardless
+ * of the number of keys. Expiration times are kept in a queue sorted by
+ * increasing expiration time: when keys are inserted with non-decreasing
+ * expiration times (e.g., with a constant lifetime), inserting a key is a
+ * push at the back of the queue and purging the expired keys only visits
+ * the keys that actually expired.
+ *
+ * A key is expired at time t if its expiration time is strictly lower than t.
+ * Expired keys are not returned by Find() and Contains(), and they are removed
+ * by Purge().
+ *
+ * @tparam Key the type of the keys
+ * @tparam Value the type of the value associated with each key
+ * @tparam Hash the hash function for the keys
+ */
+template <typename Key, typename Value = std::monostate, typename Hash = std::hash<Key>>
+class ExpiringSet
+{
+  public:
+    /**
+     * Insert a key, or update the expiration time and the value of an existing key.
+     *
+     * @param key the key
+     * @param expire the expiration time of the key
+     * @param value the value associated with the key
+     * @return a reference to the value stored in the set
+     */
+    Value& Insert(const Key& key, Time expire, Value value = Value())
+    {
+        auto [it, inserted] = m_entries.try_emplace(key);
+        it->second.value = std::move(value);
+        if (!inserted && it->second.expire == expire)
+        {
+            return it->second.value;
+        }
+        // if the key was in the set, the item already in the queue for this key
+        // is discarded when popped
+        it->second.expire = expire;
+        Enqueue(key, expire);
+        return it->second.value;
+    }
+
+    /**
+     * Find a key that is not expired.
+     *
+     * @param key the key
+     * @param now the current time
+     * @return a pointer to the value associated with the key, or a null pointer
+     *         if the key is not in the set or is expired
+     */
+    Value* Find(const Key& key, Time now)
+    {
+        auto it = m_entries.find(key);
+        if (it == m_entries.end() || it->second.expire < now)
+        {
+            return nullptr;
+        }
+        return &it->second.value;
+    }
+
+    /**
+     * @param key the key
+     * @param now the current time
+     * @return true if the key is in the set and is not expired
+     */
+    bool Contains(const Key& key, Time now) const
+    {
+        auto it = m_entries.find(key);
+        return it != m_entries.end() && it->second.expire >= now;
+    }
+
+    /**
+     * @param key the key
+     * @return the expiration time of the key, which must be in the set
+     */
+    Time GetExpiration(const Key& key) const
+    {
+        auto it = m_entries.find(key);
+        NS_ASSERT_MSG(it != m_entries.end(), "Key not found");
+        return it->second.expire;
+    }
+
+    /**
+     * Remove a key from the set.
+     *
+     * @param key the key
+     * @return true if the key was in the set
+     */
+    bool Erase(const Key& key)
+    {
+        return m_entries.erase(key) != 0;
+    }
+
+    /**
+     * Remove all the keys that are expired.
+     *
+     * @param now the current time
+     */
+    void Purge(Time now)
+    {
+        while (!m_queue.empty() && m_queue.front().first < now)
+        {
+            auto it = m_entries.find(m_queue.front().second);
+            if (it != m_entries.end() && it->second.expire == m_queue.front().first)
+            {
+                m_entries.erase(it);
+            }
+            m_queue.pop_front();
+        }
+    }
+
+    /**
+     * @return the number of keys in the set, including the expired keys not purged yet
+     */
+    std::size_t GetSize() const
+    {
+        return m_entries.size();
+    }
+
+    /**
+     * @return true if the set contains no key
+     */
+    bool IsEmpty() const
+    {
+        return m_entries.empty();
+    }
+
+    /// Remove all the keys
+    void Clear()
+    {
+        m_entries.clear();
+        m_queue.clear();
+    }
+
+  private:
+    /// An expiration time and the key it refers to
+    using QueueItem = std::pair<Time, Key>;
+
+    /**
+     * Add an item to the expiration queue, keeping the queue sorted.
+     *
+     * @param key the key
+     * @param expire the expiration time of the key
+     */
+    void Enqueue(const Key& key, Time expire)
+    {
+        if (m_queue.size() > 2 * m_entries.size() + 16)
+        {
+            // too many items refer to erased or updated keys, rebuild the queue
+            m_queue.clear();
+            for (const auto& [k, entry] : m_entries)
+            {
+                m_queue.emplace_back(entry.expire, k);
+            }
+            std::sort(m_queue.begin(), m_queue.end(), [](const auto& a, const auto& b) {
+                return a.first < b.first;
+            });
+            return;
+        }
+        if (m_queue.empty() || !(expire < m_queue.back().first))
+        {
+            m_queue.emplace_back(expire, key);
+            return;
+        }
+        // the expiration time is earlier than the latest one, e.g., the lifetime was reduced
+        auto pos = std::upper_bound(m_queue.begin(),
+                                    m_queue.end(),
+                                    expire,
+                                    [](const Time& t, const QueueItem& item) {
+                                        return t < item.first;
+                                    });
+        m_queue.emplace(pos, expire, key);
+    }
+
+    /// The expiration time and the value associated with a key
+    struct Entry
+    {
+        Time expire; //!< the expiration time
+        Value value; //!< the value
+    };
+
+    std::unordered_map<Key, Entry, Hash> m_entries; //!< the keys
+    std::deque<QueueItem> m_queue; //!< the expiration times, sorted by increasing time
+};
+
+} // namespace ns3
+
+#endif /* EXPIRING_SET_H */
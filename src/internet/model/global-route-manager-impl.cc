@@ -19,13 +19,19 @@
 
 #include "ns3/assert.h"
 #include "ns3/fatal-error.h"
+#include "ns3/global-value.h"
 #include "ns3/log.h"
 #include "ns3/node-list.h"
 #include "ns3/simulator.h"
+#include "ns3/uinteger.h"
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <iostream>
+#include <limits>
 #include <queue>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -34,6 +40,19 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("GlobalRouteManagerImpl");
 
+/**
+ * @ingroup globalrouting
+ * @anchor GlobalValueGlobalRoutingThreads
+ * The number of threads computing the global routes, or 0 for the number
+ * of hardware threads.
+ */
+static GlobalValue g_globalRoutingThreads =
+    GlobalValue("GlobalRoutingThreads",
+                "The number of threads computing the global routes "
+                "(0 for the number of hardware threads)",
+                UintegerValue(1),
+                MakeUintegerChecker<uint32_t>());
+
 /**
  * @brief Stream insertion operator.
  *
@@ -104,7 +123,6 @@ SPFVertex::SPFVertex(GlobalRoutingLSA* lsa)
     {
         NS_LOG_LOGIC("Setting m_vertexType to VertexRouter");
         m_vertexType = SPFVertex::VertexRouter;
-        m_node = lsa->GetNode();
     }
     else if (lsa->GetLSType() == GlobalRoutingLSA::NetworkLSA)
     {
@@ -412,6 +430,12 @@ SPFVertex::GetNode() const
     return m_node;
 }
 
+void
+SPFVertex::SetNode(Ptr<Node> node)
+{
+    m_node = node;
+}
+
 // ---------------------------------------------------------------------------
 //
 // GlobalRouteManagerLSDB Implementation
@@ -448,11 +472,54 @@ void
 GlobalRouteManagerLSDB::Initialize()
 {
     NS_LOG_FUNCTION(this);
+    m_lsas.clear();
+    m_indices.clear();
+    // the LSA found by GetLSAByLinkData for each link data
+    std::unordered_map<Ipv4Address, uint32_t, Ipv4AddressHash> linkData;
     for (auto i = m_database.begin(); i != m_database.end(); i++)
     {
         GlobalRoutingLSA* temp = i->second;
         temp->SetStatus(GlobalRoutingLSA::LSA_SPF_NOT_EXPLORED);
+        for (uint32_t j = 0; j < temp->GetNLinkRecords(); j++)
+        {
+            GlobalRoutingLinkRecord* lr = temp->GetLinkRecord(j);
+            if (lr->GetLinkType() == GlobalRoutingLinkRecord::TransitNetwork)
+            {
+                linkData.emplace(lr->GetLinkData(), m_lsas.size());
+            }
+        }
+        m_indices[temp] = m_lsas.size();
+        m_lsas.push_back(temp);
+    }
+
+    m_firstLinks.clear();
+    m_links.clear();
+    for (GlobalRoutingLSA* temp : m_lsas)
+    {
+        m_firstLinks.push_back(m_links.size());
+        if (temp->GetLSType() == GlobalRoutingLSA::RouterLSA)
+        {
+            for (uint32_t j = 0; j < temp->GetNLinkRecords(); j++)
+            {
+                GlobalRoutingLinkRecord* lr = temp->GetLinkRecord(j);
+                auto it = m_database.end();
+                if (lr->GetLinkType() != GlobalRoutingLinkRecord::StubNetwork)
+                {
+                    it = m_database.find(lr->GetLinkId());
+                }
+                m_links.push_back(it == m_database.end() ? NO_LSA : m_indices[it->second]);
+            }
+        }
+        else if (temp->GetLSType() == GlobalRoutingLSA::NetworkLSA)
+        {
+            for (uint32_t j = 0; j < temp->GetNAttachedRouters(); j++)
+            {
+                auto it = linkData.find(temp->GetAttachedRouter(j));
+                m_links.push_back(it == linkData.end() ? NO_LSA : it->second);
+            }
+        }
     }
+    m_firstLinks.push_back(m_links.size());
 }
 
 void
@@ -490,12 +557,10 @@ GlobalRouteManagerLSDB::GetLSA(Ipv4Address addr) const
     //
     // Look up an LSA by its address.
     //
-    for (auto i = m_database.begin(); i != m_database.end(); i++)
+    auto i = m_database.find(addr);
+    if (i != m_database.end())
     {
-        if (i->first == addr)
-        {
-            return i->second;
-        }
+        return i->second;
     }
     return nullptr;
 }
@@ -531,16 +596,29 @@ GlobalRouteManagerLSDB::GetLSAByLinkData(Ipv4Address addr) const
 // ---------------------------------------------------------------------------
 
 GlobalRouteManagerImpl::GlobalRouteManagerImpl()
-    : m_spfroot(nullptr)
+    : m_spfroot(nullptr),
+      m_ownsLsdb(true),
+      m_routesValid(false),
+      m_nUpdatedRouters(0)
 {
     NS_LOG_FUNCTION(this);
     m_lsdb = new GlobalRouteManagerLSDB();
 }
 
+GlobalRouteManagerImpl::GlobalRouteManagerImpl(GlobalRouteManagerLSDB* lsdb)
+    : m_spfroot(nullptr),
+      m_lsdb(lsdb),
+      m_ownsLsdb(false),
+      m_routesValid(false),
+      m_nUpdatedRouters(0)
+{
+    NS_LOG_FUNCTION(this << lsdb);
+}
+
 GlobalRouteManagerImpl::~GlobalRouteManagerImpl()
 {
     NS_LOG_FUNCTION(this);
-    if (m_lsdb)
+    if (m_lsdb && m_ownsLsdb)
     {
         delete m_lsdb;
     }
@@ -555,6 +633,30 @@ GlobalRouteManagerImpl::DebugUseLsdb(GlobalRouteManagerLSDB* lsdb)
         delete m_lsdb;
     }
     m_lsdb = lsdb;
+    m_routesValid = false;
+}
+
+/**
+ * @brief Delete all the routes of a node
+ *
+ * @param node the node
+ * @param gr the global routing protocol of the node
+ */
+static void
+DeleteNodeRoutes(Ptr<Node> node, Ptr<Ipv4GlobalRouting> gr)
+{
+    uint32_t j = 0;
+    uint32_t nRoutes = gr->GetNRoutes();
+    NS_LOG_LOGIC("Deleting " << gr->GetNRoutes() << " routes from node " << node->GetId());
+    // Each time we delete route 0, the route index shifts downward
+    // We can delete all routes if we delete the route numbered 0
+    // nRoutes times
+    for (j = 0; j < nRoutes; j++)
+    {
+        NS_LOG_LOGIC("Deleting global route " << j << " from node " << node->GetId());
+        gr->RemoveRoute(0);
+    }
+    NS_LOG_LOGIC("Deleted " << j << " global routes from node " << node->GetId());
 }
 
 void
@@ -569,20 +671,9 @@ GlobalRouteManagerImpl::DeleteGlobalRoutes()
         {
             continue;
         }
-        Ptr<Ipv4GlobalRouting> gr = router->GetRoutingProtocol();
-        uint32_t j = 0;
-        uint32_t nRoutes = gr->GetNRoutes();
-        NS_LOG_LOGIC("Deleting " << gr->GetNRoutes() << " routes from node " << node->GetId());
-        // Each time we delete route 0, the route index shifts downward
-        // We can delete all routes if we delete the route numbered 0
-        // nRoutes times
-        for (j = 0; j < nRoutes; j++)
-        {
-            NS_LOG_LOGIC("Deleting global route " << j << " from node " << node->GetId());
-            gr->RemoveRoute(0);
-        }
-        NS_LOG_LOGIC("Deleted " << j << " global routes from node " << node->GetId());
+        DeleteNodeRoutes(node, router->GetRoutingProtocol());
     }
+    m_routesValid = false;
     if (m_lsdb)
     {
         NS_LOG_LOGIC("Deleting LSDB, creating new one");
@@ -604,6 +695,7 @@ void
 GlobalRouteManagerImpl::BuildGlobalRoutingDatabase()
 {
     NS_LOG_FUNCTION(this);
+    m_routesValid = false;
     //
     // Walk the list of nodes looking for the GlobalRouter Interface.  Nodes with
     // global router interfaces are, not too surprisingly, our routers.
@@ -686,10 +778,73 @@ void
 GlobalRouteManagerImpl::InitializeRoutes()
 {
     NS_LOG_FUNCTION(this);
+    NS_LOG_INFO("About to start SPF calculation");
+    m_lsdb->Initialize();
+    std::vector<SPFRoot_t> roots = GetRoots(nullptr);
+    CalculateRoutes(roots);
+    m_nUpdatedRouters = roots.size();
+    m_routesValid = true;
+    NS_LOG_INFO("Finished SPF calculation");
+}
+
+//
+// The routes of a router depend on the LSAs through its SPF tree only.  We
+// compare the database with the one the routes were computed from, and only
+// compute again the routes of the routers whose SPF tree may include a changed
+// edge, or a vertex whose LSA changed otherwise.
+//
+void
+GlobalRouteManagerImpl::UpdateRoutes()
+{
+    NS_LOG_FUNCTION(this);
+    if (!m_routesValid)
+    {
+        NS_LOG_LOGIC("The routes were not computed from the LSDB, computing all of them");
+        DeleteGlobalRoutes();
+        BuildGlobalRoutingDatabase();
+        InitializeRoutes();
+        return;
+    }
+
+    GlobalRouteManagerLSDB* oldLsdb = m_lsdb;
+    m_lsdb = new GlobalRouteManagerLSDB();
+    BuildGlobalRoutingDatabase();
+    m_lsdb->Initialize();
+    std::set<Ipv4Address> routers;
+    bool some = FindAffectedRouters(*oldLsdb, routers);
+    delete oldLsdb;
+    NS_LOG_LOGIC("Updating the routes of "
+                 << (some ? std::to_string(routers.size()) : std::string("all")) << " routers");
+
+    for (auto i = NodeList::Begin(); i != NodeList::End(); i++)
+    {
+        Ptr<Node> node = *i;
+        Ptr<GlobalRouter> router = node->GetObject<GlobalRouter>();
+        if (router && (!some || routers.count(router->GetRouterId()) != 0))
+        {
+            DeleteNodeRoutes(node, router->GetRoutingProtocol());
+        }
+    }
+    std::vector<SPFRoot_t> roots = GetRoots(some ? &routers : nullptr);
+    CalculateRoutes(roots);
+    m_nUpdatedRouters = roots.size();
+    m_routesValid = true;
+}
+
+uint32_t
+GlobalRouteManagerImpl::GetNUpdatedRouters() const
+{
+    return m_nUpdatedRouters;
+}
+
+std::vector<GlobalRouteManagerImpl::SPFRoot_t>
+GlobalRouteManagerImpl::GetRoots(const std::set<Ipv4Address>* routers) const
+{
+    NS_LOG_FUNCTION(this << routers);
+    std::vector<SPFRoot_t> roots;
     //
     // Walk the list of nodes in the system.
     //
-    NS_LOG_INFO("About to start SPF calculation");
     for (auto i = NodeList::Begin(); i != NodeList::End(); i++)
     {
         Ptr<Node> node = *i;
@@ -710,12 +865,424 @@ GlobalRouteManagerImpl::InitializeRoutes()
         // if the node has a global router interface, then run the global routing
         // algorithms.
         //
-        if (rtr && rtr->GetNumLSAs())
+        if (rtr && rtr->GetNumLSAs() &&
+            (routers == nullptr || routers->count(rtr->GetRouterId()) != 0))
         {
-            SPFCalculate(rtr->GetRouterId());
+            roots.emplace_back(rtr->GetRouterId(), node);
         }
     }
-    NS_LOG_INFO("Finished SPF calculation");
+    return roots;
+}
+
+void
+GlobalRouteManagerImpl::CalculateRoutes(const std::vector<SPFRoot_t>& roots)
+{
+    NS_LOG_FUNCTION(this << roots.size());
+    UintegerValue value;
+    g_globalRoutingThreads.GetValue(value);
+    std::size_t threads = value.Get();
+    if (threads == 0)
+    {
+        threads = std::max(1U, std::thread::hardware_concurrency());
+    }
+    threads = std::min(threads, roots.size());
+
+    if (threads <= 1)
+    {
+        for (const auto& [root, node] : roots)
+        {
+            SPFCalculate(root, node);
+        }
+        return;
+    }
+
+    //
+    // The routers are handed out one at a time to workers, which share the
+    // (read only) LSDB but have their own SPF tree and LSA status.  A worker
+    // only adds routes to the node of the router it computes, so the nodes
+    // are never accessed by two threads.
+    //
+    std::atomic<std::size_t> next{0};
+    auto work = [this, &roots, &next]() {
+        GlobalRouteManagerImpl worker(m_lsdb);
+        for (std::size_t i = next++; i < roots.size(); i = next++)
+        {
+            worker.SPFCalculate(roots[i].first, roots[i].second);
+        }
+    };
+    NS_LOG_LOGIC("Computing the routes of " << roots.size() << " routers with " << threads
+                                            << " threads");
+    std::vector<std::thread> workers;
+    for (std::size_t i = 1; i < threads; i++)
+    {
+        workers.emplace_back(work);
+    }
+    work();
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+}
+
+/**
+ * @brief Compare two LSAs
+ *
+ * @param a the first LSA
+ * @param b the second LSA
+ * @param metrics whether to compare the metrics of the link records
+ * @returns true if the LSAs are the same
+ */
+static bool
+IsSameLSA(const GlobalRoutingLSA* a, const GlobalRoutingLSA* b, bool metrics)
+{
+    if (a->GetLSType() != b->GetLSType() || a->GetLinkStateId() != b->GetLinkStateId() ||
+        a->GetAdvertisingRouter() != b->GetAdvertisingRouter() ||
+        a->GetNetworkLSANetworkMask() != b->GetNetworkLSANetworkMask() ||
+        a->GetNLinkRecords() != b->GetNLinkRecords() ||
+        a->GetNAttachedRouters() != b->GetNAttachedRouters())
+    {
+        return false;
+    }
+    for (uint32_t i = 0; i < a->GetNLinkRecords(); i++)
+    {
+        GlobalRoutingLinkRecord* la = a->GetLinkRecord(i);
+        GlobalRoutingLinkRecord* lb = b->GetLinkRecord(i);
+        if (la->GetLinkType() != lb->GetLinkType() || la->GetLinkId() != lb->GetLinkId() ||
+            la->GetLinkData() != lb->GetLinkData() ||
+            (metrics && la->GetMetric() != lb->GetMetric()))
+        {
+            return false;
+        }
+    }
+    for (uint32_t i = 0; i < a->GetNAttachedRouters(); i++)
+    {
+        if (a->GetAttachedRouter(i) != b->GetAttachedRouter(i))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::vector<GlobalRouteManagerImpl::SPFEdge_t>
+GlobalRouteManagerImpl::GetEdges(const GlobalRouteManagerLSDB& lsdb, uint32_t index)
+{
+    NS_LOG_FUNCTION(&lsdb << index);
+    std::vector<SPFEdge_t> edges;
+    GlobalRoutingLSA* lsa = lsdb.m_lsas[index];
+    const uint32_t first = lsdb.m_firstLinks[index];
+    for (uint32_t i = 0; first + i < lsdb.m_firstLinks[index + 1]; i++)
+    {
+        uint32_t wIndex = lsdb.m_links[first + i];
+        if (wIndex == GlobalRouteManagerLSDB::NO_LSA)
+        {
+            continue;
+        }
+        GlobalRoutingLSA* w_lsa = lsdb.m_lsas[wIndex];
+        // the link records of W read to find the next hops from a root V
+        std::vector<uint32_t> back;
+        for (uint32_t j = 0; j < w_lsa->GetNLinkRecords(); j++)
+        {
+            GlobalRoutingLinkRecord* lr = w_lsa->GetLinkRecord(j);
+            if (lr->GetLinkId() == lsa->GetLinkStateId())
+            {
+                back.push_back(lr->GetLinkType());
+                back.push_back(lr->GetLinkData().Get());
+            }
+        }
+        if (lsa->GetLSType() == GlobalRoutingLSA::RouterLSA)
+        {
+            GlobalRoutingLinkRecord* l = lsa->GetLinkRecord(i);
+            edges.emplace_back(w_lsa->GetLinkStateId().Get(),
+                               l->GetMetric(),
+                               l->GetLinkType(),
+                               l->GetLinkData().Get(),
+                               std::move(back));
+        }
+        else
+        {
+            edges.emplace_back(w_lsa->GetLinkStateId().Get(),
+                               0,
+                               0,
+                               lsa->GetAttachedRouter(i).Get(),
+                               std::move(back));
+        }
+    }
+    return edges;
+}
+
+std::vector<uint64_t>
+GlobalRouteManagerImpl::GetDistancesTo(const GlobalRouteManagerLSDB& lsdb, uint32_t index)
+{
+    NS_LOG_FUNCTION(&lsdb << index);
+    // the links reaching each LSA, with their cost
+    std::vector<std::vector<std::pair<uint32_t, uint32_t>>> reverse(lsdb.m_lsas.size());
+    for (uint32_t v = 0; v < lsdb.m_lsas.size(); v++)
+    {
+        GlobalRoutingLSA* lsa = lsdb.m_lsas[v];
+        const uint32_t first = lsdb.m_firstLinks[v];
+        for (uint32_t i = 0; first + i < lsdb.m_firstLinks[v + 1]; i++)
+        {
+            uint32_t w = lsdb.m_links[first + i];
+            if (w != GlobalRouteManagerLSDB::NO_LSA)
+            {
+                uint32_t cost = lsa->GetLSType() == GlobalRoutingLSA::RouterLSA
+                                    ? lsa->GetLinkRecord(i)->GetMetric()
+                                    : 0;
+                reverse[w].emplace_back(v, cost);
+            }
+        }
+    }
+
+    std::vector<uint64_t> distances(lsdb.m_lsas.size(), std::numeric_limits<uint64_t>::max());
+    std::priority_queue<std::pair<uint64_t, uint32_t>,
+                        std::vector<std::pair<uint64_t, uint32_t>>,
+                        std::greater<>>
+        queue;
+    distances[index] = 0;
+    queue.emplace(0, index);
+    while (!queue.empty())
+    {
+        auto [distance, w] = queue.top();
+        queue.pop();
+        if (distance > distances[w])
+        {
+            continue;
+        }
+        for (const auto& [v, cost] : reverse[w])
+        {
+            if (distance + cost < distances[v])
+            {
+                distances[v] = distance + cost;
+                queue.emplace(distances[v], v);
+            }
+        }
+    }
+    return distances;
+}
+
+bool
+GlobalRouteManagerImpl::IsStubRouter(const GlobalRouteManagerLSDB& lsdb,
+                                     Ipv4Address root,
+                                     Ipv4Address& nextHop)
+{
+    NS_LOG_FUNCTION(&lsdb << root);
+    nextHop = Ipv4Address::GetZero();
+    GlobalRoutingLSA* rlsa = lsdb.GetLSA(root);
+    int transits = 0;
+    GlobalRoutingLinkRecord* transitLink = nullptr;
+    for (uint32_t i = 0; i < rlsa->GetNLinkRecords(); i++)
+    {
+        GlobalRoutingLinkRecord* l = rlsa->GetLinkRecord(i);
+        if (l->GetLinkType() == GlobalRoutingLinkRecord::TransitNetwork ||
+            l->GetLinkType() == GlobalRoutingLinkRecord::PointToPoint)
+        {
+            transits++;
+            transitLink = l;
+        }
+    }
+    if (transits == 0)
+    {
+        return true;
+    }
+    if (transits == 1 && transitLink->GetLinkType() == GlobalRoutingLinkRecord::PointToPoint)
+    {
+        GlobalRoutingLSA* w_lsa = lsdb.GetLSA(transitLink->GetLinkId());
+        for (uint32_t j = 0; w_lsa && j < w_lsa->GetNLinkRecords(); ++j)
+        {
+            GlobalRoutingLinkRecord* lr = w_lsa->GetLinkRecord(j);
+            if (lr->GetLinkType() == GlobalRoutingLinkRecord::PointToPoint &&
+                lr->GetLinkId() == root)
+            {
+                nextHop = lr->GetLinkData();
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+//
+// The SPF tree of a router R depends on the edges of the graph of the LSAs it
+// contains.  If no edge U->W of cost C such that d(R,U) + C = d(R,W) changed,
+// the shortest paths from R, and the order in which the SPF calculation
+// reaches the vertices, are the same in both graphs.  Then only a change of
+// another field of the LSA of a vertex reachable from R can change the routes
+// of R.  Stub routers only depend on the link record of their neighbor.
+//
+bool
+GlobalRouteManagerImpl::FindAffectedRouters(const GlobalRouteManagerLSDB& oldLsdb,
+                                            std::set<Ipv4Address>& routers) const
+{
+    NS_LOG_FUNCTION(this << &oldLsdb);
+    const std::array<const GlobalRouteManagerLSDB*, 2> lsdbs = {&oldLsdb, m_lsdb};
+
+    // The external routes are added by every router
+    if (oldLsdb.GetNumExtLSAs() != m_lsdb->GetNumExtLSAs())
+    {
+        return false;
+    }
+    for (uint32_t i = 0; i < m_lsdb->GetNumExtLSAs(); i++)
+    {
+        if (!IsSameLSA(oldLsdb.GetExtLSA(i), m_lsdb->GetExtLSA(i), true))
+        {
+            return false;
+        }
+    }
+
+    std::set<Ipv4Address> ids;
+    for (const auto lsdb : lsdbs)
+    {
+        for (const auto& [id, lsa] : lsdb->m_database)
+        {
+            ids.insert(id);
+        }
+    }
+
+    // The changed edges, by database, and the vertices to which they lead
+    std::array<std::vector<std::tuple<uint32_t, uint32_t, uint32_t>>, 2> edges;
+    // The vertices to which the distances are needed, by database
+    std::array<std::set<uint32_t>, 2> targets;
+    // The vertices whose LSA changed other than by its metrics
+    std::array<std::set<uint32_t>, 2> changed;
+    std::set<Ipv4Address> changedIds;
+    for (const auto& id : ids)
+    {
+        std::array<GlobalRoutingLSA*, 2> lsas = {oldLsdb.GetLSA(id), m_lsdb->GetLSA(id)};
+        std::array<uint32_t, 2> indices = {GlobalRouteManagerLSDB::NO_LSA,
+                                           GlobalRouteManagerLSDB::NO_LSA};
+        std::array<std::vector<SPFEdge_t>, 2> out;
+        for (std::size_t g = 0; g < 2; g++)
+        {
+            if (lsas[g])
+            {
+                indices[g] = lsdbs[g]->m_indices.at(lsas[g]);
+                out[g] = GetEdges(*lsdbs[g], indices[g]);
+            }
+        }
+        if (!lsas[0] || !lsas[1] || !IsSameLSA(lsas[0], lsas[1], true))
+        {
+            changedIds.insert(id);
+        }
+        if (!lsas[0] || !lsas[1] || !IsSameLSA(lsas[0], lsas[1], false))
+        {
+            for (std::size_t g = 0; g < 2; g++)
+            {
+                if (lsas[g])
+                {
+                    changed[g].insert(indices[g]);
+                    targets[g].insert(indices[g]);
+                }
+            }
+        }
+        if (out[0] == out[1])
+        {
+            continue;
+        }
+        // If only the order of the edges changed, all of them may change the order
+        // of the SPF calculation
+        std::array<std::vector<SPFEdge_t>, 2> diff = out;
+        std::sort(out[0].begin(), out[0].end());
+        std::sort(out[1].begin(), out[1].end());
+        if (out[0] != out[1])
+        {
+            for (std::size_t g = 0; g < 2; g++)
+            {
+                diff[g].clear();
+                std::set_difference(out[g].begin(),
+                                    out[g].end(),
+                                    out[1 - g].begin(),
+                                    out[1 - g].end(),
+                                    std::back_inserter(diff[g]));
+            }
+        }
+        for (std::size_t g = 0; g < 2; g++)
+        {
+            for (const auto& edge : diff[g])
+            {
+                GlobalRoutingLSA* w_lsa = lsdbs[g]->GetLSA(Ipv4Address(std::get<0>(edge)));
+                uint32_t wIndex = lsdbs[g]->m_indices.at(w_lsa);
+                edges[g].emplace_back(indices[g], std::get<1>(edge), wIndex);
+                targets[g].insert(indices[g]);
+                targets[g].insert(wIndex);
+            }
+        }
+    }
+    NS_LOG_LOGIC(changedIds.size() << " LSAs changed");
+    if (changedIds.empty())
+    {
+        return true;
+    }
+    //
+    // Computing the distances to a vertex costs about as much as the SPF
+    // calculation of a router.
+    //
+    if (targets[0].size() + targets[1].size() > m_lsdb->m_lsas.size() / 4)
+    {
+        return false;
+    }
+    std::array<std::map<uint32_t, std::vector<uint64_t>>, 2> distances;
+    for (std::size_t g = 0; g < 2; g++)
+    {
+        for (uint32_t target : targets[g])
+        {
+            distances[g][target] = GetDistancesTo(*lsdbs[g], target);
+        }
+    }
+
+    const uint64_t infinity = std::numeric_limits<uint64_t>::max();
+    for (const auto& id : ids)
+    {
+        std::array<GlobalRoutingLSA*, 2> lsas = {oldLsdb.GetLSA(id), m_lsdb->GetLSA(id)};
+        if ((lsas[0] && lsas[0]->GetLSType() != GlobalRoutingLSA::RouterLSA) ||
+            (lsas[1] && lsas[1]->GetLSType() != GlobalRoutingLSA::RouterLSA))
+        {
+            continue;
+        }
+        if (changedIds.count(id) != 0)
+        {
+            routers.insert(id);
+            continue;
+        }
+        std::array<Ipv4Address, 2> nextHops;
+        std::array<bool, 2> stubs = {IsStubRouter(oldLsdb, id, nextHops[0]),
+                                     IsStubRouter(*m_lsdb, id, nextHops[1])};
+        if (stubs[0] || stubs[1])
+        {
+            if (stubs[0] != stubs[1] || nextHops[0] != nextHops[1])
+            {
+                routers.insert(id);
+            }
+            continue;
+        }
+        bool affected = false;
+        for (std::size_t g = 0; g < 2 && !affected; g++)
+        {
+            uint32_t r = lsdbs[g]->m_indices.at(lsas[g]);
+            for (const auto& [u, cost, w] : edges[g])
+            {
+                uint64_t du = distances[g][u][r];
+                if (du != infinity && du + cost == distances[g][w][r])
+                {
+                    affected = true;
+                    break;
+                }
+            }
+            for (uint32_t x : changed[g])
+            {
+                if (distances[g][x][r] != infinity)
+                {
+                    affected = true;
+                    break;
+                }
+            }
+        }
+        if (affected)
+        {
+            routers.insert(id);
+        }
+    }
+    return true;
 }
 
 //
@@ -738,10 +1305,17 @@ GlobalRouteManagerImpl::SPFNext(SPFVertex* v, CandidateQueue& candidate)
 
     SPFVertex* w = nullptr;
     GlobalRoutingLSA* w_lsa = nullptr;
+    uint32_t wIndex = GlobalRouteManagerLSDB::NO_LSA;
     GlobalRoutingLinkRecord* l = nullptr;
     uint32_t distance = 0;
     uint32_t numRecordsInVertex = 0;
     //
+    // The LSAs at the other end of the links of V's LSA, as found by
+    // GetLSA () and GetLSAByLinkData ()
+    //
+    const uint32_t* links =
+        m_lsdb->m_links.data() + m_lsdb->m_firstLinks[m_lsdb->m_indices.at(v->GetLSA())];
+    //
     // V points to a Router-LSA or Network-LSA
     // Loop over the links in router LSA or attached routers in Network LSA
     //
@@ -785,15 +1359,17 @@ GlobalRouteManagerImpl::SPFNext(SPFVertex* v, CandidateQueue& candidate)
                 // Lookup the link state advertisement of the new link -- we call it <w> in
                 // the link state database.
                 //
-                w_lsa = m_lsdb->GetLSA(l->GetLinkId());
-                NS_ASSERT(w_lsa);
+                wIndex = links[i];
+                NS_ASSERT(wIndex != GlobalRouteManagerLSDB::NO_LSA);
+                w_lsa = m_lsdb->m_lsas[wIndex];
                 NS_LOG_LOGIC("Found a P2P record from " << v->GetVertexId() << " to "
                                                         << w_lsa->GetLinkStateId());
             }
             else if (l->GetLinkType() == GlobalRoutingLinkRecord::TransitNetwork)
             {
-                w_lsa = m_lsdb->GetLSA(l->GetLinkId());
-                NS_ASSERT(w_lsa);
+                wIndex = links[i];
+                NS_ASSERT(wIndex != GlobalRouteManagerLSDB::NO_LSA);
+                w_lsa = m_lsdb->m_lsas[wIndex];
                 NS_LOG_LOGIC("Found a Transit record from " << v->GetVertexId() << " to "
                                                             << w_lsa->GetLinkStateId());
             }
@@ -805,11 +1381,12 @@ GlobalRouteManagerImpl::SPFNext(SPFVertex* v, CandidateQueue& candidate)
         // Get w_lsa:  In case of V is Network-LSA
         if (v->GetVertexType() == SPFVertex::VertexNetwork)
         {
-            w_lsa = m_lsdb->GetLSAByLinkData(v->GetLSA()->GetAttachedRouter(i));
-            if (!w_lsa)
+            wIndex = links[i];
+            if (wIndex == GlobalRouteManagerLSDB::NO_LSA)
             {
                 continue;
             }
+            w_lsa = m_lsdb->m_lsas[wIndex];
             NS_LOG_LOGIC("Found a Network LSA from " << v->GetVertexId() << " to "
                                                      << w_lsa->GetLinkStateId());
         }
@@ -822,7 +1399,7 @@ GlobalRouteManagerImpl::SPFNext(SPFVertex* v, CandidateQueue& candidate)
         // If the link is to a router that is already in the shortest path first tree
         // then we have it covered -- ignore it.
         //
-        if (w_lsa->GetStatus() == GlobalRoutingLSA::LSA_SPF_IN_SPFTREE)
+        if (m_status[wIndex] == GlobalRoutingLSA::LSA_SPF_IN_SPFTREE)
         {
             NS_LOG_LOGIC("Skipping ->  LSA " << w_lsa->GetLinkStateId() << " already in SPF tree");
             continue;
@@ -846,7 +1423,7 @@ GlobalRouteManagerImpl::SPFNext(SPFVertex* v, CandidateQueue& candidate)
         NS_LOG_LOGIC("Considering w_lsa " << w_lsa->GetLinkStateId());
 
         // Is there already vertex w in candidate list?
-        if (w_lsa->GetStatus() == GlobalRoutingLSA::LSA_SPF_NOT_EXPLORED)
+        if (m_status[wIndex] == GlobalRoutingLSA::LSA_SPF_NOT_EXPLORED)
         {
             // Calculate nexthop to w
             // We need to figure out how to actually get to the new router represented
@@ -858,7 +1435,7 @@ GlobalRouteManagerImpl::SPFNext(SPFVertex* v, CandidateQueue& candidate)
             w = new SPFVertex(w_lsa);
             if (SPFNexthopCalculation(v, w, l, distance))
             {
-                w_lsa->SetStatus(GlobalRoutingLSA::LSA_SPF_CANDIDATE);
+                m_status[wIndex] = GlobalRoutingLSA::LSA_SPF_CANDIDATE;
                 //
                 // Push this new vertex onto the priority queue (ordered by distance from the
                 // root node).
@@ -873,7 +1450,7 @@ GlobalRouteManagerImpl::SPFNext(SPFVertex* v, CandidateQueue& candidate)
                 NS_ASSERT_MSG(0, "SPFNexthopCalculation never return false, but it does now!");
             }
         }
-        else if (w_lsa->GetStatus() == GlobalRoutingLSA::LSA_SPF_CANDIDATE)
+        else if (m_status[wIndex] == GlobalRoutingLSA::LSA_SPF_CANDIDATE)
         {
             //
             // We have already considered the link represented by <w>.  What wse have to
@@ -943,9 +1520,9 @@ GlobalRouteManagerImpl::SPFNext(SPFVertex* v, CandidateQueue& candidate)
                 {
                     //
                     // If we've changed the cost to get to the vertex represented by <w>, we
-                    // must reorder the priority queue keyed to that cost.
+                    // must move it up in the priority queue keyed to that cost.
                     //
-                    candidate.Reorder();
+                    candidate.Update(cw);
                 }
             }
         }
@@ -1227,7 +1804,13 @@ void
 GlobalRouteManagerImpl::DebugSPFCalculate(Ipv4Address root)
 {
     NS_LOG_FUNCTION(this << root);
-    SPFCalculate(root);
+    m_lsdb->Initialize();
+    Ptr<Node> node;
+    if (NodeList::GetNNodes() > 0)
+    {
+        node = m_lsdb->GetLSA(root)->GetNode();
+    }
+    SPFCalculate(root, node);
 }
 
 //
@@ -1296,7 +1879,7 @@ GlobalRouteManagerImpl::CheckForStubNode(Ipv4Address root)
                 if (lr->GetLinkId() == myRouterId)
                 {
                     // Next hop is stored in the LinkID field of lr
-                    Ptr<GlobalRouter> router = rlsa->GetNode()->GetObject<GlobalRouter>();
+                    Ptr<GlobalRouter> router = m_spfroot->GetNode()->GetObject<GlobalRouter>();
                     NS_ASSERT(router);
                     Ptr<Ipv4GlobalRouting> gr = router->GetRoutingProtocol();
                     NS_ASSERT(gr);
@@ -1318,15 +1901,15 @@ GlobalRouteManagerImpl::CheckForStubNode(Ipv4Address root)
 
 // quagga ospf_spf_calculate
 void
-GlobalRouteManagerImpl::SPFCalculate(Ipv4Address root)
+GlobalRouteManagerImpl::SPFCalculate(Ipv4Address root, Ptr<Node> node)
 {
-    NS_LOG_FUNCTION(this << root);
+    NS_LOG_FUNCTION(this << root << node);
 
     SPFVertex* v;
     //
-    // Initialize the Link State Database.
+    // Initialize the status of the LSAs of the (initialized) Link State Database.
     //
-    m_lsdb->Initialize();
+    m_status.assign(m_lsdb->m_lsas.size(), GlobalRoutingLSA::LSA_SPF_NOT_EXPLORED);
     //
     // The candidate queue is a priority queue of SPFVertex objects, with the top
     // of the queue being the closest vertex in terms of distance from the root
@@ -1340,13 +1923,14 @@ GlobalRouteManagerImpl::SPFCalculate(Ipv4Address root)
     // shortest path first (SPF) tree.
     //
     v = new SPFVertex(m_lsdb->GetLSA(root));
+    v->SetNode(node);
     //
     // This vertex is the root of the SPF tree and it is distance 0 from the root.
     // We also mark this vertex as being in the SPF tree.
     //
     m_spfroot = v;
     v->SetDistanceFromRoot(0);
-    v->GetLSA()->SetStatus(GlobalRoutingLSA::LSA_SPF_IN_SPFTREE);
+    m_status[m_lsdb->m_indices.at(v->GetLSA())] = GlobalRoutingLSA::LSA_SPF_IN_SPFTREE;
     NS_LOG_LOGIC("Starting SPFCalculate for node " << root);
 
     //
@@ -1356,7 +1940,7 @@ GlobalRouteManagerImpl::SPFCalculate(Ipv4Address root)
     // reached.  Instead, short-circuit this computation and just install
     // a default route in the CheckForStubNode() method.
     //
-    if (NodeList::GetNNodes() > 0 && CheckForStubNode(root))
+    if (node && CheckForStubNode(root))
     {
         NS_LOG_LOGIC("SPFCalculate truncated for stub node " << root);
         delete m_spfroot;
@@ -1407,7 +1991,7 @@ GlobalRouteManagerImpl::SPFCalculate(Ipv4Address root)
         // Update the status field of the vertex to indicate that it is in the SPF
         // tree.
         //
-        v->GetLSA()->SetStatus(GlobalRoutingLSA::LSA_SPF_IN_SPFTREE);
+        m_status[m_lsdb->m_indices.at(v->GetLSA())] = GlobalRoutingLSA::LSA_SPF_IN_SPFTREE;
         //
         // The current vertex has a parent pointer.  By calling this rather oddly
         // named method (blame quagga) we add the current vertex to the list of
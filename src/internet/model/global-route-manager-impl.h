@@ -19,7 +19,11 @@
 #include <list>
 #include <map>
 #include <queue>
+#include <set>
 #include <stdint.h>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace ns3
@@ -524,10 +528,19 @@ class SPFVertex
 
     /**
      * @brief Get the node pointer corresponding to this Vertex
+     *
+     * The node is only set for the root of the SPF tree.
+     *
      * @returns the node pointer corresponding to this Vertex
      */
     Ptr<Node> GetNode() const;
 
+    /**
+     * @brief Set the node pointer corresponding to this Vertex
+     * @param node the node pointer corresponding to this Vertex
+     */
+    void SetNode(Ptr<Node> node);
+
   private:
     VertexType m_vertexType;                        //!< Vertex type
     Ipv4Address m_vertexId;                         //!< Vertex ID
@@ -639,9 +652,10 @@ class GlobalRouteManagerLSDB
      * @brief Set all LSA flags to an initialized state, for SPF computation
      *
      * This function walks the database and resets the status flags of all of the
-     * contained Link State Advertisements to LSA_SPF_NOT_EXPLORED.  This is done
-     * prior to each SPF calculation to reset the state of the SPFVertex structures
-     * that will reference the LSAs during the calculation.
+     * contained Link State Advertisements to LSA_SPF_NOT_EXPLORED.  It also
+     * indexes the LSAs and resolves the vertex at the other end of each of their
+     * links, so that the SPF calculations do not search the database.  This is
+     * done after the database is built and prior to the SPF calculations.
      *
      * @see GlobalRoutingLSA
      * @see SPFVertex
@@ -669,6 +683,8 @@ class GlobalRouteManagerLSDB
     uint32_t GetNumExtLSAs() const;
 
   private:
+    friend class GlobalRouteManagerImpl;
+
     typedef std::map<Ipv4Address, GlobalRoutingLSA*>
         LSDBMap_t; //!< container of IPv4 addresses / Link State Advertisements
     typedef std::pair<Ipv4Address, GlobalRoutingLSA*>
@@ -677,6 +693,21 @@ class GlobalRouteManagerLSDB
     LSDBMap_t m_database; //!< database of IPv4 addresses / Link State Advertisements
     std::vector<GlobalRoutingLSA*>
         m_extdatabase; //!< database of External Link State Advertisements
+
+    /// Index of a link which does not lead to an LSA of the database
+    static constexpr uint32_t NO_LSA = 0xffffffff;
+
+    std::vector<GlobalRoutingLSA*> m_lsas; //!< the LSAs of m_database, indexed by Initialize ()
+    std::unordered_map<const GlobalRoutingLSA*, uint32_t>
+        m_indices; //!< the indices of the LSAs in m_lsas
+    /**
+     * The index in m_links of the first link of each LSA of m_lsas, followed by
+     * the number of links.  The links of a router LSA are its link records and
+     * the links of a network LSA are its attached routers.
+     */
+    std::vector<uint32_t> m_firstLinks;
+    /// The index of the LSA at the other end of each link, or NO_LSA
+    std::vector<uint32_t> m_links;
 };
 
 /**
@@ -718,9 +749,35 @@ class GlobalRouteManagerImpl
     /**
      * @brief Compute routes using a Dijkstra SPF computation and populate
      * per-node forwarding tables
+     *
+     * The SPF computations of the routers are distributed among the number of
+     * threads set by the global value GlobalRoutingThreads.
      */
     virtual void InitializeRoutes();
 
+    /**
+     * @brief Update the routes after a change of the topology
+     *
+     * The routing database is built again and compared with the one used to
+     * compute the current routes.  The routes are only computed again for the
+     * routers whose forwarding tables may change, e.g., the routers whose
+     * shortest paths include a link whose metric has changed.  If the routes
+     * were not computed by InitializeRoutes () or UpdateRoutes () from the
+     * current database, all the routes are deleted and computed again.
+     *
+     * The changes are detected through the Link State Advertisements, so routes
+     * added to the Ipv4GlobalRouting of the routers by other means are kept
+     * by the routers whose routes are not computed again.
+     */
+    virtual void UpdateRoutes();
+
+    /**
+     * @brief Get the number of routers whose routes were computed by the last
+     * call to InitializeRoutes () or UpdateRoutes ()
+     * @returns the number of routers
+     */
+    uint32_t GetNUpdatedRouters() const;
+
     /**
      * @brief Debugging routine; allow client code to supply a pre-built LSDB
      * @param lsdb the pre-built LSDB
@@ -734,8 +791,93 @@ class GlobalRouteManagerImpl
     void DebugSPFCalculate(Ipv4Address root);
 
   private:
+    /**
+     * @brief Construct a worker computing the routes of some of the routers
+     * from the LSDB of another GlobalRouteManagerImpl
+     * @param lsdb the LSDB, which must be initialized and which is not deleted
+     * by the worker
+     */
+    explicit GlobalRouteManagerImpl(GlobalRouteManagerLSDB* lsdb);
+
+    /// The router ID and the node of a root of the SPF calculations
+    typedef std::pair<Ipv4Address, Ptr<Node>> SPFRoot_t;
+
     SPFVertex* m_spfroot;           //!< the root node
     GlobalRouteManagerLSDB* m_lsdb; //!< the Link State DataBase (LSDB) of the Global Route Manager
+    bool m_ownsLsdb;                //!< whether the LSDB is deleted with this object
+    bool m_routesValid;             //!< whether the routes were computed from the LSDB
+    uint32_t m_nUpdatedRouters;     //!< the number of routers whose routes were last computed
+    std::vector<GlobalRoutingLSA::SPFStatus>
+        m_status; //!< the status of the LSAs of the LSDB in the current SPF calculation
+
+    /**
+     * @brief Get the routers of this system whose routes are computed
+     * @param routers the router IDs of the routers, or null for all of them
+     * @returns the roots of the SPF calculations
+     */
+    std::vector<SPFRoot_t> GetRoots(const std::set<Ipv4Address>* routers) const;
+
+    /**
+     * @brief Calculate the routes of the given routers, with the number of
+     * threads set by the global value GlobalRoutingThreads
+     *
+     * The LSDB must be initialized.
+     *
+     * @param roots the roots of the SPF calculations
+     */
+    void CalculateRoutes(const std::vector<SPFRoot_t>& roots);
+
+    /**
+     * @brief Find the routers whose routes may differ when computed from the
+     * LSDB rather than from another LSDB
+     *
+     * Both LSDBs must be initialized.
+     *
+     * @param oldLsdb the LSDB from which the current routes were computed
+     * @param routers the router IDs of the routers whose routes may differ
+     * @returns false if the routes of all the routers may differ
+     */
+    bool FindAffectedRouters(const GlobalRouteManagerLSDB& oldLsdb,
+                             std::set<Ipv4Address>& routers) const;
+
+    /**
+     * @brief An edge of the graph of the LSAs, as read by the SPF calculation:
+     * the ID of its target vertex, its cost, the type and data of its link
+     * record, and the type and data of the link records of the target vertex
+     * pointing back to the source vertex
+     */
+    typedef std::tuple<uint32_t, uint32_t, uint32_t, uint32_t, std::vector<uint32_t>> SPFEdge_t;
+
+    /**
+     * @brief Get the edges from a vertex of the graph of the LSAs
+     * @param lsdb the initialized LSDB
+     * @param index the index of the LSA of the vertex
+     * @returns the edges, in the order of the links of the LSA
+     */
+    static std::vector<SPFEdge_t> GetEdges(const GlobalRouteManagerLSDB& lsdb, uint32_t index);
+
+    /**
+     * @brief Compute the distances from all the vertices of the graph of the
+     * LSAs to a vertex
+     * @param lsdb the initialized LSDB
+     * @param index the index of the LSA of the vertex
+     * @returns the distance from each vertex, or UINT64_MAX if the vertex is
+     * unreachable from it
+     */
+    static std::vector<uint64_t> GetDistancesTo(const GlobalRouteManagerLSDB& lsdb,
+                                                uint32_t index);
+
+    /**
+     * @brief Test if a router is a stub, as CheckForStubNode () does
+     * @param lsdb the initialized LSDB
+     * @param root the router ID
+     * @param nextHop the next hop of the default route of the stub, or 0.0.0.0
+     * if no route is added
+     * @returns true if the SPF calculation of the router is skipped
+     */
+    static bool IsStubRouter(const GlobalRouteManagerLSDB& lsdb,
+                             Ipv4Address root,
+                             Ipv4Address& nextHop);
 
     /**
      * @brief Test if a node is a stub, from an OSPF sense.
@@ -754,8 +896,10 @@ class GlobalRouteManagerImpl
      *
      * Equivalent to quagga ospf_spf_calculate
      * @param root the root node
+     * @param node the node of the root router, or null if there is no node
+     * (the stub node test is then skipped and no routes can be added)
      */
-    void SPFCalculate(Ipv4Address root);
+    void SPFCalculate(Ipv4Address root, Ptr<Node> node);
 
     /**
      * @brief Process Stub nodes
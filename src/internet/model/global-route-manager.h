@@ -60,6 +60,15 @@ class GlobalRouteManager
      */
     static void InitializeRoutes();
 
+    /**
+     * @brief Rebuild the routing database and compute the routes again, only
+     * for the routers whose forwarding tables may change
+     *
+     * This is equivalent to calling DeleteGlobalRoutes (),
+     * BuildGlobalRoutingDatabase () and InitializeRoutes ().
+     */
+    static void UpdateRoutes();
+
     /**
      * @brief Reset the router ID counter to zero. This should only be called by tests to reset the
      * router ID counter between simulations within the same program. This function should not be
@@ -242,16 +242,8 @@ GlobalRoutingLinkRecord*
 GlobalRoutingLSA::GetLinkRecord(uint32_t n) const
 {
     NS_LOG_FUNCTION(this << n);
-    uint32_t j = 0;
-    for (auto i = m_linkRecords.begin(); i != m_linkRecords.end(); i++, j++)
-    {
-        if (j == n)
-        {
-            return *i;
-        }
-    }
-    NS_ASSERT_MSG(false, "GlobalRoutingLSA::GetLinkRecord (): invalid index");
-    return nullptr;
+    NS_ASSERT_MSG(n < m_linkRecords.size(), "GlobalRoutingLSA::GetLinkRecord (): invalid index");
+    return m_linkRecords[n];
 }
 
 bool
@@ -343,16 +335,9 @@ Ipv4Address
 GlobalRoutingLSA::GetAttachedRouter(uint32_t n) const
 {
     NS_LOG_FUNCTION(this << n);
-    uint32_t j = 0;
-    for (auto i = m_attachedRouters.begin(); i != m_attachedRouters.end(); i++, j++)
-    {
-        if (j == n)
-        {
-            return *i;
-        }
-    }
-    NS_ASSERT_MSG(false, "GlobalRoutingLSA::GetAttachedRouter (): invalid index");
-    return Ipv4Address("0.0.0.0");
+    NS_ASSERT_MSG(n < m_attachedRouters.size(),
+                  "GlobalRoutingLSA::GetAttachedRouter (): invalid index");
+    return m_attachedRouters[n];
 }
 
 void
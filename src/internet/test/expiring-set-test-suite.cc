@@ -0,0 +1,97 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/expiring-set.h"
+#include "ns3/test.h"
+
+#include <string>
+
+using namespace ns3;
+
+/**
+ * @ingroup internet-test
+ *
+ * @brief ExpiringSet Test
+ */
+class ExpiringSetTestCase : public TestCase
+{
+  public:
+    ExpiringSetTestCase();
+    void DoRun() override;
+};
+
+ExpiringSetTestCase::ExpiringSetTestCase()
+    : TestCase("Check insertion, lookup and expiration of keys in an ExpiringSet")
+{
+}
+
+void
+ExpiringSetTestCase::DoRun()
+{
+    ExpiringSet<uint32_t> set;
+    for (uint32_t i = 0; i < 100; ++i)
+    {
+        set.Insert(i, Seconds(i));
+    }
+    NS_TEST_EXPECT_MSG_EQ(set.GetSize(), 100, "Unexpected number of keys");
+    NS_TEST_EXPECT_MSG_EQ(set.Contains(50, Seconds(50)), true, "Key should not be expired yet");
+    NS_TEST_EXPECT_MSG_EQ(set.Contains(50, Seconds(51)), false, "Key should be expired");
+    NS_TEST_EXPECT_MSG_EQ(set.Contains(100, Seconds(0)), false, "Unknown key");
+
+    // extend the expiration time of a key and erase another one
+    set.Insert(10, Seconds(80));
+    NS_TEST_EXPECT_MSG_EQ(set.GetExpiration(10), Seconds(80), "Expiration time not updated");
+    NS_TEST_EXPECT_MSG_EQ(set.Erase(20), true, "Key should have been erased");
+    NS_TEST_EXPECT_MSG_EQ(set.Erase(20), false, "Key already erased");
+
+    set.Purge(Seconds(50));
+    NS_TEST_EXPECT_MSG_EQ(set.GetSize(), 51, "Keys 0-49 but 10 and 20 should be purged");
+    NS_TEST_EXPECT_MSG_EQ(set.Contains(10, Seconds(50)), true, "Key 10 should have been kept");
+
+    // reduce the expiration time of keys, which are then inserted before the latest ones
+    set.Insert(1000, Seconds(60));
+    set.Insert(99, Seconds(55));
+    set.Purge(Seconds(60));
+    NS_TEST_EXPECT_MSG_EQ(set.GetSize(), 41, "Keys 50-59 and 99 should be purged");
+    NS_TEST_EXPECT_MSG_EQ(set.Contains(1000, Seconds(60)), true, "Key 1000 should have been kept");
+
+    // many updates of the same key do not leave stale items behind
+    for (uint32_t i = 0; i < 1000; ++i)
+    {
+        set.Insert(1000, Seconds(100) + MilliSeconds(i));
+    }
+    set.Purge(Seconds(200));
+    NS_TEST_EXPECT_MSG_EQ(set.IsEmpty(), true, "All the keys should be purged");
+
+    // values associated with keys
+    ExpiringSet<uint32_t, std::string> map;
+    map.Insert(1, Seconds(1), "one");
+    NS_TEST_ASSERT_MSG_NE(map.Find(1, Seconds(0)), nullptr, "Key should be found");
+    NS_TEST_EXPECT_MSG_EQ(*map.Find(1, Seconds(0)), "one", "Unexpected value");
+    *map.Find(1, Seconds(0)) = "uno";
+    map.Insert(1, Seconds(2), *map.Find(1, Seconds(0)));
+    NS_TEST_EXPECT_MSG_EQ(*map.Find(1, Seconds(2)), "uno", "Unexpected value");
+    map.Insert(1, Seconds(2), *map.Find(1, Seconds(2)));
+    NS_TEST_EXPECT_MSG_EQ(*map.Find(1, Seconds(2)), "uno", "Unexpected value");
+    NS_TEST_EXPECT_MSG_EQ(map.Find(1, Seconds(3)), nullptr, "Key should be expired");
+    map.Clear();
+    NS_TEST_EXPECT_MSG_EQ(map.GetSize(), 0, "Set should be empty");
+}
+
+/**
+ * @ingroup internet-test
+ *
+ * @brief ExpiringSet TestSuite
+ */
+class ExpiringSetTestSuite : public TestSuite
+{
+  public:
+    ExpiringSetTestSuite()
+        : TestSuite("expiring-set", Type::UNIT)
+    {
+        AddTestCase(new ExpiringSetTestCase(), TestCase::Duration::QUICK);
+    }
+};
+
+static ExpiringSetTestSuite g_expiringSetTestSuite; //!< Static variable for test initialization
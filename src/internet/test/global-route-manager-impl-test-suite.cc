@@ -25,8 +25,12 @@
 #include "ns3/simple-net-device-helper.h"
 #include "ns3/simulator.h"
 #include "ns3/test.h"
+#include "ns3/uinteger.h"
 
 #include <cstdlib> // for rand()
+#include <sstream>
+#include <string>
+#include <vector>
 using namespace ns3;
 
 NS_LOG_COMPONENT_DEFINE("GlobalRouteManagerImplTestSuite");
@@ -52,6 +56,13 @@ NS_LOG_COMPONENT_DEFINE("GlobalRouteManagerImplTestSuite");
 //  - GlobalRouteManagerImpl computes ECMP routes correctly.
 //  - Those random routes are in fact used by the GlobalRouting protocol
 //
+//  TestCase 4: UpdateRoutesTestCase
+//  This test case tests that:
+//  - The routes computed with several threads are the same as with one thread
+//  - The routes updated after a change of the topology are the same as the
+//    routes computed again from scratch
+//  - Only the routes of the routers whose SPF tree may change are updated
+//
 
 /**
  * @ingroup internet
@@ -940,6 +951,213 @@ RandomEcmpTestCase::DoRun()
     delete srm;
 }
 
+/**
+ * @ingroup internet-test
+ *
+ * @brief Check the routes computed by several threads, and the routes updated
+ * after a change of the topology.
+ */
+class UpdateRoutesTestCase : public TestCase
+{
+  public:
+    UpdateRoutesTestCase();
+    void DoSetup() override;
+    void DoRun() override;
+
+  private:
+    /**
+     * @brief Set the metric of the interface of a device
+     * @param device the device
+     * @param metric the metric
+     */
+    static void SetMetric(Ptr<NetDevice> device, uint16_t metric);
+
+    /**
+     * @brief Get the routes of the nodes
+     * @returns the routes of each node, in order
+     */
+    std::vector<std::string> GetRoutes() const;
+
+    /**
+     * @brief Update the routes, and check them against the routes computed
+     * again from scratch
+     * @param manager the global route manager
+     * @param change the change of the topology
+     * @returns the number of routers whose routes were updated
+     */
+    uint32_t CheckUpdate(GlobalRouteManagerImpl& manager, const std::string& change);
+
+    NodeContainer m_routers;     //!< the routers of the grid
+    NodeContainer m_hosts;       //!< the hosts attached to the corners of the grid
+    NetDeviceContainer m_link;   //!< the devices of a link of the grid
+    NetDeviceContainer m_backup; //!< the devices of the link between two corners
+};
+
+UpdateRoutesTestCase::UpdateRoutesTestCase()
+    : TestCase("UpdateRoutesTestCase")
+{
+}
+
+void
+UpdateRoutesTestCase::SetMetric(Ptr<NetDevice> device, uint16_t metric)
+{
+    Ptr<Ipv4> ipv4 = device->GetNode()->GetObject<Ipv4>();
+    ipv4->SetMetric(ipv4->GetInterfaceForDevice(device), metric);
+}
+
+std::vector<std::string>
+UpdateRoutesTestCase::GetRoutes() const
+{
+    std::vector<std::string> routes;
+    for (auto it = NodeList::Begin(); it != NodeList::End(); ++it)
+    {
+        Ptr<Ipv4GlobalRouting> routing = (*it)->GetObject<GlobalRouter>()->GetRoutingProtocol();
+        std::ostringstream oss;
+        for (uint32_t i = 0; i < routing->GetNRoutes(); i++)
+        {
+            oss << *routing->GetRoute(i) << std::endl;
+        }
+        routes.push_back(oss.str());
+    }
+    return routes;
+}
+
+uint32_t
+UpdateRoutesTestCase::CheckUpdate(GlobalRouteManagerImpl& manager, const std::string& change)
+{
+    manager.UpdateRoutes();
+    uint32_t updated = manager.GetNUpdatedRouters();
+    std::vector<std::string> routes = GetRoutes();
+
+    manager.DeleteGlobalRoutes();
+    manager.BuildGlobalRoutingDatabase();
+    manager.InitializeRoutes();
+    std::vector<std::string> expected = GetRoutes();
+    for (uint32_t i = 0; i < expected.size(); i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(routes[i],
+                              expected[i],
+                              "Wrong routes of node " << i << " after the " << change);
+    }
+    NS_LOG_DEBUG(updated << " routers updated after the " << change);
+    return updated;
+}
+
+void
+UpdateRoutesTestCase::DoSetup()
+{
+    // A 5x5 grid of routers, with a host attached to each corner and a link
+    // of metric 100 between two opposite corners
+    //
+    //  h0 - r0 ---- r1 ---- ... r4 - h1
+    //       |  \    |          |
+    //       r5 ---- r6 ---- ... r9
+    //       |        |    \     |
+    //      ...      ...        ...
+    //       |        |        \ |
+    //  h2 - r20 --- r21 --- ... r24 - h3
+    //
+    const uint32_t size = 5;
+    m_routers.Create(size * size);
+    m_hosts.Create(4);
+
+    InternetStackHelper internet;
+    Ipv4GlobalRoutingHelper ipv4RoutingHelper;
+    internet.SetRoutingHelper(ipv4RoutingHelper);
+    internet.Install(m_routers);
+    internet.Install(m_hosts);
+
+    SimpleNetDeviceHelper simpleHelper;
+    simpleHelper.SetNetDevicePointToPointMode(true);
+    Ipv4AddressHelper ipv4;
+    ipv4.SetBase("10.1.0.0", "255.255.255.252");
+    auto connect = [&simpleHelper, &ipv4](Ptr<Node> a, Ptr<Node> b) {
+        Ptr<SimpleChannel> channel = CreateObject<SimpleChannel>();
+        NetDeviceContainer devices = simpleHelper.Install(a, channel);
+        devices.Add(simpleHelper.Install(b, channel));
+        ipv4.Assign(devices);
+        ipv4.NewNetwork();
+        return devices;
+    };
+
+    for (uint32_t row = 0; row < size; row++)
+    {
+        for (uint32_t col = 0; col < size; col++)
+        {
+            Ptr<Node> router = m_routers.Get(row * size + col);
+            if (col + 1 < size)
+            {
+                NetDeviceContainer devices = connect(router, m_routers.Get(row * size + col + 1));
+                if (row == 1 && col == 1)
+                {
+                    m_link = devices;
+                }
+            }
+            if (row + 1 < size)
+            {
+                connect(router, m_routers.Get((row + 1) * size + col));
+            }
+        }
+    }
+    connect(m_hosts.Get(0), m_routers.Get(0));
+    connect(m_hosts.Get(1), m_routers.Get(size - 1));
+    connect(m_hosts.Get(2), m_routers.Get(size * (size - 1)));
+    connect(m_hosts.Get(3), m_routers.Get(size * size - 1));
+    m_backup = connect(m_routers.Get(0), m_routers.Get(size * size - 1));
+    SetMetric(m_backup.Get(0), 100);
+    SetMetric(m_backup.Get(1), 100);
+}
+
+void
+UpdateRoutesTestCase::DoRun()
+{
+    const uint32_t nRouters = m_routers.GetN() + m_hosts.GetN();
+    GlobalRouteManagerImpl manager;
+    manager.BuildGlobalRoutingDatabase();
+    manager.InitializeRoutes();
+    NS_TEST_EXPECT_MSG_EQ(manager.GetNUpdatedRouters(), nRouters, "Wrong number of routers");
+    std::vector<std::string> routes = GetRoutes();
+
+    Config::SetGlobal("GlobalRoutingThreads", UintegerValue(4));
+    manager.DeleteGlobalRoutes();
+    manager.BuildGlobalRoutingDatabase();
+    manager.InitializeRoutes();
+    std::vector<std::string> threadRoutes = GetRoutes();
+    for (uint32_t i = 0; i < routes.size(); i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(threadRoutes[i],
+                              routes[i],
+                              "Wrong routes of node " << i << " computed by 4 threads");
+    }
+
+    NS_TEST_EXPECT_MSG_EQ(CheckUpdate(manager, "initialization"), 0, "No routes should change");
+
+    // The link between the corners is not on any shortest path, so that only
+    // the routes of the router whose LSA changed are computed again
+    SetMetric(m_backup.Get(0), 50);
+    NS_TEST_EXPECT_MSG_EQ(CheckUpdate(manager, "metric change of the link between the corners"),
+                          1,
+                          "Only the routes of one router should be updated");
+
+    // The stub hosts are not affected by the links of the grid
+    SetMetric(m_link.Get(0), 3);
+    NS_TEST_EXPECT_MSG_LT(CheckUpdate(manager, "metric change of a link of the grid"),
+                          nRouters - m_hosts.GetN() + 1,
+                          "The routes of the hosts should not be updated");
+    SetMetric(m_backup.Get(0), 1);
+    CheckUpdate(manager, "metric change to a shortest path between the corners");
+
+    Ptr<Ipv4> ipv4 = m_link.Get(1)->GetNode()->GetObject<Ipv4>();
+    uint32_t interface = ipv4->GetInterfaceForDevice(m_link.Get(1));
+    ipv4->SetDown(interface);
+    CheckUpdate(manager, "link down");
+    ipv4->SetUp(interface);
+    CheckUpdate(manager, "link up");
+
+    Config::SetGlobal("GlobalRoutingThreads", UintegerValue(1));
+    Simulator::Destroy();
+}
+
 /**
  * @ingroup internet-test
  *
@@ -959,6 +1177,7 @@ GlobalRouteManagerImplTestSuite::GlobalRouteManagerImplTestSuite()
     AddTestCase(new LinkRoutesTestCase(), TestCase::Duration::QUICK);
     AddTestCase(new LanRoutesTestCase(), TestCase::Duration::QUICK);
     AddTestCase(new RandomEcmpTestCase(), TestCase::Duration::QUICK);
+    AddTestCase(new UpdateRoutesTestCase(), TestCase::Duration::QUICK);
 }
 
 static GlobalRouteManagerImplTestSuite
@@ -60,10 +60,10 @@ static bool initialized = false; //!< Initialization flag
 
 // Public methods
 
-AnimationInterface::AnimationInterface(const std::string fn)
-    : m_f(nullptr),
-      m_routingF(nullptr),
+AnimationInterface::AnimationInterface(const std::string fn, AnimationTraceWriter::Format format)
+    : m_format(format),
       m_mobilityPollInterval(Seconds(0.25)),
+      m_mobilityThreshold(0),
       m_outputFileName(fn),
       gAnimUid(0),
       m_writeCallback(nullptr),
@@ -307,6 +307,12 @@ AnimationInterface::SetMobilityPollInterval(Time t)
     m_mobilityPollInterval = t;
 }
 
+void
+AnimationInterface::SetMobilityDisplacementThreshold(double threshold)
+{
+    m_mobilityThreshold = threshold;
+}
+
 void
 AnimationInterface::SetConstantPosition(Ptr<Node> n, double x, double y, double z)
 {
@@ -454,6 +460,13 @@ bool
 AnimationInterface::NodeHasMoved(Ptr<Node> n, Vector newLocation)
 {
     Vector oldLocation = GetPosition(n);
+    if (m_mobilityThreshold > 0)
+    {
+        // NetAnim only shows the x and y coordinates
+        double dx = newLocation.x - oldLocation.x;
+        double dy = newLocation.y - oldLocation.y;
+        return dx * dx + dy * dy > m_mobilityThreshold * m_mobilityThreshold;
+    }
     bool moved = !((ceil(oldLocation.x) == ceil(newLocation.x)) &&
                    (ceil(oldLocation.y) == ceil(newLocation.y)));
     return moved;
@@ -512,43 +525,18 @@ AnimationInterface::GetMovedNodes()
     return movedNodes;
 }
 
-int
-AnimationInterface::WriteN(const std::string& st, FILE* f)
+void
+AnimationInterface::Write(const AnimationTraceElement& element, AnimationTraceWriter& writer)
 {
-    if (!f)
+    if (!writer.IsOpen())
     {
-        return 0;
+        return;
     }
     if (m_writeCallback)
     {
-        m_writeCallback(st.c_str());
-    }
-    return WriteN(st.c_str(), st.length(), f);
-}
-
-int
-AnimationInterface::WriteN(const char* data, uint32_t count, FILE* f)
-{
-    if (!f)
-    {
-        return 0;
-    }
-    // Write count bytes to h from data
-    uint32_t nLeft = count;
-    const char* p = data;
-    uint32_t written = 0;
-    while (nLeft)
-    {
-        int n = std::fwrite(p, 1, nLeft, f);
-        if (n <= 0)
-        {
-            return written;
-        }
-        written += n;
-        nLeft -= n;
-        p += n;
+        m_writeCallback(element.ToString().c_str());
     }
-    return written;
+    writer.Write(element);
 }
 
 void
@@ -1412,22 +1400,20 @@ AnimationInterface::StopAnimation(bool onlyAnimation)
     m_started = false;
     NS_LOG_INFO("Stopping Animation");
     ResetAnimWriteCallback();
-    if (m_f)
+    if (m_writer.IsOpen())
     {
         // Terminate the anim element
         WriteXmlClose("anim");
-        std::fclose(m_f);
-        m_f = nullptr;
+        m_writer.Close();
     }
     if (onlyAnimation)
     {
         return;
     }
-    if (m_routingF)
+    if (m_routingWriter.IsOpen())
     {
         WriteXmlClose("anim", true);
-        std::fclose(m_routingF);
-        m_routingF = nullptr;
+        m_routingWriter.Close();
     }
 }
 
@@ -2038,32 +2024,29 @@ AnimationInterface::IsInTimeWindow()
 void
 AnimationInterface::SetOutputFile(const std::string& fn, bool routing)
 {
-    if (!routing && m_f)
+    if (!routing && m_writer.IsOpen())
     {
         return;
     }
-    if (routing && m_routingF)
+    if (routing && m_routingWriter.IsOpen())
     {
         NS_FATAL_ERROR("SetRoutingOutputFile already used once");
         return;
     }
 
     NS_LOG_INFO("Creating new trace file:" << fn);
-    FILE* f = nullptr;
-    f = std::fopen(fn.c_str(), "w");
-    if (!f)
+    AnimationTraceWriter& writer = routing ? m_routingWriter : m_writer;
+    if (!writer.Open(fn, m_format))
     {
         NS_FATAL_ERROR("Unable to open output file:" << fn);
         return; // Can't open output file
     }
     if (routing)
     {
-        m_routingF = f;
         m_routingFileName = fn;
     }
     else
     {
-        m_f = f;
         m_outputFileName = fn;
     }
 }
@@ -2359,9 +2342,9 @@ AnimationInterface::RecursiveIpv4RoutePathSearch(std::string from,
 void
 AnimationInterface::WriteXmlAnim(bool routing)
 {
-    AnimXmlElement element("anim");
+    AnimationTraceElement element("anim");
     element.AddAttribute("ver", GetNetAnimVersion());
-    FILE* f = m_f;
+    AnimationTraceWriter* writer = &m_writer;
     if (!routing)
     {
         element.AddAttribute("filetype", "animation");
@@ -2369,51 +2352,60 @@ AnimationInterface::WriteXmlAnim(bool routing)
     else
     {
         element.AddAttribute("filetype", "routing");
-        f = m_routingF;
+        writer = &m_routingWriter;
     }
-    WriteN(element.ToString(false) + ">\n", f);
+    if (!writer->IsOpen())
+    {
+        return;
+    }
+    if (m_writeCallback)
+    {
+        m_writeCallback((element.ToString(false) + ">\n").c_str());
+    }
+    writer->WriteStart(element);
 }
 
 void
 AnimationInterface::WriteXmlClose(std::string name, bool routing)
 {
-    std::string closeString = "</" + name + ">\n";
-    if (!routing)
+    AnimationTraceWriter& writer = routing ? m_routingWriter : m_writer;
+    if (!writer.IsOpen())
     {
-        WriteN(closeString, m_f);
+        return;
     }
-    else
+    if (m_writeCallback)
     {
-        WriteN(closeString, m_routingF);
+        m_writeCallback(("</" + name + ">\n").c_str());
     }
+    writer.WriteEnd(name);
 }
 
 void
 AnimationInterface::WriteXmlNode(uint32_t id, uint32_t sysId, double locX, double locY)
 {
-    AnimXmlElement element("node");
+    AnimationTraceElement element("node");
     element.AddAttribute("id", id);
     element.AddAttribute("sysId", sysId);
     element.AddAttribute("locX", locX);
     element.AddAttribute("locY", locY);
-    WriteN(element.ToString(), m_f);
+    Write(element, m_writer);
 }
 
 void
 AnimationInterface::WriteXmlUpdateLink(uint32_t fromId, uint32_t toId, std::string linkDescription)
 {
-    AnimXmlElement element("linkupdate");
+    AnimationTraceElement element("linkupdate");
     element.AddAttribute("t", Simulator::Now().GetSeconds());
     element.AddAttribute("fromId", fromId);
     element.AddAttribute("toId", toId);
     element.AddAttribute("ld", linkDescription, true);
-    WriteN(element.ToString(), m_f);
+    Write(element, m_writer);
 }
 
 void
 AnimationInterface::WriteXmlLink(uint32_t fromId, uint32_t toLp, uint32_t toId)
 {
-    AnimXmlElement element("link");
+    AnimationTraceElement element("link");
     element.AddAttribute("fromId", fromId);
     element.AddAttribute("toId", toId);
 
@@ -2436,45 +2428,45 @@ AnimationInterface::WriteXmlLink(uint32_t fromId, uint32_t toLp, uint32_t toId)
     element.AddAttribute("fd", lprop.fromNodeDescription, true);
     element.AddAttribute("td", lprop.toNodeDescription, true);
     element.AddAttribute("ld", lprop.linkDescription, true);
-    WriteN(element.ToString(), m_f);
+    Write(element, m_writer);
 }
 
 void
 AnimationInterface::WriteXmlIpv4Addresses(uint32_t nodeId, std::vector<std::string> ipv4Addresses)
 {
-    AnimXmlElement element("ip");
+    AnimationTraceElement element("ip");
     element.AddAttribute("n", nodeId);
     for (auto i = ipv4Addresses.begin(); i != ipv4Addresses.end(); ++i)
     {
-        AnimXmlElement valueElement("address");
+        AnimationTraceElement valueElement("address");
         valueElement.SetText(*i);
         element.AppendChild(valueElement);
     }
-    WriteN(element.ToString(), m_f);
+    Write(element, m_writer);
 }
 
 void
 AnimationInterface::WriteXmlIpv6Addresses(uint32_t nodeId, std::vector<std::string> ipv6Addresses)
 {
-    AnimXmlElement element("ipv6");
+    AnimationTraceElement element("ipv6");
     element.AddAttribute("n", nodeId);
     for (auto i = ipv6Addresses.begin(); i != ipv6Addresses.end(); ++i)
     {
-        AnimXmlElement valueElement("address");
+        AnimationTraceElement valueElement("address");
         valueElement.SetText(*i);
         element.AppendChild(valueElement);
     }
-    WriteN(element.ToString(), m_f);
+    Write(element, m_writer);
 }
 
 void
 AnimationInterface::WriteXmlRouting(uint32_t nodeId, std::string routingInfo)
 {
-    AnimXmlElement element("rt");
+    AnimationTraceElement element("rt");
     element.AddAttribute("t", Simulator::Now().GetSeconds());
     element.AddAttribute("id", nodeId);
     element.AddAttribute("info", routingInfo.c_str(), true);
-    WriteN(element.ToString(), m_routingF);
+    Write(element, m_routingWriter);
 }
 
 void
@@ -2483,25 +2475,25 @@ AnimationInterface::WriteXmlRp(uint32_t nodeId,
                                Ipv4RoutePathElements rpElements)
 {
     std::string tagName = "rp";
-    AnimXmlElement element(tagName, false);
+    AnimationTraceElement element(tagName);
     element.AddAttribute("t", Simulator::Now().GetSeconds());
     element.AddAttribute("id", nodeId);
     element.AddAttribute("d", destination.c_str());
     element.AddAttribute("c", rpElements.size());
     for (const auto& rpElement : rpElements)
     {
-        AnimXmlElement rpeElement("rpe");
+        AnimationTraceElement rpeElement("rpe");
         rpeElement.AddAttribute("n", rpElement.nodeId);
         rpeElement.AddAttribute("nH", rpElement.nextHop.c_str());
         element.AppendChild(rpeElement);
     }
-    WriteN(element.ToString(), m_routingF);
+    Write(element, m_routingWriter);
 }
 
 void
 AnimationInterface::WriteXmlPRef(uint64_t animUid, uint32_t fId, double fbTx, std::string metaInfo)
 {
-    AnimXmlElement element("pr");
+    AnimationTraceElement element("pr");
     element.AddAttribute("uId", animUid);
     element.AddAttribute("fId", fId);
     element.AddAttribute("fbTx", fbTx);
@@ -2509,7 +2501,7 @@ AnimationInterface::WriteXmlPRef(uint64_t animUid, uint32_t fId, double fbTx, st
     {
         element.AddAttribute("meta-info", metaInfo.c_str(), true);
     }
-    WriteN(element.ToString(), m_f);
+    Write(element, m_writer);
 }
 
 void
@@ -2519,12 +2511,12 @@ AnimationInterface::WriteXmlP(uint64_t animUid,
                               double fbRx,
                               double lbRx)
 {
-    AnimXmlElement element(pktType);
+    AnimationTraceElement element(pktType);
     element.AddAttribute("uId", animUid);
     element.AddAttribute("tId", tId);
     element.AddAttribute("fbRx", fbRx);
     element.AddAttribute("lbRx", lbRx);
-    WriteN(element.ToString(), m_f);
+    Write(element, m_writer);
 }
 
 void
@@ -2537,7 +2529,7 @@ AnimationInterface::WriteXmlP(std::string pktType,
                               double lbRx,
                               std::string metaInfo)
 {
-    AnimXmlElement element(pktType);
+    AnimationTraceElement element(pktType);
     element.AddAttribute("fId", fId);
     element.AddAttribute("fbTx", fbTx);
     element.AddAttribute("lbTx", lbTx);
@@ -2548,7 +2540,7 @@ AnimationInterface::WriteXmlP(std::string pktType,
     element.AddAttribute("tId", tId);
     element.AddAttribute("fbRx", fbRx);
     element.AddAttribute("lbRx", lbRx);
-    WriteN(element.ToString(), m_f);
+    Write(element, m_writer);
 }
 
 void
@@ -2556,74 +2548,74 @@ AnimationInterface::WriteXmlAddNodeCounter(uint32_t nodeCounterId,
                                            std::string counterName,
                                            CounterType counterType)
 {
-    AnimXmlElement element("ncs");
+    AnimationTraceElement element("ncs");
     element.AddAttribute("ncId", nodeCounterId);
     element.AddAttribute("n", counterName);
     element.AddAttribute("t", CounterTypeToString(counterType));
-    WriteN(element.ToString(), m_f);
+    Write(element, m_writer);
 }
 
 void
 AnimationInterface::WriteXmlAddResource(uint32_t resourceId, std::string resourcePath)
 {
-    AnimXmlElement element("res");
+    AnimationTraceElement element("res");
     element.AddAttribute("rid", resourceId);
     element.AddAttribute("p", resourcePath);
-    WriteN(element.ToString(), m_f);
+    Write(element, m_writer);
 }
 
 void
 AnimationInterface::WriteXmlUpdateNodeImage(uint32_t nodeId, uint32_t resourceId)
 {
-    AnimXmlElement element("nu");
+    AnimationTraceElement element("nu");
     element.AddAttribute("p", "i");
     element.AddAttribute("t", Simulator::Now().GetSeconds());
     element.AddAttribute("id", nodeId);
     element.AddAttribute("rid", resourceId);
-    WriteN(element.ToString(), m_f);
+    Write(element, m_writer);
 }
 
 void
 AnimationInterface::WriteXmlUpdateNodeSize(uint32_t nodeId, double width, double height)
 {
-    AnimXmlElement element("nu");
+    AnimationTraceElement element("nu");
     element.AddAttribute("p", "s");
     element.AddAttribute("t", Simulator::Now().GetSeconds());
     element.AddAttribute("id", nodeId);
     element.AddAttribute("w", width);
     element.AddAttribute("h", height);
-    WriteN(element.ToString(), m_f);
+    Write(element, m_writer);
 }
 
 void
 AnimationInterface::WriteXmlUpdateNodePosition(uint32_t nodeId, double x, double y)
 {
-    AnimXmlElement element("nu");
+    AnimationTraceElement element("nu");
     element.AddAttribute("p", "p");
     element.AddAttribute("t", Simulator::Now().GetSeconds());
     element.AddAttribute("id", nodeId);
     element.AddAttribute("x", x);
     element.AddAttribute("y", y);
-    WriteN(element.ToString(), m_f);
+    Write(element, m_writer);
 }
 
 void
 AnimationInterface::WriteXmlUpdateNodeColor(uint32_t nodeId, uint8_t r, uint8_t g, uint8_t b)
 {
-    AnimXmlElement element("nu");
+    AnimationTraceElement element("nu");
     element.AddAttribute("p", "c");
     element.AddAttribute("t", Simulator::Now().GetSeconds());
     element.AddAttribute("id", nodeId);
     element.AddAttribute("r", (uint32_t)r);
     element.AddAttribute("g", (uint32_t)g);
     element.AddAttribute("b", (uint32_t)b);
-    WriteN(element.ToString(), m_f);
+    Write(element, m_writer);
 }
 
 void
 AnimationInterface::WriteXmlUpdateNodeDescription(uint32_t nodeId)
 {
-    AnimXmlElement element("nu");
+    AnimationTraceElement element("nu");
     element.AddAttribute("p", "d");
     element.AddAttribute("t", Simulator::Now().GetSeconds());
     element.AddAttribute("id", nodeId);
@@ -2631,7 +2623,7 @@ AnimationInterface::WriteXmlUpdateNodeDescription(uint32_t nodeId)
     {
         element.AddAttribute("descr", m_nodeDescriptions[nodeId], true);
     }
-    WriteN(element.ToString(), m_f);
+    Write(element, m_writer);
 }
 
 void
@@ -2639,12 +2631,12 @@ AnimationInterface::WriteXmlUpdateNodeCounter(uint32_t nodeCounterId,
                                               uint32_t nodeId,
                                               double counterValue)
 {
-    AnimXmlElement element("nc");
+    AnimationTraceElement element("nc");
     element.AddAttribute("c", nodeCounterId);
     element.AddAttribute("i", nodeId);
     element.AddAttribute("t", Simulator::Now().GetSeconds());
     element.AddAttribute("v", counterValue);
-    WriteN(element.ToString(), m_f);
+    Write(element, m_writer);
 }
 
 void
@@ -2655,14 +2647,14 @@ AnimationInterface::WriteXmlUpdateBackground(std::string fileName,
                                              double scaleY,
                                              double opacity)
 {
-    AnimXmlElement element("bg");
+    AnimationTraceElement element("bg");
     element.AddAttribute("f", fileName);
     element.AddAttribute("x", x);
     element.AddAttribute("y", y);
     element.AddAttribute("sx", scaleX);
     element.AddAttribute("sy", scaleY);
     element.AddAttribute("o", opacity);
-    WriteN(element.ToString(), m_f);
+    Write(element, m_writer);
 }
 
 void
@@ -2670,116 +2662,11 @@ AnimationInterface::WriteXmlNonP2pLinkProperties(uint32_t id,
                                                  std::string ipAddress,
                                                  std::string channelType)
 {
-    AnimXmlElement element("nonp2plinkproperties");
+    AnimationTraceElement element("nonp2plinkproperties");
     element.AddAttribute("id", id);
     element.AddAttribute("ipAddress", ipAddress);
     element.AddAttribute("channelType", channelType);
-    WriteN(element.ToString(), m_f);
-}
-
-/***** AnimXmlElement  *****/
-
-AnimationInterface::AnimXmlElement::AnimXmlElement(std::string tagName, bool emptyElement)
-    : m_tagName(tagName),
-      m_text("")
-{
-}
-
-template <typename T>
-void
-AnimationInterface::AnimXmlElement::AddAttribute(std::string attribute, T value, bool xmlEscape)
-{
-    std::ostringstream oss;
-    oss << std::setprecision(10);
-    oss << value;
-    std::string attributeString = attribute;
-    if (xmlEscape)
-    {
-        attributeString += "=\"";
-        std::string valueStr = oss.str();
-        for (auto it = valueStr.begin(); it != valueStr.end(); ++it)
-        {
-            switch (*it)
-            {
-            case '&':
-                attributeString += "&amp;";
-                break;
-            case '\"':
-                attributeString += "&quot;";
-                break;
-            case '\'':
-                attributeString += "&apos;";
-                break;
-            case '<':
-                attributeString += "&lt;";
-                break;
-            case '>':
-                attributeString += "&gt;";
-                break;
-            default:
-                attributeString += *it;
-                break;
-            }
-        }
-        attributeString += "\" ";
-    }
-    else
-    {
-        attributeString += "=\"" + oss.str() + "\" ";
-    }
-    m_attributes.push_back(attributeString);
-}
-
-void
-AnimationInterface::AnimXmlElement::AppendChild(AnimXmlElement e)
-{
-    m_children.push_back(e.ToString());
-}
-
-void
-AnimationInterface::AnimXmlElement::SetText(std::string text)
-{
-    m_text = text;
-}
-
-std::string
-AnimationInterface::AnimXmlElement::ToString(bool autoClose)
-{
-    std::string elementString = "<" + m_tagName + " ";
-
-    for (auto i = m_attributes.begin(); i != m_attributes.end(); ++i)
-    {
-        elementString += *i;
-    }
-    if (m_children.empty() && m_text.empty())
-    {
-        if (autoClose)
-        {
-            elementString += "/>";
-        }
-    }
-    else
-    {
-        elementString += ">";
-        if (!m_text.empty())
-        {
-            elementString += m_text;
-        }
-        if (!m_children.empty())
-        {
-            elementString += "\n";
-            for (auto i = m_children.begin(); i != m_children.end(); ++i)
-            {
-                elementString += *i + "\n";
-            }
-        }
-        if (autoClose)
-        {
-            elementString += "</" + m_tagName + ">";
-        }
-    }
-
-    return elementString + ((autoClose) ? "\n" : "");
+    Write(element, m_writer);
 }
 
 /***** AnimByteTag *****/
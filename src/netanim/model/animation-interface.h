@@ -12,6 +12,8 @@
 #ifndef ANIMATION_INTERFACE__H
 #define ANIMATION_INTERFACE__H
 
+#include "animation-trace-writer.h"
+
 #include "ns3/config.h"
 #include "ns3/ipv4-l3-protocol.h"
 #include "ns3/ipv4.h"
@@ -79,9 +81,13 @@ class AnimationInterface
     /**
      * @brief Constructor
      * @param filename The Filename for the trace file used by the Animator
+     * @param format The format of the trace file; a binary trace is smaller and
+     *        faster to write, and is converted to the XML read by NetAnim with
+     *        the netanim-convert utility
      *
      */
-    AnimationInterface(const std::string filename);
+    AnimationInterface(const std::string filename,
+                       AnimationTraceWriter::Format format = AnimationTraceWriter::XML);
 
     /**
      * Counter Types
@@ -225,6 +231,16 @@ class AnimationInterface
      */
     void SetMobilityPollInterval(Time t);
 
+    /**
+     * @brief Set the displacement of a node after which its position is written
+     *
+     * @param threshold The distance in meters between the current position of a node
+     * and its last written position above which the position is written again.
+     * Default: 0, to write the position whenever it changes at the precision of a meter
+     *
+     */
+    void SetMobilityDisplacementThreshold(double threshold);
+
     /**
      * @brief Set a callback function to listen to AnimationInterface write events
      *
@@ -559,54 +575,13 @@ class AnimationInterface
     // Node Counters
     typedef std::map<uint32_t, uint64_t> NodeCounterMap64; ///< NodeCounterMap64 typedef
 
-    /// AnimXmlElement class
-    class AnimXmlElement
-    {
-      public:
-        /**
-         * Constructor
-         *
-         * @param tagName tag name
-         * @param emptyElement empty element?
-         */
-        AnimXmlElement(std::string tagName, bool emptyElement = true);
-        template <typename T>
-        /**
-         * Add attribute function
-         * @param attribute the attribute name
-         * @param value the attribute value
-         * @param xmlEscape true to escape
-         */
-        void AddAttribute(std::string attribute, T value, bool xmlEscape = false);
-        /**
-         * Set text function
-         * @param text the text for the element
-         */
-        void SetText(std::string text);
-        /**
-         * Append child function
-         * @param e the element to add as a child
-         */
-        void AppendChild(AnimXmlElement e);
-        /**
-         * Get text for the element function
-         * @param autoClose auto close the element
-         * @returns the text
-         */
-        std::string ToString(bool autoClose = true);
-
-      private:
-        std::string m_tagName;                 ///< tag name
-        std::string m_text;                    ///< element string
-        std::vector<std::string> m_attributes; ///< list of attributes
-        std::vector<std::string> m_children;   ///< list of children
-    };
-
     // ##### State #####
 
-    FILE* m_f;                             ///< File handle for output (0 if none)
-    FILE* m_routingF;                      ///< File handle for routing table output (0 if None);
+    AnimationTraceWriter m_writer;         ///< Writer of the trace file
+    AnimationTraceWriter m_routingWriter;  ///< Writer of the routing table trace file
+    AnimationTraceWriter::Format m_format; ///< Format of the trace files
     Time m_mobilityPollInterval;           ///< mobility poll interval
+    double m_mobilityThreshold;            ///< displacement after which a position is written
     std::string m_outputFileName;          ///< output file name
     uint64_t gAnimUid;                     ///< Packet unique identifier used by AnimationInterface
     AnimWriteCallback m_writeCallback;     ///< write callback
@@ -749,20 +724,11 @@ class AnimationInterface
      */
     void AddByteTag(uint64_t animUid, Ptr<const Packet> p);
     /**
-     * WriteN function
-     * @param data the data t write
-     * @param count the number of bytes to write
-     * @param f the file to write to
-     * @returns the number of bytes written
-     */
-    int WriteN(const char* data, uint32_t count, FILE* f);
-    /**
-     * WriteN function
-     * @param st the string to output
-     * @param f the file to write to
-     * @returns the number of bytes written
+     * Write function
+     * @param element the element to write
+     * @param writer the writer of the trace file, which may be closed
      */
-    int WriteN(const std::string& st, FILE* f);
+    void Write(const AnimationTraceElement& element, AnimationTraceWriter& writer);
     /**
      * Get MAC address function
      * @param nd the device
@@ -0,0 +1,801 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "animation-trace-writer.h"
+
+#include "ns3/assert.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <functional>
+
+/**
+ * @file
+ * @ingroup netanim
+ * ns3::AnimationTraceElement and ns3::AnimationTraceWriter implementations.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("AnimationTraceWriter");
+
+namespace
+{
+
+/// Magic bytes at the start of a binary trace
+const char BINARY_MAGIC[] = "NS3ANIMB";
+/// Size of the magic bytes
+const std::size_t BINARY_MAGIC_SIZE = 8;
+/// Version of the binary format
+const char BINARY_VERSION = 1;
+/// Size of the buffer handed over to the writer thread
+const std::size_t BUFFER_SIZE = 1 << 20;
+/// Maximum length of the attribute values added to the dictionary
+const std::size_t MAX_DICTIONARY_STRING = 32;
+/// Maximum number of strings in the dictionary
+const std::size_t MAX_DICTIONARY_SIZE = 1 << 16;
+
+/// Types of the attribute values in the binary format
+enum ValueType : uint8_t
+{
+    DICTIONARY_STRING = 0,
+    INLINE_STRING = 1,
+    UNSIGNED = 2,
+    SIGNED = 3,
+    DOUBLE = 4,
+    INTEGRAL_DOUBLE = 5,
+    REPEATED_DOUBLE = 6,
+    SHORT_DOUBLE = 7,
+    RECENT_DOUBLE = 8,
+};
+
+/// Number of recent double values that can be referred to
+const uint32_t N_RECENT_DOUBLES = 8;
+
+/**
+ * Reverse the bytes of a 64-bit value
+ * @param value the value
+ * @returns the value with its bytes reversed
+ */
+uint64_t
+ByteSwap(uint64_t value)
+{
+    uint64_t swapped = 0;
+    for (uint32_t byte = 0; byte < 8; ++byte)
+    {
+        swapped = (swapped << 8) | ((value >> (8 * byte)) & 0xff);
+    }
+    return swapped;
+}
+
+/**
+ * Get the zigzag encoding of a signed integer
+ * @param value the integer
+ * @returns the encoding, where the small absolute values are small
+ */
+uint64_t
+ZigZag(int64_t value)
+{
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+/**
+ * Decode a zigzag encoded signed integer
+ * @param value the encoding
+ * @returns the integer
+ */
+int64_t
+UnZigZag(uint64_t value)
+{
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+/**
+ * Get the bits of a double
+ * @param value the double
+ * @returns the bits
+ */
+uint64_t
+DoubleBits(double value)
+{
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+/// Reader of a binary trace
+class BinaryTraceReader
+{
+  public:
+    /**
+     * Constructor
+     * @param is the input stream of the binary trace
+     */
+    BinaryTraceReader(std::istream& is)
+        : m_is(is)
+    {
+    }
+
+    /**
+     * Read a byte
+     * @param [out] byte the byte
+     * @returns false at the end of the stream
+     */
+    bool GetByte(uint8_t& byte)
+    {
+        int c = m_is.get();
+        if (c == std::char_traits<char>::eof())
+        {
+            return false;
+        }
+        byte = static_cast<uint8_t>(c);
+        return true;
+    }
+
+    /**
+     * Read an unsigned integer in LEB128 encoding
+     * @param [out] value the integer
+     * @returns false if the stream is truncated or invalid
+     */
+    bool GetVarint(uint64_t& value)
+    {
+        value = 0;
+        for (uint32_t shift = 0; shift < 64; shift += 7)
+        {
+            uint8_t byte;
+            if (!GetByte(byte))
+            {
+                return false;
+            }
+            value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+            if ((byte & 0x80) == 0)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Read a string
+     * @param [out] text the string
+     * @returns false if the stream is truncated
+     */
+    bool GetString(std::string& text)
+    {
+        uint64_t size;
+        if (!GetVarint(size))
+        {
+            return false;
+        }
+        text.resize(size);
+        return size == 0 || static_cast<bool>(m_is.read(text.data(), size));
+    }
+
+    /**
+     * Read the dictionary index of a string
+     * @param [out] text the string
+     * @returns false if the stream is truncated or the index is invalid
+     */
+    bool GetDictionaryString(std::string& text)
+    {
+        uint64_t index;
+        if (!GetVarint(index) || index >= m_dictionary.size())
+        {
+            return false;
+        }
+        text = m_dictionary[index];
+        return true;
+    }
+
+    std::istream& m_is;                    //!< the input stream
+    std::vector<std::string> m_dictionary; //!< the dictionary strings
+    std::unordered_map<std::string, double> m_lastDouble; //!< last double, by attribute name
+    std::vector<double> m_recentDoubles;                  //!< recent doubles, the last one first
+};
+
+} // namespace
+
+/***** AnimationTraceElement *****/
+
+AnimationTraceElement::AnimationTraceElement(std::string tagName)
+    : m_tagName(tagName),
+      m_text("")
+{
+}
+
+std::string
+AnimationTraceElement::Escape(const std::string& text)
+{
+    std::string escaped;
+    for (auto it = text.begin(); it != text.end(); ++it)
+    {
+        switch (*it)
+        {
+        case '&':
+            escaped += "&amp;";
+            break;
+        case '\"':
+            escaped += "&quot;";
+            break;
+        case '\'':
+            escaped += "&apos;";
+            break;
+        case '<':
+            escaped += "&lt;";
+            break;
+        case '>':
+            escaped += "&gt;";
+            break;
+        default:
+            escaped += *it;
+            break;
+        }
+    }
+    return escaped;
+}
+
+void
+AnimationTraceElement::AppendChild(AnimationTraceElement e)
+{
+    m_children.push_back(std::move(e));
+}
+
+void
+AnimationTraceElement::SetText(std::string text)
+{
+    m_text = text;
+}
+
+std::string
+AnimationTraceElement::ToString(bool autoClose) const
+{
+    std::string elementString = "<" + m_tagName + " ";
+
+    std::ostringstream oss;
+    oss << std::setprecision(10);
+    for (const auto& attribute : m_attributes)
+    {
+        elementString += attribute.name + "=\"";
+        if (const auto text = std::get_if<std::string>(&attribute.value))
+        {
+            elementString += *text;
+        }
+        else
+        {
+            oss.str("");
+            std::visit(
+                [&oss](const auto& value) {
+                    if constexpr (!std::is_same_v<std::decay_t<decltype(value)>, std::string>)
+                    {
+                        oss << value;
+                    }
+                },
+                attribute.value);
+            elementString += oss.str();
+        }
+        elementString += "\" ";
+    }
+    if (m_children.empty() && m_text.empty())
+    {
+        if (autoClose)
+        {
+            elementString += "/>";
+        }
+    }
+    else
+    {
+        elementString += ">";
+        if (!m_text.empty())
+        {
+            elementString += m_text;
+        }
+        if (!m_children.empty())
+        {
+            elementString += "\n";
+            for (const auto& child : m_children)
+            {
+                elementString += child.ToString() + "\n";
+            }
+        }
+        if (autoClose)
+        {
+            elementString += "</" + m_tagName + ">";
+        }
+    }
+
+    return elementString + ((autoClose) ? "\n" : "");
+}
+
+/***** AnimationTraceWriter *****/
+
+AnimationTraceWriter::AnimationTraceWriter()
+    : m_file(nullptr),
+      m_format(XML),
+      m_pendingFull(false),
+      m_stop(false),
+      m_recentDoubles{},
+      m_nRecentDoubles(0)
+{
+}
+
+AnimationTraceWriter::~AnimationTraceWriter()
+{
+    Close();
+}
+
+bool
+AnimationTraceWriter::Open(const std::string& fileName, Format format)
+{
+    NS_LOG_FUNCTION(this << fileName << format);
+    NS_ASSERT_MSG(!m_file, "Trace file already open");
+    m_file = std::fopen(fileName.c_str(), "w");
+    if (!m_file)
+    {
+        return false;
+    }
+    m_format = format;
+    m_buffer.reserve(BUFFER_SIZE);
+    m_pending.reserve(BUFFER_SIZE);
+    m_pendingFull = false;
+    m_stop = false;
+    m_dictionary.clear();
+    m_lastDouble.clear();
+    m_hasLastDouble.clear();
+    m_nRecentDoubles = 0;
+    if (m_format == BINARY)
+    {
+        m_buffer.append(BINARY_MAGIC, BINARY_MAGIC_SIZE);
+        m_buffer += BINARY_VERSION;
+    }
+    m_thread = std::thread(&AnimationTraceWriter::Run, this);
+    return true;
+}
+
+bool
+AnimationTraceWriter::IsOpen() const
+{
+    return m_file != nullptr;
+}
+
+void
+AnimationTraceWriter::Flush()
+{
+    std::unique_lock lock(m_mutex);
+    // Wait for the writer thread to be done with the previous buffer
+    m_cond.wait(lock, [this] { return !m_pendingFull; });
+    std::swap(m_buffer, m_pending);
+    m_pendingFull = true;
+    m_cond.notify_all();
+}
+
+void
+AnimationTraceWriter::Run()
+{
+    std::unique_lock lock(m_mutex);
+    while (true)
+    {
+        m_cond.wait(lock, [this] { return m_pendingFull || m_stop; });
+        if (m_pendingFull)
+        {
+            // The simulation thread does not touch the pending buffer until it is released
+            lock.unlock();
+            std::fwrite(m_pending.data(), 1, m_pending.size(), m_file);
+            m_pending.clear();
+            lock.lock();
+            m_pendingFull = false;
+            m_cond.notify_all();
+        }
+        else
+        {
+            return;
+        }
+    }
+}
+
+void
+AnimationTraceWriter::Close()
+{
+    if (!m_file)
+    {
+        return;
+    }
+    NS_LOG_FUNCTION(this);
+    Flush();
+    {
+        std::lock_guard lock(m_mutex);
+        m_stop = true;
+        m_cond.notify_all();
+    }
+    m_thread.join();
+    std::fclose(m_file);
+    m_file = nullptr;
+}
+
+void
+AnimationTraceWriter::Write(const AnimationTraceElement& element)
+{
+    if (m_format == XML)
+    {
+        m_buffer += element.ToString();
+    }
+    else
+    {
+        DefineStrings(element);
+        m_buffer += 'E';
+        PutElement(element);
+    }
+    if (m_buffer.size() >= BUFFER_SIZE)
+    {
+        Flush();
+    }
+}
+
+void
+AnimationTraceWriter::WriteStart(const AnimationTraceElement& element)
+{
+    if (m_format == XML)
+    {
+        m_buffer += element.ToString(false) + ">\n";
+    }
+    else
+    {
+        DefineStrings(element);
+        m_buffer += 'O';
+        PutElement(element);
+    }
+}
+
+void
+AnimationTraceWriter::WriteEnd(const std::string& tagName)
+{
+    if (m_format == XML)
+    {
+        m_buffer += "</" + tagName + ">\n";
+    }
+    else
+    {
+        int64_t index = Intern(tagName, true);
+        m_buffer += 'C';
+        PutVarint(index);
+    }
+}
+
+void
+AnimationTraceWriter::PutVarint(uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        m_buffer += static_cast<char>((value & 0x7f) | 0x80);
+        value >>= 7;
+    }
+    m_buffer += static_cast<char>(value);
+}
+
+void
+AnimationTraceWriter::PutString(const std::string& text)
+{
+    PutVarint(text.size());
+    m_buffer += text;
+}
+
+int64_t
+AnimationTraceWriter::Intern(const std::string& text, bool force)
+{
+    auto it = m_dictionary.find(text);
+    if (it != m_dictionary.end())
+    {
+        return it->second;
+    }
+    if (!force &&
+        (text.size() > MAX_DICTIONARY_STRING || m_dictionary.size() >= MAX_DICTIONARY_SIZE))
+    {
+        return -1;
+    }
+    uint32_t index = m_dictionary.size();
+    m_dictionary.emplace(text, index);
+    m_buffer += 'S';
+    PutString(text);
+    return index;
+}
+
+void
+AnimationTraceWriter::DefineStrings(const AnimationTraceElement& element)
+{
+    Intern(element.m_tagName, true);
+    for (const auto& attribute : element.m_attributes)
+    {
+        Intern(attribute.name, true);
+        if (const auto text = std::get_if<std::string>(&attribute.value))
+        {
+            Intern(*text, false);
+        }
+    }
+    for (const auto& child : element.m_children)
+    {
+        DefineStrings(child);
+    }
+    if (m_lastDouble.size() < m_dictionary.size())
+    {
+        m_lastDouble.resize(m_dictionary.size());
+        m_hasLastDouble.resize(m_dictionary.size(), false);
+    }
+}
+
+void
+AnimationTraceWriter::PutElement(const AnimationTraceElement& element)
+{
+    PutVarint(m_dictionary.at(element.m_tagName));
+    PutVarint(element.m_attributes.size());
+    for (const auto& attribute : element.m_attributes)
+    {
+        const uint32_t name = m_dictionary.at(attribute.name);
+        PutVarint(name);
+        if (const auto text = std::get_if<std::string>(&attribute.value))
+        {
+            if (auto it = m_dictionary.find(*text); it != m_dictionary.end())
+            {
+                m_buffer += static_cast<char>(DICTIONARY_STRING);
+                PutVarint(it->second);
+            }
+            else
+            {
+                m_buffer += static_cast<char>(INLINE_STRING);
+                PutString(*text);
+            }
+        }
+        else if (const auto u = std::get_if<uint64_t>(&attribute.value))
+        {
+            m_buffer += static_cast<char>(UNSIGNED);
+            PutVarint(*u);
+        }
+        else if (const auto s = std::get_if<int64_t>(&attribute.value))
+        {
+            m_buffer += static_cast<char>(SIGNED);
+            PutVarint(ZigZag(*s));
+        }
+        else
+        {
+            double d = std::get<double>(attribute.value);
+            uint64_t bits = DoubleBits(d);
+            uint32_t recent = 0;
+            while (recent < std::min<uint64_t>(m_nRecentDoubles, N_RECENT_DOUBLES) &&
+                   m_recentDoubles[(m_nRecentDoubles - 1 - recent) % N_RECENT_DOUBLES] != bits)
+            {
+                ++recent;
+            }
+            // the low bytes of the mantissa of the decimal numbers with few
+            // digits are often zero, and hence so are the high bytes once swapped
+            uint64_t swapped = ByteSwap(bits);
+            if (m_hasLastDouble[name] && DoubleBits(m_lastDouble[name]) == bits)
+            {
+                m_buffer += static_cast<char>(REPEATED_DOUBLE);
+            }
+            else if (recent < std::min<uint64_t>(m_nRecentDoubles, N_RECENT_DOUBLES))
+            {
+                m_buffer += static_cast<char>(RECENT_DOUBLE + recent);
+            }
+            else if (std::trunc(d) == d && std::fabs(d) < 9007199254740992.0 &&
+                     !(d == 0 && std::signbit(d)))
+            {
+                // integers up to 2^53 are exact in a double, and hence also the conversion back
+                m_buffer += static_cast<char>(INTEGRAL_DOUBLE);
+                PutVarint(ZigZag(static_cast<int64_t>(d)));
+            }
+            else if (swapped < (uint64_t{1} << 49))
+            {
+                // at most 7 bytes as a varint
+                m_buffer += static_cast<char>(SHORT_DOUBLE);
+                PutVarint(swapped);
+            }
+            else
+            {
+                m_buffer += static_cast<char>(DOUBLE);
+                for (uint32_t byte = 0; byte < 8; ++byte)
+                {
+                    m_buffer += static_cast<char>(bits >> (8 * byte));
+                }
+            }
+            m_lastDouble[name] = d;
+            m_hasLastDouble[name] = true;
+            m_recentDoubles[m_nRecentDoubles++ % N_RECENT_DOUBLES] = bits;
+        }
+    }
+    PutVarint(element.m_children.size());
+    for (const auto& child : element.m_children)
+    {
+        PutElement(child);
+    }
+    PutString(element.m_text);
+}
+
+bool
+AnimationTraceWriter::ConvertToXml(std::istream& is, std::ostream& os)
+{
+    NS_LOG_FUNCTION(&is << &os);
+    char header[BINARY_MAGIC_SIZE + 1];
+    if (!is.read(header, sizeof(header)) ||
+        std::memcmp(header, BINARY_MAGIC, BINARY_MAGIC_SIZE) != 0 ||
+        header[BINARY_MAGIC_SIZE] != BINARY_VERSION)
+    {
+        NS_LOG_WARN("Not a binary animation trace");
+        return false;
+    }
+
+    BinaryTraceReader reader(is);
+
+    // Read an element; the dictionary strings were all defined before it
+    std::function<bool(AnimationTraceElement&)> getElement;
+    getElement = [&reader, &getElement](AnimationTraceElement& element) {
+        uint64_t count;
+        if (!reader.GetDictionaryString(element.m_tagName) || !reader.GetVarint(count))
+        {
+            return false;
+        }
+        for (uint64_t i = 0; i < count; ++i)
+        {
+            AnimationTraceElement::Attribute attribute;
+            uint8_t type;
+            if (!reader.GetDictionaryString(attribute.name) || !reader.GetByte(type))
+            {
+                return false;
+            }
+            uint64_t u;
+            std::string text;
+            switch (type)
+            {
+            case DICTIONARY_STRING:
+                if (!reader.GetDictionaryString(text))
+                {
+                    return false;
+                }
+                attribute.value = text;
+                break;
+            case INLINE_STRING:
+                if (!reader.GetString(text))
+                {
+                    return false;
+                }
+                attribute.value = text;
+                break;
+            case UNSIGNED:
+                if (!reader.GetVarint(u))
+                {
+                    return false;
+                }
+                attribute.value = u;
+                break;
+            case SIGNED:
+                if (!reader.GetVarint(u))
+                {
+                    return false;
+                }
+                attribute.value = UnZigZag(u);
+                break;
+            case DOUBLE: {
+                uint64_t bits = 0;
+                for (uint32_t byte = 0; byte < 8; ++byte)
+                {
+                    uint8_t b;
+                    if (!reader.GetByte(b))
+                    {
+                        return false;
+                    }
+                    bits |= static_cast<uint64_t>(b) << (8 * byte);
+                }
+                double d;
+                std::memcpy(&d, &bits, sizeof(d));
+                attribute.value = d;
+                break;
+            }
+            case INTEGRAL_DOUBLE:
+                if (!reader.GetVarint(u))
+                {
+                    return false;
+                }
+                attribute.value = static_cast<double>(UnZigZag(u));
+                break;
+            case SHORT_DOUBLE: {
+                if (!reader.GetVarint(u))
+                {
+                    return false;
+                }
+                uint64_t bits = ByteSwap(u);
+                double d;
+                std::memcpy(&d, &bits, sizeof(d));
+                attribute.value = d;
+                break;
+            }
+            case REPEATED_DOUBLE: {
+                auto it = reader.m_lastDouble.find(attribute.name);
+                if (it == reader.m_lastDouble.end())
+                {
+                    return false;
+                }
+                attribute.value = it->second;
+                break;
+            }
+            default:
+                if (type < RECENT_DOUBLE || type >= RECENT_DOUBLE + N_RECENT_DOUBLES ||
+                    type - RECENT_DOUBLE >= static_cast<int>(reader.m_recentDoubles.size()))
+                {
+                    return false;
+                }
+                attribute.value = reader.m_recentDoubles[type - RECENT_DOUBLE];
+                break;
+            }
+            if (const auto d = std::get_if<double>(&attribute.value))
+            {
+                reader.m_lastDouble[attribute.name] = *d;
+                reader.m_recentDoubles.insert(reader.m_recentDoubles.begin(), *d);
+                if (reader.m_recentDoubles.size() > N_RECENT_DOUBLES)
+                {
+                    reader.m_recentDoubles.pop_back();
+                }
+            }
+            element.m_attributes.push_back(std::move(attribute));
+        }
+        if (!reader.GetVarint(count))
+        {
+            return false;
+        }
+        for (uint64_t i = 0; i < count; ++i)
+        {
+            AnimationTraceElement child("");
+            if (!getElement(child))
+            {
+                return false;
+            }
+            element.m_children.push_back(std::move(child));
+        }
+        return reader.GetString(element.m_text);
+    };
+
+    uint8_t type;
+    while (reader.GetByte(type))
+    {
+        std::string text;
+        AnimationTraceElement element("");
+        switch (type)
+        {
+        case 'S':
+            if (!reader.GetString(text))
+            {
+                return false;
+            }
+            reader.m_dictionary.push_back(text);
+            break;
+        case 'E':
+            if (!getElement(element))
+            {
+                return false;
+            }
+            os << element.ToString();
+            break;
+        case 'O':
+            if (!getElement(element))
+            {
+                return false;
+            }
+            os << element.ToString(false) << ">\n";
+            break;
+        case 'C':
+            if (!reader.GetDictionaryString(text))
+            {
+                return false;
+            }
+            os << "</" << text << ">\n";
+            break;
+        default:
+            NS_LOG_WARN("Invalid record type " << static_cast<uint32_t>(type));
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace ns3
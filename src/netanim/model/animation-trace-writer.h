@@ -0,0 +1,291 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef ANIMATION_TRACE_WRITER_H
+#define ANIMATION_TRACE_WRITER_H
+
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+/**
+ * @file
+ * @ingroup netanim
+ * ns3::AnimationTraceElement and ns3::AnimationTraceWriter declarations.
+ */
+
+namespace ns3
+{
+
+/**
+ * @ingroup netanim
+ *
+ * @brief An XML element of an animation trace
+ *
+ * The attribute values keep their type, so that they can be written
+ * either as XML text or in the binary format of AnimationTraceWriter.
+ */
+class AnimationTraceElement
+{
+  public:
+    /**
+     * Constructor
+     *
+     * @param tagName tag name
+     */
+    AnimationTraceElement(std::string tagName);
+
+    /**
+     * Add attribute function
+     * @param attribute the attribute name
+     * @param value the attribute value
+     * @param xmlEscape true to escape
+     */
+    template <typename T>
+    void AddAttribute(std::string attribute, T value, bool xmlEscape = false);
+    /**
+     * Set text function
+     * @param text the text for the element
+     */
+    void SetText(std::string text);
+    /**
+     * Append child function
+     * @param e the element to add as a child
+     */
+    void AppendChild(AnimationTraceElement e);
+    /**
+     * Get text for the element function
+     * @param autoClose auto close the element
+     * @returns the text
+     */
+    std::string ToString(bool autoClose = true) const;
+
+  private:
+    friend class AnimationTraceWriter;
+
+    /// Value of an attribute: a string, an unsigned or signed integer, or a double
+    typedef std::variant<std::string, uint64_t, int64_t, double> Value;
+
+    /// An attribute
+    struct Attribute
+    {
+        std::string name; ///< attribute name
+        Value value;      ///< attribute value, already escaped if a string
+    };
+
+    /**
+     * Escape the XML special characters of a string
+     * @param text the string
+     * @returns the escaped string
+     */
+    static std::string Escape(const std::string& text);
+
+    std::string m_tagName;                         ///< tag name
+    std::string m_text;                            ///< element string
+    std::vector<Attribute> m_attributes;           ///< list of attributes
+    std::vector<AnimationTraceElement> m_children; ///< list of children
+};
+
+/**
+ * @ingroup netanim
+ *
+ * @brief Writer of an animation trace file
+ *
+ * The elements are appended to an in-memory buffer, which is handed over
+ * to a background thread writing it to the file when it is full, while
+ * the elements are appended to a second buffer.  The simulation hence
+ * does not wait for the file writes, unless it produces the trace faster
+ * than it can be written.
+ *
+ * The trace is written either as the XML read by NetAnim, or in a binary
+ * format that is typically less than half as large and faster to produce,
+ * and that ConvertToXml() expands into the same XML.  The binary format
+ * is a header, the 8 bytes "NS3ANIMB" and a version byte, followed by
+ * records, each starting with a type byte:
+ *
+ *  - 'S' \<string\>: add a string to the dictionary, at the next index;
+ *  - 'E' \<element\>: an element;
+ *  - 'O' \<element\>: the start tag of an element, for the root element;
+ *  - 'C' \<varint\>: the end tag of the element whose tag name is the
+ *    dictionary string at this index.
+ *
+ * An \<element\> is the dictionary index of its tag name, the number of
+ * attributes, the attributes, the number of children, the children
+ * elements and the text \<string\>.  An attribute is the dictionary index
+ * of its name, a type byte and the value:
+ *
+ *  - 0: a string, as the \<varint\> dictionary index of the string;
+ *  - 1: a \<string\>;
+ *  - 2: an unsigned integer, as a \<varint\>;
+ *  - 3: a signed integer, as a zigzag \<varint\>;
+ *  - 4: a double, as its 8 bytes in little-endian order;
+ *  - 5: a double holding an integer, as a zigzag \<varint\>;
+ *  - 6: a double equal to the previous double value of an attribute of
+ *    the same name, e.g., the time of the events at the same time;
+ *  - 7: a double, as its 8 bytes in big-endian order in a \<varint\>,
+ *    which is shorter when the low bytes of the mantissa are zero;
+ *  - 8 + k, with k < 8: a double equal to the (k+1)-th last double value,
+ *    e.g., the same time in another attribute.
+ *
+ * A \<varint\> is an unsigned integer in LEB128 encoding, and a \<string\>
+ * is its length as a \<varint\> followed by its bytes.  Only the short
+ * strings are added to the dictionary.
+ */
+class AnimationTraceWriter
+{
+  public:
+    /// Trace file formats
+    enum Format
+    {
+        XML,   ///< XML read by NetAnim
+        BINARY ///< binary format, converted to XML by ConvertToXml()
+    };
+
+    AnimationTraceWriter();
+    ~AnimationTraceWriter();
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    AnimationTraceWriter(const AnimationTraceWriter&) = delete;
+    AnimationTraceWriter& operator=(const AnimationTraceWriter&) = delete;
+
+    /**
+     * Open the trace file and start the writer thread
+     * @param fileName the file name
+     * @param format the format of the trace
+     * @returns true if the file was opened
+     */
+    bool Open(const std::string& fileName, Format format);
+
+    /// @returns true if a trace file is open
+    bool IsOpen() const;
+
+    /**
+     * Write an element
+     * @param element the element
+     */
+    void Write(const AnimationTraceElement& element);
+
+    /**
+     * Write the start tag of an element, followed by a newline
+     * @param element the element, whose children and text are ignored
+     */
+    void WriteStart(const AnimationTraceElement& element);
+
+    /**
+     * Write the end tag of an element, followed by a newline
+     * @param tagName the tag name of the element
+     */
+    void WriteEnd(const std::string& tagName);
+
+    /// Write the buffered elements, stop the writer thread and close the file
+    void Close();
+
+    /**
+     * Convert a binary trace to XML
+     * @param is the input stream of the binary trace
+     * @param os the output stream of the XML trace
+     * @returns false if the binary trace is invalid or truncated
+     */
+    static bool ConvertToXml(std::istream& is, std::ostream& os);
+
+  private:
+    /// Hand the filled buffer over to the writer thread
+    void Flush();
+    /// Write the buffers handed over, until Close() is called
+    void Run();
+
+    /**
+     * Append an unsigned integer in LEB128 encoding to the buffer
+     * @param value the integer
+     */
+    void PutVarint(uint64_t value);
+    /**
+     * Append a string to the buffer
+     * @param text the string
+     */
+    void PutString(const std::string& text);
+    /**
+     * Get the dictionary index of a string, adding it to the dictionary if needed
+     * @param text the string
+     * @param force add the string even if it is long or the dictionary is full
+     * @returns the index, or -1 if the string is not in the dictionary and
+     *          cannot be added
+     */
+    int64_t Intern(const std::string& text, bool force);
+    /**
+     * Add the strings of an element and its children to the dictionary,
+     * which must be done before the record of the element is started
+     * @param element the element
+     */
+    void DefineStrings(const AnimationTraceElement& element);
+    /**
+     * Append an element in binary format to the buffer
+     * @param element the element, whose strings are already defined
+     */
+    void PutElement(const AnimationTraceElement& element);
+
+    FILE* m_file;                   ///< the trace file, or nullptr if not open
+    Format m_format;                ///< the format of the trace
+    std::string m_buffer;           ///< the buffer the elements are appended to
+    std::string m_pending;          ///< the buffer handed over to the writer thread
+    bool m_pendingFull;             ///< whether the writer thread has a buffer to write
+    bool m_stop;                    ///< whether the writer thread must stop
+    std::thread m_thread;           ///< the writer thread
+    std::mutex m_mutex;             ///< mutex of the buffer handed over and the flags
+    std::condition_variable m_cond; ///< signals a change of the buffer handed over or flags
+
+    std::unordered_map<std::string, uint32_t> m_dictionary; ///< index of the dictionary strings
+
+    std::vector<double> m_lastDouble;        ///< last double value, by attribute name index
+    std::vector<bool> m_hasLastDouble;       ///< whether there is a last double value, by name
+    std::array<uint64_t, 8> m_recentDoubles; ///< bits of the last double values, in a ring
+    uint64_t m_nRecentDoubles;               ///< number of double values written
+};
+
+/***** Template implementations *****/
+
+template <typename T>
+void
+AnimationTraceElement::AddAttribute(std::string attribute, T value, bool xmlEscape)
+{
+    Attribute a;
+    a.name = attribute;
+    if constexpr (std::is_same_v<T, bool> ||
+                  (std::is_integral_v<T> && std::is_unsigned_v<T> && sizeof(T) > 1))
+    {
+        a.value = static_cast<uint64_t>(value);
+    }
+    else if constexpr (std::is_integral_v<T> && sizeof(T) > 1)
+    {
+        a.value = static_cast<int64_t>(value);
+    }
+    else if constexpr (std::is_floating_point_v<T>)
+    {
+        // the output operator of float converts it to a double too
+        a.value = static_cast<double>(value);
+    }
+    else
+    {
+        std::ostringstream oss;
+        oss << std::setprecision(10);
+        oss << value;
+        a.value = xmlEscape ? Escape(oss.str()) : oss.str();
+    }
+    m_attributes.push_back(std::move(a));
+}
+
+} // namespace ns3
+
+#endif /* ANIMATION_TRACE_WRITER_H */
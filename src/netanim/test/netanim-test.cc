@@ -13,6 +13,7 @@
 #include "ns3/basic-energy-source.h"
 #include "ns3/core-module.h"
 #include "ns3/internet-module.h"
+#include "ns3/mobility-module.h"
 #include "ns3/netanim-module.h"
 #include "ns3/network-module.h"
 #include "ns3/point-to-point-layout-module.h"
@@ -20,7 +21,10 @@
 #include "ns3/simple-device-energy-model.h"
 #include "ns3/udp-echo-helper.h"
 
+#include <fstream>
 #include <iostream>
+#include <limits>
+#include <sstream>
 
 using namespace ns3;
 using namespace ns3::energy;
@@ -231,6 +235,218 @@ AnimationRemainingEnergyTestCase::CheckLogic()
                               "Wrong remaining energy value was traced");
 }
 
+/**
+ * @ingroup netanim-test
+ *
+ * @brief Check that a binary trace is converted to the same XML as the XML trace
+ */
+class AnimationBinaryTraceTestCase : public TestCase
+{
+  public:
+    /**
+     * @brief Constructor.
+     */
+    AnimationBinaryTraceTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Write a trace with the elements of the test
+     * @param fileName the file name
+     * @param format the format of the trace
+     */
+    void WriteElements(const std::string& fileName, AnimationTraceWriter::Format format);
+
+    /**
+     * Run a scenario with moving nodes and packets
+     * @param fileName the trace file name
+     * @param format the format of the trace
+     * @param threshold the mobility displacement threshold
+     */
+    void RunScenario(const std::string& fileName,
+                     AnimationTraceWriter::Format format,
+                     double threshold);
+
+    /**
+     * Read a file
+     * @param fileName the file name
+     * @returns the content of the file
+     */
+    static std::string ReadFile(const std::string& fileName);
+
+    /**
+     * Convert a binary trace to XML
+     * @param fileName the binary trace file name
+     * @returns the XML trace
+     */
+    std::string Convert(const std::string& fileName);
+};
+
+AnimationBinaryTraceTestCase::AnimationBinaryTraceTestCase()
+    : TestCase("Verify the binary trace format and the mobility displacement threshold")
+{
+}
+
+void
+AnimationBinaryTraceTestCase::WriteElements(const std::string& fileName,
+                                            AnimationTraceWriter::Format format)
+{
+    AnimationTraceWriter writer;
+    NS_TEST_ASSERT_MSG_EQ(writer.Open(fileName, format), true, "Trace file not opened");
+    AnimationTraceElement root("anim");
+    root.AddAttribute("ver", "test");
+    writer.WriteStart(root);
+    const double values[] = {0,
+                             -0.0,
+                             1,
+                             -3,
+                             0.1,
+                             1.0 / 3,
+                             1e15,
+                             1e17,
+                             -2.5e-300,
+                             std::numeric_limits<double>::max(),
+                             std::numeric_limits<double>::infinity()};
+    for (uint32_t i = 0; i < 3000; ++i)
+    {
+        AnimationTraceElement element(i % 2 ? "p" : "nu");
+        element.AddAttribute("t", i / 4 * 0.25);
+        element.AddAttribute("x", values[i % 11]);
+        element.AddAttribute("id", i);
+        element.AddAttribute("uId", uint64_t{1} << (i % 64));
+        element.AddAttribute("s", -static_cast<int64_t>(i) * 1000003);
+        element.AddAttribute("f", 0.1f * i);
+        element.AddAttribute("d", "<\"node&'" + std::to_string(i % 50) + ">", true);
+        element.AddAttribute("m", std::string(i % 100, 'a' + i % 26));
+        if (i % 7 == 0)
+        {
+            AnimationTraceElement child("address");
+            child.SetText("10.0.0." + std::to_string(i % 256));
+            element.AppendChild(child);
+            AnimationTraceElement empty("rpe");
+            empty.AddAttribute("n", i);
+            element.AppendChild(empty);
+        }
+        if (i % 11 == 0)
+        {
+            element.SetText("text");
+        }
+        writer.Write(element);
+    }
+    writer.WriteEnd("anim");
+    writer.Close();
+}
+
+void
+AnimationBinaryTraceTestCase::RunScenario(const std::string& fileName,
+                                          AnimationTraceWriter::Format format,
+                                          double threshold)
+{
+    NodeContainer nodes;
+    nodes.Create(3);
+    MobilityHelper mobility;
+    mobility.SetMobilityModel("ns3::ConstantVelocityMobilityModel");
+    mobility.Install(nodes);
+    for (uint32_t i = 0; i < nodes.GetN(); ++i)
+    {
+        auto model = nodes.Get(i)->GetObject<ConstantVelocityMobilityModel>();
+        model->SetPosition(Vector(10 * i, 0, 0));
+        model->SetVelocity(Vector(0.5 * i, 0.25, 0));
+    }
+
+    PointToPointHelper pointToPoint;
+    NetDeviceContainer devices = pointToPoint.Install(nodes.Get(0), nodes.Get(1));
+    InternetStackHelper stack;
+    stack.Install(nodes);
+    Ipv4AddressHelper address;
+    address.SetBase("10.1.1.0", "255.255.255.0");
+    Ipv4InterfaceContainer interfaces = address.Assign(devices);
+    UdpEchoServerHelper echoServer(9);
+    echoServer.Install(nodes.Get(1));
+    UdpEchoClientHelper echoClient(interfaces.GetAddress(1), 9);
+    echoClient.SetAttribute("Interval", TimeValue(Seconds(0.5)));
+    echoClient.Install(nodes.Get(0));
+
+    {
+        AnimationInterface anim(fileName, format);
+        anim.SetMobilityDisplacementThreshold(threshold);
+        anim.UpdateNodeDescription(nodes.Get(0), "client <0>");
+        Simulator::Stop(Seconds(20));
+        Simulator::Run();
+    }
+    Simulator::Destroy();
+}
+
+std::string
+AnimationBinaryTraceTestCase::ReadFile(const std::string& fileName)
+{
+    std::ifstream is(fileName, std::ios::binary);
+    std::ostringstream os;
+    os << is.rdbuf();
+    return os.str();
+}
+
+std::string
+AnimationBinaryTraceTestCase::Convert(const std::string& fileName)
+{
+    std::ifstream is(fileName, std::ios::binary);
+    std::ostringstream os;
+    NS_TEST_EXPECT_MSG_EQ(AnimationTraceWriter::ConvertToXml(is, os),
+                          true,
+                          "Binary trace conversion failed");
+    return os.str();
+}
+
+void
+AnimationBinaryTraceTestCase::DoRun()
+{
+    const std::string xmlFile = CreateTempDirFilename("netanim-test.xml");
+    const std::string binaryFile = CreateTempDirFilename("netanim-test.bin");
+
+    WriteElements(xmlFile, AnimationTraceWriter::XML);
+    WriteElements(binaryFile, AnimationTraceWriter::BINARY);
+    std::string xml = ReadFile(xmlFile);
+    NS_TEST_ASSERT_MSG_EQ(Convert(binaryFile), xml, "Converted binary trace differs");
+    NS_TEST_EXPECT_MSG_LT(ReadFile(binaryFile).size(), xml.size(), "Binary trace too large");
+
+    // A truncated trace is detected
+    std::string binary = ReadFile(binaryFile);
+    std::istringstream truncated(binary.substr(0, binary.size() / 2));
+    std::ostringstream os;
+    NS_TEST_EXPECT_MSG_EQ(AnimationTraceWriter::ConvertToXml(truncated, os),
+                          false,
+                          "Truncated binary trace not detected");
+
+    RunScenario(xmlFile, AnimationTraceWriter::XML, 0);
+    RunScenario(binaryFile, AnimationTraceWriter::BINARY, 0);
+    xml = ReadFile(xmlFile);
+    NS_TEST_ASSERT_MSG_EQ(Convert(binaryFile), xml, "Converted binary trace differs");
+    NS_TEST_EXPECT_MSG_LT(ReadFile(binaryFile).size() * 2,
+                          xml.size(),
+                          "Binary trace should be less than half as large");
+
+    // The nodes move by 5, 11.2 and 20.6 m in 20 s, hence their positions
+    // are written at most 2 + 5 + 10 times above a threshold of 2 m
+    auto countPositions = [](const std::string& trace) {
+        uint32_t count = 0;
+        for (auto pos = trace.find("p=\"p\""); pos != std::string::npos;
+             pos = trace.find("p=\"p\"", pos + 1))
+        {
+            ++count;
+        }
+        return count;
+    };
+    NS_TEST_EXPECT_MSG_EQ(countPositions(xml), 35, "Unexpected number of position updates");
+    RunScenario(xmlFile, AnimationTraceWriter::XML, 2);
+    uint32_t decimated = countPositions(ReadFile(xmlFile));
+    NS_TEST_EXPECT_MSG_LT_OR_EQ(decimated, 17, "Too many position updates");
+    NS_TEST_EXPECT_MSG_GT_OR_EQ(decimated, 15, "Too few position updates");
+
+    remove(xmlFile.c_str());
+    remove(binaryFile.c_str());
+}
+
 /**
  * @ingroup netanim-test
  *
@@ -244,5 +460,6 @@ static class AnimationInterfaceTestSuite : public TestSuite
     {
         AddTestCase(new AnimationInterfaceTestCase(), TestCase::Duration::QUICK);
         AddTestCase(new AnimationRemainingEnergyTestCase(), TestCase::Duration::QUICK);
+        AddTestCase(new AnimationBinaryTraceTestCase(), TestCase::Duration::QUICK);
     }
 } g_animationInterfaceTestSuite; ///< the test suite
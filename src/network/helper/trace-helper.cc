@@ -8,6 +8,7 @@
 
 #include "ns3/abort.h"
 #include "ns3/assert.h"
+#include "ns3/boolean.h"
 #include "ns3/log.h"
 #include "ns3/names.h"
 #include "ns3/net-device.h"
@@ -24,6 +25,24 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("TraceHelper");
 
+namespace
+{
+
+/**
+ * Whether PcapHelper::CreateFile() creates files written asynchronously,
+ * set by PcapHelperForDevice while it enables the pcap traces
+ */
+bool g_pcapAsyncWrite = false;
+
+/**
+ * Whether AsciiTraceHelper::CreateFileStream() creates files written
+ * asynchronously, set by AsciiTraceHelperForDevice while it enables the
+ * ascii traces
+ */
+bool g_asciiAsyncWrite = false;
+
+} // namespace
+
 PcapHelper::PcapHelper()
 {
     NS_LOG_FUNCTION_NOARGS();
@@ -44,6 +63,10 @@ PcapHelper::CreateFile(std::string filename,
     NS_LOG_FUNCTION(filename << filemode << dataLinkType << snapLen << tzCorrection);
 
     Ptr<PcapFileWrapper> file = CreateObject<PcapFileWrapper>();
+    if (g_pcapAsyncWrite)
+    {
+        file->SetAttribute("AsyncWrite", BooleanValue(true));
+    }
     file->Open(filename, filemode);
     NS_ABORT_MSG_IF(file->Fail(), "Unable to Open " << filename << " for mode " << filemode);
 
@@ -179,11 +202,12 @@ AsciiTraceHelper::~AsciiTraceHelper()
 }
 
 Ptr<OutputStreamWrapper>
-AsciiTraceHelper::CreateFileStream(std::string filename, std::ios::openmode filemode)
+AsciiTraceHelper::CreateFileStream(std::string filename, std::ios::openmode filemode, bool async)
 {
-    NS_LOG_FUNCTION(filename << filemode);
+    NS_LOG_FUNCTION(filename << filemode << async);
 
-    Ptr<OutputStreamWrapper> StreamWrapper = Create<OutputStreamWrapper>(filename, filemode);
+    Ptr<OutputStreamWrapper> StreamWrapper =
+        Create<OutputStreamWrapper>(filename, filemode, async || g_asciiAsyncWrite);
 
     //
     // Note that the ascii trace helper promptly forgets all about the trace file.
@@ -411,7 +435,10 @@ PcapHelperForDevice::EnablePcap(std::string prefix,
                                 bool promiscuous,
                                 bool explicitFilename)
 {
+    bool asyncWrite = g_pcapAsyncWrite;
+    g_pcapAsyncWrite = m_pcapAsyncWrite;
     EnablePcapInternal(prefix, nd, promiscuous, explicitFilename);
+    g_pcapAsyncWrite = asyncWrite;
 }
 
 void
@@ -479,13 +506,19 @@ PcapHelperForDevice::EnablePcap(std::string prefix,
     }
 }
 
+void
+PcapHelperForDevice::SetPcapAsyncWrite(bool enable)
+{
+    m_pcapAsyncWrite = enable;
+}
+
 //
 // Public API
 //
 void
 AsciiTraceHelperForDevice::EnableAscii(std::string prefix, Ptr<NetDevice> nd, bool explicitFilename)
 {
-    EnableAsciiInternal(Ptr<OutputStreamWrapper>(), prefix, nd, explicitFilename);
+    EnableAsciiImpl(Ptr<OutputStreamWrapper>(), prefix, nd, explicitFilename);
 }
 
 //
@@ -494,7 +527,7 @@ AsciiTraceHelperForDevice::EnableAscii(std::string prefix, Ptr<NetDevice> nd, bo
 void
 AsciiTraceHelperForDevice::EnableAscii(Ptr<OutputStreamWrapper> stream, Ptr<NetDevice> nd)
 {
-    EnableAsciiInternal(stream, std::string(), nd, false);
+    EnableAsciiImpl(stream, std::string(), nd, false);
 }
 
 //
@@ -527,7 +560,22 @@ AsciiTraceHelperForDevice::EnableAsciiImpl(Ptr<OutputStreamWrapper> stream,
                                            bool explicitFilename)
 {
     Ptr<NetDevice> nd = Names::Find<NetDevice>(ndName);
+    EnableAsciiImpl(stream, prefix, nd, explicitFilename);
+}
+
+//
+// Private API
+//
+void
+AsciiTraceHelperForDevice::EnableAsciiImpl(Ptr<OutputStreamWrapper> stream,
+                                           std::string prefix,
+                                           Ptr<NetDevice> nd,
+                                           bool explicitFilename)
+{
+    bool asyncWrite = g_asciiAsyncWrite;
+    g_asciiAsyncWrite = m_asciiAsyncWrite;
     EnableAsciiInternal(stream, prefix, nd, explicitFilename);
+    g_asciiAsyncWrite = asyncWrite;
 }
 
 //
@@ -559,7 +607,7 @@ AsciiTraceHelperForDevice::EnableAsciiImpl(Ptr<OutputStreamWrapper> stream,
     for (auto i = d.Begin(); i != d.End(); ++i)
     {
         Ptr<NetDevice> dev = *i;
-        EnableAsciiInternal(stream, prefix, dev, false);
+        EnableAsciiImpl(stream, prefix, dev, false);
     }
 }
 
@@ -668,9 +716,18 @@ AsciiTraceHelperForDevice::EnableAsciiImpl(Ptr<OutputStreamWrapper> stream,
 
         Ptr<NetDevice> nd = node->GetDevice(deviceid);
 
-        EnableAsciiInternal(stream, prefix, nd, explicitFilename);
+        EnableAsciiImpl(stream, prefix, nd, explicitFilename);
         return;
     }
 }
 
+//
+// Public API
+//
+void
+AsciiTraceHelperForDevice::SetAsciiAsyncWrite(bool enable)
+{
+    m_asciiAsyncWrite = enable;
+}
+
 } // namespace ns3
@@ -93,6 +93,10 @@ class PcapHelper
     /**
      * @brief Create and initialize a pcap file.
      *
+     * The file is written asynchronously if the "AsyncWrite" attribute of
+     * ns3::PcapFileWrapper is true, or if it is created by a
+     * PcapHelperForDevice for which SetPcapAsyncWrite() was called.
+     *
      * @param filename file name
      * @param filemode file mode
      * @param dataLinkType data link type of packet data
@@ -220,12 +224,18 @@ class AsciiTraceHelper
      * that can solve the problem so we use one of those to carry the stream
      * around and deal with the lifetime issues.
      *
+     * The file is written asynchronously, from a background thread, if async
+     * is true or if it is created by an AsciiTraceHelperForDevice for which
+     * SetAsciiAsyncWrite() was called; see ns3::AsyncFileBuffer.
+     *
      * @param filename file name
      * @param filemode file mode
+     * @param async whether the file is written asynchronously
      * @returns a smart pointer to the output stream
      */
     Ptr<OutputStreamWrapper> CreateFileStream(std::string filename,
-                                              std::ios::openmode filemode = std::ios::out);
+                                              std::ios::openmode filemode = std::ios::out,
+                                              bool async = false);
 
     /**
      * @brief Hook a trace source to the default enqueue operation trace sink that
@@ -616,6 +626,7 @@ class PcapHelperForDevice
      * @brief Construct a PcapHelperForDevice
      */
     PcapHelperForDevice()
+        : m_pcapAsyncWrite(false)
     {
     }
 
@@ -708,6 +719,22 @@ class PcapHelperForDevice
      * @param promiscuous If true capture all possible packets available at the device.
      */
     void EnablePcapAll(std::string prefix, bool promiscuous = false);
+
+    /**
+     * @brief Set whether the pcap files subsequently created by this helper
+     * are written asynchronously.
+     *
+     * The packets are then copied into a bounded ring of buffers, written to
+     * the file by a background thread, rather than written by the simulation;
+     * see ns3::AsyncFileBuffer.  The files are completely written when they
+     * are closed and when Simulator::Destroy() is called.
+     *
+     * @param enable If true, write the pcap files asynchronously.
+     */
+    void SetPcapAsyncWrite(bool enable);
+
+  private:
+    bool m_pcapAsyncWrite; //!< Write the pcap files asynchronously
 };
 
 /**
@@ -721,6 +748,7 @@ class AsciiTraceHelperForDevice
      * @brief Construct an AsciiTraceHelperForDevice.
      */
     AsciiTraceHelperForDevice()
+        : m_asciiAsyncWrite(false)
     {
     }
 
@@ -878,6 +906,21 @@ class AsciiTraceHelperForDevice
      */
     void EnableAscii(Ptr<OutputStreamWrapper> stream, uint32_t nodeid, uint32_t deviceid);
 
+    /**
+     * @brief Set whether the ascii trace files subsequently created by this
+     * helper from a prefix are written asynchronously.
+     *
+     * The traces are then copied into a bounded ring of buffers, written to
+     * the file by a background thread, rather than written by the simulation;
+     * see ns3::AsyncFileBuffer.  The files are completely written when they
+     * are closed and when Simulator::Destroy() is called.  The streams passed
+     * to EnableAscii() are written asynchronously if they were created so by
+     * AsciiTraceHelper::CreateFileStream().
+     *
+     * @param enable If true, write the ascii trace files asynchronously.
+     */
+    void SetAsciiAsyncWrite(bool enable);
+
   private:
     /**
      * @brief Enable ascii trace output on the device specified by a global
@@ -949,6 +992,8 @@ class AsciiTraceHelperForDevice
                          std::string prefix,
                          Ptr<NetDevice> nd,
                          bool explicitFilename);
+
+    bool m_asciiAsyncWrite; //!< Write the ascii trace files asynchronously
 };
 
 } // namespace ns3
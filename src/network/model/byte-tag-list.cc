@@ -7,14 +7,13 @@
  */
 #include "byte-tag-list.h"
 
+#include "packet-allocator.h"
+
 #include "ns3/log.h"
 
 #include <cstring>
 #include <limits>
-#include <vector>
 
-#define USE_FREE_LIST 1
-#define FREE_LIST_SIZE 1000
 #define OFFSET_MAX (std::numeric_limits<int32_t>::max())
 
 namespace ns3
@@ -37,32 +36,8 @@ struct ByteTagListData
     uint8_t data[4]; //!< data
 };
 
-#ifdef USE_FREE_LIST
-/**
- * @ingroup packet
- *
- * @brief Container class for struct ByteTagListData
- *
- * Internal use only.
- */
-static class ByteTagListDataFreeList : public std::vector<ByteTagListData*>
-{
-  public:
-    ~ByteTagListDataFreeList();
-} g_freeList; //!< Container for struct ByteTagListData
-
-static uint32_t g_maxSize = 0; //!< maximum data size (used for allocation)
-
-ByteTagListDataFreeList::~ByteTagListDataFreeList()
-{
-    NS_LOG_FUNCTION(this);
-    for (auto i = begin(); i != end(); i++)
-    {
-        auto buffer = (uint8_t*)(*i);
-        delete[] buffer;
-    }
-}
-#endif /* USE_FREE_LIST */
+/// maximum data size of the lists of this thread (used for allocation)
+static thread_local uint32_t g_maxSize = 0;
 
 ByteTagList::Iterator::Item::Item(TagBuffer buf_)
     : buf(buf_)
@@ -158,6 +133,10 @@ ByteTagList::ByteTagList(const ByteTagList& o)
     {
         m_data->count++;
     }
+    else
+    {
+        std::memcpy(m_inline, o.m_inline, m_used);
+    }
 }
 
 ByteTagList&
@@ -178,6 +157,10 @@ ByteTagList::operator=(const ByteTagList& o)
     {
         m_data->count++;
     }
+    else
+    {
+        std::memcpy(m_inline, o.m_inline, m_used);
+    }
     return *this;
 }
 
@@ -195,19 +178,26 @@ ByteTagList::Add(TypeId tid, uint32_t bufferSize, int32_t start, int32_t end)
     NS_LOG_FUNCTION(this << tid << bufferSize << start << end);
     uint32_t spaceNeeded = m_used + bufferSize + 4 + 4 + 4 + 4;
     NS_ASSERT(m_used <= spaceNeeded);
-    if (m_data == nullptr)
+    uint8_t* buffer = m_inline;
+    if (m_data == nullptr && spaceNeeded > INLINE_SIZE)
     {
+        // move the tags from the inline buffer to the heap
         m_data = Allocate(spaceNeeded);
-        m_used = 0;
+        std::memcpy(&m_data->data, m_inline, m_used);
     }
-    else if (m_data->size < spaceNeeded || (m_data->count != 1 && m_data->dirty != m_used))
+    else if (m_data != nullptr &&
+             (m_data->size < spaceNeeded || (m_data->count != 1 && m_data->dirty != m_used)))
     {
         ByteTagListData* newData = Allocate(spaceNeeded);
         std::memcpy(&newData->data, &m_data->data, m_used);
         Deallocate(m_data);
         m_data = newData;
     }
-    TagBuffer tag = TagBuffer(&m_data->data[m_used], &m_data->data[spaceNeeded]);
+    if (m_data != nullptr)
+    {
+        buffer = m_data->data;
+    }
+    TagBuffer tag = TagBuffer(&buffer[m_used], &buffer[spaceNeeded]);
     tag.WriteU32(tid.GetUid());
     tag.WriteU32(bufferSize);
     tag.WriteU32(start - m_adjustment);
@@ -221,7 +211,10 @@ ByteTagList::Add(TypeId tid, uint32_t bufferSize, int32_t start, int32_t end)
         m_maxEnd = end - m_adjustment;
     }
     m_used = spaceNeeded;
-    m_data->dirty = m_used;
+    if (m_data != nullptr)
+    {
+        m_data->dirty = m_used;
+    }
     return tag;
 }
 
@@ -263,14 +256,8 @@ ByteTagList::Iterator
 ByteTagList::Begin(int32_t offsetStart, int32_t offsetEnd) const
 {
     NS_LOG_FUNCTION(this << offsetStart << offsetEnd);
-    if (m_data == nullptr)
-    {
-        return Iterator(nullptr, nullptr, offsetStart, offsetEnd, 0);
-    }
-    else
-    {
-        return Iterator(m_data->data, &m_data->data[m_used], offsetStart, offsetEnd, m_adjustment);
-    }
+    auto buffer = m_data != nullptr ? m_data->data : const_cast<uint8_t*>(m_inline);
+    return Iterator(buffer, &buffer[m_used], offsetStart, offsetEnd, m_adjustment);
 }
 
 void
@@ -338,30 +325,16 @@ ByteTagList::AddAtStart(int32_t prependOffset)
     *this = list;
 }
 
-#ifdef USE_FREE_LIST
-
 ByteTagListData*
 ByteTagList::Allocate(uint32_t size)
 {
     NS_LOG_FUNCTION(this << size);
-    while (!g_freeList.empty())
-    {
-        ByteTagListData* data = g_freeList.back();
-        g_freeList.pop_back();
-        NS_ASSERT(data != nullptr);
-        if (data->size >= size)
-        {
-            data->count = 1;
-            data->dirty = 0;
-            return data;
-        }
-        auto buffer = (uint8_t*)data;
-        delete[] buffer;
-    }
-    auto buffer = new uint8_t[std::max(size, g_maxSize) + sizeof(ByteTagListData) - 4];
-    auto data = (ByteTagListData*)buffer;
+    // the whole block is used, so that the list can grow in place
+    const std::size_t header = sizeof(ByteTagListData) - 4;
+    const std::size_t blockSize = PacketAllocator::GetBlockSize(header + std::max(size, g_maxSize));
+    auto data = static_cast<ByteTagListData*>(PacketAllocator::Allocate(blockSize));
     data->count = 1;
-    data->size = size;
+    data->size = blockSize - header;
     data->dirty = 0;
     return data;
 }
@@ -378,50 +351,10 @@ ByteTagList::Deallocate(ByteTagListData* data)
     data->count--;
     if (data->count == 0)
     {
-        if (g_freeList.size() > FREE_LIST_SIZE || data->size < g_maxSize)
-        {
-            auto buffer = (uint8_t*)data;
-            delete[] buffer;
-        }
-        else
-        {
-            g_freeList.push_back(data);
-        }
-    }
-}
-
-#else /* USE_FREE_LIST */
-
-ByteTagListData*
-ByteTagList::Allocate(uint32_t size)
-{
-    NS_LOG_FUNCTION(this << size);
-    uint8_t* buffer = new uint8_t[size + sizeof(ByteTagListData) - 4];
-    ByteTagListData* data = (ByteTagListData*)buffer;
-    data->count = 1;
-    data->size = size;
-    data->dirty = 0;
-    return data;
-}
-
-void
-ByteTagList::Deallocate(ByteTagListData* data)
-{
-    NS_LOG_FUNCTION(this << data);
-    if (data == 0)
-    {
-        return;
-    }
-    data->count--;
-    if (data->count == 0)
-    {
-        uint8_t* buffer = (uint8_t*)data;
-        delete[] buffer;
+        PacketAllocator::Deallocate(data, data->size + sizeof(ByteTagListData) - 4);
     }
 }
 
-#endif /* USE_FREE_LIST */
-
 uint32_t
 ByteTagList::GetSerializedSize() const
 {
@@ -36,9 +36,13 @@ struct ByteTagListData;
  *     as 4 32bit integers (TypeId, tag data size, start, end) followed
  *     by the tag data as generated by Tag::Serialize.
  *
- *   - The struct ByteTagListData structure which contains the tag byte buffer
- *     is shared and, thus, reference-counted. This data structure is unshared
- *     as-needed to emulate COW semantics.
+ *   - The tags are stored inline, in the ByteTagList itself, as long as
+ *     they fit in #INLINE_SIZE bytes, so that tagging a packet with a small
+ *     tag does not allocate memory. Copying such a list copies its tags.
+ *   - Beyond #INLINE_SIZE bytes, the tags are moved to a struct
+ *     ByteTagListData, allocated by the PacketAllocator, which contains the
+ *     tag byte buffer. It is shared and, thus, reference-counted. This data
+ *     structure is unshared as-needed to emulate COW semantics.
  *
  *   - Each tag tags a unique set of bytes identified by the pair of offsets
  *     (start,end). These offsets are relative to the start of the packet
@@ -142,6 +146,11 @@ class ByteTagList
         int32_t m_nextEnd;     //!< End of the next tag
     };
 
+    /**
+     * Size of the tags stored inline, in bytes.
+     */
+    static constexpr uint32_t INLINE_SIZE = 64;
+
     ByteTagList();
 
     /**
@@ -272,11 +281,12 @@ class ByteTagList
      */
     void Deallocate(ByteTagListData* data);
 
-    int32_t m_minStart;      //!< minimal start offset
-    int32_t m_maxEnd;        //!< maximal end offset
-    int32_t m_adjustment;    //!< adjustment to byte tag offsets
-    uint32_t m_used;         //!< the number of used bytes in the buffer
-    ByteTagListData* m_data; //!< the ByteTagListData structure
+    int32_t m_minStart;                       //!< minimal start offset
+    int32_t m_maxEnd;                         //!< maximal end offset
+    int32_t m_adjustment;                     //!< adjustment to byte tag offsets
+    uint32_t m_used;                          //!< the number of used bytes in the buffer
+    ByteTagListData* m_data;                  //!< the spilled tags, or nullptr if inline
+    alignas(4) uint8_t m_inline[INLINE_SIZE]; //!< the buffer of the inline tags
 };
 
 void
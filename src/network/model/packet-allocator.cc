@@ -0,0 +1,205 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "packet-allocator.h"
+
+#include "ns3/valgrind.h"
+
+#include <bit>
+#include <new>
+
+/**
+ * @file
+ * @ingroup packet
+ * ns3::PacketAllocator implementation.
+ */
+
+namespace ns3
+{
+
+namespace
+{
+
+/// Base 2 logarithm of the smallest size class, in bytes.
+constexpr unsigned PACKET_POOL_MIN_SHIFT = 5;
+/// Base 2 logarithm of the largest size class, in bytes.
+constexpr unsigned PACKET_POOL_MAX_SHIFT = 12;
+/// Largest block allocated from the slabs, in bytes.
+constexpr std::size_t PACKET_POOL_MAX_SIZE = std::size_t{1} << PACKET_POOL_MAX_SHIFT;
+/// Size of the slabs carved into blocks, in bytes.
+constexpr std::size_t PACKET_POOL_SLAB_SIZE = 64 * 1024;
+
+/// A free block of the packet pool.
+struct PacketPoolBlock
+{
+    PacketPoolBlock* next; //!< Next free block of the same size class.
+};
+
+/**
+ * The packet pool of a thread.
+ *
+ * The pool is constant-initialized and trivially destructible, so that
+ * accessing it does not need any thread-local initialization guard.
+ */
+struct PacketPool
+{
+    /// Free blocks of each size class.
+    PacketPoolBlock* freeBlocks[PACKET_POOL_MAX_SHIFT - PACKET_POOL_MIN_SHIFT + 1]{};
+    char* slab{nullptr};        //!< Unused part of the current slab.
+    std::size_t slabLeft{0};    //!< Size of the unused part of the current slab.
+    int state{0};               //!< 0 if not checked yet, 1 if enabled, -1 if bypassed.
+    PacketAllocatorStats stats; //!< Statistics of the allocations.
+};
+
+/// The packet pool of the current thread.
+thread_local PacketPool g_packetPool;
+
+/**
+ * Get the size class of a block.
+ * @param [in] size The size of the block, at most PACKET_POOL_MAX_SIZE.
+ * @returns The index of the size class.
+ */
+inline unsigned
+GetSizeClass(std::size_t size)
+{
+    const unsigned shift = size <= 1 ? 0 : std::bit_width(size - 1);
+    return shift <= PACKET_POOL_MIN_SHIFT ? 0 : shift - PACKET_POOL_MIN_SHIFT;
+}
+
+/**
+ * Enable the packet pool of the current thread, unless the program runs
+ * under valgrind or the address sanitizer.
+ * @param [in,out] pool The packet pool of the current thread.
+ * @returns true if the pool is enabled.
+ */
+bool
+EnablePacketPool(PacketPool& pool)
+{
+    bool bypass = RUNNING_ON_VALGRIND;
+#if defined(__SANITIZE_ADDRESS__)
+    bypass = true;
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer)
+    bypass = true;
+#endif
+#endif
+    pool.state = bypass ? -1 : 1;
+    return !bypass;
+}
+
+/**
+ * Check whether the packet pool should be used for a block.
+ * @param [in,out] pool The packet pool of the current thread.
+ * @param [in] size The size of the block.
+ * @returns true if the block should be allocated from the pool.
+ */
+inline bool
+UsePacketPool(PacketPool& pool, std::size_t size)
+{
+    if (size > PACKET_POOL_MAX_SIZE)
+    {
+        return false;
+    }
+    return pool.state > 0 || (pool.state == 0 && EnablePacketPool(pool));
+}
+
+/**
+ * Carve a block from the current slab, allocating a new slab if needed.
+ * @param [in,out] pool The packet pool of the current thread.
+ * @param [in] sizeClass The size class of the block.
+ * @returns The block.
+ */
+void*
+AllocateFromSlab(PacketPool& pool, unsigned sizeClass)
+{
+    const std::size_t blockSize = std::size_t{1} << (sizeClass + PACKET_POOL_MIN_SHIFT);
+    if (pool.slabLeft < blockSize)
+    {
+        // the rest of the slab is lost, which wastes less than the
+        // largest size class per slab
+        pool.stats.slabs++;
+        pool.slab = static_cast<char*>(::operator new(PACKET_POOL_SLAB_SIZE));
+        pool.slabLeft = PACKET_POOL_SLAB_SIZE;
+    }
+    void* p = pool.slab;
+    pool.slab += blockSize;
+    pool.slabLeft -= blockSize;
+    return p;
+}
+
+} // namespace
+
+std::ostream&
+operator<<(std::ostream& os, const PacketAllocatorStats& stats)
+{
+    os << "allocations=" << stats.allocations << " deallocations=" << stats.deallocations
+       << " freeListAllocations=" << stats.freeListAllocations
+       << " heapAllocations=" << stats.heapAllocations << " slabs=" << stats.slabs;
+    return os;
+}
+
+void*
+PacketAllocator::Allocate(std::size_t size)
+{
+    PacketPool& pool = g_packetPool;
+    pool.stats.allocations++;
+    if (!UsePacketPool(pool, size))
+    {
+        pool.stats.heapAllocations++;
+        return ::operator new(GetBlockSize(size));
+    }
+    const unsigned sizeClass = GetSizeClass(size);
+    PacketPoolBlock* block = pool.freeBlocks[sizeClass];
+    if (block == nullptr)
+    {
+        return AllocateFromSlab(pool, sizeClass);
+    }
+    pool.stats.freeListAllocations++;
+    pool.freeBlocks[sizeClass] = block->next;
+    return block;
+}
+
+void
+PacketAllocator::Deallocate(void* p, std::size_t size)
+{
+    if (p == nullptr)
+    {
+        return;
+    }
+    PacketPool& pool = g_packetPool;
+    pool.stats.deallocations++;
+    if (!UsePacketPool(pool, size))
+    {
+        ::operator delete(p);
+        return;
+    }
+    const unsigned sizeClass = GetSizeClass(size);
+    auto block = static_cast<PacketPoolBlock*>(p);
+    block->next = pool.freeBlocks[sizeClass];
+    pool.freeBlocks[sizeClass] = block;
+}
+
+std::size_t
+PacketAllocator::GetBlockSize(std::size_t size)
+{
+    if (size > PACKET_POOL_MAX_SIZE)
+    {
+        return size;
+    }
+    return std::size_t{1} << (GetSizeClass(size) + PACKET_POOL_MIN_SHIFT);
+}
+
+PacketAllocatorStats
+PacketAllocator::GetStats()
+{
+    return g_packetPool.stats;
+}
+
+void
+PacketAllocator::ResetStats()
+{
+    g_packetPool.stats = PacketAllocatorStats();
+}
+
+} // namespace ns3
@@ -0,0 +1,113 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef PACKET_ALLOCATOR_H
+#define PACKET_ALLOCATOR_H
+
+/**
+ * @file
+ * @ingroup packet
+ * ns3::PacketAllocator and ns3::PacketAllocatorStats declarations.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+namespace ns3
+{
+
+/**
+ * @ingroup packet
+ *
+ * @brief Statistics of the memory allocations of the packets.
+ *
+ * The counts cover the Packet objects, their Buffer::Data and their
+ * PacketMetadata::Data, allocated and deallocated by the calling thread
+ * since it started or since PacketAllocator::ResetStats().
+ */
+struct PacketAllocatorStats
+{
+    /** Number of blocks allocated. */
+    uint64_t allocations{0};
+    /** Number of blocks deallocated. */
+    uint64_t deallocations{0};
+    /** Number of blocks allocated from the free lists of the slab allocator. */
+    uint64_t freeListAllocations{0};
+    /** Number of blocks allocated with operator new, e.g., because they are too large. */
+    uint64_t heapAllocations{0};
+    /** Number of slabs allocated, with operator new, by the slab allocator. */
+    uint64_t slabs{0};
+};
+
+/**
+ * @brief Stream insertion operator.
+ *
+ * @param [in,out] os The output stream.
+ * @param [in] stats The statistics.
+ * @returns The output stream.
+ */
+std::ostream& operator<<(std::ostream& os, const PacketAllocatorStats& stats);
+
+/**
+ * @ingroup packet
+ *
+ * @brief Slab allocator of the Packet objects, of their Buffer::Data and of
+ * their PacketMetadata::Data.
+ *
+ * The blocks are rounded up to power of two size classes, from 32 bytes to
+ * 4 KiB, which are carved from 64 KiB slabs and recycled through per-thread
+ * free lists, without any locking. The slabs are never released, so that a
+ * block allocated by a thread, e.g., a packet sent by a node simulated by
+ * one of the threads of MultithreadedSimulatorImpl, can be deallocated by
+ * another one, which then recycles it. The larger blocks are allocated with
+ * operator new, and the slab allocator is bypassed under valgrind and the
+ * address sanitizer, so that they can check the packet memory.
+ */
+class PacketAllocator
+{
+  public:
+    /**
+     * Allocate a block.
+     *
+     * @param [in] size The size of the block.
+     * @returns The block, of at least GetBlockSize(size) bytes.
+     */
+    static void* Allocate(std::size_t size);
+
+    /**
+     * Deallocate a block.
+     *
+     * @param [in] p The block, or nullptr.
+     * @param [in] size The size requested to allocate the block, or any size
+     *             between this one and GetBlockSize() of this one.
+     */
+    static void Deallocate(void* p, std::size_t size);
+
+    /**
+     * Get the size of the block that would be allocated for a request.
+     *
+     * The callers can use all of the block, e.g., to grow in place.
+     *
+     * @param [in] size The requested size.
+     * @returns The size of the block, which is not less than \p size.
+     */
+    static std::size_t GetBlockSize(std::size_t size);
+
+    /**
+     * Get the statistics of the allocations of the calling thread.
+     *
+     * @returns The statistics.
+     */
+    static PacketAllocatorStats GetStats();
+
+    /**
+     * Reset the statistics of the allocations of the calling thread.
+     */
+    static void ResetStats();
+};
+
+} // namespace ns3
+
+#endif /* PACKET_ALLOCATOR_H */
@@ -8,11 +8,12 @@
 
 /**
 \file   packet-tag-list.cc
-\brief  Implements a linked list of Packet tags, including copy-on-write semantics.
+\brief  Implements a list of Packet tags, including copy-on-write semantics.
 */
 
 #include "packet-tag-list.h"
 
+#include "packet-allocator.h"
 #include "tag-buffer.h"
 #include "tag.h"
 
@@ -20,231 +21,138 @@
 #include "ns3/log.h"
 
 #include <cstring>
+#include <limits>
 
 namespace ns3
 {
 
 NS_LOG_COMPONENT_DEFINE("PacketTagList");
 
-PacketTagList::TagData*
-PacketTagList::CreateTagData(size_t dataSize)
+uint32_t
+PacketTagList::GetRecordSize(uint32_t dataSize)
 {
     NS_ASSERT_MSG(dataSize < std::numeric_limits<decltype(TagData::size)>::max(),
                   "Requested TagData size " << dataSize << " exceeds maximum "
                                             << std::numeric_limits<decltype(TagData::size)>::max());
-
-    void* p = std::malloc(sizeof(TagData) + dataSize - 1);
-    // The matching frees are in RemoveAll and RemoveWriter
-
-    auto tag = new (p) TagData;
-    tag->size = dataSize;
-    return tag;
+    // ensure size is multiple of 4 bytes for 4 byte boundaries
+    return (sizeof(TagData) + dataSize - 1 + 3) & (~3);
 }
 
-bool
-PacketTagList::COWTraverse(Tag& tag, PacketTagList::COWWriter Writer)
+uint32_t
+PacketTagList::Find(TypeId tid) const
 {
-    TypeId tid = tag.GetInstanceTypeId();
-    NS_LOG_FUNCTION(this << tid);
-    NS_LOG_INFO("looking for " << tid);
-
-    // trivial case when list is empty
-    if (m_next == nullptr)
+    const uint8_t* records = GetRecords();
+    uint32_t offset = 0;
+    while (offset < m_used)
     {
-        return false;
-    }
-
-    bool found = false;
-
-    TagData** prevNext = &m_next; // previous node's next pointer
-    TagData* cur = m_next;        // cursor to current node
-    TagData* it = nullptr;        // utility
-
-    // Search from the head of the list until we find tid or a merge
-    while (cur != nullptr)
-    {
-        if (cur->count > 1)
-        {
-            // found merge
-            NS_LOG_INFO("found initial merge before tid");
-            break;
-        }
-        else if (cur->tid == tid)
+        auto cur = reinterpret_cast<const TagData*>(records + offset);
+        if (cur->tid == tid)
         {
-            NS_LOG_INFO("found tid before initial merge, calling writer");
-            found = (this->*Writer)(tag, true, cur, prevNext);
             break;
         }
-        else
-        {
-            // no merge or tid found yet, move on
-            prevNext = &cur->next;
-            cur = cur->next;
-        }
-    }
-
-    // did we find it or run out of tags?
-    if (cur == nullptr || found)
-    {
-        NS_LOG_INFO("returning after header with found: " << found);
-        return found;
+        offset += GetRecordSize(cur->size);
     }
+    return offset;
+}
 
-    // From here on out, we have to copy the list
-    // until we find tid, then link past it
-
-    // Before we do all that work, let's make sure tid really exists
-    for (it = cur; it != nullptr; it = it->next)
+uint8_t*
+PacketTagList::Splice(uint32_t offset, uint32_t removed, uint32_t inserted)
+{
+    NS_LOG_FUNCTION(this << offset << removed << inserted);
+    NS_ASSERT(offset + removed <= m_used);
+    const uint32_t used = m_used - removed + inserted;
+    const uint32_t tail = m_used - offset - removed;
+    uint8_t* records = GetRecords();
+
+    bool inPlace = false;
+    if (m_storage == nullptr)
     {
-        if (it->tid == tid)
-        {
-            break;
-        }
+        inPlace = (used <= INLINE_SIZE);
     }
-    if (it == nullptr)
+    else
     {
-        // got to end of list without finding tid
-        NS_LOG_INFO("tid not found after first merge");
-        return found;
+        inPlace = (m_storage->count == 1 && used > INLINE_SIZE && used <= m_storage->capacity);
     }
 
-    // At this point cur is a merge, but untested for tid
-    NS_ASSERT(cur != nullptr);
-    NS_ASSERT(cur->count > 1);
-
-    /*
-       Walk the remainder of the list, copying, until we find tid
-       As we put a copy of the cur node onto our list,
-       we move the merge point down the list.
-
-       Starting position                  End position
-         T1 is a merge                     T1.count decremented
-                                           T2 is a merge
-                                           T1' is a copy of T1
-
-            other                             other
-                 \                                 \
-        Prev  ->  T1  ->  T2  -> ...                T1  ->  T2  -> ...
-             /   /                                         /|
-        pNext cur                         Prev  ->  T1' --/ |
-                                                       /    |
-                                                  pNext   cur
-
-       When we reach tid, we link past it, decrement count, and we're done.
-    */
-
-    // Should normally check for null cur pointer,
-    // but since we know tid exists, we'll skip this test
-    while (/* cur && */ cur->tid != tid)
+    if (inPlace)
     {
-        NS_ASSERT(cur != nullptr);
-        NS_ASSERT(cur->count > 1);
-        cur->count--; // unmerge cur
-        TagData* copy = CreateTagData(cur->size);
-        copy->tid = cur->tid;
-        copy->count = 1;
-        copy->size = cur->size;
-        memcpy(copy->data, cur->data, copy->size);
-        copy->next = cur->next; // merge into tail
-        copy->next->count++;    // mark new merge
-        *prevNext = copy;       // point prior list at copy
-        prevNext = &copy->next; // advance
-        cur = copy->next;
-    }
-    // Sanity check:
-    NS_ASSERT(cur != nullptr);  // cur should be non-zero
-    NS_ASSERT(cur->tid == tid); // cur->tid should be tid
-    NS_ASSERT(cur->count > 1);  // cur should be a merge
-
-    // link around tid, removing it from our list
-    found = (this->*Writer)(tag, false, cur, prevNext);
-    return found;
-}
-
-bool
-PacketTagList::Remove(Tag& tag)
-{
-    return COWTraverse(tag, &PacketTagList::RemoveWriter);
-}
-
-// COWWriter implementing Remove
-bool
-PacketTagList::RemoveWriter(Tag& tag,
-                            bool preMerge,
-                            PacketTagList::TagData* cur,
-                            PacketTagList::TagData** prevNext)
-{
-    NS_LOG_FUNCTION_NOARGS();
-
-    // found tid
-    bool found = true;
-    tag.Deserialize(TagBuffer(cur->data, cur->data + cur->size));
-    *prevNext = cur->next; // link around cur
-
-    if (preMerge)
-    {
-        // found tid before first merge, so delete cur
-        cur->~TagData();
-        std::free(cur);
+        std::memmove(records + offset + inserted, records + offset + removed, tail);
     }
     else
     {
-        // cur is always a merge at this point
-        // unmerge cur, since we linked around it already
-        cur->count--;
-        if (cur->next != nullptr)
+        // move the records inline if they fit, or to a new storage
+        TagStorage* storage = nullptr;
+        uint8_t* dest = m_inline;
+        if (used > INLINE_SIZE)
+        {
+            const std::size_t header = sizeof(TagStorage) - sizeof(TagStorage::data);
+            const std::size_t size = PacketAllocator::GetBlockSize(header + used);
+            storage = static_cast<TagStorage*>(PacketAllocator::Allocate(size));
+            storage->count = 1;
+            storage->capacity = size - header;
+            dest = storage->data;
+        }
+        std::memcpy(dest, records, offset);
+        std::memcpy(dest + offset + inserted, records + offset + removed, tail);
+        if (m_storage != nullptr)
         {
-            // there's a next, so make it a merge
-            cur->next->count++;
+            ReleaseStorage();
         }
+        m_storage = storage;
+        records = dest;
     }
-    return found;
+    m_used = used;
+    return records + offset;
 }
 
-bool
-PacketTagList::Replace(Tag& tag)
+void
+PacketTagList::ReleaseStorage()
 {
-    bool found = COWTraverse(tag, &PacketTagList::ReplaceWriter);
-    if (!found)
+    NS_LOG_FUNCTION(this);
+    m_storage->count--;
+    if (m_storage->count == 0)
     {
-        Add(tag);
+        PacketAllocator::Deallocate(m_storage,
+                                    sizeof(TagStorage) - sizeof(TagStorage::data) +
+                                        m_storage->capacity);
     }
-    return found;
+    m_storage = nullptr;
 }
 
-// COWWriter implementing Replace
 bool
-PacketTagList::ReplaceWriter(Tag& tag,
-                             bool preMerge,
-                             PacketTagList::TagData* cur,
-                             PacketTagList::TagData** prevNext)
+PacketTagList::Remove(Tag& tag)
 {
-    NS_LOG_FUNCTION_NOARGS();
-
-    // found tid
-    bool found = true;
-    if (preMerge)
+    TypeId tid = tag.GetInstanceTypeId();
+    NS_LOG_FUNCTION(this << tid);
+    const uint32_t offset = Find(tid);
+    if (offset == m_used)
     {
-        // found tid before first merge, so just rewrite
-        tag.Serialize(TagBuffer(cur->data, cur->data + cur->size));
+        return false;
     }
-    else
+    auto cur = reinterpret_cast<TagData*>(GetRecords() + offset);
+    tag.Deserialize(TagBuffer(cur->data, cur->data + cur->size));
+    Splice(offset, GetRecordSize(cur->size), 0);
+    return true;
+}
+
+bool
+PacketTagList::Replace(Tag& tag)
+{
+    TypeId tid = tag.GetInstanceTypeId();
+    NS_LOG_FUNCTION(this << tid);
+    const uint32_t offset = Find(tid);
+    if (offset == m_used)
     {
-        // cur is always a merge at this point
-        // need to copy, replace, and link past cur
-        cur->count--; // unmerge cur
-        TagData* copy = CreateTagData(tag.GetSerializedSize());
-        copy->tid = tag.GetInstanceTypeId();
-        copy->count = 1;
-        tag.Serialize(TagBuffer(copy->data, copy->data + copy->size));
-        copy->next = cur->next; // merge into tail
-        if (copy->next != nullptr)
-        {
-            copy->next->count++; // mark new merge
-        }
-        *prevNext = copy; // point prior list at copy
+        Add(tag);
+        return false;
     }
-    return found;
+    const uint32_t size = tag.GetSerializedSize();
+    auto cur = reinterpret_cast<TagData*>(GetRecords() + offset);
+    auto copy = new (Splice(offset, GetRecordSize(cur->size), GetRecordSize(size))) TagData;
+    copy->tid = tid;
+    copy->size = size;
+    tag.Serialize(TagBuffer(copy->data, copy->data + copy->size));
+    return true;
 }
 
 void
@@ -252,44 +160,44 @@ PacketTagList::Add(const Tag& tag) const
 {
     NS_LOG_FUNCTION(this << tag.GetInstanceTypeId());
     // ensure this id was not yet added
-    for (TagData* cur = m_next; cur != nullptr; cur = cur->next)
-    {
-        NS_ASSERT_MSG(cur->tid != tag.GetInstanceTypeId(),
-                      "Error: cannot add the same kind of tag twice. The tag type is "
-                          << tag.GetInstanceTypeId().GetName());
-    }
-    TagData* head = CreateTagData(tag.GetSerializedSize());
-    head->count = 1;
-    head->next = nullptr;
+    NS_ASSERT_MSG(Find(tag.GetInstanceTypeId()) == m_used,
+                  "Error: cannot add the same kind of tag twice. The tag type is "
+                      << tag.GetInstanceTypeId().GetName());
+    const uint32_t size = tag.GetSerializedSize();
+    auto self = const_cast<PacketTagList*>(this);
+    auto head = new (self->Splice(0, 0, GetRecordSize(size))) TagData;
     head->tid = tag.GetInstanceTypeId();
-    head->next = m_next;
+    head->size = size;
     tag.Serialize(TagBuffer(head->data, head->data + head->size));
-
-    const_cast<PacketTagList*>(this)->m_next = head;
 }
 
 bool
 PacketTagList::Peek(Tag& tag) const
 {
     NS_LOG_FUNCTION(this << tag.GetInstanceTypeId());
-    TypeId tid = tag.GetInstanceTypeId();
-    for (TagData* cur = m_next; cur != nullptr; cur = cur->next)
+    const uint32_t offset = Find(tag.GetInstanceTypeId());
+    if (offset == m_used)
     {
-        if (cur->tid == tid)
-        {
-            /* found tag */
-            tag.Deserialize(TagBuffer(cur->data, cur->data + cur->size));
-            return true;
-        }
+        /* no tag found */
+        return false;
     }
-    /* no tag found */
-    return false;
+    /* found tag */
+    auto cur = reinterpret_cast<TagData*>(GetRecords() + offset);
+    tag.Deserialize(TagBuffer(cur->data, cur->data + cur->size));
+    return true;
 }
 
 const PacketTagList::TagData*
 PacketTagList::Head() const
 {
-    return m_next;
+    return m_used == 0 ? nullptr : reinterpret_cast<const TagData*>(GetRecords());
+}
+
+const PacketTagList::TagData*
+PacketTagList::Next(const PacketTagList::TagData* cur) const
+{
+    auto next = reinterpret_cast<const uint8_t*>(cur) + GetRecordSize(cur->size);
+    return next == GetRecords() + m_used ? nullptr : reinterpret_cast<const TagData*>(next);
 }
 
 uint32_t
@@ -301,7 +209,7 @@ PacketTagList::GetSerializedSize() const
 
     size = 4; // numberOfTags
 
-    for (TagData* cur = m_next; cur != nullptr; cur = cur->next)
+    for (const TagData* cur = Head(); cur != nullptr; cur = Next(cur))
     {
         size += 4; // TagData -> size
 
@@ -335,7 +243,7 @@ PacketTagList::Serialize(uint32_t* buffer, uint32_t maxSize) const
     uint32_t* numberOfTags = p;
     *p++ = 0;
 
-    for (TagData* cur = m_next; cur != nullptr; cur = cur->next)
+    for (const TagData* cur = Head(); cur != nullptr; cur = Next(cur))
     {
         size += 4;
 
@@ -393,7 +301,6 @@ PacketTagList::Deserialize(const uint32_t* buffer, uint32_t size)
 
     NS_LOG_INFO("Deserializing number of tags " << numberOfTags);
 
-    TagData* prevTag = nullptr;
     for (uint32_t i = 0; i < numberOfTags; ++i)
     {
         NS_ASSERT(sizeCheck >= 4);
@@ -411,30 +318,16 @@ PacketTagList::Deserialize(const uint32_t* buffer, uint32_t size)
 
         NS_LOG_INFO("Deserializing tag of type " << tid);
 
-        TagData* newTag = CreateTagData(tagSize);
-        newTag->count = 1;
-        newTag->next = nullptr;
-        newTag->tid = tid;
-
         NS_ASSERT(sizeCheck >= tagSize);
+        auto newTag = new (Splice(m_used, 0, GetRecordSize(tagSize))) TagData;
+        newTag->tid = tid;
+        newTag->size = tagSize;
         memcpy(newTag->data, p, tagSize);
 
         // ensure 4 byte boundary
         uint32_t tagWordSize = (tagSize + 3) & (~3);
         p += tagWordSize / 4;
         sizeCheck -= tagWordSize;
-
-        // Set link list pointers.
-        if (i == 0)
-        {
-            m_next = newTag;
-        }
-        else
-        {
-            prevTag->next = newTag;
-        }
-
-        prevTag = newTag;
     }
 
     NS_ASSERT(sizeCheck == 0);
@@ -10,11 +10,12 @@
 
 /**
 \file   packet-tag-list.h
-\brief  Defines a linked list of Packet tags, including copy-on-write semantics.
+\brief  Defines a list of Packet tags, including copy-on-write semantics.
 */
 
 #include "ns3/type-id.h"
 
+#include <cstring>
 #include <ostream>
 #include <stdint.h>
 
@@ -33,88 +34,26 @@ class Tag;
  *
  * @internal
  *
- * The implementation of this class is a bit tricky.  Refer to this
- * diagram in the discussion that follows.
+ *   - Tags are stored in serialized form, as contiguous TagData records
+ *     aligned on 4 bytes, from the most recently added to the oldest one.
+ *     #Peek, #Remove and #Replace are hence a linear scan of a small array.
  *
- * @dot
- *    digraph {
- *        rankdir = "LR";
- *        clusterrank = local;
- *        node [ shape = record, fontname="FreeSans", fontsize="10" ];
- *        oth  [ label="<l> Other branch | <n> next | <c> ..." ];
- *        PTL1 [ label="<l> PacketTagList A | <n> m_next" , shape=Mrecord];
- *        PTL2 [ label="<l> PacketTagList B | <n> m_next" , shape=Mrecord];
- *        oth:n  -> T7:l ;
- *        PTL2:n -> T6:l ;
- *        PTL1:n -> T5:l ;
- *        T1   [ label="<l> T1  | <n> next | <c> count = 1" ];
- *        T2   [ label="<l> T2  | <n> next | <c> count = 1" ];
- *        T3   [ label="<l> T3  | <n> next | <c> count = 2" ];
- *        T4   [ label="<l> T4  | <n> next | <c> count = 1" ];
- *        T5   [ label="<l> T5  | <n> next | <c> count = 2" ];
- *        T6   [ label="<l> T6  | <n> next | <c> count = 1" ];
- *        T7   [ label="<l> T7  | <n> next | <c> count = 1" ];
- *        NULL [ label="0", shape = ellipse ];
- *        subgraph cluster_list {
- *          penwidth = 0;
- *          T6:n -> T5:l ;
- *          T5:n -> T4:l ;
- *          T4:n -> T3:l ;
- *          T7:n -> T3:l ;
- *          T3:n -> T2:l ;
- *          T2:n -> T1:l ;
- *          T1:n -> NULL ;
- *        };
- *      }
- * @enddot
+ *   - The records are stored inline, in the PacketTagList itself, as long as
+ *     they fit in #INLINE_SIZE bytes, which is enough for the few small tags
+ *     that most packets carry, so that adding a tag does not allocate memory.
+ *     Copying an inline PacketTagList copies the records.
  *
- *   - Tags are stored in serialized form in a tree of TagData
- *     structures. (``T1-T7`` in the diagram)
- *
- *   - Each TagData points (\c next pointers in the diagram)
- *     toward the root of the tree, which is a null pointer.
- *
- *   - \c count is the number of incoming pointers to this
- *     TagData.  Branch points, where branches merge or join, have
- *     ``count \> 1`` (\c T3, \c T5); successive links along
- *     a branch have ``count = 1`` (\c T1, \c T2, \c T4, \c T6, \c T7).
- *
- *   - Each PacketTagList points to a specific TagData,
- *     which is the most recent Tag added to the packet. (``T5-T7``)
- *
- *   - Conceptually, therefore, each Packet has a PacketTagList which
- *     points to a singly-linked list of TagData.
- *
- * @par <b> Copy-on-write </b> is implemented as follows:
- *
- *   - #Add prepends the new tag to the list (growing that branch of the tree,
- *     as \c T6). This is a constant time operation, and does not affect
- *     any other #PacketTagList's, hence this is a \c const function.
- *
- *   - Copy constructor (PacketTagList(const PacketTagList & o))
- *     and assignment (#operator=(const PacketTagList & o))
- *     simply join the tree at the same place as the original
- *     PacketTagList \c o, incrementing the \c count.
- *     For assignment, the old branch is deleted, up to
- *     the first branch point, which has its \c count decremented.
- *     (PacketTagList \c B started as a copy of PacketTagList \c A,
- *     before \c T6 was added to \c B).
- *
- *   - #Remove and #Replace are a little tricky, depending on where the
- *     target tag is found relative to the first branch point:
- *     - \e Target before <em> the first branch point: </em> \n
- *       The target is just dealt with in place (linked around and deleted,
- *       in the case of #Remove; rewritten in the case of #Replace).
- *     - \e Target at or after <em> the first branch point: </em> \n
- *       The portion of the list between the first branch and the target is
- *       shared. This portion is copied before the #Remove or #Replace is
- *       performed.
+ *   - Beyond #INLINE_SIZE bytes, the records are moved to a TagStorage block
+ *     allocated by the PacketAllocator. The block is shared, and reference
+ *     counted, by the copies of the PacketTagList, and is unshared by the
+ *     first of them which adds, removes or replaces a tag (copy-on-write).
+ *     The records move back inline when they fit again.
  */
 class PacketTagList
 {
   public:
     /**
-     * Tree node for sharing serialized tags.
+     * Header of the serialized tags.
      *
      * See PacketTagList for a discussion of the data structure.
      *
@@ -124,19 +63,22 @@ class PacketTagList
      * The Item nested class can't be forward declared, so friending isn't
      * possible.
      *
-     * We use placement new so we can allocate enough room for the Tag
-     * type which will be serialized into data.  See Object::Aggregates
+     * The records are laid out in a byte array, each one with enough room
+     * for the Tag type which is serialized into data.  See Object::Aggregates
      * for a similar construction.
      */
     struct TagData
     {
-        TagData* next;   //!< Pointer to next in list
-        uint32_t count;  //!< Number of incoming links
         TypeId tid;      //!< Type of the tag serialized into #data
-        uint32_t size;   //!< Size of the \c data buffer
+        uint16_t size;   //!< Size of the \c data buffer
         uint8_t data[1]; //!< Serialization buffer
     };
 
+    /**
+     * Size of the tags stored inline, in bytes.
+     */
+    static constexpr uint32_t INLINE_SIZE = 64;
+
     /**
      * Create a new PacketTagList.
      */
@@ -146,8 +88,8 @@ class PacketTagList
      *
      * @param [in] o The PacketTagList to copy.
      *
-     * This makes a light-weight copy by #RemoveAll, then
-     * pointing to the same \ref TagData as \pname{o}.
+     * This copies the inline tags of \pname{o}, or shares its
+     * TagStorage.
      */
     inline PacketTagList(const PacketTagList& o);
     /**
@@ -157,18 +99,18 @@ class PacketTagList
      * @returns the copied object
      *
      * This makes a light-weight copy by #RemoveAll, then
-     * pointing to the same \ref TagData as \pname{o}.
+     * copying the inline tags of \pname{o}, or sharing its TagStorage.
      */
     inline PacketTagList& operator=(const PacketTagList& o);
     /**
      * Destructor
      *
-     * #RemoveAll's the tags up to the first merge.
+     * #RemoveAll's the tags.
      */
     inline ~PacketTagList();
 
     /**
-     * Add a tag to the head of this branch.
+     * Add a tag to the head of this list.
      *
      * @param [in] tag The tag to add
      */
@@ -200,13 +142,19 @@ class PacketTagList
      */
     bool Peek(Tag& tag) const;
     /**
-     * Remove all tags from this list (up to the first merge).
+     * Remove all tags from this list.
      */
     inline void RemoveAll();
     /**
-     * @returns pointer to head of tag list
+     * @returns pointer to the first tag of the list, or nullptr if the list is empty
      */
     const PacketTagList::TagData* Head() const;
+    /**
+     * @param [in] cur A tag of this list.
+     * @returns pointer to the tag following \pname{cur}, or nullptr if
+     *          \pname{cur} is the last one
+     */
+    const PacketTagList::TagData* Next(const PacketTagList::TagData* cur) const;
     /**
      * Returns number of bytes required for packet serialization.
      *
@@ -234,66 +182,56 @@ class PacketTagList
 
   private:
     /**
-     * Allocate and construct a TagData struct, sizing the data area
-     * large enough to serialize dataSize bytes from a Tag.
-     *
-     * @param [in] dataSize The serialized size of the Tag.
-     * @returns The newly constructed TagData object.
+     * Heap storage of the tags, shared by the copies of a PacketTagList.
      */
-    static TagData* CreateTagData(size_t dataSize);
+    struct TagStorage
+    {
+        uint32_t count;    //!< Number of PacketTagLists sharing the storage
+        uint32_t capacity; //!< Size of the \c data buffer
+        uint8_t data[4];   //!< The TagData records
+    };
 
     /**
-     * Typedef of method function pointer for copy-on-write operations
+     * Get the size of the record of a tag.
      *
-     * @param [in] tag The tag type to operate on.
-     * @param [in] preMerge True if \pname{tag} was found before the first merge,
-     *             false otherwise.
-     * @param [in] cur Pointer to the tag.
-     * @param [in] prevNext Pointer to the struct TagData.next pointer
-     *          pointing to \pname{cur}.
-     * @returns True if operation successful, false otherwise
+     * @param [in] dataSize The serialized size of the Tag.
+     * @returns The size of the TagData record, a multiple of 4 bytes.
      */
-    typedef bool (PacketTagList::*COWWriter)(Tag& tag,
-                                             bool preMerge,
-                                             TagData* cur,
-                                             TagData** prevNext);
+    static uint32_t GetRecordSize(uint32_t dataSize);
+
     /**
-     * Traverse the list implementing copy-on-write, using \pname{Writer}.
-     *
-     * @param [in] tag The tag type to operate on.
-     * @param [in] Writer The copy-on-write function to use.
-     * @returns True if \pname{tag} found, false otherwise.
+     * @returns The TagData records.
      */
-    bool COWTraverse(Tag& tag, PacketTagList::COWWriter Writer);
+    inline uint8_t* GetRecords() const;
+
     /**
-     * Copy-on-write implementing Remove.
+     * Find a tag.
      *
-     * @param [in] tag The target tag type to remove.
-     * @param [in] preMerge True if \pname{tag} was found before the first merge,
-     *             false otherwise.
-     * @param [in] cur Pointer to the tag.
-     * @param [in] prevNext Pointer to the struct TagData.next pointer
-     *          pointing to \pname{cur}.
-     * @returns True, since tag will definitely be removed.
+     * @param [in] tid The type of the tag.
+     * @returns The offset of the TagData record of the tag, or #m_used if not found.
      */
-    bool RemoveWriter(Tag& tag, bool preMerge, TagData* cur, TagData** prevNext);
+    uint32_t Find(TypeId tid) const;
+
     /**
-     * Copy-on-write implementing Replace
+     * Replace the bytes of a range of the records by uninitialized ones,
+     * unsharing the TagStorage, or moving the records inline or to a new
+     * TagStorage, as needed.
      *
-     * @param [in] tag The target tag type to replace
-     * @param [in] preMerge True if \pname{tag} was found before the first merge,
-     *          false otherwise.
-     * @param [in] cur Pointer to the tag
-     * @param [in] prevNext Pointer to the struct TagData.next pointer
-     *          pointing to \pname{cur}.
-     * @returns True, since tag value will definitely be replaced.
+     * @param [in] offset The offset of the range.
+     * @param [in] removed The number of bytes removed from the range.
+     * @param [in] inserted The number of bytes inserted in place of them.
+     * @returns A pointer to the inserted bytes.
      */
-    bool ReplaceWriter(Tag& tag, bool preMerge, TagData* cur, TagData** prevNext);
+    uint8_t* Splice(uint32_t offset, uint32_t removed, uint32_t inserted);
 
     /**
-     * Pointer to first \ref TagData on the list
+     * Release the TagStorage, deallocating it if it is not shared.
      */
-    TagData* m_next;
+    void ReleaseStorage();
+
+    TagStorage* m_storage;                    //!< The shared records, or nullptr if inline
+    uint32_t m_used;                          //!< Number of bytes of the records
+    alignas(4) uint8_t m_inline[INLINE_SIZE]; //!< The inline records
 };
 
 } // namespace ns3
@@ -306,16 +244,22 @@ namespace ns3
 {
 
 PacketTagList::PacketTagList()
-    : m_next()
+    : m_storage(nullptr),
+      m_used(0)
 {
 }
 
 PacketTagList::PacketTagList(const PacketTagList& o)
-    : m_next(o.m_next)
+    : m_storage(o.m_storage),
+      m_used(o.m_used)
 {
-    if (m_next != nullptr)
+    if (m_storage != nullptr)
+    {
+        m_storage->count++;
+    }
+    else
     {
-        m_next->count++;
+        std::memcpy(m_inline, o.m_inline, m_used);
     }
 }
 
@@ -323,15 +267,20 @@ PacketTagList&
 PacketTagList::operator=(const PacketTagList& o)
 {
     // self assignment
-    if (m_next == o.m_next)
+    if (this == &o)
     {
         return *this;
     }
     RemoveAll();
-    m_next = o.m_next;
-    if (m_next != nullptr)
+    m_storage = o.m_storage;
+    m_used = o.m_used;
+    if (m_storage != nullptr)
+    {
+        m_storage->count++;
+    }
+    else
     {
-        m_next->count++;
+        std::memcpy(m_inline, o.m_inline, m_used);
     }
     return *this;
 }
@@ -344,27 +293,17 @@ PacketTagList::~PacketTagList()
 void
 PacketTagList::RemoveAll()
 {
-    TagData* prev = nullptr;
-    for (TagData* cur = m_next; cur != nullptr; cur = cur->next)
-    {
-        cur->count--;
-        if (cur->count > 0)
-        {
-            break;
-        }
-        if (prev != nullptr)
-        {
-            prev->~TagData();
-            std::free(prev);
-        }
-        prev = cur;
-    }
-    if (prev != nullptr)
+    if (m_storage != nullptr)
     {
-        prev->~TagData();
-        std::free(prev);
+        ReleaseStorage();
     }
-    m_next = nullptr;
+    m_used = 0;
+}
+
+uint8_t*
+PacketTagList::GetRecords() const
+{
+    return m_storage != nullptr ? m_storage->data : const_cast<uint8_t*>(m_inline);
 }
 
 } // namespace ns3
@@ -7,6 +7,8 @@
  */
 #include "packet.h"
 
+#include "packet-allocator.h"
+
 #include "ns3/assert.h"
 #include "ns3/log.h"
 #include "ns3/simulator.h"
@@ -78,8 +80,9 @@ ByteTagIterator::ByteTagIterator(ByteTagList::Iterator i)
 {
 }
 
-PacketTagIterator::PacketTagIterator(const PacketTagList::TagData* head)
-    : m_current(head)
+PacketTagIterator::PacketTagIterator(const PacketTagList& list)
+    : m_list(&list),
+      m_current(list.Head())
 {
 }
 
@@ -94,7 +97,7 @@ PacketTagIterator::Next()
 {
     NS_ASSERT(HasNext());
     const PacketTagList::TagData* prev = m_current;
-    m_current = m_current->next;
+    m_current = m_list->Next(m_current);
     return PacketTagIterator::Item(prev);
 }
 
@@ -116,6 +119,18 @@ PacketTagIterator::Item::GetTag(Tag& tag) const
     tag.Deserialize(TagBuffer((uint8_t*)m_data->data, (uint8_t*)m_data->data + m_data->size));
 }
 
+void*
+Packet::operator new(std::size_t size)
+{
+    return PacketAllocator::Allocate(size);
+}
+
+void
+Packet::operator delete(void* p, std::size_t size)
+{
+    PacketAllocator::Deallocate(p, size);
+}
+
 Ptr<Packet>
 Packet::Copy() const
 {
@@ -1008,7 +1023,7 @@ Packet::PrintPacketTags(std::ostream& os) const
 PacketTagIterator
 Packet::GetPacketTagIterator() const
 {
-    return PacketTagIterator(m_packetTagList.Head());
+    return PacketTagIterator(m_packetTagList);
 }
 
 std::ostream&
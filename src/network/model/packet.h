@@ -22,6 +22,7 @@
 #include "ns3/mac48-address.h"
 #include "ns3/ptr.h"
 
+#include <cstddef>
 #include <stdint.h>
 
 namespace ns3
@@ -169,9 +170,10 @@ class PacketTagIterator
     friend class Packet;
     /**
      * Constructor
-     * @param head head of the items
+     * @param list the list of the items
      */
-    PacketTagIterator(const PacketTagList::TagData* head);
+    PacketTagIterator(const PacketTagList& list);
+    const PacketTagList* m_list;             //!< the list of the tags in a packet
     const PacketTagList::TagData* m_current; //!< actual position over the set of tags in a packet
 };
 
@@ -279,6 +281,20 @@ class Packet : public SimpleRefCount<Packet>
      * @param size the size of the input buffer.
      */
     Packet(const uint8_t* buffer, uint32_t size);
+    /**
+     * @brief Allocate the memory of a packet from the PacketAllocator.
+     *
+     * @param [in] size The size of the packet.
+     * @returns The memory of the packet.
+     */
+    static void* operator new(std::size_t size);
+    /**
+     * @brief Return the memory of a packet to the PacketAllocator.
+     *
+     * @param [in] p The memory of the packet.
+     * @param [in] size The size of the packet.
+     */
+    static void operator delete(void* p, std::size_t size);
     /**
      * @brief Create a new packet which contains a fragment of the original
      * packet.
@@ -591,6 +607,9 @@ class Packet : public SimpleRefCount<Packet>
      * @brief Returns an iterator over the set of byte tags included in this packet
      *
      * @returns an iterator over the set of byte tags included in this packet.
+     *
+     * The iterator refers to the tags stored in this packet, so it must not
+     * be used after this packet is destroyed or its byte tags are changed.
      */
     ByteTagIterator GetByteTagIterator() const;
     /**
@@ -676,6 +695,9 @@ class Packet : public SimpleRefCount<Packet>
      *
      * @returns an object which can be used to iterate over the list of
      *  packet tags.
+     *
+     * The iterator refers to the tags stored in this packet, so it must not
+     * be used after this packet is destroyed or its packet tags are changed.
      */
     PacketTagIterator GetPacketTagIterator() const;
 
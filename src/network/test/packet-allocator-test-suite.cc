@@ -0,0 +1,194 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/packet-allocator.h"
+#include "ns3/packet.h"
+#include "ns3/test.h"
+
+#include <cstring>
+#include <string>
+#include <thread>
+
+/**
+ * @file
+ * @ingroup network-test
+ * PacketAllocator test suite.
+ */
+
+namespace ns3
+{
+
+namespace tests
+{
+
+/**
+ * @ingroup network-test
+ * Check the size classes and the recycling of the blocks.
+ */
+class PacketAllocatorBlockTestCase : public TestCase
+{
+  public:
+    PacketAllocatorBlockTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+PacketAllocatorBlockTestCase::PacketAllocatorBlockTestCase()
+    : TestCase("Check the allocation of the blocks")
+{
+}
+
+void
+PacketAllocatorBlockTestCase::DoRun()
+{
+    NS_TEST_EXPECT_MSG_EQ(PacketAllocator::GetBlockSize(1), 32, "Wrong smallest block");
+    NS_TEST_EXPECT_MSG_EQ(PacketAllocator::GetBlockSize(32), 32, "Wrong block size");
+    NS_TEST_EXPECT_MSG_EQ(PacketAllocator::GetBlockSize(33), 64, "Wrong block size");
+    NS_TEST_EXPECT_MSG_EQ(PacketAllocator::GetBlockSize(4096), 4096, "Wrong largest block");
+    NS_TEST_EXPECT_MSG_EQ(PacketAllocator::GetBlockSize(5000), 5000, "Wrong heap block");
+
+    void* p = PacketAllocator::Allocate(100);
+    NS_TEST_ASSERT_MSG_NE(p, nullptr, "No block");
+    // the whole block can be used
+    std::memset(p, 0, PacketAllocator::GetBlockSize(100));
+    PacketAllocator::ResetStats();
+    PacketAllocator::Deallocate(p, 100);
+    void* q = PacketAllocator::Allocate(120);
+    auto stats = PacketAllocator::GetStats();
+    NS_TEST_EXPECT_MSG_EQ(stats.allocations, 1, "Wrong number of allocations");
+    NS_TEST_EXPECT_MSG_EQ(stats.deallocations, 1, "Wrong number of deallocations");
+    if (stats.heapAllocations == 0)
+    {
+        // the slab allocator is not bypassed, e.g., by valgrind
+        NS_TEST_EXPECT_MSG_EQ(q, p, "The block of the same size class was not recycled");
+        NS_TEST_EXPECT_MSG_EQ(stats.freeListAllocations, 1, "Wrong free list allocations");
+    }
+    // the block can be deallocated with its full size
+    PacketAllocator::Deallocate(q, PacketAllocator::GetBlockSize(120));
+
+    PacketAllocator::ResetStats();
+    p = PacketAllocator::Allocate(5000);
+    PacketAllocator::Deallocate(p, 5000);
+    stats = PacketAllocator::GetStats();
+    NS_TEST_EXPECT_MSG_EQ(stats.heapAllocations, 1, "A large block was not allocated on the heap");
+    NS_TEST_EXPECT_MSG_EQ(stats.deallocations, 1, "Wrong number of deallocations");
+}
+
+/**
+ * @ingroup network-test
+ * Check the allocations of the packets.
+ */
+class PacketAllocatorPacketTestCase : public TestCase
+{
+  public:
+    PacketAllocatorPacketTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+PacketAllocatorPacketTestCase::PacketAllocatorPacketTestCase()
+    : TestCase("Check the allocations of the packets")
+{
+}
+
+void
+PacketAllocatorPacketTestCase::DoRun()
+{
+    PacketAllocator::ResetStats();
+    Ptr<Packet> p = Create<Packet>(100);
+    // the Packet, its Buffer::Data and its PacketMetadata::Data
+    NS_TEST_EXPECT_MSG_EQ(PacketAllocator::GetStats().allocations,
+                          3,
+                          "Wrong number of allocations to create a packet");
+    Ptr<Packet> copy = p->Copy();
+    // the copy shares the data of the original
+    NS_TEST_EXPECT_MSG_EQ(PacketAllocator::GetStats().allocations,
+                          4,
+                          "Wrong number of allocations to copy a packet");
+    p = nullptr;
+    copy = nullptr;
+    const auto stats = PacketAllocator::GetStats();
+    NS_TEST_EXPECT_MSG_EQ(stats.deallocations,
+                          stats.allocations,
+                          "The packets were not deallocated: " << stats);
+}
+
+/**
+ * @ingroup network-test
+ * Check that a packet created by a thread can be destroyed by another one.
+ */
+class PacketAllocatorThreadTestCase : public TestCase
+{
+  public:
+    PacketAllocatorThreadTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+PacketAllocatorThreadTestCase::PacketAllocatorThreadTestCase()
+    : TestCase("Check the deallocation of the packets by another thread")
+{
+}
+
+void
+PacketAllocatorThreadTestCase::DoRun()
+{
+    Ptr<Packet> p;
+    void* block = nullptr;
+    PacketAllocatorStats threadStats;
+    std::thread thread([&p, &block, &threadStats]() {
+        p = Create<Packet>(reinterpret_cast<const uint8_t*>("hello"), 5);
+        block = PacketAllocator::Allocate(100);
+        threadStats = PacketAllocator::GetStats();
+    });
+    thread.join();
+    const auto live = threadStats.allocations - threadStats.deallocations;
+    NS_TEST_EXPECT_MSG_GT_OR_EQ(live, 4, "Wrong allocations of the thread: " << threadStats);
+
+    PacketAllocator::ResetStats();
+    uint8_t data[5];
+    p->CopyData(data, 5);
+    NS_TEST_EXPECT_MSG_EQ(std::string(reinterpret_cast<char*>(data), 5),
+                          "hello",
+                          "Wrong packet data");
+    p = nullptr;
+    PacketAllocator::Deallocate(block, 100);
+    NS_TEST_EXPECT_MSG_EQ(PacketAllocator::GetStats().deallocations,
+                          live,
+                          "The blocks were not deallocated by this thread");
+
+    // the blocks are recycled by this thread
+    void* recycled = PacketAllocator::Allocate(100);
+    if (PacketAllocator::GetStats().heapAllocations == 0)
+    {
+        NS_TEST_EXPECT_MSG_EQ(recycled, block, "The block of the other thread was not recycled");
+    }
+    PacketAllocator::Deallocate(recycled, 100);
+}
+
+/**
+ * @ingroup network-test
+ * PacketAllocator test suite.
+ */
+class PacketAllocatorTestSuite : public TestSuite
+{
+  public:
+    PacketAllocatorTestSuite()
+        : TestSuite("packet-allocator", Type::UNIT)
+    {
+        AddTestCase(new PacketAllocatorBlockTestCase(), TestCase::Duration::QUICK);
+        AddTestCase(new PacketAllocatorPacketTestCase(), TestCase::Duration::QUICK);
+        AddTestCase(new PacketAllocatorThreadTestCase(), TestCase::Duration::QUICK);
+    }
+};
+
+/// Static variable for test initialization.
+static PacketAllocatorTestSuite g_packetAllocatorTestSuite;
+
+} // namespace tests
+
+} // namespace ns3
@@ -5,6 +5,7 @@
  *
  * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
  */
+#include "ns3/packet-allocator.h"
 #include "ns3/packet-tag-list.h"
 #include "ns3/packet.h"
 #include "ns3/test.h"
@@ -1257,6 +1258,101 @@ PacketTagListTest::DoRun()
     }
 }
 
+/**
+ * @ingroup network-test
+ * @ingroup tests
+ *
+ * Packet inline tags unit tests.
+ */
+class PacketInlineTagsTest : public TestCase
+{
+  public:
+    PacketInlineTagsTest();
+
+  private:
+    void DoRun() override;
+    /**
+     * Count the byte tags of a packet.
+     * @param p The packet.
+     * @return The number of byte tags.
+     */
+    uint32_t CountByteTags(Ptr<const Packet> p);
+};
+
+PacketInlineTagsTest::PacketInlineTagsTest()
+    : TestCase("Packet inline tags")
+{
+}
+
+uint32_t
+PacketInlineTagsTest::CountByteTags(Ptr<const Packet> p)
+{
+    uint32_t n = 0;
+    for (ByteTagIterator i = p->GetByteTagIterator(); i.HasNext(); i.Next())
+    {
+        n++;
+    }
+    return n;
+}
+
+void
+PacketInlineTagsTest::DoRun()
+{
+    PacketAllocator::ResetStats();
+    Ptr<Packet> p = Create<Packet>(1000);
+    const auto created = PacketAllocator::GetStats().allocations;
+    p->AddPacketTag(ATestTag<4>(4));
+    p->AddPacketTag(ATestTag<8>(8));
+    p->AddByteTag(ATestTag<20>(20));
+    Ptr<Packet> inlineCopy = p->Copy();
+    NS_TEST_EXPECT_MSG_EQ(PacketAllocator::GetStats().allocations - created,
+                          1,
+                          "The small tags were not stored inline");
+
+    // spill the tags of the packet out of the inline buffers
+    p->AddPacketTag(ATestTag<40>(40));
+    p->AddByteTag(ATestTag<30>(30));
+    Ptr<Packet> copy = p->Copy();
+    NS_TEST_EXPECT_MSG_EQ(PacketAllocator::GetStats().allocations - created,
+                          4,
+                          "The large tags were not stored on the heap, or were not shared");
+
+    // the tags are unshared and moved back inline
+    ATestTag<40> t40;
+    NS_TEST_EXPECT_MSG_EQ(copy->RemovePacketTag(t40), true, "Missing tag in the copy");
+    NS_TEST_EXPECT_MSG_EQ(t40.GetData(), 40, "Wrong tag in the copy");
+    NS_TEST_EXPECT_MSG_EQ(copy->PeekPacketTag(t40), false, "The tag was not removed");
+    NS_TEST_EXPECT_MSG_EQ(p->PeekPacketTag(t40), true, "The tag was removed from the original");
+    NS_TEST_EXPECT_MSG_EQ(inlineCopy->PeekPacketTag(t40), false, "The tag was added to the copy");
+    ATestTag<8> t8;
+    NS_TEST_EXPECT_MSG_EQ(copy->PeekPacketTag(t8), true, "Missing tag in the copy");
+    NS_TEST_EXPECT_MSG_EQ(t8.GetData(), 8, "Wrong tag in the copy");
+
+    copy->AddByteTag(ATestTag<1>(1));
+    NS_TEST_EXPECT_MSG_EQ(CountByteTags(p), 2, "Wrong number of byte tags");
+    NS_TEST_EXPECT_MSG_EQ(CountByteTags(copy), 3, "Wrong number of byte tags in the copy");
+    NS_TEST_EXPECT_MSG_EQ(CountByteTags(inlineCopy), 1, "Wrong number of byte tags in the copy");
+
+    // the packet tags are iterated from the most recently added one
+    const char* names[] = {"anon::ATestTag<40>", "anon::ATestTag<8>", "anon::ATestTag<4>"};
+    uint32_t n = 0;
+    for (PacketTagIterator i = p->GetPacketTagIterator(); i.HasNext(); n++)
+    {
+        const auto item = i.Next();
+        NS_TEST_ASSERT_MSG_LT(n, 3, "Too many packet tags");
+        NS_TEST_EXPECT_MSG_EQ(item.GetTypeId().GetName(), names[n], "Wrong packet tag");
+    }
+    NS_TEST_EXPECT_MSG_EQ(n, 3, "Wrong number of packet tags");
+
+    p = nullptr;
+    copy = nullptr;
+    inlineCopy = nullptr;
+    const auto stats = PacketAllocator::GetStats();
+    NS_TEST_EXPECT_MSG_EQ(stats.deallocations,
+                          stats.allocations,
+                          "The tags were not deallocated: " << stats);
+}
+
 /**
  * @ingroup network-test
  * @ingroup tests
@@ -1274,6 +1370,7 @@ PacketTestSuite::PacketTestSuite()
 {
     AddTestCase(new PacketTest, TestCase::Duration::QUICK);
     AddTestCase(new PacketTagListTest, TestCase::Duration::QUICK);
+    AddTestCase(new PacketInlineTagsTest, TestCase::Duration::QUICK);
 }
 
 static PacketTestSuite g_packetTestSuite; //!< Static variable for test initialization
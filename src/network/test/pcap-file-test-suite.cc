@@ -4,13 +4,19 @@
  * Author:  Craig Dowell (craigdo@ee.washington.edu)
  */
 
+#include "ns3/boolean.h"
 #include "ns3/log.h"
+#include "ns3/output-stream-wrapper.h"
+#include "ns3/packet.h"
+#include "ns3/pcap-file-wrapper.h"
 #include "ns3/pcap-file.h"
+#include "ns3/simulator.h"
 #include "ns3/test.h"
 
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <fstream>
 #include <iostream>
 #include <sstream>
 
@@ -1364,6 +1370,121 @@ DiffTestCase::DoRun()
     NS_TEST_EXPECT_MSG_EQ(usec, 3696, "Files are different from 2.3696 seconds");
 }
 
+/**
+ * @ingroup network-test
+ * @ingroup tests
+ *
+ * @brief Test case to make sure that the files written asynchronously are
+ * identical to the files written synchronously.
+ */
+class AsyncWriteTestCase : public TestCase
+{
+  public:
+    AsyncWriteTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Read a whole file
+     * @param filename the file name
+     * @returns the content of the file
+     */
+    static std::string ReadFile(const std::string& filename);
+};
+
+AsyncWriteTestCase::AsyncWriteTestCase()
+    : TestCase("Check that the files written asynchronously are complete")
+{
+}
+
+std::string
+AsyncWriteTestCase::ReadFile(const std::string& filename)
+{
+    std::ifstream file(filename, std::ios::binary);
+    std::ostringstream oss;
+    oss << file.rdbuf();
+    return oss.str();
+}
+
+void
+AsyncWriteTestCase::DoRun()
+{
+    //
+    // A pcap file written through a ring of small buffers, so that the writer
+    // waits for the background thread, is identical to the file written
+    // synchronously
+    //
+    std::string syncFilename = CreateTempDirFilename("sync.pcap");
+    std::string asyncFilename = CreateTempDirFilename("async.pcap");
+    PcapFile syncFile;
+    PcapFile asyncFile;
+    syncFile.Open(syncFilename, std::ios::out);
+    asyncFile.OpenAsync(asyncFilename, 100, 2);
+    NS_TEST_ASSERT_MSG_EQ(asyncFile.Fail(), false, "OpenAsync (" << asyncFilename << ") fails");
+    syncFile.Init(1, N_PACKET_BYTES);
+    asyncFile.Init(1, N_PACKET_BYTES);
+    NS_TEST_ASSERT_MSG_EQ(asyncFile.Fail(), false, "Init of an asynchronous file fails");
+    uint8_t data[1000];
+    for (uint32_t i = 0; i < sizeof(data); ++i)
+    {
+        data[i] = i;
+    }
+    for (uint32_t i = 0; i < 1000; ++i)
+    {
+        syncFile.Write(i, i * 7, data, i);
+        asyncFile.Write(i, i * 7, data, i);
+        syncFile.Write(i, i * 7 + 1, Create<Packet>(data, i % 100));
+        asyncFile.Write(i, i * 7 + 1, Create<Packet>(data, i % 100));
+    }
+    NS_TEST_EXPECT_MSG_EQ(asyncFile.Fail(), false, "Write to an asynchronous file fails");
+    syncFile.Close();
+    asyncFile.Close();
+    NS_TEST_EXPECT_MSG_EQ(asyncFile.Fail(), false, "Close of an asynchronous file fails");
+    NS_TEST_EXPECT_MSG_EQ((ReadFile(asyncFilename) == ReadFile(syncFilename)),
+                          true,
+                          "The asynchronous pcap file differs");
+
+    //
+    // The files still open are completely written by Simulator::Destroy()
+    //
+    auto wrapper = CreateObject<PcapFileWrapper>();
+    wrapper->SetAttribute("AsyncWrite", BooleanValue(true));
+    wrapper->Open(asyncFilename, std::ios::out);
+    wrapper->Init(1);
+    wrapper->Write(Seconds(1), Create<Packet>(100));
+    std::string asciiFilename = CreateTempDirFilename("async.tr");
+    auto stream = Create<OutputStreamWrapper>(asciiFilename, std::ios::out, true);
+    std::ostringstream expected;
+    for (uint32_t i = 0; i < 10000; ++i)
+    {
+        *stream->GetStream() << "line " << i << std::endl;
+        expected << "line " << i << std::endl;
+    }
+    Simulator::Destroy();
+    NS_TEST_EXPECT_MSG_EQ(CheckFileLength(asyncFilename, 24 + 16 + 100),
+                          true,
+                          "Simulator::Destroy () does not write the pcap file");
+    NS_TEST_EXPECT_MSG_EQ((ReadFile(asciiFilename) == expected.str()),
+                          true,
+                          "Simulator::Destroy () does not write the ascii file");
+
+    //
+    // The files are still written to after Simulator::Destroy()
+    //
+    *stream->GetStream() << "last line" << std::endl;
+    expected << "last line" << std::endl;
+    stream = nullptr;
+    wrapper = nullptr;
+    NS_TEST_EXPECT_MSG_EQ((ReadFile(asciiFilename) == expected.str()),
+                          true,
+                          "The ascii file is incomplete");
+
+    remove(syncFilename.c_str());
+    remove(asyncFilename.c_str());
+    remove(asciiFilename.c_str());
+}
+
 /**
  * @ingroup network-test
  * @ingroup tests
@@ -1387,6 +1508,7 @@ PcapFileTestSuite::PcapFileTestSuite()
     AddTestCase(new RecordHeaderTestCase, TestCase::Duration::QUICK);
     AddTestCase(new ReadFileTestCase, TestCase::Duration::QUICK);
     AddTestCase(new DiffTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new AsyncWriteTestCase, TestCase::Duration::QUICK);
 }
 
 static PcapFileTestSuite pcapFileTestSuite; //!< Static variable for test initialization
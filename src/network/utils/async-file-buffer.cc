@@ -0,0 +1,449 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "async-file-buffer.h"
+
+#include "ns3/assert.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+
+#ifndef __WIN32__
+#include <cerrno>
+#include <sys/uio.h>
+#endif
+
+/**
+ * @file
+ * @ingroup network
+ * ns3::AsyncFileBuffer implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("AsyncFileBuffer");
+
+namespace
+{
+
+/// Maximum number of buffers written by a single call
+const uint64_t MAX_BATCH = 64;
+
+#ifndef __WIN32__
+/**
+ * Write buffers to a file descriptor, retrying after partial writes
+ * @param fd the file descriptor
+ * @param iov the buffers, which are modified
+ * @param count the number of buffers
+ * @returns false if a write failed
+ */
+bool
+WriteVector(int fd, struct iovec* iov, int count)
+{
+    while (count > 0)
+    {
+        ssize_t written = writev(fd, iov, count);
+        if (written < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return false;
+        }
+        while (count > 0 && static_cast<std::size_t>(written) >= iov->iov_len)
+        {
+            written -= iov->iov_len;
+            ++iov;
+            --count;
+        }
+        if (count > 0)
+        {
+            iov->iov_base = static_cast<char*>(iov->iov_base) + written;
+            iov->iov_len -= written;
+        }
+    }
+    return true;
+}
+#endif
+
+} // namespace
+
+/**
+ * The I/O thread shared by all the open AsyncFileBuffer objects.
+ *
+ * The thread is started when a file is opened and stopped when the last
+ * open file is closed.  It scans the open files whenever a buffer is handed
+ * over, and sleeps otherwise.
+ */
+class AsyncFileBuffer::Service
+{
+  public:
+    /**
+     * Get the service; it is never destroyed, so that the files still open
+     * when the program exits can be written by the exit handler
+     * @returns the service
+     */
+    static Service& Get();
+
+    /**
+     * Add a file to the files written by the I/O thread
+     * @param buffer the stream buffer of the file
+     */
+    void Register(AsyncFileBuffer* buffer);
+    /**
+     * Remove a file from the files written by the I/O thread
+     * @param buffer the stream buffer of the file, whose buffers are all written
+     */
+    void Unregister(AsyncFileBuffer* buffer);
+    /// @returns the stream buffers of the open files
+    std::vector<AsyncFileBuffer*> GetBuffers();
+    /// Reset the flag that a flush of all files is scheduled at Simulator::Destroy()
+    void ResetDestroy();
+    /// Wake the I/O thread up, after a buffer was handed over
+    void Notify();
+
+  private:
+    /**
+     * Write the buffers handed over, until the thread is replaced or stopped
+     * @param generation the generation of the thread
+     */
+    void Run(uint64_t generation);
+
+    std::mutex m_mutex;                      ///< protects the members below but m_work
+    std::vector<AsyncFileBuffer*> m_buffers; ///< the open files
+    std::thread m_thread;                    ///< the I/O thread
+    uint64_t m_generation{0};                ///< incremented when the thread is stopped
+    bool m_destroyScheduled{false};          ///< whether FlushAll() runs at Simulator::Destroy()
+    bool m_exitRegistered{false};            ///< whether FlushAll() runs at exit
+    std::atomic<uint64_t> m_work{0};         ///< incremented when a buffer is handed over
+};
+
+AsyncFileBuffer::Service&
+AsyncFileBuffer::Service::Get()
+{
+    static auto service = new Service();
+    return *service;
+}
+
+void
+AsyncFileBuffer::Service::Register(AsyncFileBuffer* buffer)
+{
+    std::lock_guard lock(m_mutex);
+    m_buffers.push_back(buffer);
+    if (!m_thread.joinable())
+    {
+        m_thread = std::thread(&Service::Run, this, m_generation);
+    }
+    if (!m_destroyScheduled)
+    {
+        Simulator::ScheduleDestroy(&AsyncFileBuffer::FlushAll);
+        m_destroyScheduled = true;
+    }
+    if (!m_exitRegistered)
+    {
+        std::atexit(&AsyncFileBuffer::FlushAll);
+        m_exitRegistered = true;
+    }
+}
+
+void
+AsyncFileBuffer::Service::Unregister(AsyncFileBuffer* buffer)
+{
+    std::thread thread;
+    {
+        std::lock_guard lock(m_mutex);
+        m_buffers.erase(std::find(m_buffers.begin(), m_buffers.end(), buffer));
+        if (m_buffers.empty())
+        {
+            // a thread started by a later Register() does not run along this one
+            ++m_generation;
+            thread = std::move(m_thread);
+        }
+    }
+    if (thread.joinable())
+    {
+        Notify();
+        thread.join();
+    }
+}
+
+std::vector<AsyncFileBuffer*>
+AsyncFileBuffer::Service::GetBuffers()
+{
+    std::lock_guard lock(m_mutex);
+    return m_buffers;
+}
+
+void
+AsyncFileBuffer::Service::ResetDestroy()
+{
+    std::lock_guard lock(m_mutex);
+    m_destroyScheduled = false;
+}
+
+void
+AsyncFileBuffer::Service::Notify()
+{
+    m_work.fetch_add(1, std::memory_order_release);
+    m_work.notify_all();
+}
+
+void
+AsyncFileBuffer::Service::Run(uint64_t generation)
+{
+    while (true)
+    {
+        // read the counter before the scan, so that a buffer handed over
+        // after the scan wakes the thread up
+        const uint64_t work = m_work.load(std::memory_order_acquire);
+        {
+            std::lock_guard lock(m_mutex);
+            if (generation != m_generation)
+            {
+                return;
+            }
+            for (auto buffer : m_buffers)
+            {
+                buffer->WritePending();
+            }
+        }
+        m_work.wait(work, std::memory_order_acquire);
+    }
+}
+
+AsyncFileBuffer::AsyncFileBuffer()
+    : m_file(nullptr),
+      m_bufferSize(0),
+      m_head(0),
+      m_tail(0),
+      m_error(false),
+      m_offset(0),
+      m_stalls(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+AsyncFileBuffer::~AsyncFileBuffer()
+{
+    NS_LOG_FUNCTION(this);
+    Close();
+}
+
+bool
+AsyncFileBuffer::Open(const std::string& filename,
+                      std::ios::openmode mode,
+                      uint32_t bufferSize,
+                      uint32_t nBuffers)
+{
+    NS_LOG_FUNCTION(this << filename << mode << bufferSize << nBuffers);
+    NS_ASSERT_MSG(m_file == nullptr, "File already open");
+    NS_ASSERT_MSG(mode & std::ios::out, "Files are opened for writing only");
+    NS_ASSERT(bufferSize > 0 && nBuffers > 0);
+    std::string fopenMode = (mode & std::ios::app) ? "a" : "w";
+    if (mode & std::ios::binary)
+    {
+        fopenMode += "b";
+    }
+    m_file = std::fopen(filename.c_str(), fopenMode.c_str());
+    if (m_file == nullptr)
+    {
+        return false;
+    }
+    m_bufferSize = bufferSize;
+    m_slots.clear();
+    m_slots.resize(nBuffers);
+    m_head = 0;
+    m_tail = 0;
+    m_error = false;
+    m_offset = 0;
+    m_stalls = 0;
+    Acquire();
+    Service::Get().Register(this);
+    return true;
+}
+
+bool
+AsyncFileBuffer::IsOpen() const
+{
+    return m_file != nullptr;
+}
+
+void
+AsyncFileBuffer::Acquire()
+{
+    const uint64_t tail = m_tail.load(std::memory_order_relaxed);
+    for (uint64_t head = m_head.load(std::memory_order_acquire); tail - head >= m_slots.size();
+         head = m_head.load(std::memory_order_acquire))
+    {
+        NS_LOG_LOGIC("all the buffers are waiting to be written");
+        ++m_stalls;
+        m_head.wait(head, std::memory_order_acquire);
+    }
+    Slot& slot = m_slots[tail % m_slots.size()];
+    if (!slot.data)
+    {
+        slot.data.reset(new char[m_bufferSize]);
+    }
+    setp(slot.data.get(), slot.data.get() + m_bufferSize);
+}
+
+void
+AsyncFileBuffer::Publish()
+{
+    const uint64_t tail = m_tail.load(std::memory_order_relaxed);
+    const std::size_t size = pptr() - pbase();
+    m_slots[tail % m_slots.size()].size = size;
+    m_offset += size;
+    m_tail.store(tail + 1, std::memory_order_release);
+    Service::Get().Notify();
+    Acquire();
+}
+
+bool
+AsyncFileBuffer::WritePending()
+{
+    const uint64_t tail = m_tail.load(std::memory_order_acquire);
+    uint64_t head = m_head.load(std::memory_order_relaxed);
+    if (head == tail)
+    {
+        return false;
+    }
+    while (head != tail)
+    {
+        const uint64_t count = std::min(tail - head, MAX_BATCH);
+        if (!m_error)
+        {
+#ifdef __WIN32__
+            for (uint64_t i = 0; i < count; ++i)
+            {
+                const Slot& slot = m_slots[(head + i) % m_slots.size()];
+                if (std::fwrite(slot.data.get(), 1, slot.size, m_file) != slot.size)
+                {
+                    m_error = true;
+                }
+            }
+            m_error = std::fflush(m_file) != 0 || m_error;
+#else
+            struct iovec iov[MAX_BATCH];
+            for (uint64_t i = 0; i < count; ++i)
+            {
+                const Slot& slot = m_slots[(head + i) % m_slots.size()];
+                iov[i].iov_base = slot.data.get();
+                iov[i].iov_len = slot.size;
+            }
+            m_error = !WriteVector(fileno(m_file), iov, static_cast<int>(count));
+#endif
+        }
+        head += count;
+        m_head.store(head, std::memory_order_release);
+        m_head.notify_all();
+    }
+    return true;
+}
+
+AsyncFileBuffer::int_type
+AsyncFileBuffer::overflow(int_type ch)
+{
+    if (m_file == nullptr || m_error)
+    {
+        return traits_type::eof();
+    }
+    Publish();
+    if (!traits_type::eq_int_type(ch, traits_type::eof()))
+    {
+        *pptr() = traits_type::to_char_type(ch);
+        pbump(1);
+    }
+    return traits_type::not_eof(ch);
+}
+
+int
+AsyncFileBuffer::sync()
+{
+    return m_error ? -1 : 0;
+}
+
+AsyncFileBuffer::pos_type
+AsyncFileBuffer::seekoff(off_type off, std::ios::seekdir dir, std::ios::openmode which)
+{
+    // Only report the current position, which the pcap files seek to when
+    // writing their header
+    const pos_type pos(static_cast<off_type>(m_offset + (pptr() - pbase())));
+    if (m_file != nullptr && (which & std::ios::out) &&
+        ((dir == std::ios::cur && off == 0) || (dir == std::ios::beg && pos_type(off) == pos)))
+    {
+        return pos;
+    }
+    return pos_type(off_type(-1));
+}
+
+AsyncFileBuffer::pos_type
+AsyncFileBuffer::seekpos(pos_type pos, std::ios::openmode which)
+{
+    return seekoff(off_type(pos), std::ios::beg, which);
+}
+
+bool
+AsyncFileBuffer::Flush()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_file == nullptr)
+    {
+        return true;
+    }
+    if (pptr() > pbase())
+    {
+        Publish();
+    }
+    const uint64_t tail = m_tail.load(std::memory_order_relaxed);
+    for (uint64_t head = m_head.load(std::memory_order_acquire); head != tail;
+         head = m_head.load(std::memory_order_acquire))
+    {
+        m_head.wait(head, std::memory_order_acquire);
+    }
+    return !m_error;
+}
+
+bool
+AsyncFileBuffer::Close()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_file == nullptr)
+    {
+        return true;
+    }
+    bool ok = Flush();
+    Service::Get().Unregister(this);
+    ok = std::fclose(m_file) == 0 && ok;
+    m_file = nullptr;
+    m_slots.clear();
+    setp(nullptr, nullptr);
+    return ok;
+}
+
+uint64_t
+AsyncFileBuffer::GetStalls() const
+{
+    return m_stalls;
+}
+
+void
+AsyncFileBuffer::FlushAll()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    Service& service = Service::Get();
+    service.ResetDestroy();
+    for (auto buffer : service.GetBuffers())
+    {
+        buffer->Flush();
+    }
+}
+
+} // namespace ns3
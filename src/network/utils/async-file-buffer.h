@@ -0,0 +1,147 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef ASYNC_FILE_BUFFER_H
+#define ASYNC_FILE_BUFFER_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+/**
+ * @file
+ * @ingroup network
+ * ns3::AsyncFileBuffer declaration.
+ */
+
+namespace ns3
+{
+
+/**
+ * @ingroup network
+ *
+ * @brief A stream buffer writing a file asynchronously, from a background thread
+ *
+ * The data written to a std::ostream using this stream buffer is copied
+ * into a ring of fixed-size buffers.  When a buffer is full, it is handed
+ * over to an I/O thread, shared by all the open AsyncFileBuffer objects,
+ * which writes the consecutive full buffers with a single writev() call
+ * and hands them back.  The buffers are allocated the first time they are
+ * used, and the ring is a lock-free single-producer single-consumer queue.
+ *
+ * The memory used by a file is bounded by the size of its ring: if all the
+ * buffers are waiting to be written, the writer blocks until the I/O thread
+ * has written the oldest one.
+ *
+ * The std::ostream::flush() and std::endl of the writer do not wait for the
+ * data to be written, as they are used after each line by the ascii trace
+ * sinks.  Flush() and Close() do.  The buffered data of all the open files
+ * is also written when Simulator::Destroy() is called, and when the program
+ * exits.
+ *
+ * The ring is owned by a single writer thread: the stream must not be
+ * written from several threads.
+ */
+class AsyncFileBuffer : public std::streambuf
+{
+  public:
+    /// Default size of a buffer, in bytes
+    static const uint32_t BUFFER_SIZE_DEFAULT = 32768;
+    /// Default number of buffers in the ring
+    static const uint32_t BUFFERS_DEFAULT = 8;
+
+    AsyncFileBuffer();
+    ~AsyncFileBuffer() override;
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    AsyncFileBuffer(const AsyncFileBuffer&) = delete;
+    AsyncFileBuffer& operator=(const AsyncFileBuffer&) = delete;
+
+    /**
+     * Open a file for writing
+     *
+     * @param filename the file name
+     * @param mode the access mode, which must include std::ios::out; the file
+     *        is appended to if it includes std::ios::app, and truncated otherwise
+     * @param bufferSize the size of a buffer, in bytes
+     * @param nBuffers the number of buffers in the ring
+     * @returns true if the file was opened
+     */
+    bool Open(const std::string& filename,
+              std::ios::openmode mode,
+              uint32_t bufferSize = BUFFER_SIZE_DEFAULT,
+              uint32_t nBuffers = BUFFERS_DEFAULT);
+
+    /// @returns true if a file is open
+    bool IsOpen() const;
+
+    /**
+     * Write the buffered data to the file, and wait until it is written
+     * @returns false if a write failed
+     */
+    bool Flush();
+
+    /**
+     * Write the buffered data and close the file
+     * @returns false if a write failed
+     */
+    bool Close();
+
+    /**
+     * @returns the number of times the writer waited for a buffer to be
+     *          written because the ring was full
+     */
+    uint64_t GetStalls() const;
+
+    /// Flush() all the open files
+    static void FlushAll();
+
+  protected:
+    int_type overflow(int_type ch) override;
+    /**
+     * Do nothing: the data is handed over to the I/O thread when a buffer is
+     * full, rather than at each std::endl
+     * @returns 0, or -1 if a write failed
+     */
+    int sync() override;
+    pos_type seekoff(off_type off, std::ios::seekdir dir, std::ios::openmode which) override;
+    pos_type seekpos(pos_type pos, std::ios::openmode which) override;
+
+  private:
+    class Service;
+
+    /// A buffer of the ring
+    struct Slot
+    {
+        std::unique_ptr<char[]> data; ///< the buffer, or nullptr if not yet used
+        std::size_t size;             ///< the number of bytes to write
+    };
+
+    /// Hand the current buffer over to the I/O thread, and start filling the next one
+    void Publish();
+    /// Start filling the next buffer, waiting for it to be written if needed
+    void Acquire();
+    /**
+     * Write the buffers handed over, from the I/O thread
+     * @returns true if buffers were written
+     */
+    bool WritePending();
+
+    std::FILE* m_file;            ///< the file, or nullptr if not open
+    uint32_t m_bufferSize;        ///< the size of a buffer
+    std::vector<Slot> m_slots;    ///< the ring of buffers
+    std::atomic<uint64_t> m_head; ///< number of buffers written by the I/O thread
+    std::atomic<uint64_t> m_tail; ///< number of buffers handed over to the I/O thread
+    std::atomic<bool> m_error;    ///< whether a write failed
+    uint64_t m_offset;            ///< number of bytes handed over to the I/O thread
+    uint64_t m_stalls;            ///< number of waits for a buffer to be written
+};
+
+} // namespace ns3
+
+#endif /* ASYNC_FILE_BUFFER_H */
@@ -6,6 +6,8 @@
 
 #include "output-stream-wrapper.h"
 
+#include "async-file-buffer.h"
+
 #include "ns3/abort.h"
 #include "ns3/fatal-impl.h"
 #include "ns3/log.h"
@@ -17,15 +19,28 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("OutputStreamWrapper");
 
-OutputStreamWrapper::OutputStreamWrapper(std::string filename, std::ios::openmode filemode)
+OutputStreamWrapper::OutputStreamWrapper(std::string filename,
+                                         std::ios::openmode filemode,
+                                         bool async)
     : m_destroyable(true)
 {
-    NS_LOG_FUNCTION(this << filename << filemode);
-    auto os = new std::ofstream();
-    os->open(filename, filemode);
-    m_ostream = os;
+    NS_LOG_FUNCTION(this << filename << filemode << async);
+    bool isOpen;
+    if (async)
+    {
+        m_asyncBuffer = std::make_unique<AsyncFileBuffer>();
+        isOpen = m_asyncBuffer->Open(filename, filemode);
+        m_ostream = new std::ostream(m_asyncBuffer.get());
+    }
+    else
+    {
+        auto os = new std::ofstream();
+        os->open(filename, filemode);
+        isOpen = os->is_open();
+        m_ostream = os;
+    }
     FatalImpl::RegisterStream(m_ostream);
-    NS_ABORT_MSG_UNLESS(os->is_open(),
+    NS_ABORT_MSG_UNLESS(isOpen,
                         "AsciiTraceHelper::CreateFileStream(): Unable to Open "
                             << filename << " for mode " << filemode);
 }
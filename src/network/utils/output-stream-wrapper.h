@@ -12,10 +12,13 @@
 #include "ns3/simple-ref-count.h"
 
 #include <fstream>
+#include <memory>
 
 namespace ns3
 {
 
+class AsyncFileBuffer;
+
 /**
  * @brief A class encapsulating an output stream.
  *
@@ -64,8 +67,10 @@ class OutputStreamWrapper : public SimpleRefCount<OutputStreamWrapper>
      * Constructor
      * @param filename file name
      * @param filemode std::ios::openmode flags
+     * @param async whether the file is written asynchronously, from a
+     *        background thread, by an AsyncFileBuffer
      */
-    OutputStreamWrapper(std::string filename, std::ios::openmode filemode);
+    OutputStreamWrapper(std::string filename, std::ios::openmode filemode, bool async = false);
     /**
      * Constructor
      * @param os output stream
@@ -83,8 +88,9 @@ class OutputStreamWrapper : public SimpleRefCount<OutputStreamWrapper>
     std::ostream* GetStream();
 
   private:
-    std::ostream* m_ostream; //!< The output stream
-    bool m_destroyable;      //!< Can be destroyed
+    std::ostream* m_ostream;                        //!< The output stream
+    bool m_destroyable;                             //!< Can be destroyed
+    std::unique_ptr<AsyncFileBuffer> m_asyncBuffer; //!< Stream buffer of an asynchronous file
 };
 
 } // namespace ns3
@@ -6,6 +6,8 @@
 
 #include "pcap-file-wrapper.h"
 
+#include "async-file-buffer.h"
+
 #include "ns3/boolean.h"
 #include "ns3/buffer.h"
 #include "ns3/header.h"
@@ -37,7 +39,25 @@ PcapFileWrapper::GetTypeId()
                           "microseconds(default).",
                           BooleanValue(false),
                           MakeBooleanAccessor(&PcapFileWrapper::m_nanosecMode),
-                          MakeBooleanChecker());
+                          MakeBooleanChecker())
+            .AddAttribute("AsyncWrite",
+                          "Whether the files opened for writing only are written asynchronously, "
+                          "from a background thread, rather than by the simulation.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&PcapFileWrapper::m_asyncWrite),
+                          MakeBooleanChecker())
+            .AddAttribute("AsyncBufferSize",
+                          "The size in bytes of the buffers of an asynchronously written file.",
+                          UintegerValue(AsyncFileBuffer::BUFFER_SIZE_DEFAULT),
+                          MakeUintegerAccessor(&PcapFileWrapper::m_asyncBufferSize),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("AsyncBuffers",
+                          "The number of buffers of an asynchronously written file; the "
+                          "simulation waits for the oldest one to be written when they are "
+                          "all full.",
+                          UintegerValue(AsyncFileBuffer::BUFFERS_DEFAULT),
+                          MakeUintegerAccessor(&PcapFileWrapper::m_asyncBuffers),
+                          MakeUintegerChecker<uint32_t>(1));
     return tid;
 }
 
@@ -84,7 +104,14 @@ void
 PcapFileWrapper::Open(const std::string& filename, std::ios::openmode mode)
 {
     NS_LOG_FUNCTION(this << filename << mode);
-    m_file.Open(filename, mode);
+    if (m_asyncWrite && (mode & std::ios::in) == 0)
+    {
+        m_file.OpenAsync(filename, m_asyncBufferSize, m_asyncBuffers);
+    }
+    else
+    {
+        m_file.Open(filename, mode);
+    }
 }
 
 void
@@ -60,6 +60,9 @@ class PcapFileWrapper : public Object
      * selected as a binary file (fstream::binary is automatically ored with the mode
      * field).
      *
+     * If the "AsyncWrite" attribute is true and the file is not opened for
+     * reading, it is written asynchronously (see PcapFile::OpenAsync()).
+     *
      * @param filename String containing the name of the file.
      *
      * @param mode String containing the access mode for the file.
@@ -211,9 +214,12 @@ class PcapFileWrapper : public Object
     uint32_t GetDataLinkType();
 
   private:
-    PcapFile m_file;    //!< Pcap file
-    uint32_t m_snapLen; //!< max length of saved packets
-    bool m_nanosecMode; //!< Timestamps in nanosecond mode
+    PcapFile m_file;            //!< Pcap file
+    uint32_t m_snapLen;         //!< max length of saved packets
+    bool m_nanosecMode;         //!< Timestamps in nanosecond mode
+    bool m_asyncWrite;          //!< Write the files asynchronously
+    uint32_t m_asyncBufferSize; //!< Size of the buffers of an asynchronous file
+    uint32_t m_asyncBuffers;    //!< Number of buffers of an asynchronous file
 };
 
 } // namespace ns3
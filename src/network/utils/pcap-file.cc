@@ -8,6 +8,8 @@
 
 #include "pcap-file.h"
 
+#include "async-file-buffer.h"
+
 #include "ns3/assert.h"
 #include "ns3/buffer.h"
 #include "ns3/build-profile.h"
@@ -81,6 +83,18 @@ void
 PcapFile::Close()
 {
     NS_LOG_FUNCTION(this);
+    if (m_asyncBuffer)
+    {
+        bool ok = m_asyncBuffer->Close();
+        // Give the stream its file buffer back, which also clears its state
+        m_file.std::ios::rdbuf(m_file.rdbuf());
+        m_asyncBuffer.reset();
+        if (!ok)
+        {
+            m_file.setstate(std::ios::failbit);
+        }
+        return;
+    }
     m_file.close();
 }
 
@@ -336,6 +350,25 @@ PcapFile::Open(const std::string& filename, std::ios::openmode mode)
     }
 }
 
+void
+PcapFile::OpenAsync(const std::string& filename, uint32_t bufferSize, uint32_t nBuffers)
+{
+    NS_LOG_FUNCTION(this << filename << bufferSize << nBuffers);
+    NS_ASSERT(!m_file.fail());
+    NS_ASSERT(!m_file.is_open() && !m_asyncBuffer);
+
+    m_filename = filename;
+    auto buffer = std::make_unique<AsyncFileBuffer>();
+    if (!buffer->Open(filename, std::ios::out | std::ios::binary, bufferSize, nBuffers))
+    {
+        m_file.setstate(std::ios::failbit);
+        return;
+    }
+    m_asyncBuffer = std::move(buffer);
+    // The stream writes into the asynchronous buffer instead of its file buffer
+    m_file.std::ios::rdbuf(m_asyncBuffer.get());
+}
+
 void
 PcapFile::Init(uint32_t dataLinkType,
                uint32_t snapLen,
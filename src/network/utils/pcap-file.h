@@ -12,12 +12,14 @@
 #include "ns3/ptr.h"
 
 #include <fstream>
+#include <memory>
 #include <stdint.h>
 #include <string>
 
 namespace ns3
 {
 
+class AsyncFileBuffer;
 class Packet;
 class Header;
 
@@ -70,6 +72,18 @@ class PcapFile
      */
     void Open(const std::string& filename, std::ios::openmode mode);
 
+    /**
+     * Create a new pcap file written asynchronously, from a background thread,
+     * by an AsyncFileBuffer.  The file is opened for writing only, and the
+     * packets written are copied into a ring of buffers written by the
+     * background thread.
+     *
+     * @param filename String containing the name of the file.
+     * @param bufferSize the size of a buffer of the ring, in bytes
+     * @param nBuffers the number of buffers of the ring, which bounds the memory used
+     */
+    void OpenAsync(const std::string& filename, uint32_t bufferSize, uint32_t nBuffers);
+
     /**
      * Close the underlying file.
      */
@@ -362,11 +376,12 @@ class PcapFile
      */
     void ReadAndVerifyFileHeader();
 
-    std::string m_filename;      //!< file name
-    std::fstream m_file;         //!< file stream
-    PcapFileHeader m_fileHeader; //!< file header
-    bool m_swapMode;             //!< swap mode
-    bool m_nanosecMode;          //!< nanosecond timestamp mode
+    std::string m_filename;                         //!< file name
+    std::fstream m_file;                            //!< file stream
+    std::unique_ptr<AsyncFileBuffer> m_asyncBuffer; //!< stream buffer of an asynchronous file
+    PcapFileHeader m_fileHeader;                    //!< file header
+    bool m_swapMode;                                //!< swap mode
+    bool m_nanosecMode;                             //!< nanosecond timestamp mode
 };
 
 } // namespace ns3
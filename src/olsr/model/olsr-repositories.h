@@ -11,11 +11,15 @@
 #ifndef OLSR_REPOSITORIES_H
 #define OLSR_REPOSITORIES_H
 
+#include "ns3/expiring-set.h"
 #include "ns3/ipv4-address.h"
 #include "ns3/nstime.h"
 
+#include <algorithm>
+#include <array>
 #include <iostream>
 #include <set>
+#include <unordered_map>
 #include <vector>
 
 namespace ns3
@@ -314,13 +318,266 @@ operator<<(std::ostream& os, const AssociationTuple& tuple)
     return os;
 }
 
+/**
+ * @ingroup olsr
+ *
+ * A set of tuples indexed by one or more of their addresses.
+ *
+ * The tuples are stored in a vector, which can be accessed as such. Each index
+ * maps an address to the positions of the tuples with that address in the
+ * vector, so that finding the tuples with a given address does not require
+ * scanning the whole set. An erased tuple is only marked as such and removed
+ * from the indexes, so that erasing does not move the other tuples. The erased
+ * tuples are removed from the vector, keeping the order of the other tuples,
+ * when the vector is accessed or when they are more numerous than the others.
+ *
+ * The positions returned by Find() are valid until the next call to Insert(),
+ * Get() or GetMutable(). The addresses used by the indexes must not be modified
+ * through the pointers or references to the tuples, except through the vector
+ * returned by GetMutable(), after which the indexes are rebuilt.
+ *
+ * @tparam Tuple the type of the tuples
+ * @tparam N the number of indexes
+ */
+template <typename Tuple, std::size_t N>
+class IndexedTupleSet
+{
+  public:
+    /// Function returning the address of a tuple used by an index
+    typedef Ipv4Address (*KeyFunction)(const Tuple&);
+    /// Positions of the tuples with a given address
+    typedef std::vector<std::size_t> Positions;
+
+    /**
+     * Constructor.
+     * @param keys the functions returning the address used by each index
+     */
+    IndexedTupleSet(const std::array<KeyFunction, N>& keys)
+        : m_keys(keys),
+          m_erased(0),
+          m_valid(true)
+    {
+    }
+
+    /**
+     * @returns the tuples
+     */
+    const std::vector<Tuple>& Get() const
+    {
+        Compact();
+        return m_tuples;
+    }
+
+    /**
+     * Get the tuples, which may be modified. The indexes are rebuilt before the next lookup.
+     * @returns the tuples
+     */
+    std::vector<Tuple>& GetMutable()
+    {
+        Compact();
+        m_valid = false;
+        return m_tuples;
+    }
+
+    /**
+     * @param index the index
+     * @param addr the address
+     * @returns the positions of the tuples with the given address in the given index
+     */
+    const Positions& Find(std::size_t index, const Ipv4Address& addr) const
+    {
+        static const Positions none;
+        Validate();
+        auto it = m_indexes[index].find(addr);
+        return it == m_indexes[index].end() ? none : it->second;
+    }
+
+    /**
+     * @param pos the position of a tuple
+     * @returns the tuple
+     */
+    Tuple& At(std::size_t pos)
+    {
+        return m_tuples[pos];
+    }
+
+    /**
+     * @param pos the position of a tuple
+     * @returns the tuple
+     */
+    const Tuple& At(std::size_t pos) const
+    {
+        return m_tuples[pos];
+    }
+
+    /**
+     * Insert a tuple at the end of the vector.
+     * @param tuple the tuple
+     * @returns the inserted tuple
+     */
+    Tuple& Insert(const Tuple& tuple)
+    {
+        if (m_erased > 16 && m_erased > m_tuples.size() / 2)
+        {
+            Compact();
+        }
+        Validate();
+        m_tuples.push_back(tuple);
+        m_erasedFlags.push_back(false);
+        for (std::size_t i = 0; i < N; i++)
+        {
+            m_indexes[i][m_keys[i](tuple)].push_back(m_tuples.size() - 1);
+        }
+        return m_tuples.back();
+    }
+
+    /**
+     * Erase a tuple. The other tuples keep their position and their order.
+     * @param pos the position of the tuple
+     */
+    void Erase(std::size_t pos)
+    {
+        Validate();
+        for (std::size_t i = 0; i < N; i++)
+        {
+            RemoveFromIndex(i, pos);
+        }
+        MarkErased(pos);
+    }
+
+    /**
+     * Erase the tuples with a given address that satisfy a predicate.
+     * @param index the index
+     * @param addr the address
+     * @param pred the predicate
+     */
+    template <typename Predicate>
+    void EraseIf(std::size_t index, const Ipv4Address& addr, Predicate pred)
+    {
+        Validate();
+        auto it = m_indexes[index].find(addr);
+        if (it == m_indexes[index].end())
+        {
+            return;
+        }
+        // the positions with the given address are filtered in a single pass
+        Positions kept;
+        for (auto pos : it->second)
+        {
+            if (!pred(m_tuples[pos]))
+            {
+                kept.push_back(pos);
+                continue;
+            }
+            for (std::size_t i = 0; i < N; i++)
+            {
+                if (i != index)
+                {
+                    RemoveFromIndex(i, pos);
+                }
+            }
+            MarkErased(pos);
+        }
+        if (kept.empty())
+        {
+            m_indexes[index].erase(it);
+        }
+        else
+        {
+            it->second = std::move(kept);
+        }
+    }
+
+  private:
+    /**
+     * Remove a position from an index.
+     * @param index the index
+     * @param pos the position of the tuple
+     */
+    void RemoveFromIndex(std::size_t index, std::size_t pos)
+    {
+        auto it = m_indexes[index].find(m_keys[index](m_tuples[pos]));
+        std::erase(it->second, pos);
+        if (it->second.empty())
+        {
+            m_indexes[index].erase(it);
+        }
+    }
+
+    /**
+     * Mark a tuple as erased.
+     * @param pos the position of the tuple
+     */
+    void MarkErased(std::size_t pos)
+    {
+        m_erasedFlags[pos] = true;
+        m_erased++;
+    }
+
+    /// Remove the erased tuples from the vector, keeping the order of the other tuples
+    void Compact() const
+    {
+        if (m_erased == 0)
+        {
+            return;
+        }
+        std::size_t kept = 0;
+        for (std::size_t pos = 0; pos < m_tuples.size(); pos++)
+        {
+            if (!m_erasedFlags[pos])
+            {
+                if (kept != pos)
+                {
+                    m_tuples[kept] = std::move(m_tuples[pos]);
+                }
+                kept++;
+            }
+        }
+        m_tuples.erase(m_tuples.begin() + kept, m_tuples.end());
+        m_erasedFlags.assign(kept, false);
+        m_erased = 0;
+        m_valid = false;
+    }
+
+    /// Rebuild the indexes if the tuples were moved or modified through GetMutable()
+    void Validate() const
+    {
+        if (m_valid)
+        {
+            return;
+        }
+        // the vector returned by GetMutable() has no erased tuple but may have been resized
+        m_erasedFlags.resize(m_tuples.size(), false);
+        for (std::size_t i = 0; i < N; i++)
+        {
+            m_indexes[i].clear();
+            for (std::size_t pos = 0; pos < m_tuples.size(); pos++)
+            {
+                if (!m_erasedFlags[pos])
+                {
+                    m_indexes[i][m_keys[i](m_tuples[pos])].push_back(pos);
+                }
+            }
+        }
+        m_valid = true;
+    }
+
+    std::array<KeyFunction, N> m_keys;       //!< the address used by each index
+    mutable std::vector<Tuple> m_tuples;     //!< the tuples, including the erased ones
+    mutable std::vector<bool> m_erasedFlags; //!< whether each tuple is erased
+    mutable std::size_t m_erased;            //!< the number of erased tuples
+    /// the indexes
+    mutable std::array<std::unordered_map<Ipv4Address, Positions, Ipv4AddressHash>, N> m_indexes;
+    mutable bool m_valid; //!< whether the indexes are up to date
+};
+
 typedef std::set<Ipv4Address> MprSet;                       //!< MPR Set type.
 typedef std::vector<MprSelectorTuple> MprSelectorSet;       //!< MPR Selector Set type.
 typedef std::vector<LinkTuple> LinkSet;                     //!< Link Set type.
 typedef std::vector<NeighborTuple> NeighborSet;             //!< Neighbor Set type.
 typedef std::vector<TwoHopNeighborTuple> TwoHopNeighborSet; //!< 2-hop Neighbor Set type.
 typedef std::vector<TopologyTuple> TopologySet;             //!< Topology Set type.
-typedef std::vector<DuplicateTuple> DuplicateSet;           //!< Duplicate Set type.
+typedef ExpiringSet<uint64_t, DuplicateTuple> DuplicateSet; //!< Duplicate Set type.
 typedef std::vector<IfaceAssocTuple> IfaceAssocSet;         //!< Interface Association Set type.
 typedef std::vector<AssociationTuple> AssociationSet;       //!< Association Set type.
 typedef std::vector<Association> Associations;              //!< Association Set type.
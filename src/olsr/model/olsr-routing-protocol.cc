@@ -41,8 +41,12 @@
 #include "ns3/udp-socket-factory.h"
 #include "ns3/uinteger.h"
 
+#include <functional>
 #include <iomanip>
 #include <iostream>
+#include <queue>
+#include <tuple>
+#include <utility>
 
 /********** Useful macros **********/
 
@@ -220,6 +224,13 @@ RoutingProtocol::GetTypeId()
                                           "high",
                                           Willingness::ALWAYS,
                                           "always"))
+            .AddAttribute("IncrementalRouting",
+                          "Whether the routing table is incrementally repaired, once per "
+                          "simulation instant, when the OLSR state changes. If false, the whole "
+                          "routing table is recomputed after each change.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&RoutingProtocol::m_incrementalRouting),
+                          MakeBooleanChecker())
             .AddTraceSource("Rx",
                             "Receive OLSR packet.",
                             MakeTraceSourceAccessor(&RoutingProtocol::m_rxPacketTrace),
@@ -238,6 +249,7 @@ RoutingProtocol::GetTypeId()
 RoutingProtocol::RoutingProtocol()
     : m_routingTableAssociation(nullptr),
       m_ipv4(nullptr),
+      m_routingTableValid(false),
       m_helloTimer(Timer::CANCEL_ON_DESTROY),
       m_tcTimer(Timer::CANCEL_ON_DESTROY),
       m_midTimer(Timer::CANCEL_ON_DESTROY),
@@ -295,6 +307,7 @@ RoutingProtocol::DoDispose()
     }
     m_sendSockets.clear();
     m_table.clear();
+    m_routingTableComputationEvent.Cancel();
 
     Ipv4RoutingProtocol::DoDispose();
 }
@@ -628,7 +641,7 @@ RoutingProtocol::RecvOlsr(Ptr<Socket> socket)
     }
 
     // After processing all OLSR messages, we must recompute the routing table
-    RoutingTableComputation();
+    ScheduleRoutingTableComputation();
 }
 
 ///
@@ -642,7 +655,8 @@ int
 RoutingProtocol::Degree(const NeighborTuple& tuple)
 {
     int degree = 0;
-    for (auto it = m_state.GetTwoHopNeighbors().begin(); it != m_state.GetTwoHopNeighbors().end();
+    for (auto it = std::as_const(m_state).GetTwoHopNeighbors().begin();
+         it != std::as_const(m_state).GetTwoHopNeighbors().end();
          it++)
     {
         const TwoHopNeighborTuple& nb2hop_tuple = *it;
@@ -707,7 +721,8 @@ RoutingProtocol::MprComputation()
     // N is the subset of neighbors of the node, which are
     // neighbor "of the interface I"
     NeighborSet N;
-    for (auto neighbor = m_state.GetNeighbors().begin(); neighbor != m_state.GetNeighbors().end();
+    for (auto neighbor = std::as_const(m_state).GetNeighbors().begin();
+         neighbor != std::as_const(m_state).GetNeighbors().end();
          neighbor++)
     {
         if (neighbor->status == NeighborTuple::STATUS_SYM) // I think that we need this check
@@ -723,8 +738,8 @@ RoutingProtocol::MprComputation()
     // (iii) all the symmetric neighbors: the nodes for which there exists a symmetric
     //       link to this node on some interface.
     TwoHopNeighborSet N2;
-    for (auto twoHopNeigh = m_state.GetTwoHopNeighbors().begin();
-         twoHopNeigh != m_state.GetTwoHopNeighbors().end();
+    for (auto twoHopNeigh = std::as_const(m_state).GetTwoHopNeighbors().begin();
+         twoHopNeigh != std::as_const(m_state).GetTwoHopNeighbors().end();
          twoHopNeigh++)
     {
         // excluding:
@@ -999,10 +1014,32 @@ RoutingProtocol::RoutingTableComputation()
 
     // 1. All the entries from the routing table are removed.
     Clear();
+    m_topologyParents.clear();
+    m_topologyChildren.clear();
+    m_ifaceAssocRoutes.clear();
+    m_changedTopologyOrigins.clear();
 
+    ComputeNeighborRoutes();
+    // the state needed by the incremental computation is only kept when it is enabled
+    if (m_incrementalRouting)
+    {
+        m_neighborRoutes = m_table;
+    }
+    ComputeTopologyRoutes();
+    ComputeIfaceAssocRoutes();
+    ComputeHnaRoutes();
+    m_routingTableValid = m_incrementalRouting;
+
+    NS_LOG_DEBUG("Node " << m_mainAddress << ": RoutingTableComputation end.");
+    m_routingTableChanged(GetSize());
+}
+
+void
+RoutingProtocol::ComputeNeighborRoutes()
+{
     // 2. The new routing entries are added starting with the
     // symmetric neighbors (h=1) as the destination nodes.
-    const NeighborSet& neighborSet = m_state.GetNeighbors();
+    const NeighborSet& neighborSet = std::as_const(m_state).GetNeighbors();
     for (auto it = neighborSet.begin(); it != neighborSet.end(); it++)
     {
         const NeighborTuple& nb_tuple = *it;
@@ -1067,7 +1104,7 @@ RoutingProtocol::RoutingTableComputation()
     //  least one entry in the 2-hop neighbor set where
     //  N_neighbor_main_addr correspond to a neighbor node with
     //  willingness different of Willingness::NEVER,
-    const TwoHopNeighborSet& twoHopNeighbors = m_state.GetTwoHopNeighbors();
+    const TwoHopNeighborSet& twoHopNeighbors = std::as_const(m_state).GetTwoHopNeighbors();
     for (auto it = twoHopNeighbors.begin(); it != twoHopNeighbors.end(); it++)
     {
         const TwoHopNeighborTuple& nb2hop_tuple = *it;
@@ -1133,7 +1170,11 @@ RoutingProtocol::RoutingTableComputation()
                          << nb2hop_tuple.twoHopNeighborAddr << " not found in the routing table)");
         }
     }
+}
 
+void
+RoutingProtocol::ComputeTopologyRoutes()
+{
     for (uint32_t h = 2;; h++)
     {
         bool added = false;
@@ -1171,6 +1212,10 @@ RoutingProtocol::RoutingTableComputation()
                          lastAddrEntry.nextAddr,
                          lastAddrEntry.interface,
                          h + 1);
+                if (m_incrementalRouting)
+                {
+                    SetTopologyParent(topology_tuple.destAddr, topology_tuple.lastAddr);
+                }
                 added = true;
             }
             else
@@ -1188,7 +1233,11 @@ RoutingProtocol::RoutingTableComputation()
             break;
         }
     }
+}
 
+void
+RoutingProtocol::ComputeIfaceAssocRoutes()
+{
     // 4. For each entry in the multiple interface association base
     // where there exists a routing entry such that:
     // R_dest_addr == I_main_addr (of the multiple interface association entry)
@@ -1211,9 +1260,17 @@ RoutingProtocol::RoutingTableComputation()
             //       R_dist       =  R_dist       (of the recorded route entry)
             //       R_iface_addr =  R_iface_addr (of the recorded route entry).
             AddEntry(tuple.ifaceAddr, entry1.nextAddr, entry1.interface, entry1.distance);
+            if (m_incrementalRouting)
+            {
+                m_ifaceAssocRoutes.push_back(tuple.ifaceAddr);
+            }
         }
     }
+}
 
+void
+RoutingProtocol::ComputeHnaRoutes()
+{
     // 5. For each tuple in the association set,
     //    If there is no entry in the routing table with:
     //        R_dest_addr     == A_network_addr/A_netmask
@@ -1293,11 +1350,222 @@ RoutingProtocol::RoutingTableComputation()
                                                  gatewayEntry.distance);
         }
     }
+}
 
-    NS_LOG_DEBUG("Node " << m_mainAddress << ": RoutingTableComputation end.");
+void
+RoutingProtocol::ScheduleRoutingTableComputation()
+{
+    if (!m_incrementalRouting)
+    {
+        RoutingTableComputation();
+        return;
+    }
+    if (!m_routingTableComputationEvent.IsPending())
+    {
+        m_routingTableComputationEvent =
+            Simulator::ScheduleNow(&RoutingProtocol::IncrementalRoutingTableComputation, this);
+    }
+}
+
+void
+RoutingProtocol::IncrementalRoutingTableComputation()
+{
+    if (!m_routingTableValid)
+    {
+        RoutingTableComputation();
+        return;
+    }
+
+    NS_LOG_DEBUG(Simulator::Now().As(Time::S)
+                 << " : Node " << m_mainAddress
+                 << ": IncrementalRoutingTableComputation begin...");
+
+    // The routes to the interface addresses are recomputed at the end
+    for (const auto& ifaceAddr : m_ifaceAssocRoutes)
+    {
+        m_table.erase(ifaceAddr);
+    }
+    m_ifaceAssocRoutes.clear();
+
+    // Recompute the routes to the neighbors and 2-hop neighbors in an empty table
+    std::map<Ipv4Address, RoutingTableEntry> neighborRoutes;
+    m_table.swap(neighborRoutes);
+    ComputeNeighborRoutes();
+    m_table.swap(neighborRoutes);
+
+    // Destinations whose route may have changed: the routes computed from the
+    // topology set that go through them must be recomputed
+    std::set<Ipv4Address> roots;
+    for (const auto& [dest, entry] : m_neighborRoutes)
+    {
+        if (neighborRoutes.find(dest) == neighborRoutes.end())
+        {
+            m_table.erase(dest);
+            roots.insert(dest);
+        }
+    }
+    for (const auto& [dest, entry] : neighborRoutes)
+    {
+        auto it = m_neighborRoutes.find(dest);
+        if (it == m_neighborRoutes.end() || it->second.nextAddr != entry.nextAddr ||
+            it->second.interface != entry.interface || it->second.distance != entry.distance)
+        {
+            RemoveTopologyParent(dest);
+            m_table[dest] = entry;
+            roots.insert(dest);
+        }
+    }
+    m_neighborRoutes.swap(neighborRoutes);
+
+    for (const auto& origin : m_changedTopologyOrigins)
+    {
+        auto children = m_topologyChildren.find(origin);
+        if (children == m_topologyChildren.end())
+        {
+            continue;
+        }
+        for (const auto& child : children->second)
+        {
+            if (m_state.FindTopologyTuple(child, origin) == nullptr)
+            {
+                roots.insert(child);
+            }
+        }
+    }
+
+    // All the routes in the subtrees of the shortest-path tree rooted at the
+    // destinations above are affected
+    std::set<Ipv4Address> affected;
+    std::vector<Ipv4Address> stack(roots.begin(), roots.end());
+    while (!stack.empty())
+    {
+        Ipv4Address dest = stack.back();
+        stack.pop_back();
+        if (!affected.insert(dest).second)
+        {
+            continue;
+        }
+        auto children = m_topologyChildren.find(dest);
+        if (children != m_topologyChildren.end())
+        {
+            stack.insert(stack.end(), children->second.begin(), children->second.end());
+        }
+    }
+
+    if (2 * affected.size() > m_table.size())
+    {
+        NS_LOG_DEBUG("Most routes are affected, recomputing the whole routing table.");
+        RoutingTableComputation();
+        return;
+    }
+
+    NS_LOG_LOGIC(roots.size() << " changed routes, " << affected.size() << " affected routes");
+
+    for (const auto& dest : affected)
+    {
+        if (m_neighborRoutes.find(dest) == m_neighborRoutes.end())
+        {
+            m_table.erase(dest);
+        }
+        RemoveTopologyParent(dest);
+    }
+
+    // Candidate routes (distance, destination, last hop), processed by increasing distance
+    using Candidate = std::tuple<uint32_t, Ipv4Address, Ipv4Address>;
+    std::priority_queue<Candidate, std::vector<Candidate>, std::greater<>> candidates;
+
+    auto relax = [this, &candidates](const Ipv4Address& lastAddr) {
+        auto last = m_table.find(lastAddr);
+        // as in RoutingTableComputation, only the routes of 2 hops or more are extended
+        if (last == m_table.end() || last->second.distance < 2)
+        {
+            return;
+        }
+        for (const auto* tuple : m_state.FindTopologyTuplesByLastAddr(lastAddr))
+        {
+            if (m_neighborRoutes.find(tuple->destAddr) == m_neighborRoutes.end())
+            {
+                candidates.emplace(last->second.distance + 1, tuple->destAddr, lastAddr);
+            }
+        }
+    };
+
+    for (const auto& dest : affected)
+    {
+        if (m_neighborRoutes.find(dest) != m_neighborRoutes.end())
+        {
+            relax(dest);
+            continue;
+        }
+        for (const auto* tuple : m_state.FindTopologyTuplesByDestAddr(dest))
+        {
+            auto last = m_table.find(tuple->lastAddr);
+            if (last != m_table.end() && last->second.distance >= 2)
+            {
+                candidates.emplace(last->second.distance + 1, dest, tuple->lastAddr);
+            }
+        }
+    }
+    for (const auto& origin : m_changedTopologyOrigins)
+    {
+        relax(origin);
+    }
+    m_changedTopologyOrigins.clear();
+
+    while (!candidates.empty())
+    {
+        auto [distance, dest, lastAddr] = candidates.top();
+        candidates.pop();
+
+        auto last = m_table.find(lastAddr);
+        if (last == m_table.end() || last->second.distance + 1 != distance)
+        {
+            // the route to the last hop has changed since the candidate was queued
+            continue;
+        }
+        auto it = m_table.find(dest);
+        if (it != m_table.end() && it->second.distance <= distance)
+        {
+            continue;
+        }
+        NS_LOG_LOGIC("Route to " << dest << " via " << lastAddr << ", distance " << distance);
+        AddEntry(dest, last->second.nextAddr, last->second.interface, distance);
+        SetTopologyParent(dest, lastAddr);
+        relax(dest);
+    }
+
+    ComputeIfaceAssocRoutes();
+    ComputeHnaRoutes();
+
+    NS_LOG_DEBUG("Node " << m_mainAddress << ": IncrementalRoutingTableComputation end.");
     m_routingTableChanged(GetSize());
 }
 
+void
+RoutingProtocol::SetTopologyParent(const Ipv4Address& dest, const Ipv4Address& lastAddr)
+{
+    RemoveTopologyParent(dest);
+    m_topologyParents[dest] = lastAddr;
+    m_topologyChildren[lastAddr].insert(dest);
+}
+
+void
+RoutingProtocol::RemoveTopologyParent(const Ipv4Address& dest)
+{
+    auto it = m_topologyParents.find(dest);
+    if (it == m_topologyParents.end())
+    {
+        return;
+    }
+    auto children = m_topologyChildren.find(it->second);
+    children->second.erase(dest);
+    if (children->second.empty())
+    {
+        m_topologyChildren.erase(children);
+    }
+    m_topologyParents.erase(it);
+}
+
 void
 RoutingProtocol::ProcessHello(const olsr::MessageHeader& msg,
                               const Ipv4Address& receiverIface,
@@ -1320,7 +1588,7 @@ RoutingProtocol::ProcessHello(const olsr::MessageHeader& msg,
         }
         NS_LOG_DEBUG("** END dump Link Set for OLSR Node " << m_mainAddress);
 
-        const NeighborSet& neighbors = m_state.GetNeighbors();
+        const NeighborSet& neighbors = std::as_const(m_state).GetNeighbors();
         NS_LOG_DEBUG(Simulator::Now().As(Time::S)
                      << " ** BEGIN dump Neighbor Set for OLSR Node " << m_mainAddress);
         for (auto neighbor = neighbors.begin(); neighbor != neighbors.end(); neighbor++)
@@ -1336,7 +1604,7 @@ RoutingProtocol::ProcessHello(const olsr::MessageHeader& msg,
 
 #ifdef NS3_LOG_ENABLE
     {
-        const TwoHopNeighborSet& twoHopNeighbors = m_state.GetTwoHopNeighbors();
+        const TwoHopNeighborSet& twoHopNeighbors = std::as_const(m_state).GetTwoHopNeighbors();
         NS_LOG_DEBUG(Simulator::Now().As(Time::S)
                      << " ** BEGIN dump TwoHopNeighbor Set for OLSR Node " << m_mainAddress);
         for (auto tuple = twoHopNeighbors.begin(); tuple != twoHopNeighbors.end(); tuple++)
@@ -1382,6 +1650,10 @@ RoutingProtocol::ProcessTc(const olsr::MessageHeader& msg, const Ipv4Address& se
     //    T_seq       <  ANSN
     // MUST be removed from the topology set.
     m_state.EraseOlderTopologyTuples(msg.GetOriginatorAddress(), tc.ansn);
+    if (m_incrementalRouting)
+    {
+        m_changedTopologyOrigins.insert(msg.GetOriginatorAddress());
+    }
 
     // 4. For each of the advertised neighbor main address received in
     // the TC message:
@@ -1459,17 +1731,9 @@ RoutingProtocol::ProcessMid(const olsr::MessageHeader& msg, const Ipv4Address& s
     // 2. For each interface address listed in the MID message
     for (auto i = mid.interfaceAddresses.begin(); i != mid.interfaceAddresses.end(); i++)
     {
-        bool updated = false;
-        IfaceAssocSet& ifaceAssoc = m_state.GetIfaceAssocSetMutable();
-        for (auto tuple = ifaceAssoc.begin(); tuple != ifaceAssoc.end(); tuple++)
-        {
-            if (tuple->ifaceAddr == *i && tuple->mainAddr == msg.GetOriginatorAddress())
-            {
-                NS_LOG_LOGIC("IfaceAssoc updated: " << *tuple);
-                tuple->time = now + msg.GetVTime();
-                updated = true;
-            }
-        }
+        bool updated = m_state.UpdateIfaceAssocTuples(*i,
+                                                      msg.GetOriginatorAddress(),
+                                                      now + msg.GetVTime());
         if (!updated)
         {
             IfaceAssocTuple tuple;
@@ -1489,18 +1753,38 @@ RoutingProtocol::ProcessMid(const olsr::MessageHeader& msg, const Ipv4Address& s
     // 3. (not part of the RFC) iterate over all NeighborTuple's and
     // TwoHopNeighborTuples, update the neighbor addresses taking into account
     // the new MID information.
-    NeighborSet& neighbors = m_state.GetNeighbors();
-    for (auto neighbor = neighbors.begin(); neighbor != neighbors.end(); neighbor++)
+    // Only the tuples whose addresses change are erased and inserted again, so
+    // that the indexes of the sets are kept.
+    NeighborSet changedNeighbors;
+    for (const auto& neighbor : std::as_const(m_state).GetNeighbors())
+    {
+        if (GetMainAddress(neighbor.neighborMainAddr) != neighbor.neighborMainAddr)
+        {
+            changedNeighbors.push_back(neighbor);
+        }
+    }
+    for (auto& neighbor : changedNeighbors)
     {
-        neighbor->neighborMainAddr = GetMainAddress(neighbor->neighborMainAddr);
+        m_state.EraseNeighborTuple(neighbor.neighborMainAddr);
+        neighbor.neighborMainAddr = GetMainAddress(neighbor.neighborMainAddr);
+        m_state.InsertNeighborTuple(neighbor);
     }
 
-    TwoHopNeighborSet& twoHopNeighbors = m_state.GetTwoHopNeighbors();
-    for (auto twoHopNeighbor = twoHopNeighbors.begin(); twoHopNeighbor != twoHopNeighbors.end();
-         twoHopNeighbor++)
+    TwoHopNeighborSet changedTwoHopNeighbors;
+    for (const auto& twoHopNeighbor : std::as_const(m_state).GetTwoHopNeighbors())
     {
-        twoHopNeighbor->neighborMainAddr = GetMainAddress(twoHopNeighbor->neighborMainAddr);
-        twoHopNeighbor->twoHopNeighborAddr = GetMainAddress(twoHopNeighbor->twoHopNeighborAddr);
+        if (GetMainAddress(twoHopNeighbor.neighborMainAddr) != twoHopNeighbor.neighborMainAddr ||
+            GetMainAddress(twoHopNeighbor.twoHopNeighborAddr) != twoHopNeighbor.twoHopNeighborAddr)
+        {
+            changedTwoHopNeighbors.push_back(twoHopNeighbor);
+        }
+    }
+    for (auto& twoHopNeighbor : changedTwoHopNeighbors)
+    {
+        m_state.EraseTwoHopNeighborTuple(twoHopNeighbor);
+        twoHopNeighbor.neighborMainAddr = GetMainAddress(twoHopNeighbor.neighborMainAddr);
+        twoHopNeighbor.twoHopNeighborAddr = GetMainAddress(twoHopNeighbor.twoHopNeighborAddr);
+        m_state.InsertTwoHopNeighborTuple(twoHopNeighbor);
     }
     NS_LOG_DEBUG("Node " << m_mainAddress << " ProcessMid from " << senderIface << " -> END.");
 }
@@ -1615,6 +1899,8 @@ RoutingProtocol::ForwardDefault(olsr::MessageHeader olsrMessage,
         duplicated->expirationTime = now + OLSR_DUP_HOLD_TIME;
         duplicated->retransmitted = retransmitted;
         duplicated->ifaceList.push_back(localIface);
+        // Refresh the expiration time in the Duplicate Set
+        AddDuplicateTuple(*duplicated);
     }
     // ...or create a new one
     else
@@ -1625,13 +1911,8 @@ RoutingProtocol::ForwardDefault(olsr::MessageHeader olsrMessage,
         newDup.expirationTime = now + OLSR_DUP_HOLD_TIME;
         newDup.retransmitted = retransmitted;
         newDup.ifaceList.push_back(localIface);
+        // The Duplicate Set removes the tuple when it expires
         AddDuplicateTuple(newDup);
-        // Schedule dup tuple deletion
-        Simulator::Schedule(OLSR_DUP_HOLD_TIME,
-                            &RoutingProtocol::DupTupleTimerExpire,
-                            this,
-                            newDup.address,
-                            newDup.sequenceNumber);
     }
 }
 
@@ -1758,8 +2039,8 @@ RoutingProtocol::SendHello()
         else
         {
             bool ok = false;
-            for (auto nb_tuple = m_state.GetNeighbors().begin();
-                 nb_tuple != m_state.GetNeighbors().end();
+            for (auto nb_tuple = std::as_const(m_state).GetNeighbors().begin();
+                 nb_tuple != std::as_const(m_state).GetNeighbors().end();
                  nb_tuple++)
             {
                 if (nb_tuple->neighborMainAddr == GetMainAddress(link_tuple->neighborIfaceAddr))
@@ -2325,7 +2606,7 @@ RoutingProtocol::NeighborLoss(const LinkTuple& tuple)
     m_state.EraseMprSelectorTuples(GetMainAddress(tuple.neighborIfaceAddr));
 
     MprComputation();
-    RoutingTableComputation();
+    ScheduleRoutingTableComputation();
 }
 
 void
@@ -2524,6 +2805,10 @@ RoutingProtocol::AddTopologyTuple(const TopologyTuple& tuple)
     //         tuple->seq());
 
     m_state.InsertTopologyTuple(tuple);
+    if (m_incrementalRouting)
+    {
+        m_changedTopologyOrigins.insert(tuple.lastAddr);
+    }
 }
 
 void
@@ -2536,7 +2821,12 @@ RoutingProtocol::RemoveTopologyTuple(const TopologyTuple& tuple)
     //         OLSR::node_id(tuple->last_addr()),
     //         tuple->seq());
 
+    Ipv4Address lastAddr = tuple.lastAddr;
     m_state.EraseTopologyTuple(tuple);
+    if (m_incrementalRouting)
+    {
+        m_changedTopologyOrigins.insert(lastAddr);
+    }
 }
 
 void
@@ -2631,28 +2921,6 @@ RoutingProtocol::HnaTimerExpire()
     m_hnaTimer.Schedule(m_hnaInterval);
 }
 
-void
-RoutingProtocol::DupTupleTimerExpire(Ipv4Address address, uint16_t sequenceNumber)
-{
-    DuplicateTuple* tuple = m_state.FindDuplicateTuple(address, sequenceNumber);
-    if (tuple == nullptr)
-    {
-        return;
-    }
-    if (tuple->expirationTime < Simulator::Now())
-    {
-        RemoveDuplicateTuple(*tuple);
-    }
-    else
-    {
-        m_events.Track(Simulator::Schedule(DELAY(tuple->expirationTime),
-                                           &RoutingProtocol::DupTupleTimerExpire,
-                                           this,
-                                           address,
-                                           sequenceNumber));
-    }
-}
-
 void
 RoutingProtocol::LinkTupleTimerExpire(Ipv4Address neighborIfaceAddr)
 {
@@ -3192,13 +3460,15 @@ RoutingProtocol::Dump()
     Time now = Simulator::Now();
     NS_LOG_DEBUG("Dumping for node with main address " << m_mainAddress);
     NS_LOG_DEBUG(" Neighbor set");
-    for (auto iter = m_state.GetNeighbors().begin(); iter != m_state.GetNeighbors().end(); iter++)
+    for (auto iter = std::as_const(m_state).GetNeighbors().begin();
+         iter != std::as_const(m_state).GetNeighbors().end();
+         iter++)
     {
         NS_LOG_DEBUG("  " << *iter);
     }
     NS_LOG_DEBUG(" Two-hop neighbor set");
-    for (auto iter = m_state.GetTwoHopNeighbors().begin();
-         iter != m_state.GetTwoHopNeighbors().end();
+    for (auto iter = std::as_const(m_state).GetTwoHopNeighbors().begin();
+         iter != std::as_const(m_state).GetTwoHopNeighbors().end();
          iter++)
     {
         if (now < iter->expirationTime)
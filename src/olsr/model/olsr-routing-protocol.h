@@ -29,10 +29,13 @@
 #include "ns3/traced-callback.h"
 
 #include <map>
+#include <set>
 #include <vector>
 
 /// Testcase for MPR computation mechanism
 class OlsrMprTestCase;
+/// Testcase for incremental routing table computation
+class OlsrIncrementalRoutingTestCase;
 
 namespace ns3
 {
@@ -77,6 +80,10 @@ class RoutingProtocol : public Ipv4RoutingProtocol
      * Declared friend to enable unit tests.
      */
     friend class ::OlsrMprTestCase;
+    /**
+     * Declared friend to enable unit tests.
+     */
+    friend class ::OlsrIncrementalRoutingTestCase;
 
     static const uint16_t OLSR_PORT_NUMBER; //!< port number (698)
 
@@ -389,6 +396,84 @@ class RoutingProtocol : public Ipv4RoutingProtocol
      */
     void RoutingTableComputation();
 
+    /**
+     * @brief Updates the routing table after the OLSR state has changed.
+     *
+     * If incremental computation is enabled, the update is deferred to the end
+     * of the current simulation instant, so that all the changes made in the
+     * same instant are handled by a single update. Otherwise, the routing table
+     * is immediately recomputed from scratch.
+     */
+    void ScheduleRoutingTableComputation();
+
+    /**
+     * @brief Repairs the routing table after the OLSR state has changed.
+     *
+     * The routes to the neighbors and 2-hop neighbors are recomputed, since
+     * they only depend on the (small) local neighborhood. The routes computed
+     * from the topology set form a shortest-path tree rooted at the 2-hop
+     * neighbors; only the subtrees whose root route changed, or whose
+     * topology tuple was removed, are recomputed, and the new topology
+     * tuples are relaxed, as in a dynamic single-source shortest-path
+     * algorithm.
+     *
+     * Among the paths of equal length, the last hop chosen may differ from
+     * the one chosen by RoutingTableComputation(), but the distances are the same.
+     */
+    void IncrementalRoutingTableComputation();
+
+    /**
+     * @brief Adds the routes to the symmetric neighbors and to the 2-hop
+     * neighbors (steps 2 and 3 of the routing table computation).
+     */
+    void ComputeNeighborRoutes();
+
+    /**
+     * @brief Adds the routes computed from the topology set (step 3.1 of the
+     * routing table computation), assuming that the routing table only contains
+     * the routes to the neighbors and 2-hop neighbors.
+     */
+    void ComputeTopologyRoutes();
+
+    /**
+     * @brief Adds the routes to the interface addresses of the nodes that
+     * have a route (step 4 of the routing table computation).
+     */
+    void ComputeIfaceAssocRoutes();
+
+    /**
+     * @brief Recomputes the HNA routing table (step 5 of the routing table computation).
+     */
+    void ComputeHnaRoutes();
+
+    /**
+     * @brief Records that a route computed from the topology set goes through
+     * the given last hop.
+     * @param dest the destination address.
+     * @param lastAddr the address of the last hop before the destination.
+     */
+    void SetTopologyParent(const Ipv4Address& dest, const Ipv4Address& lastAddr);
+
+    /**
+     * @brief Forgets the last hop of a route computed from the topology set, if any.
+     * @param dest the destination address.
+     */
+    void RemoveTopologyParent(const Ipv4Address& dest);
+
+    bool m_incrementalRouting; //!< Whether the routing table is incrementally updated.
+    bool m_routingTableValid;  //!< Whether the incremental computation can start from the table.
+    EventId m_routingTableComputationEvent; //!< Deferred routing table computation.
+    /// Routes to the neighbors and 2-hop neighbors (steps 2 and 3), as last computed.
+    std::map<Ipv4Address, RoutingTableEntry> m_neighborRoutes;
+    /// Last hop of each route computed from the topology set.
+    std::map<Ipv4Address, Ipv4Address> m_topologyParents;
+    /// Destinations of the routes computed from the topology set, indexed by last hop.
+    std::map<Ipv4Address, std::set<Ipv4Address>> m_topologyChildren;
+    /// Destinations of the routes to interface addresses (step 4).
+    std::vector<Ipv4Address> m_ifaceAssocRoutes;
+    /// Last addresses of the topology tuples added or removed since the last computation.
+    std::set<Ipv4Address> m_changedTopologyOrigins;
+
   public:
     /**
      * @brief Gets the main address associated with a given interface address.
@@ -433,16 +518,6 @@ class RoutingProtocol : public Ipv4RoutingProtocol
      */
     void HnaTimerExpire();
 
-    /**
-     * @brief Removes tuple if expired. Else timer is rescheduled to expire at tuple.expirationTime.
-     *
-     * The task of actually removing the tuple is left to the OLSR agent.
-     *
-     * @param address The address of the tuple.
-     * @param sequenceNumber The sequence number of the tuple.
-     */
-    void DupTupleTimerExpire(Ipv4Address address, uint16_t sequenceNumber);
-
     bool m_linkTupleTimerFirstTime; //!< Flag to indicate if it is the first time the LinkTupleTimer
                                     //!< fires.
     /**
@@ -16,34 +16,55 @@
 
 #include "olsr-state.h"
 
+#include "ns3/simulator.h"
+
 namespace ns3
 {
 namespace olsr
 {
 
+/// Indexes of the 2-hop Neighbor Set and of the Topology Set
+enum
+{
+    BY_NEIGHBOR = 0, //!< 2-hop neighbor tuples by neighbor main address
+    BY_TWO_HOP = 1,  //!< 2-hop neighbor tuples by 2-hop neighbor address
+    BY_DEST = 0,     //!< topology tuples by destination address
+    BY_LAST = 1,     //!< topology tuples by last address
+    BY_IFACE = 0,    //!< interface association tuples by interface address
+    BY_MAIN = 1,     //!< interface association tuples by main address
+};
+
+OlsrState::OlsrState()
+    : m_linkSet({[](const LinkTuple& t) { return t.neighborIfaceAddr; }}),
+      m_neighborSet({[](const NeighborTuple& t) { return t.neighborMainAddr; }}),
+      m_twoHopNeighborSet({[](const TwoHopNeighborTuple& t) { return t.neighborMainAddr; },
+                           [](const TwoHopNeighborTuple& t) { return t.twoHopNeighborAddr; }}),
+      m_topologySet({[](const TopologyTuple& t) { return t.destAddr; },
+                     [](const TopologyTuple& t) { return t.lastAddr; }}),
+      m_mprSelectorSet({[](const MprSelectorTuple& t) { return t.mainAddr; }}),
+      m_ifaceAssocSet({[](const IfaceAssocTuple& t) { return t.ifaceAddr; },
+                       [](const IfaceAssocTuple& t) { return t.mainAddr; }}),
+      m_associationSet({[](const AssociationTuple& t) { return t.gatewayAddr; }})
+{
+}
+
 /********** MPR Selector Set Manipulation **********/
 
 MprSelectorTuple*
 OlsrState::FindMprSelectorTuple(const Ipv4Address& mainAddr)
 {
-    for (auto it = m_mprSelectorSet.begin(); it != m_mprSelectorSet.end(); it++)
-    {
-        if (it->mainAddr == mainAddr)
-        {
-            return &(*it);
-        }
-    }
-    return nullptr;
+    const auto& positions = m_mprSelectorSet.Find(0, mainAddr);
+    return positions.empty() ? nullptr : &m_mprSelectorSet.At(positions.front());
 }
 
 void
 OlsrState::EraseMprSelectorTuple(const MprSelectorTuple& tuple)
 {
-    for (auto it = m_mprSelectorSet.begin(); it != m_mprSelectorSet.end(); it++)
+    for (auto pos : m_mprSelectorSet.Find(0, tuple.mainAddr))
     {
-        if (*it == tuple)
+        if (m_mprSelectorSet.At(pos) == tuple)
         {
-            m_mprSelectorSet.erase(it);
+            m_mprSelectorSet.Erase(pos);
             break;
         }
     }
@@ -52,23 +73,13 @@ OlsrState::EraseMprSelectorTuple(const MprSelectorTuple& tuple)
 void
 OlsrState::EraseMprSelectorTuples(const Ipv4Address& mainAddr)
 {
-    for (auto it = m_mprSelectorSet.begin(); it != m_mprSelectorSet.end();)
-    {
-        if (it->mainAddr == mainAddr)
-        {
-            it = m_mprSelectorSet.erase(it);
-        }
-        else
-        {
-            it++;
-        }
-    }
+    m_mprSelectorSet.EraseIf(0, mainAddr, [](const MprSelectorTuple&) { return true; });
 }
 
 void
 OlsrState::InsertMprSelectorTuple(const MprSelectorTuple& tuple)
 {
-    m_mprSelectorSet.push_back(tuple);
+    m_mprSelectorSet.Insert(tuple);
 }
 
 std::string
@@ -76,12 +87,13 @@ OlsrState::PrintMprSelectorSet() const
 {
     std::ostringstream os;
     os << "[";
-    for (auto iter = m_mprSelectorSet.begin(); iter != m_mprSelectorSet.end(); iter++)
+    const MprSelectorSet& mprSelectorSet = m_mprSelectorSet.Get();
+    for (auto iter = mprSelectorSet.begin(); iter != mprSelectorSet.end(); iter++)
     {
         auto next = iter;
         next++;
         os << iter->mainAddr;
-        if (next != m_mprSelectorSet.end())
+        if (next != mprSelectorSet.end())
         {
             os << ", ";
         }
@@ -95,24 +107,18 @@ OlsrState::PrintMprSelectorSet() const
 NeighborTuple*
 OlsrState::FindNeighborTuple(const Ipv4Address& mainAddr)
 {
-    for (auto it = m_neighborSet.begin(); it != m_neighborSet.end(); it++)
-    {
-        if (it->neighborMainAddr == mainAddr)
-        {
-            return &(*it);
-        }
-    }
-    return nullptr;
+    const auto& positions = m_neighborSet.Find(0, mainAddr);
+    return positions.empty() ? nullptr : &m_neighborSet.At(positions.front());
 }
 
 const NeighborTuple*
 OlsrState::FindSymNeighborTuple(const Ipv4Address& mainAddr) const
 {
-    for (auto it = m_neighborSet.begin(); it != m_neighborSet.end(); it++)
+    for (auto pos : m_neighborSet.Find(0, mainAddr))
     {
-        if (it->neighborMainAddr == mainAddr && it->status == NeighborTuple::STATUS_SYM)
+        if (m_neighborSet.At(pos).status == NeighborTuple::STATUS_SYM)
         {
-            return &(*it);
+            return &m_neighborSet.At(pos);
         }
     }
     return nullptr;
@@ -121,11 +127,11 @@ OlsrState::FindSymNeighborTuple(const Ipv4Address& mainAddr) const
 NeighborTuple*
 OlsrState::FindNeighborTuple(const Ipv4Address& mainAddr, Willingness willingness)
 {
-    for (auto it = m_neighborSet.begin(); it != m_neighborSet.end(); it++)
+    for (auto pos : m_neighborSet.Find(0, mainAddr))
     {
-        if (it->neighborMainAddr == mainAddr && it->willingness == willingness)
+        if (m_neighborSet.At(pos).willingness == willingness)
         {
-            return &(*it);
+            return &m_neighborSet.At(pos);
         }
     }
     return nullptr;
@@ -134,11 +140,11 @@ OlsrState::FindNeighborTuple(const Ipv4Address& mainAddr, Willingness willingnes
 void
 OlsrState::EraseNeighborTuple(const NeighborTuple& tuple)
 {
-    for (auto it = m_neighborSet.begin(); it != m_neighborSet.end(); it++)
+    for (auto pos : m_neighborSet.Find(0, tuple.neighborMainAddr))
     {
-        if (*it == tuple)
+        if (m_neighborSet.At(pos) == tuple)
         {
-            m_neighborSet.erase(it);
+            m_neighborSet.Erase(pos);
             break;
         }
     }
@@ -147,29 +153,24 @@ OlsrState::EraseNeighborTuple(const NeighborTuple& tuple)
 void
 OlsrState::EraseNeighborTuple(const Ipv4Address& mainAddr)
 {
-    for (auto it = m_neighborSet.begin(); it != m_neighborSet.end(); it++)
+    const auto& positions = m_neighborSet.Find(0, mainAddr);
+    if (!positions.empty())
     {
-        if (it->neighborMainAddr == mainAddr)
-        {
-            it = m_neighborSet.erase(it);
-            break;
-        }
+        m_neighborSet.Erase(positions.front());
     }
 }
 
 void
 OlsrState::InsertNeighborTuple(const NeighborTuple& tuple)
 {
-    for (auto it = m_neighborSet.begin(); it != m_neighborSet.end(); it++)
+    NeighborTuple* existing = FindNeighborTuple(tuple.neighborMainAddr);
+    if (existing != nullptr)
     {
-        if (it->neighborMainAddr == tuple.neighborMainAddr)
-        {
-            // Update it
-            *it = tuple;
-            return;
-        }
+        // Update it
+        *existing = tuple;
+        return;
     }
-    m_neighborSet.push_back(tuple);
+    m_neighborSet.Insert(tuple);
 }
 
 /********** Neighbor 2 Hop Set Manipulation **********/
@@ -178,12 +179,15 @@ TwoHopNeighborTuple*
 OlsrState::FindTwoHopNeighborTuple(const Ipv4Address& neighborMainAddr,
                                    const Ipv4Address& twoHopNeighborAddr)
 {
-    for (auto it = m_twoHopNeighborSet.begin(); it != m_twoHopNeighborSet.end(); it++)
+    const auto& byNeighbor = m_twoHopNeighborSet.Find(BY_NEIGHBOR, neighborMainAddr);
+    const auto& byTwoHop = m_twoHopNeighborSet.Find(BY_TWO_HOP, twoHopNeighborAddr);
+    for (auto pos : (byNeighbor.size() < byTwoHop.size() ? byNeighbor : byTwoHop))
     {
-        if (it->neighborMainAddr == neighborMainAddr &&
-            it->twoHopNeighborAddr == twoHopNeighborAddr)
+        TwoHopNeighborTuple& tuple = m_twoHopNeighborSet.At(pos);
+        if (tuple.neighborMainAddr == neighborMainAddr &&
+            tuple.twoHopNeighborAddr == twoHopNeighborAddr)
         {
-            return &(*it);
+            return &tuple;
         }
     }
     return nullptr;
@@ -192,12 +196,12 @@ OlsrState::FindTwoHopNeighborTuple(const Ipv4Address& neighborMainAddr,
 void
 OlsrState::EraseTwoHopNeighborTuple(const TwoHopNeighborTuple& tuple)
 {
-    for (auto it = m_twoHopNeighborSet.begin(); it != m_twoHopNeighborSet.end(); it++)
+    for (auto pos : m_twoHopNeighborSet.Find(BY_TWO_HOP, tuple.twoHopNeighborAddr))
     {
-        if (*it == tuple)
+        if (m_twoHopNeighborSet.At(pos).neighborMainAddr == tuple.neighborMainAddr)
         {
-            m_twoHopNeighborSet.erase(it);
-            break;
+            m_twoHopNeighborSet.Erase(pos);
+            return;
         }
     }
 }
@@ -206,40 +210,25 @@ void
 OlsrState::EraseTwoHopNeighborTuples(const Ipv4Address& neighborMainAddr,
                                      const Ipv4Address& twoHopNeighborAddr)
 {
-    for (auto it = m_twoHopNeighborSet.begin(); it != m_twoHopNeighborSet.end();)
-    {
-        if (it->neighborMainAddr == neighborMainAddr &&
-            it->twoHopNeighborAddr == twoHopNeighborAddr)
-        {
-            it = m_twoHopNeighborSet.erase(it);
-        }
-        else
-        {
-            it++;
-        }
-    }
+    m_twoHopNeighborSet.EraseIf(BY_TWO_HOP,
+                                twoHopNeighborAddr,
+                                [&neighborMainAddr](const TwoHopNeighborTuple& tuple) {
+                                    return tuple.neighborMainAddr == neighborMainAddr;
+                                });
 }
 
 void
 OlsrState::EraseTwoHopNeighborTuples(const Ipv4Address& neighborMainAddr)
 {
-    for (auto it = m_twoHopNeighborSet.begin(); it != m_twoHopNeighborSet.end();)
-    {
-        if (it->neighborMainAddr == neighborMainAddr)
-        {
-            it = m_twoHopNeighborSet.erase(it);
-        }
-        else
-        {
-            it++;
-        }
-    }
+    m_twoHopNeighborSet.EraseIf(BY_NEIGHBOR, neighborMainAddr, [](const TwoHopNeighborTuple&) {
+        return true;
+    });
 }
 
 void
 OlsrState::InsertTwoHopNeighborTuple(const TwoHopNeighborTuple& tuple)
 {
-    m_twoHopNeighborSet.push_back(tuple);
+    m_twoHopNeighborSet.Insert(tuple);
 }
 
 /********** MPR Set Manipulation **********/
@@ -265,36 +254,38 @@ OlsrState::GetMprSet() const
 
 /********** Duplicate Set Manipulation **********/
 
+/**
+ * Get the key of a duplicate tuple in the Duplicate Set.
+ * @param address The duplicate tuple address.
+ * @param sequenceNumber The duplicate tuple sequence number.
+ * @returns The key.
+ */
+static uint64_t
+GetDuplicateKey(const Ipv4Address& address, uint16_t sequenceNumber)
+{
+    return (static_cast<uint64_t>(address.Get()) << 16) | sequenceNumber;
+}
+
 DuplicateTuple*
 OlsrState::FindDuplicateTuple(const Ipv4Address& addr, uint16_t sequenceNumber)
 {
-    for (auto it = m_duplicateSet.begin(); it != m_duplicateSet.end(); it++)
-    {
-        if (it->address == addr && it->sequenceNumber == sequenceNumber)
-        {
-            return &(*it);
-        }
-    }
-    return nullptr;
+    Time now = Simulator::Now();
+    m_duplicateSet.Purge(now);
+    return m_duplicateSet.Find(GetDuplicateKey(addr, sequenceNumber), now);
 }
 
 void
 OlsrState::EraseDuplicateTuple(const DuplicateTuple& tuple)
 {
-    for (auto it = m_duplicateSet.begin(); it != m_duplicateSet.end(); it++)
-    {
-        if (*it == tuple)
-        {
-            m_duplicateSet.erase(it);
-            break;
-        }
-    }
+    m_duplicateSet.Erase(GetDuplicateKey(tuple.address, tuple.sequenceNumber));
 }
 
 void
 OlsrState::InsertDuplicateTuple(const DuplicateTuple& tuple)
 {
-    m_duplicateSet.push_back(tuple);
+    m_duplicateSet.Insert(GetDuplicateKey(tuple.address, tuple.sequenceNumber),
+                          tuple.expirationTime,
+                          tuple);
 }
 
 /********** Link Set Manipulation **********/
@@ -302,32 +293,17 @@ OlsrState::InsertDuplicateTuple(const DuplicateTuple& tuple)
 LinkTuple*
 OlsrState::FindLinkTuple(const Ipv4Address& ifaceAddr)
 {
-    for (auto it = m_linkSet.begin(); it != m_linkSet.end(); it++)
-    {
-        if (it->neighborIfaceAddr == ifaceAddr)
-        {
-            return &(*it);
-        }
-    }
-    return nullptr;
+    const auto& positions = m_linkSet.Find(0, ifaceAddr);
+    return positions.empty() ? nullptr : &m_linkSet.At(positions.front());
 }
 
 LinkTuple*
 OlsrState::FindSymLinkTuple(const Ipv4Address& ifaceAddr, Time now)
 {
-    for (auto it = m_linkSet.begin(); it != m_linkSet.end(); it++)
+    LinkTuple* tuple = FindLinkTuple(ifaceAddr);
+    if (tuple != nullptr && tuple->symTime > now)
     {
-        if (it->neighborIfaceAddr == ifaceAddr)
-        {
-            if (it->symTime > now)
-            {
-                return &(*it);
-            }
-            else
-            {
-                break;
-            }
-        }
+        return tuple;
     }
     return nullptr;
 }
@@ -335,11 +311,11 @@ OlsrState::FindSymLinkTuple(const Ipv4Address& ifaceAddr, Time now)
 void
 OlsrState::EraseLinkTuple(const LinkTuple& tuple)
 {
-    for (auto it = m_linkSet.begin(); it != m_linkSet.end(); it++)
+    for (auto pos : m_linkSet.Find(0, tuple.neighborIfaceAddr))
     {
-        if (*it == tuple)
+        if (m_linkSet.At(pos) == tuple)
         {
-            m_linkSet.erase(it);
+            m_linkSet.Erase(pos);
             break;
         }
     }
@@ -348,8 +324,7 @@ OlsrState::EraseLinkTuple(const LinkTuple& tuple)
 LinkTuple&
 OlsrState::InsertLinkTuple(const LinkTuple& tuple)
 {
-    m_linkSet.push_back(tuple);
-    return m_linkSet.back();
+    return m_linkSet.Insert(tuple);
 }
 
 /********** Topology Set Manipulation **********/
@@ -357,11 +332,14 @@ OlsrState::InsertLinkTuple(const LinkTuple& tuple)
 TopologyTuple*
 OlsrState::FindTopologyTuple(const Ipv4Address& destAddr, const Ipv4Address& lastAddr)
 {
-    for (auto it = m_topologySet.begin(); it != m_topologySet.end(); it++)
+    const auto& byDest = m_topologySet.Find(BY_DEST, destAddr);
+    const auto& byLast = m_topologySet.Find(BY_LAST, lastAddr);
+    for (auto pos : (byDest.size() < byLast.size() ? byDest : byLast))
     {
-        if (it->destAddr == destAddr && it->lastAddr == lastAddr)
+        TopologyTuple& tuple = m_topologySet.At(pos);
+        if (tuple.destAddr == destAddr && tuple.lastAddr == lastAddr)
         {
-            return &(*it);
+            return &tuple;
         }
     }
     return nullptr;
@@ -370,24 +348,46 @@ OlsrState::FindTopologyTuple(const Ipv4Address& destAddr, const Ipv4Address& las
 TopologyTuple*
 OlsrState::FindNewerTopologyTuple(const Ipv4Address& lastAddr, uint16_t ansn)
 {
-    for (auto it = m_topologySet.begin(); it != m_topologySet.end(); it++)
+    for (auto pos : m_topologySet.Find(BY_LAST, lastAddr))
     {
-        if (it->lastAddr == lastAddr && it->sequenceNumber > ansn)
+        if (m_topologySet.At(pos).sequenceNumber > ansn)
         {
-            return &(*it);
+            return &m_topologySet.At(pos);
         }
     }
     return nullptr;
 }
 
+std::vector<const TopologyTuple*>
+OlsrState::FindTopologyTuplesByLastAddr(const Ipv4Address& lastAddr) const
+{
+    std::vector<const TopologyTuple*> tuples;
+    for (auto pos : m_topologySet.Find(BY_LAST, lastAddr))
+    {
+        tuples.push_back(&m_topologySet.At(pos));
+    }
+    return tuples;
+}
+
+std::vector<const TopologyTuple*>
+OlsrState::FindTopologyTuplesByDestAddr(const Ipv4Address& destAddr) const
+{
+    std::vector<const TopologyTuple*> tuples;
+    for (auto pos : m_topologySet.Find(BY_DEST, destAddr))
+    {
+        tuples.push_back(&m_topologySet.At(pos));
+    }
+    return tuples;
+}
+
 void
 OlsrState::EraseTopologyTuple(const TopologyTuple& tuple)
 {
-    for (auto it = m_topologySet.begin(); it != m_topologySet.end(); it++)
+    for (auto pos : m_topologySet.Find(BY_DEST, tuple.destAddr))
     {
-        if (*it == tuple)
+        if (m_topologySet.At(pos) == tuple)
         {
-            m_topologySet.erase(it);
+            m_topologySet.Erase(pos);
             break;
         }
     }
@@ -396,23 +396,15 @@ OlsrState::EraseTopologyTuple(const TopologyTuple& tuple)
 void
 OlsrState::EraseOlderTopologyTuples(const Ipv4Address& lastAddr, uint16_t ansn)
 {
-    for (auto it = m_topologySet.begin(); it != m_topologySet.end();)
-    {
-        if (it->lastAddr == lastAddr && it->sequenceNumber < ansn)
-        {
-            it = m_topologySet.erase(it);
-        }
-        else
-        {
-            it++;
-        }
-    }
+    m_topologySet.EraseIf(BY_LAST, lastAddr, [ansn](const TopologyTuple& tuple) {
+        return tuple.sequenceNumber < ansn;
+    });
 }
 
 void
 OlsrState::InsertTopologyTuple(const TopologyTuple& tuple)
 {
-    m_topologySet.push_back(tuple);
+    m_topologySet.Insert(tuple);
 }
 
 /********** Interface Association Set Manipulation **********/
@@ -420,37 +412,44 @@ OlsrState::InsertTopologyTuple(const TopologyTuple& tuple)
 IfaceAssocTuple*
 OlsrState::FindIfaceAssocTuple(const Ipv4Address& ifaceAddr)
 {
-    for (auto it = m_ifaceAssocSet.begin(); it != m_ifaceAssocSet.end(); it++)
-    {
-        if (it->ifaceAddr == ifaceAddr)
-        {
-            return &(*it);
-        }
-    }
-    return nullptr;
+    const auto& positions = m_ifaceAssocSet.Find(BY_IFACE, ifaceAddr);
+    return positions.empty() ? nullptr : &m_ifaceAssocSet.At(positions.front());
 }
 
 const IfaceAssocTuple*
 OlsrState::FindIfaceAssocTuple(const Ipv4Address& ifaceAddr) const
 {
-    for (auto it = m_ifaceAssocSet.begin(); it != m_ifaceAssocSet.end(); it++)
+    const auto& positions = m_ifaceAssocSet.Find(BY_IFACE, ifaceAddr);
+    return positions.empty() ? nullptr : &m_ifaceAssocSet.At(positions.front());
+}
+
+bool
+OlsrState::UpdateIfaceAssocTuples(const Ipv4Address& ifaceAddr,
+                                  const Ipv4Address& mainAddr,
+                                  Time time)
+{
+    bool updated = false;
+    // the time is not indexed, so the tuples can be modified in place
+    for (auto pos : m_ifaceAssocSet.Find(BY_IFACE, ifaceAddr))
     {
-        if (it->ifaceAddr == ifaceAddr)
+        IfaceAssocTuple& tuple = m_ifaceAssocSet.At(pos);
+        if (tuple.mainAddr == mainAddr)
         {
-            return &(*it);
+            tuple.time = time;
+            updated = true;
         }
     }
-    return nullptr;
+    return updated;
 }
 
 void
 OlsrState::EraseIfaceAssocTuple(const IfaceAssocTuple& tuple)
 {
-    for (auto it = m_ifaceAssocSet.begin(); it != m_ifaceAssocSet.end(); it++)
+    for (auto pos : m_ifaceAssocSet.Find(BY_IFACE, tuple.ifaceAddr))
     {
-        if (*it == tuple)
+        if (m_ifaceAssocSet.At(pos) == tuple)
         {
-            m_ifaceAssocSet.erase(it);
+            m_ifaceAssocSet.Erase(pos);
             break;
         }
     }
@@ -459,19 +458,16 @@ OlsrState::EraseIfaceAssocTuple(const IfaceAssocTuple& tuple)
 void
 OlsrState::InsertIfaceAssocTuple(const IfaceAssocTuple& tuple)
 {
-    m_ifaceAssocSet.push_back(tuple);
+    m_ifaceAssocSet.Insert(tuple);
 }
 
 std::vector<Ipv4Address>
 OlsrState::FindNeighborInterfaces(const Ipv4Address& neighborMainAddr) const
 {
     std::vector<Ipv4Address> retval;
-    for (auto it = m_ifaceAssocSet.begin(); it != m_ifaceAssocSet.end(); it++)
+    for (auto pos : m_ifaceAssocSet.Find(BY_MAIN, neighborMainAddr))
     {
-        if (it->mainAddr == neighborMainAddr)
-        {
-            retval.push_back(it->ifaceAddr);
-        }
+        retval.push_back(m_ifaceAssocSet.At(pos).ifaceAddr);
     }
     return retval;
 }
@@ -483,12 +479,12 @@ OlsrState::FindAssociationTuple(const Ipv4Address& gatewayAddr,
                                 const Ipv4Address& networkAddr,
                                 const Ipv4Mask& netmask)
 {
-    for (auto it = m_associationSet.begin(); it != m_associationSet.end(); it++)
+    for (auto pos : m_associationSet.Find(0, gatewayAddr))
     {
-        if (it->gatewayAddr == gatewayAddr and it->networkAddr == networkAddr and
-            it->netmask == netmask)
+        AssociationTuple& tuple = m_associationSet.At(pos);
+        if (tuple.networkAddr == networkAddr && tuple.netmask == netmask)
         {
-            return &(*it);
+            return &tuple;
         }
     }
     return nullptr;
@@ -497,11 +493,11 @@ OlsrState::FindAssociationTuple(const Ipv4Address& gatewayAddr,
 void
 OlsrState::EraseAssociationTuple(const AssociationTuple& tuple)
 {
-    for (auto it = m_associationSet.begin(); it != m_associationSet.end(); it++)
+    for (auto pos : m_associationSet.Find(0, tuple.gatewayAddr))
     {
-        if (*it == tuple)
+        if (m_associationSet.At(pos) == tuple)
         {
-            m_associationSet.erase(it);
+            m_associationSet.Erase(pos);
             break;
         }
     }
@@ -510,7 +506,7 @@ OlsrState::EraseAssociationTuple(const AssociationTuple& tuple)
 void
 OlsrState::InsertAssociationTuple(const AssociationTuple& tuple)
 {
-    m_associationSet.push_back(tuple);
+    m_associationSet.Insert(tuple);
 }
 
 void
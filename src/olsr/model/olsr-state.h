@@ -26,23 +26,31 @@ class OlsrState
     //  friend class Olsr;
 
   protected:
-    LinkSet m_linkSet;                     //!< Link Set (\RFC{3626}, section 4.2.1).
-    NeighborSet m_neighborSet;             //!< Neighbor Set (\RFC{3626}, section 4.3.1).
-    TwoHopNeighborSet m_twoHopNeighborSet; //!< 2-hop Neighbor Set (\RFC{3626}, section 4.3.2).
-    TopologySet m_topologySet;             //!< Topology Set (\RFC{3626}, section 4.4).
-    MprSet m_mprSet;                       //!< MPR Set (\RFC{3626}, section 4.3.3).
-    MprSelectorSet m_mprSelectorSet;       //!< MPR Selector Set (\RFC{3626}, section 4.3.4).
-    DuplicateSet m_duplicateSet;           //!< Duplicate Set (\RFC{3626}, section 3.4).
-    IfaceAssocSet m_ifaceAssocSet;         //!< Interface Association Set (\RFC{3626}, section 4.1).
-    AssociationSet m_associationSet; //!< Association Set (\RFC{3626}, section12.2). Associations
-                                     //!< obtained from HNA messages generated by other nodes.
-    Associations m_associations;     //!< The node's local Host Network Associations that will be
-                                     //!< advertised using HNA messages.
+    /// Link Set (\RFC{3626}, section 4.2.1), indexed by neighbor interface address.
+    IndexedTupleSet<LinkTuple, 1> m_linkSet;
+    /// Neighbor Set (\RFC{3626}, section 4.3.1), indexed by neighbor main address.
+    IndexedTupleSet<NeighborTuple, 1> m_neighborSet;
+    /// 2-hop Neighbor Set (\RFC{3626}, section 4.3.2), indexed by neighbor main address and by
+    /// 2-hop neighbor address.
+    IndexedTupleSet<TwoHopNeighborTuple, 2> m_twoHopNeighborSet;
+    /// Topology Set (\RFC{3626}, section 4.4), indexed by destination address and by last
+    /// address.
+    IndexedTupleSet<TopologyTuple, 2> m_topologySet;
+    MprSet m_mprSet;                 //!< MPR Set (\RFC{3626}, section 4.3.3).
+    /// MPR Selector Set (\RFC{3626}, section 4.3.4), indexed by main address.
+    IndexedTupleSet<MprSelectorTuple, 1> m_mprSelectorSet;
+    DuplicateSet m_duplicateSet; //!< Duplicate Set (\RFC{3626}, section 3.4).
+    /// Interface Association Set (\RFC{3626}, section 4.1), indexed by interface address and by
+    /// main address.
+    IndexedTupleSet<IfaceAssocTuple, 2> m_ifaceAssocSet;
+    /// Association Set (\RFC{3626}, section12.2), indexed by gateway address. Associations
+    /// obtained from HNA messages generated by other nodes.
+    IndexedTupleSet<AssociationTuple, 1> m_associationSet;
+    Associations m_associations; //!< The node's local Host Network Associations that will be
+                                 //!< advertised using HNA messages.
 
   public:
-    OlsrState()
-    {
-    }
+    OlsrState();
 
     // MPR selector
 
@@ -52,7 +60,7 @@ class OlsrState
      */
     const MprSelectorSet& GetMprSelectors() const
     {
-        return m_mprSelectorSet;
+        return m_mprSelectorSet.Get();
     }
 
     /**
@@ -94,16 +102,17 @@ class OlsrState
      */
     const NeighborSet& GetNeighbors() const
     {
-        return m_neighborSet;
+        return m_neighborSet.Get();
     }
 
     /**
-     * Gets the neighbor set.
+     * Gets a mutable reference to the neighbor set. The neighbor addresses may be
+     * modified, the index is then rebuilt before the next lookup.
      * @returns The neighbor set.
      */
     NeighborSet& GetNeighbors()
     {
-        return m_neighborSet;
+        return m_neighborSet.GetMutable();
     }
 
     /**
@@ -153,16 +162,17 @@ class OlsrState
      */
     const TwoHopNeighborSet& GetTwoHopNeighbors() const
     {
-        return m_twoHopNeighborSet;
+        return m_twoHopNeighborSet.Get();
     }
 
     /**
-     * Gets the 2-hop neighbor set.
+     * Gets a mutable reference to the 2-hop neighbor set. The addresses may be
+     * modified, the indexes are then rebuilt before the next lookup.
      * @returns The 2-hop neighbor set.
      */
     TwoHopNeighborSet& GetTwoHopNeighbors()
     {
-        return m_twoHopNeighborSet;
+        return m_twoHopNeighborSet.GetMutable();
     }
 
     /**
@@ -220,7 +230,8 @@ class OlsrState
     // Duplicate
 
     /**
-     * Finds a duplicate tuple.
+     * Finds a duplicate tuple. Tuples whose expiration time has passed are
+     * removed from the Duplicate Set first.
      * @param address The duplicate tuple address.
      * @param sequenceNumber The duplicate tuple sequence number.
      * @returns The duplicate tuple, or a null pointer if no match.
@@ -233,7 +244,8 @@ class OlsrState
      */
     void EraseDuplicateTuple(const DuplicateTuple& tuple);
     /**
-     * Inserts a duplicate tuple.
+     * Inserts a duplicate tuple, or replaces the tuple with the same address
+     * and sequence number. The tuple is removed once its expiration time has passed.
      * @param tuple The tuple to insert.
      */
     void InsertDuplicateTuple(const DuplicateTuple& tuple);
@@ -246,7 +258,7 @@ class OlsrState
      */
     const LinkSet& GetLinks() const
     {
-        return m_linkSet;
+        return m_linkSet.Get();
     }
 
     /**
@@ -282,7 +294,7 @@ class OlsrState
      */
     const TopologySet& GetTopologySet() const
     {
-        return m_topologySet;
+        return m_topologySet.Get();
     }
 
     /**
@@ -299,6 +311,20 @@ class OlsrState
      * @returns The topology tuple, or a null pointer if no match.
      */
     TopologyTuple* FindNewerTopologyTuple(const Ipv4Address& lastAddr, uint16_t ansn);
+    /**
+     * Finds the topology tuples with a given last address.
+     * @param lastAddr The address of the node previous to the destination.
+     * @returns The matching topology tuples.
+     */
+    std::vector<const TopologyTuple*> FindTopologyTuplesByLastAddr(
+        const Ipv4Address& lastAddr) const;
+    /**
+     * Finds the topology tuples with a given destination address.
+     * @param destAddr The destination address.
+     * @returns The matching topology tuples.
+     */
+    std::vector<const TopologyTuple*> FindTopologyTuplesByDestAddr(
+        const Ipv4Address& destAddr) const;
     /**
      * Erases a topology tuple.
      * @param tuple The tuple to erase.
@@ -324,16 +350,17 @@ class OlsrState
      */
     const IfaceAssocSet& GetIfaceAssocSet() const
     {
-        return m_ifaceAssocSet;
+        return m_ifaceAssocSet.Get();
     }
 
     /**
-     * Gets a mutable reference to the interface association set.
+     * Gets a mutable reference to the interface association set. The addresses may be
+     * modified, the indexes are then rebuilt before the next lookup.
      * @returns The interface association set.
      */
     IfaceAssocSet& GetIfaceAssocSetMutable()
     {
-        return m_ifaceAssocSet;
+        return m_ifaceAssocSet.GetMutable();
     }
 
     /**
@@ -348,6 +375,17 @@ class OlsrState
      * @returns The interface association  tuple, or a null pointer if no match.
      */
     const IfaceAssocTuple* FindIfaceAssocTuple(const Ipv4Address& ifaceAddr) const;
+    /**
+     * Updates the expiration time of the interface association tuples with the
+     * given interface and main addresses.
+     * @param ifaceAddr The interface address.
+     * @param mainAddr The main address.
+     * @param time The new expiration time.
+     * @returns True if at least one tuple was updated.
+     */
+    bool UpdateIfaceAssocTuples(const Ipv4Address& ifaceAddr,
+                                const Ipv4Address& mainAddr,
+                                Time time);
     /**
      * Erases a interface association tuple.
      * @param tuple The tuple to erase.
@@ -366,7 +404,7 @@ class OlsrState
      */
     const AssociationSet& GetAssociationSet() const // Associations known to the node
     {
-        return m_associationSet;
+        return m_associationSet.Get();
     }
 
     /**
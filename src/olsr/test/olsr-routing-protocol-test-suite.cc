@@ -8,11 +8,17 @@
  *          Gustavo J. A. M. Carneiro <gjc@inescporto.pt>
  */
 
+#include "ns3/internet-stack-helper.h"
 #include "ns3/ipv4-header.h"
+#include "ns3/node.h"
 #include "ns3/olsr-repositories.h"
 #include "ns3/olsr-routing-protocol.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/simple-net-device.h"
 #include "ns3/test.h"
 
+#include <vector>
+
 /**
  * @ingroup olsr
  * @defgroup olsr-test olsr module tests
@@ -163,6 +169,297 @@ OlsrMprTestCase::DoRun()
                           "Node 1 must NOT select node 8 as MPR");
 }
 
+/**
+ * @ingroup olsr-test
+ * @ingroup tests
+ *
+ * Testcase checking that the incremental routing table computation finds the
+ * same distances as the full computation when the topology changes.
+ */
+class OlsrIncrementalRoutingTestCase : public TestCase
+{
+  public:
+    OlsrIncrementalRoutingTestCase();
+    void DoRun() override;
+};
+
+OlsrIncrementalRoutingTestCase::OlsrIncrementalRoutingTestCase()
+    : TestCase("Check OLSR incremental routing table computation")
+{
+}
+
+void
+OlsrIncrementalRoutingTestCase::DoRun()
+{
+    Ptr<Node> node = CreateObject<Node>();
+    InternetStackHelper internet;
+    internet.Install(node);
+    Ptr<SimpleNetDevice> device = CreateObject<SimpleNetDevice>();
+    device->SetAddress(Mac48Address::Allocate());
+    node->AddDevice(device);
+    Ptr<Ipv4> ipv4 = node->GetObject<Ipv4>();
+    uint32_t interface = ipv4->AddInterface(device);
+    ipv4->AddAddress(interface, Ipv4InterfaceAddress("10.0.0.1", "255.0.0.0"));
+
+    Ptr<RoutingProtocol> protocol = CreateObject<RoutingProtocol>();
+    protocol->SetIpv4(ipv4);
+    protocol->m_mainAddress = Ipv4Address("10.0.0.1");
+    Ptr<RoutingProtocol> reference = CreateObject<RoutingProtocol>();
+    reference->SetIpv4(ipv4);
+    reference->m_mainAddress = Ipv4Address("10.0.0.1");
+
+    // 4 neighbors, 4 2-hop neighbors and 60 remote nodes
+    std::vector<Ipv4Address> neighbors;
+    std::vector<Ipv4Address> nodes;
+    for (uint32_t i = 2; i < 6; i++)
+    {
+        Ipv4Address addr(0x0a000000 + i);
+        neighbors.push_back(addr);
+        nodes.push_back(addr);
+        LinkTuple link;
+        link.localIfaceAddr = Ipv4Address("10.0.0.1");
+        link.neighborIfaceAddr = addr;
+        link.symTime = Seconds(3600);
+        link.asymTime = Seconds(3600);
+        link.time = Seconds(3600);
+        protocol->m_state.InsertLinkTuple(link);
+        NeighborTuple neighbor;
+        neighbor.neighborMainAddr = addr;
+        neighbor.status = NeighborTuple::STATUS_SYM;
+        neighbor.willingness = Willingness::DEFAULT;
+        protocol->m_state.InsertNeighborTuple(neighbor);
+    }
+    for (uint32_t i = 0; i < 64; i++)
+    {
+        nodes.emplace_back(0x0a000100 + i);
+    }
+
+    Ptr<UniformRandomVariable> rng = CreateObject<UniformRandomVariable>();
+    rng->SetStream(1);
+    auto pick = [&rng](const std::vector<Ipv4Address>& addrs) {
+        return addrs[rng->GetInteger(0, addrs.size() - 1)];
+    };
+
+    TwoHopNeighborTuple twoHop;
+    twoHop.expirationTime = Seconds(3600);
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        twoHop.neighborMainAddr = neighbors[i];
+        twoHop.twoHopNeighborAddr = nodes[4 + i];
+        protocol->m_state.InsertTwoHopNeighborTuple(twoHop);
+    }
+    for (uint32_t i = 0; i < 150; i++)
+    {
+        TopologyTuple topology;
+        topology.lastAddr = pick(nodes);
+        topology.destAddr = pick(nodes);
+        if (protocol->m_state.FindTopologyTuple(topology.destAddr, topology.lastAddr) == nullptr)
+        {
+            protocol->AddTopologyTuple(topology);
+        }
+    }
+    protocol->RoutingTableComputation();
+
+    for (uint32_t round = 0; round < 300; round++)
+    {
+        for (uint32_t change = rng->GetInteger(1, 4); change > 0; change--)
+        {
+            uint32_t action = rng->GetInteger(0, 9);
+            const TopologySet& topologySet = protocol->m_state.GetTopologySet();
+            if (action < 4 && !topologySet.empty())
+            {
+                TopologyTuple topology = topologySet[rng->GetInteger(0, topologySet.size() - 1)];
+                protocol->RemoveTopologyTuple(topology);
+            }
+            else if (action < 9)
+            {
+                TopologyTuple topology;
+                topology.lastAddr = pick(nodes);
+                topology.destAddr = pick(nodes);
+                if (protocol->m_state.FindTopologyTuple(topology.destAddr, topology.lastAddr) ==
+                    nullptr)
+                {
+                    protocol->AddTopologyTuple(topology);
+                }
+            }
+            else
+            {
+                twoHop.neighborMainAddr = pick(neighbors);
+                twoHop.twoHopNeighborAddr = nodes[rng->GetInteger(4, 11)];
+                if (protocol->m_state.FindTwoHopNeighborTuple(twoHop.neighborMainAddr,
+                                                              twoHop.twoHopNeighborAddr))
+                {
+                    protocol->m_state.EraseTwoHopNeighborTuple(twoHop);
+                }
+                else
+                {
+                    protocol->m_state.InsertTwoHopNeighborTuple(twoHop);
+                }
+            }
+        }
+        protocol->IncrementalRoutingTableComputation();
+
+        reference->m_state = protocol->m_state;
+        reference->RoutingTableComputation();
+
+        NS_TEST_ASSERT_MSG_EQ(protocol->m_table.size(),
+                              reference->m_table.size(),
+                              "Unexpected number of routes in round " << round);
+        for (const auto& [dest, entry] : reference->m_table)
+        {
+            auto it = protocol->m_table.find(dest);
+            NS_TEST_ASSERT_MSG_EQ((it != protocol->m_table.end()),
+                                  true,
+                                  "No route to " << dest << " in round " << round);
+            NS_TEST_EXPECT_MSG_EQ(it->second.distance,
+                                  entry.distance,
+                                  "Unexpected distance to " << dest << " in round " << round);
+            auto next = protocol->m_table.find(it->second.nextAddr);
+            NS_TEST_EXPECT_MSG_EQ((next != protocol->m_table.end() && next->second.distance == 1),
+                                  true,
+                                  "Next hop to " << dest << " is not a neighbor");
+        }
+    }
+
+    protocol->Dispose();
+    reference->Dispose();
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup olsr-test
+ * @ingroup tests
+ *
+ * Testcase checking the lookups in the indexed repositories of OlsrState.
+ */
+class OlsrStateTestCase : public TestCase
+{
+  public:
+    OlsrStateTestCase();
+    void DoRun() override;
+};
+
+OlsrStateTestCase::OlsrStateTestCase()
+    : TestCase("Check OLSR state repositories")
+{
+}
+
+void
+OlsrStateTestCase::DoRun()
+{
+    OlsrState state;
+
+    // node 10.0.1.i advertises nodes 10.0.2.0 to 10.0.2.i
+    for (uint32_t i = 0; i < 10; i++)
+    {
+        for (uint32_t j = 0; j <= i; j++)
+        {
+            TopologyTuple tuple;
+            tuple.lastAddr = Ipv4Address(0x0a000100 + i);
+            tuple.destAddr = Ipv4Address(0x0a000200 + j);
+            tuple.sequenceNumber = 1;
+            state.InsertTopologyTuple(tuple);
+        }
+    }
+    NS_TEST_EXPECT_MSG_EQ(state.GetTopologySet().size(), 55, "Unexpected topology set size");
+    NS_TEST_EXPECT_MSG_EQ(state.FindTopologyTuplesByLastAddr(Ipv4Address("10.0.1.4")).size(),
+                          5,
+                          "Unexpected number of tuples from 10.0.1.4");
+    NS_TEST_EXPECT_MSG_EQ(state.FindTopologyTuplesByDestAddr(Ipv4Address("10.0.2.4")).size(),
+                          6,
+                          "Unexpected number of tuples to 10.0.2.4");
+
+    // newer tuples from 10.0.1.5 replace the older ones
+    TopologyTuple tuple;
+    tuple.lastAddr = Ipv4Address("10.0.1.5");
+    tuple.destAddr = Ipv4Address("10.0.2.9");
+    tuple.sequenceNumber = 2;
+    state.InsertTopologyTuple(tuple);
+    state.EraseOlderTopologyTuples(tuple.lastAddr, 2);
+    NS_TEST_EXPECT_MSG_EQ(state.GetTopologySet().size(), 50, "Unexpected topology set size");
+    NS_TEST_EXPECT_MSG_NE(state.FindNewerTopologyTuple(tuple.lastAddr, 1),
+                          nullptr,
+                          "Newer tuple not found");
+    NS_TEST_EXPECT_MSG_EQ(state.FindTopologyTuple(Ipv4Address("10.0.2.0"), tuple.lastAddr),
+                          nullptr,
+                          "Older tuple not erased");
+
+    state.EraseTopologyTuple(*state.FindTopologyTuple(Ipv4Address("10.0.2.0"),
+                                                      Ipv4Address("10.0.1.0")));
+    for (const auto& t : state.GetTopologySet())
+    {
+        NS_TEST_EXPECT_MSG_EQ(state.FindTopologyTuple(t.destAddr, t.lastAddr),
+                              &t,
+                              "Tuple " << t << " not found");
+    }
+    NS_TEST_EXPECT_MSG_EQ(state.FindTopologyTuplesByDestAddr(Ipv4Address("10.0.2.0")).size(),
+                          8,
+                          "Unexpected number of tuples to 10.0.2.0");
+
+    // 2-hop neighbors
+    TwoHopNeighborTuple twoHop;
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        twoHop.neighborMainAddr = Ipv4Address(0x0a000000 + i);
+        for (uint32_t j = 0; j < 4; j++)
+        {
+            twoHop.twoHopNeighborAddr = Ipv4Address(0x0a000300 + j);
+            state.InsertTwoHopNeighborTuple(twoHop);
+        }
+    }
+    state.EraseTwoHopNeighborTuples(Ipv4Address("10.0.0.1"));
+    state.EraseTwoHopNeighborTuples(Ipv4Address("10.0.0.2"), Ipv4Address("10.0.3.2"));
+    NS_TEST_EXPECT_MSG_EQ(state.GetTwoHopNeighbors().size(), 11, "Unexpected 2-hop set size");
+    NS_TEST_EXPECT_MSG_EQ(
+        state.FindTwoHopNeighborTuple(Ipv4Address("10.0.0.2"), Ipv4Address("10.0.3.2")),
+        nullptr,
+        "2-hop tuple not erased");
+    NS_TEST_EXPECT_MSG_NE(
+        state.FindTwoHopNeighborTuple(Ipv4Address("10.0.0.3"), Ipv4Address("10.0.3.2")),
+        nullptr,
+        "2-hop tuple not found");
+    // erasing keeps the insertion order of the other tuples
+    std::vector<std::pair<uint32_t, uint32_t>> order;
+    for (const auto& t : state.GetTwoHopNeighbors())
+    {
+        order.emplace_back(t.neighborMainAddr.Get() & 0xff, t.twoHopNeighborAddr.Get() & 0xff);
+    }
+    const std::vector<std::pair<uint32_t, uint32_t>> expected =
+        {{0, 0}, {0, 1}, {0, 2}, {0, 3}, {2, 0}, {2, 1}, {2, 3}, {3, 0}, {3, 1}, {3, 2}, {3, 3}};
+    NS_TEST_EXPECT_MSG_EQ((order == expected), true, "Erasing changed the order of the tuples");
+
+    // interface associations
+    IfaceAssocTuple assoc;
+    assoc.ifaceAddr = Ipv4Address("10.0.4.1");
+    assoc.mainAddr = Ipv4Address("10.0.4.0");
+    assoc.time = Seconds(1);
+    state.InsertIfaceAssocTuple(assoc);
+    NS_TEST_EXPECT_MSG_EQ(
+        state.UpdateIfaceAssocTuples(assoc.ifaceAddr, Ipv4Address("10.0.5.0"), Seconds(2)),
+        false,
+        "Tuple with another main address updated");
+    NS_TEST_EXPECT_MSG_EQ(state.UpdateIfaceAssocTuples(assoc.ifaceAddr, assoc.mainAddr, Seconds(2)),
+                          true,
+                          "Tuple not updated");
+    NS_TEST_EXPECT_MSG_EQ(state.FindIfaceAssocTuple(assoc.ifaceAddr)->time,
+                          Seconds(2),
+                          "Expiration time not updated");
+
+    // modifying the addresses through the mutable accessor updates the indexes
+    for (auto& t : state.GetTwoHopNeighbors())
+    {
+        t.neighborMainAddr = Ipv4Address("10.0.0.9");
+    }
+    NS_TEST_EXPECT_MSG_NE(
+        state.FindTwoHopNeighborTuple(Ipv4Address("10.0.0.9"), Ipv4Address("10.0.3.2")),
+        nullptr,
+        "2-hop tuple not found after update");
+    NS_TEST_EXPECT_MSG_EQ(
+        state.FindTwoHopNeighborTuple(Ipv4Address("10.0.0.3"), Ipv4Address("10.0.3.2")),
+        nullptr,
+        "2-hop tuple found at its former address");
+}
+
 /**
  * @ingroup olsr-test
  * @ingroup tests
@@ -179,6 +476,8 @@ OlsrProtocolTestSuite::OlsrProtocolTestSuite()
     : TestSuite("routing-olsr", Type::UNIT)
 {
     AddTestCase(new OlsrMprTestCase(), TestCase::Duration::QUICK);
+    AddTestCase(new OlsrIncrementalRoutingTestCase(), TestCase::Duration::QUICK);
+    AddTestCase(new OlsrStateTestCase(), TestCase::Duration::QUICK);
 }
 
 static OlsrProtocolTestSuite g_olsrProtocolTestSuite; //!< Static variable for test initialization
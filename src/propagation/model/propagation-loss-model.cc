@@ -20,6 +20,7 @@
 #include "ns3/string.h"
 
 #include <cmath>
+#include <limits>
 
 namespace ns3
 {
@@ -72,6 +73,56 @@ PropagationLossModel::CalcRxPower(double txPowerDbm,
     return self;
 }
 
+void
+PropagationLossModel::CalcRxPowers(double txPowerDbm,
+                                   Ptr<MobilityModel> a,
+                                   const std::vector<Ptr<MobilityModel>>& b,
+                                   std::vector<double>& rxPowerDbm,
+                                   std::vector<double>& distances) const
+{
+    NS_LOG_FUNCTION(this << txPowerDbm << a << b.size());
+    rxPowerDbm.assign(b.size(), txPowerDbm);
+    distances.resize(b.size());
+    const auto position = a->GetPosition();
+    for (std::size_t i = 0; i < b.size(); ++i)
+    {
+        distances[i] = CalculateDistance(position, b[i]->GetPosition());
+    }
+    for (auto model = this; model != nullptr; model = PeekPointer(model->m_next))
+    {
+        model->DoCalcRxPowers(a, b, distances, rxPowerDbm);
+    }
+}
+
+double
+PropagationLossModel::GetRxPowerUpperBound(double txPowerDbm, double distance) const
+{
+    double self = DoGetRxPowerUpperBound(txPowerDbm, distance);
+    if (m_next)
+    {
+        self = m_next->GetRxPowerUpperBound(self, distance);
+    }
+    return self;
+}
+
+double
+PropagationLossModel::DoGetRxPowerUpperBound(double txPowerDbm, double distance) const
+{
+    return std::numeric_limits<double>::infinity();
+}
+
+void
+PropagationLossModel::DoCalcRxPowers(Ptr<MobilityModel> a,
+                                     const std::vector<Ptr<MobilityModel>>& b,
+                                     const std::vector<double>& distances,
+                                     std::vector<double>& rxPowerDbm) const
+{
+    for (std::size_t i = 0; i < b.size(); ++i)
+    {
+        rxPowerDbm[i] = DoCalcRxPower(rxPowerDbm[i], a, b[i]);
+    }
+}
+
 int64_t
 PropagationLossModel::AssignStreams(int64_t stream)
 {
@@ -273,6 +324,41 @@ FriisPropagationLossModel::DoCalcRxPower(double txPowerDbm,
     return txPowerDbm - std::max(lossDb, m_minLoss);
 }
 
+void
+FriisPropagationLossModel::DoCalcRxPowers(Ptr<MobilityModel> a,
+                                          const std::vector<Ptr<MobilityModel>>& b,
+                                          const std::vector<double>& distances,
+                                          std::vector<double>& rxPowerDbm) const
+{
+    // same computation as DoCalcRxPower, without the per-destination logging
+    const double numerator = m_lambda * m_lambda;
+    for (std::size_t i = 0; i < distances.size(); ++i)
+    {
+        const double distance = distances[i];
+        if (distance <= 0)
+        {
+            rxPowerDbm[i] -= m_minLoss;
+            continue;
+        }
+        double denominator = 16 * M_PI * M_PI * distance * distance * m_systemLoss;
+        double lossDb = -10 * log10(numerator / denominator);
+        rxPowerDbm[i] -= std::max(lossDb, m_minLoss);
+    }
+}
+
+double
+FriisPropagationLossModel::DoGetRxPowerUpperBound(double txPowerDbm, double distance) const
+{
+    if (distance <= 0)
+    {
+        return txPowerDbm - m_minLoss;
+    }
+    double numerator = m_lambda * m_lambda;
+    double denominator = 16 * M_PI * M_PI * distance * distance * m_systemLoss;
+    double lossDb = -10 * log10(numerator / denominator);
+    return txPowerDbm - std::max(lossDb, m_minLoss);
+}
+
 int64_t
 FriisPropagationLossModel::DoAssignStreams(int64_t stream)
 {
@@ -550,6 +636,42 @@ LogDistancePropagationLossModel::DoCalcRxPower(double txPowerDbm,
     return txPowerDbm + rxc;
 }
 
+void
+LogDistancePropagationLossModel::DoCalcRxPowers(Ptr<MobilityModel> a,
+                                                const std::vector<Ptr<MobilityModel>>& b,
+                                                const std::vector<double>& distances,
+                                                std::vector<double>& rxPowerDbm) const
+{
+    for (std::size_t i = 0; i < distances.size(); ++i)
+    {
+        const double distance = distances[i];
+        if (distance <= m_referenceDistance)
+        {
+            rxPowerDbm[i] -= m_referenceLoss;
+            continue;
+        }
+        double pathLossDb = 10 * m_exponent * std::log10(distance / m_referenceDistance);
+        double rxc = -m_referenceLoss - pathLossDb;
+        rxPowerDbm[i] += rxc;
+    }
+}
+
+double
+LogDistancePropagationLossModel::DoGetRxPowerUpperBound(double txPowerDbm, double distance) const
+{
+    if (m_exponent < 0)
+    {
+        // the loss decreases with the distance, hence no bound
+        return std::numeric_limits<double>::infinity();
+    }
+    if (distance <= m_referenceDistance)
+    {
+        return txPowerDbm - m_referenceLoss;
+    }
+    double pathLossDb = 10 * m_exponent * std::log10(distance / m_referenceDistance);
+    return txPowerDbm - m_referenceLoss - pathLossDb;
+}
+
 int64_t
 LogDistancePropagationLossModel::DoAssignStreams(int64_t stream)
 {
@@ -649,6 +771,74 @@ ThreeLogDistancePropagationLossModel::DoCalcRxPower(double txPowerDbm,
     return txPowerDbm - pathLossDb;
 }
 
+void
+ThreeLogDistancePropagationLossModel::DoCalcRxPowers(Ptr<MobilityModel> a,
+                                                     const std::vector<Ptr<MobilityModel>>& b,
+                                                     const std::vector<double>& distances,
+                                                     std::vector<double>& rxPowerDbm) const
+{
+    // the loss at the start of each range does not depend on the destination
+    const double loss1 = m_referenceLoss;
+    const double loss2 =
+        m_referenceLoss + 10 * m_exponent0 * std::log10(m_distance1 / m_distance0);
+    const double loss3 = loss2 + 10 * m_exponent1 * std::log10(m_distance2 / m_distance1);
+    for (std::size_t i = 0; i < distances.size(); ++i)
+    {
+        const double distance = distances[i];
+        NS_ASSERT(distance >= 0);
+        double pathLossDb;
+        if (distance < m_distance0)
+        {
+            pathLossDb = 0;
+        }
+        else if (distance < m_distance1)
+        {
+            pathLossDb = loss1 + 10 * m_exponent0 * std::log10(distance / m_distance0);
+        }
+        else if (distance < m_distance2)
+        {
+            pathLossDb = loss2 + 10 * m_exponent1 * std::log10(distance / m_distance1);
+        }
+        else
+        {
+            pathLossDb = loss3 + 10 * m_exponent2 * std::log10(distance / m_distance2);
+        }
+        rxPowerDbm[i] -= pathLossDb;
+    }
+}
+
+double
+ThreeLogDistancePropagationLossModel::DoGetRxPowerUpperBound(double txPowerDbm,
+                                                             double distance) const
+{
+    if (m_referenceLoss < 0 || m_exponent0 < 0 || m_exponent1 < 0 || m_exponent2 < 0)
+    {
+        // the loss is not a non-decreasing function of the distance, hence no bound
+        return std::numeric_limits<double>::infinity();
+    }
+    double pathLossDb;
+    if (distance < m_distance0)
+    {
+        pathLossDb = 0;
+    }
+    else if (distance < m_distance1)
+    {
+        pathLossDb = m_referenceLoss + 10 * m_exponent0 * std::log10(distance / m_distance0);
+    }
+    else if (distance < m_distance2)
+    {
+        pathLossDb = m_referenceLoss + 10 * m_exponent0 * std::log10(m_distance1 / m_distance0) +
+                     10 * m_exponent1 * std::log10(distance / m_distance1);
+    }
+    else
+    {
+        pathLossDb = m_referenceLoss + 10 * m_exponent0 * std::log10(m_distance1 / m_distance0) +
+                     10 * m_exponent1 * std::log10(m_distance2 / m_distance1) +
+                     10 * m_exponent2 * std::log10(distance / m_distance2);
+    }
+    return txPowerDbm - pathLossDb;
+}
+
 int64_t
 ThreeLogDistancePropagationLossModel::DoAssignStreams(int64_t stream)
 {
@@ -764,6 +954,41 @@ NakagamiPropagationLossModel::DoCalcRxPower(double txPowerDbm,
     return resultPowerDbm;
 }
 
+void
+NakagamiPropagationLossModel::DoCalcRxPowers(Ptr<MobilityModel> a,
+                                             const std::vector<Ptr<MobilityModel>>& b,
+                                             const std::vector<double>& distances,
+                                             std::vector<double>& rxPowerDbm) const
+{
+    // convert all the powers to Watt, draw the faded powers in the order of the
+    // destinations (as DoCalcRxPower would) and convert them back to dBm
+    for (auto& power : rxPowerDbm)
+    {
+        power = std::pow(10, (power - 30) / 10);
+    }
+    for (std::size_t i = 0; i < distances.size(); ++i)
+    {
+        const double distance = distances[i];
+        NS_ASSERT(distance >= 0);
+        const double m = (distance < m_distance1)   ? m_m0
+                         : (distance < m_distance2) ? m_m1
+                                                    : m_m2;
+        auto int_m = static_cast<unsigned int>(std::floor(m));
+        if (int_m == m)
+        {
+            rxPowerDbm[i] = m_erlangRandomVariable->GetValue(int_m, rxPowerDbm[i] / m);
+        }
+        else
+        {
+            rxPowerDbm[i] = m_gammaRandomVariable->GetValue(m, rxPowerDbm[i] / m);
+        }
+    }
+    for (auto& power : rxPowerDbm)
+    {
+        power = 10 * std::log10(power) + 30;
+    }
+}
+
 int64_t
 NakagamiPropagationLossModel::DoAssignStreams(int64_t stream)
 {
@@ -814,6 +1039,12 @@ FixedRssLossModel::DoCalcRxPower(double txPowerDbm,
     return m_rss;
 }
 
+double
+FixedRssLossModel::DoGetRxPowerUpperBound(double txPowerDbm, double distance) const
+{
+    return m_rss;
+}
+
 int64_t
 FixedRssLossModel::DoAssignStreams(int64_t stream)
 {
@@ -947,6 +1178,31 @@ RangePropagationLossModel::DoCalcRxPower(double txPowerDbm,
     }
 }
 
+void
+RangePropagationLossModel::DoCalcRxPowers(Ptr<MobilityModel> a,
+                                          const std::vector<Ptr<MobilityModel>>& b,
+                                          const std::vector<double>& distances,
+                                          std::vector<double>& rxPowerDbm) const
+{
+    for (std::size_t i = 0; i < distances.size(); ++i)
+    {
+        if (distances[i] > m_range)
+        {
+            rxPowerDbm[i] = -1000;
+        }
+    }
+}
+
+double
+RangePropagationLossModel::DoGetRxPowerUpperBound(double txPowerDbm, double distance) const
+{
+    if (distance <= m_range)
+    {
+        return txPowerDbm;
+    }
+    return -1000;
+}
+
 int64_t
 RangePropagationLossModel::DoAssignStreams(int64_t stream)
 {
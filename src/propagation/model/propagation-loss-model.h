@@ -17,6 +17,7 @@
 #include "ns3/random-variable-stream.h"
 
 #include <unordered_map>
+#include <vector>
 
 namespace ns3
 {
@@ -90,6 +91,50 @@ class PropagationLossModel : public Object
      */
     double CalcRxPower(double txPowerDbm, Ptr<MobilityModel> a, Ptr<MobilityModel> b) const;
 
+    /**
+     * Returns the Rx Power at each of the given destinations, taking into
+     * account all the PropagationLossModel(s) chained to the current one.
+     *
+     * The positions of the source and the destinations are read once for
+     * the whole chain, and each model processes all the destinations at
+     * once. The result is the same as calling CalcRxPower() for each
+     * destination in turn: models using random variables draw their values
+     * in the order of the destinations, from the streams set by
+     * AssignStreams().
+     *
+     * The output vectors are resized to the number of destinations, so that
+     * a caller computing the powers repeatedly can reuse them without
+     * allocating memory.
+     *
+     * @param txPowerDbm current transmission power (in dBm)
+     * @param a the mobility model of the source
+     * @param b the mobility models of the destinations
+     * @param [out] rxPowerDbm the reception power at each destination (in dBm)
+     * @param [out] distances the distance between the source and each destination (in m)
+     */
+    void CalcRxPowers(double txPowerDbm,
+                      Ptr<MobilityModel> a,
+                      const std::vector<Ptr<MobilityModel>>& b,
+                      std::vector<double>& rxPowerDbm,
+                      std::vector<double>& distances) const;
+
+    /**
+     * Returns an upper bound on the Rx Power that any receiver located at
+     * the given distance, or further away, can observe, taking into account
+     * all the PropagationLossModel(s) chained to the current one.
+     *
+     * The returned value is non-increasing with the distance and can be used
+     * to derive a conservative maximum range (e.g., to skip receivers that
+     * cannot possibly sense a signal). If any model in the chain cannot
+     * provide a finite bound (e.g., because it uses random variables with
+     * unbounded support), positive infinity is returned.
+     *
+     * @param txPowerDbm current transmission power (in dBm)
+     * @param distance the distance between the source and the destination (in m)
+     * @returns an upper bound on the reception power (in dBm)
+     */
+    double GetRxPowerUpperBound(double txPowerDbm, double distance) const;
+
     /**
      * If this loss model uses objects of type RandomVariableStream,
      * set the stream numbers to the integers starting with the offset
@@ -128,6 +173,36 @@ class PropagationLossModel : public Object
                                  Ptr<MobilityModel> a,
                                  Ptr<MobilityModel> b) const = 0;
 
+    /**
+     * Subclasses whose loss is a non-decreasing function of the distance can
+     * override this method to provide an upper bound on the Rx Power at the
+     * given distance or further away. The default implementation returns
+     * positive infinity, i.e., no bound is known.
+     *
+     * @param txPowerDbm current transmission power (in dBm)
+     * @param distance the distance between the source and the destination (in m)
+     * @returns an upper bound on the reception power (in dBm)
+     */
+    virtual double DoGetRxPowerUpperBound(double txPowerDbm, double distance) const;
+
+    /**
+     * Apply the loss of this model to the power received at each destination.
+     *
+     * The default implementation calls DoCalcRxPower() for each destination.
+     * Subclasses can override this method to process all the destinations at
+     * once, provided that the results are identical.
+     *
+     * @param a the mobility model of the source
+     * @param b the mobility models of the destinations
+     * @param distances the distance between the source and each destination (in m)
+     * @param [in,out] rxPowerDbm the power at each destination (in dBm), before and after
+     *                 applying the loss
+     */
+    virtual void DoCalcRxPowers(Ptr<MobilityModel> a,
+                                const std::vector<Ptr<MobilityModel>>& b,
+                                const std::vector<double>& distances,
+                                std::vector<double>& rxPowerDbm) const;
+
     Ptr<PropagationLossModel> m_next; //!< Next propagation loss model in the list
 };
 
@@ -294,6 +369,13 @@ class FriisPropagationLossModel : public PropagationLossModel
     double DoCalcRxPower(double txPowerDbm,
                          Ptr<MobilityModel> a,
                          Ptr<MobilityModel> b) const override;
+
+    void DoCalcRxPowers(Ptr<MobilityModel> a,
+                        const std::vector<Ptr<MobilityModel>>& b,
+                        const std::vector<double>& distances,
+                        std::vector<double>& rxPowerDbm) const override;
+
+    double DoGetRxPowerUpperBound(double txPowerDbm, double distance) const override;
     int64_t DoAssignStreams(int64_t stream) override;
 
     /**
@@ -485,6 +567,13 @@ class LogDistancePropagationLossModel : public PropagationLossModel
                          Ptr<MobilityModel> a,
                          Ptr<MobilityModel> b) const override;
 
+    void DoCalcRxPowers(Ptr<MobilityModel> a,
+                        const std::vector<Ptr<MobilityModel>>& b,
+                        const std::vector<double>& distances,
+                        std::vector<double>& rxPowerDbm) const override;
+
+    double DoGetRxPowerUpperBound(double txPowerDbm, double distance) const override;
+
     int64_t DoAssignStreams(int64_t stream) override;
 
     /**
@@ -561,6 +650,13 @@ class ThreeLogDistancePropagationLossModel : public PropagationLossModel
                          Ptr<MobilityModel> a,
                          Ptr<MobilityModel> b) const override;
 
+    void DoCalcRxPowers(Ptr<MobilityModel> a,
+                        const std::vector<Ptr<MobilityModel>>& b,
+                        const std::vector<double>& distances,
+                        std::vector<double>& rxPowerDbm) const override;
+
+    double DoGetRxPowerUpperBound(double txPowerDbm, double distance) const override;
+
     int64_t DoAssignStreams(int64_t stream) override;
 
     double m_distance0; //!< Beginning of the first (near) distance field
@@ -624,6 +720,11 @@ class NakagamiPropagationLossModel : public PropagationLossModel
                          Ptr<MobilityModel> a,
                          Ptr<MobilityModel> b) const override;
 
+    void DoCalcRxPowers(Ptr<MobilityModel> a,
+                        const std::vector<Ptr<MobilityModel>>& b,
+                        const std::vector<double>& distances,
+                        std::vector<double>& rxPowerDbm) const override;
+
     int64_t DoAssignStreams(int64_t stream) override;
 
     double m_distance1; //!< Distance1
@@ -677,6 +778,7 @@ class FixedRssLossModel : public PropagationLossModel
     double DoCalcRxPower(double txPowerDbm,
                          Ptr<MobilityModel> a,
                          Ptr<MobilityModel> b) const override;
+    double DoGetRxPowerUpperBound(double txPowerDbm, double distance) const override;
 
     int64_t DoAssignStreams(int64_t stream) override;
 
@@ -767,6 +869,13 @@ class RangePropagationLossModel : public PropagationLossModel
                          Ptr<MobilityModel> a,
                          Ptr<MobilityModel> b) const override;
 
+    void DoCalcRxPowers(Ptr<MobilityModel> a,
+                        const std::vector<Ptr<MobilityModel>>& b,
+                        const std::vector<double>& distances,
+                        std::vector<double>& rxPowerDbm) const override;
+
+    double DoGetRxPowerUpperBound(double txPowerDbm, double distance) const override;
+
     int64_t DoAssignStreams(int64_t stream) override;
 
     double m_range; //!< Maximum Transmission Range (meters)
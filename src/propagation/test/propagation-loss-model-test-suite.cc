@@ -14,6 +14,9 @@
 #include "ns3/simulator.h"
 #include "ns3/test.h"
 
+#include <cmath>
+#include <vector>
+
 using namespace ns3;
 
 NS_LOG_COMPONENT_DEFINE("PropagationLossModelsTest");
@@ -481,6 +484,166 @@ RangePropagationLossModelTestCase::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @ingroup propagation-tests
+ *
+ * @brief PropagationLossModel Rx Power Upper Bound Test
+ *
+ * Checks that the upper bound on the Rx power of a chain of deterministic
+ * loss models matches the actual Rx power and does not increase with the
+ * distance, and that it is infinite when the chain includes a fading model.
+ */
+class RxPowerUpperBoundTestCase : public TestCase
+{
+  public:
+    RxPowerUpperBoundTestCase();
+    ~RxPowerUpperBoundTestCase() override;
+
+  private:
+    void DoRun() override;
+};
+
+RxPowerUpperBoundTestCase::RxPowerUpperBoundTestCase()
+    : TestCase("Test PropagationLossModel Rx power upper bound")
+{
+}
+
+RxPowerUpperBoundTestCase::~RxPowerUpperBoundTestCase()
+{
+}
+
+void
+RxPowerUpperBoundTestCase::DoRun()
+{
+    Ptr<MobilityModel> a = CreateObject<ConstantPositionMobilityModel>();
+    a->SetPosition(Vector(0, 0, 0));
+    Ptr<MobilityModel> b = CreateObject<ConstantPositionMobilityModel>();
+
+    Ptr<LogDistancePropagationLossModel> logDistance =
+        CreateObject<LogDistancePropagationLossModel>();
+    Ptr<FriisPropagationLossModel> friis = CreateObject<FriisPropagationLossModel>();
+    Ptr<RangePropagationLossModel> range = CreateObject<RangePropagationLossModel>();
+    range->SetAttribute("MaxRange", DoubleValue(300));
+    logDistance->SetNext(friis);
+    friis->SetNext(range);
+
+    double txPwrdBm = 20.0;
+    double previous = logDistance->GetRxPowerUpperBound(txPwrdBm, 0);
+    for (double distance = 0.5; distance < 1000; distance *= 1.5)
+    {
+        b->SetPosition(Vector(distance, 0, 0));
+        double rxPwrdBm = logDistance->CalcRxPower(txPwrdBm, a, b);
+        double bound = logDistance->GetRxPowerUpperBound(txPwrdBm, distance);
+        NS_TEST_EXPECT_MSG_EQ_TOL(bound, rxPwrdBm, 1e-9, "Bound differs for deterministic models");
+        NS_TEST_EXPECT_MSG_LT_OR_EQ(bound, previous, "Bound increases with the distance");
+        previous = bound;
+    }
+
+    range->SetNext(CreateObject<NakagamiPropagationLossModel>());
+    NS_TEST_EXPECT_MSG_EQ(std::isinf(logDistance->GetRxPowerUpperBound(txPwrdBm, 100)),
+                          true,
+                          "Bound should be infinite with a fading model");
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup propagation-tests
+ *
+ * @brief PropagationLossModel Batch Rx Power Test
+ *
+ * Checks that computing the Rx power at many destinations at once gives the
+ * same results as computing it for each destination in turn, including with
+ * fading models using the same random variable streams and models without
+ * a batch implementation.
+ */
+class BatchRxPowerTestCase : public TestCase
+{
+  public:
+    BatchRxPowerTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Create a chain of loss models
+     * @param deterministic whether the chain starts with Friis and two ray ground models,
+     *        otherwise it starts with three log distance and range models
+     * @returns the first model of the chain
+     */
+    Ptr<PropagationLossModel> CreateChain(bool deterministic) const;
+};
+
+BatchRxPowerTestCase::BatchRxPowerTestCase()
+    : TestCase("Test PropagationLossModel batch Rx power computation")
+{
+}
+
+Ptr<PropagationLossModel>
+BatchRxPowerTestCase::CreateChain(bool deterministic) const
+{
+    auto nakagami = CreateObject<NakagamiPropagationLossModel>();
+    Ptr<PropagationLossModel> first;
+    if (deterministic)
+    {
+        first = CreateObject<FriisPropagationLossModel>();
+        auto twoRay = CreateObject<TwoRayGroundPropagationLossModel>();
+        first->SetNext(twoRay);
+        auto logDistance = CreateObject<LogDistancePropagationLossModel>();
+        twoRay->SetNext(logDistance);
+        logDistance->SetNext(nakagami);
+        nakagami->SetAttribute("m0", DoubleValue(2));
+    }
+    else
+    {
+        first = CreateObject<ThreeLogDistancePropagationLossModel>();
+        auto range = CreateObject<RangePropagationLossModel>();
+        range->SetAttribute("MaxRange", DoubleValue(400));
+        first->SetNext(range);
+        range->SetNext(nakagami);
+        // non-integer m values use the gamma distribution
+        nakagami->SetAttribute("m0", DoubleValue(1.5));
+        nakagami->SetAttribute("m1", DoubleValue(0.75));
+    }
+    first->AssignStreams(1);
+    return first;
+}
+
+void
+BatchRxPowerTestCase::DoRun()
+{
+    Ptr<MobilityModel> a = CreateObject<ConstantPositionMobilityModel>();
+    a->SetPosition(Vector(0, 0, 1.5));
+    std::vector<Ptr<MobilityModel>> b;
+    for (uint32_t i = 0; i < 100; ++i)
+    {
+        Ptr<MobilityModel> mobility = CreateObject<ConstantPositionMobilityModel>();
+        mobility->SetPosition(Vector(5.5 * i, (i % 7) * 3.0, 1.5));
+        b.push_back(mobility);
+    }
+
+    for (bool deterministic : {true, false})
+    {
+        auto scalar = CreateChain(deterministic);
+        auto batch = CreateChain(deterministic);
+        std::vector<double> rxPowerDbm;
+        std::vector<double> distances;
+        for (uint32_t round = 0; round < 3; ++round)
+        {
+            batch->CalcRxPowers(16.0, a, b, rxPowerDbm, distances);
+            NS_TEST_ASSERT_MSG_EQ(rxPowerDbm.size(), b.size(), "Unexpected number of results");
+            NS_TEST_ASSERT_MSG_EQ(distances.size(), b.size(), "Unexpected number of distances");
+            for (std::size_t i = 0; i < b.size(); ++i)
+            {
+                NS_TEST_EXPECT_MSG_EQ(rxPowerDbm[i],
+                                      scalar->CalcRxPower(16.0, a, b[i]),
+                                      "Batch and per-destination Rx power differ for destination "
+                                          << i);
+            }
+        }
+    }
+    Simulator::Destroy();
+}
+
 /**
  * @ingroup propagation-tests
  *
@@ -492,6 +655,8 @@ RangePropagationLossModelTestCase::DoRun()
  *   - LogDistancePropagationLossModel
  *   - MatrixPropagationLossModel
  *   - RangePropagationLossModel
+ *   - the Rx power upper bound of a chain of loss models
+ *   - the batch Rx power computation of a chain of loss models
  */
 class PropagationLossModelsTestSuite : public TestSuite
 {
@@ -507,6 +672,8 @@ PropagationLossModelsTestSuite::PropagationLossModelsTestSuite()
     AddTestCase(new LogDistancePropagationLossModelTestCase, TestCase::Duration::QUICK);
     AddTestCase(new MatrixPropagationLossModelTestCase, TestCase::Duration::QUICK);
     AddTestCase(new RangePropagationLossModelTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new RxPowerUpperBoundTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new BatchRxPowerTestCase, TestCase::Duration::QUICK);
 }
 
 /// Static variable for test initialization
@@ -355,6 +355,189 @@ class SpectrumValue : public SimpleRefCount<SpectrumValue>
      */
     friend SpectrumValue operator-(const SpectrumValue& rhs);
 
+    /**
+     * @name Operators on temporaries
+     *
+     * These overloads compute the result in the storage of an operand which
+     * is a temporary, e.g., the result of another operation, instead of
+     * allocating a new SpectrumValue: <tt>a * b + c</tt> allocates a single
+     * SpectrumValue.
+     * @{
+     */
+
+    /**
+     * addition operator
+     *
+     * @param lhs Left Hand Side of the operator
+     * @param rhs Right Hand Side of the operator
+     *
+     * @return the value of lhs + rhs
+     */
+    friend SpectrumValue operator+(SpectrumValue&& lhs, const SpectrumValue& rhs);
+
+    /**
+     * addition operator
+     *
+     * @param lhs Left Hand Side of the operator
+     * @param rhs Right Hand Side of the operator
+     *
+     * @return the value of lhs + rhs
+     */
+    friend SpectrumValue operator+(const SpectrumValue& lhs, SpectrumValue&& rhs);
+
+    /**
+     * addition operator
+     *
+     * @param lhs Left Hand Side of the operator
+     * @param rhs Right Hand Side of the operator
+     *
+     * @return the value of lhs + rhs
+     */
+    friend SpectrumValue operator+(SpectrumValue&& lhs, SpectrumValue&& rhs);
+
+    /**
+     * addition operator
+     *
+     * @param lhs Left Hand Side of the operator
+     * @param rhs Right Hand Side of the operator
+     *
+     * @return the value of lhs + rhs
+     */
+    friend SpectrumValue operator+(SpectrumValue&& lhs, double rhs);
+
+    /**
+     * addition operator
+     *
+     * @param lhs Left Hand Side of the operator
+     * @param rhs Right Hand Side of the operator
+     *
+     * @return the value of lhs + rhs
+     */
+    friend SpectrumValue operator+(double lhs, SpectrumValue&& rhs);
+
+    /**
+     * subtraction operator
+     *
+     * @param lhs Left Hand Side of the operator
+     * @param rhs Right Hand Side of the operator
+     *
+     * @return the value of lhs - rhs
+     */
+    friend SpectrumValue operator-(SpectrumValue&& lhs, const SpectrumValue& rhs);
+
+    /**
+     * subtraction operator
+     *
+     * @param lhs Left Hand Side of the operator
+     * @param rhs Right Hand Side of the operator
+     *
+     * @return the value of lhs - rhs
+     */
+    friend SpectrumValue operator-(SpectrumValue&& lhs, double rhs);
+
+    /**
+     * multiplication component-by-component (Schur product)
+     *
+     * @param lhs Left Hand Side of the operator
+     * @param rhs Right Hand Side of the operator
+     *
+     * @return the value of lhs * rhs
+     */
+    friend SpectrumValue operator*(SpectrumValue&& lhs, const SpectrumValue& rhs);
+
+    /**
+     * multiplication component-by-component (Schur product)
+     *
+     * @param lhs Left Hand Side of the operator
+     * @param rhs Right Hand Side of the operator
+     *
+     * @return the value of lhs * rhs
+     */
+    friend SpectrumValue operator*(const SpectrumValue& lhs, SpectrumValue&& rhs);
+
+    /**
+     * multiplication component-by-component (Schur product)
+     *
+     * @param lhs Left Hand Side of the operator
+     * @param rhs Right Hand Side of the operator
+     *
+     * @return the value of lhs * rhs
+     */
+    friend SpectrumValue operator*(SpectrumValue&& lhs, SpectrumValue&& rhs);
+
+    /**
+     * multiplication component-by-component (Schur product)
+     *
+     * @param lhs Left Hand Side of the operator
+     * @param rhs Right Hand Side of the operator
+     *
+     * @return the value of lhs * rhs
+     */
+    friend SpectrumValue operator*(SpectrumValue&& lhs, double rhs);
+
+    /**
+     * multiplication component-by-component (Schur product)
+     *
+     * @param lhs Left Hand Side of the operator
+     * @param rhs Right Hand Side of the operator
+     *
+     * @return the value of lhs * rhs
+     */
+    friend SpectrumValue operator*(double lhs, SpectrumValue&& rhs);
+
+    /**
+     * division component-by-component
+     *
+     * @param lhs Left Hand Side of the operator
+     * @param rhs Right Hand Side of the operator
+     *
+     * @return the value of lhs / rhs
+     */
+    friend SpectrumValue operator/(SpectrumValue&& lhs, const SpectrumValue& rhs);
+
+    /**
+     * division component-by-component
+     *
+     * @param lhs Left Hand Side of the operator
+     * @param rhs Right Hand Side of the operator
+     *
+     * @return the value of lhs / rhs
+     */
+    friend SpectrumValue operator/(SpectrumValue&& lhs, double rhs);
+
+    /**
+     * unary minus operator
+     *
+     * @param rhs Right Hand Side of the operator
+     * @return the value of - rhs
+     */
+    friend SpectrumValue operator-(SpectrumValue&& rhs);
+
+    /**
+     * @param lhs the base
+     * @param rhs the exponent
+     *
+     * @return each value in base raised to the exponent
+     */
+    friend SpectrumValue Pow(SpectrumValue&& lhs, double rhs);
+
+    /**
+     * @param lhs the base
+     * @param rhs the exponent
+     *
+     * @return the value in base raised to each value in the exponent
+     */
+    friend SpectrumValue Pow(double lhs, SpectrumValue&& rhs);
+
+    /**
+     * @param arg the argument
+     *
+     * @return the logarithm in base 10 of all values in the argument
+     */
+    friend SpectrumValue Log10(SpectrumValue&& arg);
+
+    /**@}*/
+
     /**
      * left shift operator
      *
@@ -661,7 +844,10 @@ double Sum(const SpectrumValue& x);
 double Prod(const SpectrumValue& x);
 SpectrumValue Pow(const SpectrumValue& lhs, double rhs);
 SpectrumValue Pow(double lhs, const SpectrumValue& rhs);
+SpectrumValue Pow(SpectrumValue&& lhs, double rhs);
+SpectrumValue Pow(double lhs, SpectrumValue&& rhs);
 SpectrumValue Log10(const SpectrumValue& arg);
+SpectrumValue Log10(SpectrumValue&& arg);
 SpectrumValue Log2(const SpectrumValue& arg);
 SpectrumValue Log(const SpectrumValue& arg);
 double Integral(const SpectrumValue& arg);
@@ -81,6 +81,62 @@ SpectrumValueTestCase::DoRun()
     NS_TEST_ASSERT_MSG_SPECTRUM_VALUE_EQ_TOL(m_a, m_b, TOLERANCE, "");
 }
 
+/**
+ * @ingroup spectrum-tests
+ *
+ * @brief Check Sum, Norm and Integral against a sequential computation, with
+ * numbers of bands which are not a multiple of the number of partial sums.
+ */
+class SpectrumValueReductionTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     * @param nBands the number of bands
+     */
+    SpectrumValueReductionTestCase(uint32_t nBands);
+    void DoRun() override;
+
+  private:
+    uint32_t m_nBands; //!< the number of bands
+};
+
+SpectrumValueReductionTestCase::SpectrumValueReductionTestCase(uint32_t nBands)
+    : TestCase("Check the reductions with " + std::to_string(nBands) + " bands"),
+      m_nBands(nBands)
+{
+}
+
+void
+SpectrumValueReductionTestCase::DoRun()
+{
+    Bands bands;
+    for (uint32_t i = 0; i < m_nBands; i++)
+    {
+        // bands of different widths
+        BandInfo band;
+        band.fl = i * 10.0;
+        band.fh = band.fl + 1.0 + i % 3;
+        band.fc = (band.fl + band.fh) / 2;
+        bands.push_back(band);
+    }
+    Ptr<SpectrumModel> f = Create<SpectrumModel>(bands);
+    SpectrumValue v(f);
+    double sum = 0;
+    double squares = 0;
+    double integral = 0;
+    for (uint32_t i = 0; i < m_nBands; i++)
+    {
+        v[i] = std::sin(i + 1.0);
+        sum += v[i];
+        squares += v[i] * v[i];
+        integral += v[i] * (bands[i].fh - bands[i].fl);
+    }
+    NS_TEST_ASSERT_MSG_EQ_TOL(Sum(v), sum, TOLERANCE, "Wrong sum");
+    NS_TEST_ASSERT_MSG_EQ_TOL(Norm(v), std::sqrt(squares), TOLERANCE, "Wrong norm");
+    NS_TEST_ASSERT_MSG_EQ_TOL(Integral(v), integral, TOLERANCE, "Wrong integral");
+}
+
 /**
  * @ingroup spectrum-tests
  *
@@ -264,6 +320,47 @@ SpectrumValueTestSuite::SpectrumValueTestSuite()
     tv1rs3 = v1 >> 3;
     AddTestCase(new SpectrumValueTestCase(tv1rs3, v1rs3, "tv1rs3 = v1 >> 3"),
                 TestCase::Duration::QUICK);
+
+    // the operators computing the result in the storage of a temporary operand
+    AddTestCase(new SpectrumValueTestCase((v1 + 0.0) + v2, v3, "(v1 + 0) + v2"),
+                TestCase::Duration::QUICK);
+    AddTestCase(new SpectrumValueTestCase(v1 + (v2 + 0.0), v3, "v1 + (v2 + 0)"),
+                TestCase::Duration::QUICK);
+    AddTestCase(new SpectrumValueTestCase((v1 + 0.0) + (v2 + 0.0), v3, "(v1 + 0) + (v2 + 0)"),
+                TestCase::Duration::QUICK);
+    AddTestCase(new SpectrumValueTestCase((v1 + 0.0) - v2, v4, "(v1 + 0) - v2"),
+                TestCase::Duration::QUICK);
+    AddTestCase(new SpectrumValueTestCase((v1 * 1.0) * v2, v5, "(v1 * 1) * v2"),
+                TestCase::Duration::QUICK);
+    AddTestCase(new SpectrumValueTestCase(v1 * (v2 * 1.0), v5, "v1 * (v2 * 1)"),
+                TestCase::Duration::QUICK);
+    AddTestCase(new SpectrumValueTestCase((v1 * 1.0) * (v2 * 1.0), v5, "(v1 * 1) * (v2 * 1)"),
+                TestCase::Duration::QUICK);
+    AddTestCase(new SpectrumValueTestCase((v1 * 1.0) / v2, v6, "(v1 * 1) div v2"),
+                TestCase::Duration::QUICK);
+    AddTestCase(new SpectrumValueTestCase((v1 * 1.0) + doubleValue, v7, "(v1 * 1) + doubleValue"),
+                TestCase::Duration::QUICK);
+    AddTestCase(new SpectrumValueTestCase(doubleValue + (v1 * 1.0), v7, "doubleValue + (v1 * 1)"),
+                TestCase::Duration::QUICK);
+    AddTestCase(new SpectrumValueTestCase((v1 * 1.0) - doubleValue, v8, "(v1 * 1) - doubleValue"),
+                TestCase::Duration::QUICK);
+    AddTestCase(new SpectrumValueTestCase((v1 + 0.0) * doubleValue, v9, "(v1 + 0) * doubleValue"),
+                TestCase::Duration::QUICK);
+    AddTestCase(new SpectrumValueTestCase(doubleValue * (v1 + 0.0), v9, "doubleValue * (v1 + 0)"),
+                TestCase::Duration::QUICK);
+    AddTestCase(
+        new SpectrumValueTestCase((v1 + 0.0) / doubleValue, v10, "(v1 + 0) div doubleValue"),
+        TestCase::Duration::QUICK);
+    AddTestCase(new SpectrumValueTestCase(-(v2 - v1), v4, "-(v2 - v1)"), TestCase::Duration::QUICK);
+    AddTestCase(new SpectrumValueTestCase(Log10(Pow(10.0, v1 * 1.0)), v1, "Log10(Pow(10, v1 * 1))"),
+                TestCase::Duration::QUICK);
+    AddTestCase(new SpectrumValueTestCase(Pow(v2 * 1.0, 1.0), v2, "Pow(v2 * 1, 1)"),
+                TestCase::Duration::QUICK);
+
+    for (uint32_t nBands : {1, 7, 8, 9, 100})
+    {
+        AddTestCase(new SpectrumValueReductionTestCase(nBands), TestCase::Duration::QUICK);
+    }
 }
 
 /**
@@ -62,19 +62,7 @@ ErrorRateModel::GetChunkSuccessRate(WifiMode mode,
     if (mode.GetModulationClass() == WIFI_MOD_CLASS_DSSS ||
         mode.GetModulationClass() == WIFI_MOD_CLASS_HR_DSSS)
     {
-        switch (mode.GetDataRate(MHz_u{22}))
-        {
-        case 1000000:
-            return DsssErrorRateModel::GetDsssDbpskSuccessRate(snr, nbits);
-        case 2000000:
-            return DsssErrorRateModel::GetDsssDqpskSuccessRate(snr, nbits);
-        case 5500000:
-            return DsssErrorRateModel::GetDsssDqpskCck5_5SuccessRate(snr, nbits);
-        case 11000000:
-            return DsssErrorRateModel::GetDsssDqpskCck11SuccessRate(snr, nbits);
-        default:
-            NS_ASSERT("undefined DSSS/HR-DSSS datarate");
-        }
+        return DoGetDsssChunkSuccessRate(mode, snr, nbits);
     }
     else
     {
@@ -83,6 +71,25 @@ ErrorRateModel::GetChunkSuccessRate(WifiMode mode,
     return 0;
 }
 
+double
+ErrorRateModel::DoGetDsssChunkSuccessRate(WifiMode mode, double snr, uint64_t nbits) const
+{
+    switch (mode.GetDataRate(MHz_u{22}))
+    {
+    case 1000000:
+        return DsssErrorRateModel::GetDsssDbpskSuccessRate(snr, nbits);
+    case 2000000:
+        return DsssErrorRateModel::GetDsssDqpskSuccessRate(snr, nbits);
+    case 5500000:
+        return DsssErrorRateModel::GetDsssDqpskCck5_5SuccessRate(snr, nbits);
+    case 11000000:
+        return DsssErrorRateModel::GetDsssDqpskCck11SuccessRate(snr, nbits);
+    default:
+        NS_ASSERT("undefined DSSS/HR-DSSS datarate");
+    }
+    return 0;
+}
+
 bool
 ErrorRateModel::IsAwgn() const
 {
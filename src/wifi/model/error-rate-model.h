@@ -59,7 +59,8 @@ class ErrorRateModel : public Object
      * to calculate the chunk error rate, and the txVector is used for
      * other information as needed.
      *
-     * This method handles 802.11b rates by using the DSSS error rate model.
+     * This method handles 802.11b rates by calling DoGetDsssChunkSuccessRate(),
+     * which uses the DSSS error rate model unless overridden by the subclass.
      * For all other rates, the method implemented by the subclass is called.
      *
      * @param mode the Wi-Fi mode applicable to this chunk
@@ -91,6 +92,19 @@ class ErrorRateModel : public Object
      */
     virtual int64_t AssignStreams(int64_t stream);
 
+  protected:
+    /**
+     * Return the probability that a chunk sent with a DSSS or HR/DSSS mode
+     * is successfully received, computed by the DsssErrorRateModel.
+     *
+     * @param mode the DSSS or HR/DSSS mode applicable to this chunk
+     * @param snr the SNR of the chunk
+     * @param nbits the number of bits in this chunk
+     *
+     * @return probability of successfully receiving the chunk
+     */
+    virtual double DoGetDsssChunkSuccessRate(WifiMode mode, double snr, uint64_t nbits) const;
+
   private:
     /**
      * A pure virtual method that must be implemented in the subclass.
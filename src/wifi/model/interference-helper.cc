@@ -23,6 +23,7 @@
 
 #include <algorithm>
 #include <numeric>
+#include <utility>
 
 namespace ns3
 {
@@ -153,6 +154,66 @@ InterferenceHelper::NiChange::GetEvent() const
     return m_event;
 }
 
+/****************************************************************
+ *       The NiChanges of a band
+ ****************************************************************/
+
+InterferenceHelper::NiChanges::const_iterator
+InterferenceHelper::NiChanges::upper_bound(Time moment) const
+{
+    return std::upper_bound(m_changes.cbegin(),
+                            m_changes.cend(),
+                            moment,
+                            [](Time t, const value_type& change) { return t < change.first; });
+}
+
+InterferenceHelper::NiChanges::iterator
+InterferenceHelper::NiChanges::upper_bound(Time moment)
+{
+    return m_changes.begin() + (std::as_const(*this).upper_bound(moment) - m_changes.cbegin());
+}
+
+InterferenceHelper::NiChanges::const_iterator
+InterferenceHelper::NiChanges::find(Time moment) const
+{
+    auto it = std::lower_bound(m_changes.cbegin(),
+                               m_changes.cend(),
+                               moment,
+                               [](const value_type& change, Time t) { return change.first < t; });
+    return (it != m_changes.cend() && it->first == moment) ? it : m_changes.cend();
+}
+
+InterferenceHelper::NiChanges::iterator
+InterferenceHelper::NiChanges::find(Time moment)
+{
+    return m_changes.begin() + (std::as_const(*this).find(moment) - m_changes.cbegin());
+}
+
+InterferenceHelper::NiChanges::iterator
+InterferenceHelper::NiChanges::insert(const value_type& change)
+{
+    return m_changes.insert(upper_bound(change.first), change);
+}
+
+InterferenceHelper::NiChanges::iterator
+InterferenceHelper::NiChanges::insert(iterator position, const value_type& change)
+{
+    NS_ASSERT(position == upper_bound(change.first));
+    return m_changes.insert(position, change);
+}
+
+InterferenceHelper::NiChanges::iterator
+InterferenceHelper::NiChanges::emplace(Time moment, NiChange change)
+{
+    return m_changes.emplace(upper_bound(moment), moment, std::move(change));
+}
+
+InterferenceHelper::NiChanges::iterator
+InterferenceHelper::NiChanges::erase(iterator first, iterator last)
+{
+    return m_changes.erase(first, last);
+}
+
 /****************************************************************
  *       The actual InterferenceHelper
  ****************************************************************/
@@ -368,10 +429,13 @@ InterferenceHelper::AppendEvent(Ptr<Event> event,
             // HE TB PPDU transmission and the start of HE TB payload.
             m_firstPowers.find(band)->second = previousPowerStart;
         }
-        auto first =
+        // inserting the end change does not move the changes up to the start change, which
+        // is however located by its index since the iterators to it are invalidated
+        const auto start =
             AddNiChangeEvent(event->GetStartTime(), NiChange(previousPowerStart, event), niIt);
+        const auto first = start - niIt->second.begin();
         auto last = AddNiChangeEvent(event->GetEndTime(), NiChange(previousPowerEnd, event), niIt);
-        for (auto i = first; i != last; ++i)
+        for (auto i = niIt->second.begin() + first; i != last; ++i)
         {
             i->second.AddPower(power);
         }
@@ -649,8 +713,8 @@ InterferenceHelper::CalculatePhyHeaderSectionPsr(Ptr<const Event> event,
 {
     NS_LOG_FUNCTION(this << band);
     double psr = 1.0; /* Packet Success Rate */
-    auto niIt = nis->find(band)->second;
-    auto j = niIt.begin();
+    const auto& niIt = nis->find(band)->second;
+    auto j = niIt.cbegin();
 
     NS_ASSERT(!phyHeaderSections.empty());
     Time stopLastSection;
@@ -663,7 +727,7 @@ InterferenceHelper::CalculatePhyHeaderSectionPsr(Ptr<const Event> event,
     NS_ABORT_IF(!m_firstPowers.contains(band));
     auto noiseInterference = m_firstPowers.at(band);
     const auto power = event->GetRxPower(band);
-    while (++j != niIt.end())
+    while (++j != niIt.cend())
     {
         auto current = j->first;
         NS_LOG_DEBUG("previous= " << previous << ", current=" << current);
@@ -711,13 +775,13 @@ InterferenceHelper::CalculatePhyHeaderPer(Ptr<const Event> event,
                                           WifiPpduField header) const
 {
     NS_LOG_FUNCTION(this << band << header);
-    auto niIt = nis->find(band)->second;
+    const auto& niIt = nis->find(band)->second;
     auto phyEntity =
         WifiPhy::GetStaticPhyEntity(event->GetPpdu()->GetTxVector().GetModulationClass());
 
     PhyHeaderSections sections;
     for (const auto& section :
-         phyEntity->GetPhyHeaderSections(event->GetPpdu()->GetTxVector(), niIt.begin()->first))
+         phyEntity->GetPhyHeaderSections(event->GetPpdu()->GetTxVector(), niIt.cbegin()->first))
     {
         if (section.first == header)
         {
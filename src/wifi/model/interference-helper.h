@@ -16,6 +16,7 @@
 #include "ns3/object.h"
 
 #include <map>
+#include <vector>
 
 namespace ns3
 {
@@ -400,9 +401,136 @@ class InterferenceHelper : public Object
     };
 
     /**
-     * typedef for a multimap of NiChange
+     * The NiChanges of a band, sorted by time.
+     *
+     * The changes are stored in a sorted vector, whose contiguous storage is
+     * cheaper to walk and to update than the nodes of a std::multimap. It
+     * provides the subset of the std::multimap<Time, NiChange> interface used
+     * by this class, with the same semantics: a change is inserted after the
+     * changes at the same time, and find() returns the first change at a
+     * given time. Unlike with a std::multimap, inserting or erasing changes
+     * invalidates the iterators to the subsequent changes.
      */
-    using NiChanges = std::multimap<Time, NiChange>;
+    class NiChanges
+    {
+      public:
+        /// the type of the elements: the time of a change and the change
+        using value_type = std::pair<Time, NiChange>;
+        /// the iterator type
+        using iterator = std::vector<value_type>::iterator;
+        /// the const iterator type
+        using const_iterator = std::vector<value_type>::const_iterator;
+
+        /// @return an iterator to the first change
+        iterator begin()
+        {
+            return m_changes.begin();
+        }
+
+        /// @return an iterator past the last change
+        iterator end()
+        {
+            return m_changes.end();
+        }
+
+        /// @return a const iterator to the first change
+        const_iterator begin() const
+        {
+            return m_changes.cbegin();
+        }
+
+        /// @return a const iterator past the last change
+        const_iterator end() const
+        {
+            return m_changes.cend();
+        }
+
+        /// @return a const iterator to the first change
+        const_iterator cbegin() const
+        {
+            return m_changes.cbegin();
+        }
+
+        /// @return a const iterator past the last change
+        const_iterator cend() const
+        {
+            return m_changes.cend();
+        }
+
+        /// @return the number of changes
+        std::size_t size() const
+        {
+            return m_changes.size();
+        }
+
+        /// @return true if there is no change
+        bool empty() const
+        {
+            return m_changes.empty();
+        }
+
+        /// Remove all the changes
+        void clear()
+        {
+            m_changes.clear();
+        }
+
+        /**
+         * @param moment the time
+         * @return an iterator to the first change later than the given time
+         */
+        iterator upper_bound(Time moment);
+        /**
+         * @param moment the time
+         * @return a const iterator to the first change later than the given time
+         */
+        const_iterator upper_bound(Time moment) const;
+        /**
+         * @param moment the time
+         * @return an iterator to the first change at the given time, or end()
+         */
+        iterator find(Time moment);
+        /**
+         * @param moment the time
+         * @return a const iterator to the first change at the given time, or end()
+         */
+        const_iterator find(Time moment) const;
+        /**
+         * Insert a change after the changes at the same time.
+         *
+         * @param change the time and the change
+         * @return an iterator to the inserted change
+         */
+        iterator insert(const value_type& change);
+        /**
+         * Insert a change at a given position, which must be upper_bound() of
+         * the time of the change.
+         *
+         * @param position the position
+         * @param change the time and the change
+         * @return an iterator to the inserted change
+         */
+        iterator insert(iterator position, const value_type& change);
+        /**
+         * Insert a change after the changes at the same time.
+         *
+         * @param moment the time of the change
+         * @param change the change
+         * @return an iterator to the inserted change
+         */
+        iterator emplace(Time moment, NiChange change);
+        /**
+         * Remove the changes of a range.
+         *
+         * @param first the first change to remove
+         * @param last the change following the last change to remove
+         * @return an iterator to the change following the removed ones
+         */
+        iterator erase(iterator first, iterator last);
+
+      private:
+        std::vector<value_type> m_changes; ///< the changes, sorted by time
+    };
 
     /**
      * Map of NiChanges per band
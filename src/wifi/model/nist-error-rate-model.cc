@@ -11,10 +11,20 @@
 
 #include "wifi-tx-vector.h"
 
+#include "ns3/boolean.h"
 #include "ns3/log.h"
+#include "ns3/string.h"
 
+#include <algorithm>
 #include <bitset>
 #include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <set>
 
 namespace ns3
 {
@@ -23,17 +33,197 @@ NS_LOG_COMPONENT_DEFINE("NistErrorRateModel");
 
 NS_OBJECT_ENSURE_REGISTERED(NistErrorRateModel);
 
+namespace
+{
+
+/// SNR of the first entry of the tables, in dB
+const double TABLE_MIN_SNR_DB = -25.0;
+/// SNR of the last entry of the tables, in dB
+const double TABLE_MAX_SNR_DB = 50.0;
+/// SNR step between the entries of the tables, in dB
+const double TABLE_SNR_STEP_DB = 0.01;
+/// Number of entries of a table
+const std::size_t TABLE_SIZE =
+    static_cast<std::size_t>((TABLE_MAX_SNR_DB - TABLE_MIN_SNR_DB) / TABLE_SNR_STEP_DB + 0.5) + 1;
+/// Lower bound of the table entries, for which the success rate rounds to 1
+const double TABLE_MIN_VALUE = -800.0;
+/// Flag of the keys of the tables of the DSSS and HR/DSSS rates
+const uint32_t TABLE_DSSS_KEY = 0x80000000;
+
+/// The tables shared by all the models
+struct TableStore
+{
+    std::mutex mutex;                               ///< protects the members below
+    std::map<uint32_t, std::vector<double>> tables; ///< the tables, by key
+    std::set<std::string> loadedFiles;              ///< the cache files already loaded
+};
+
+/**
+ * @return the tables shared by all the models
+ */
+TableStore&
+GetTableStore()
+{
+    static TableStore store;
+    return store;
+}
+
+/**
+ * Convert the probability that a bit is successfully received to a table entry.
+ *
+ * The entry is NaN if the probability is 1/2 or less: at such low SNRs, the
+ * analytic error rates saturate, or are discontinuous for the Matlab fits
+ * of the CCK error rates, so interpolating would be inaccurate.  The NaN
+ * makes the interpolated success rate NaN, so that the analytic expressions
+ * are used instead.
+ *
+ * @param ps the probability that a bit is successfully received
+ * @return ln(-ln(ps)), or NaN if ps is 1/2 or less
+ */
+double
+ToTableValue(double ps)
+{
+    if (!(ps < 1.0))
+    {
+        return TABLE_MIN_VALUE;
+    }
+    if (ps <= 0.5)
+    {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    return std::max(std::log(-std::log(ps)), TABLE_MIN_VALUE);
+}
+
+/**
+ * Interpolate the success rate of a chunk from a table.
+ *
+ * @param table the table
+ * @param snr the SNR of the chunk (in linear scale)
+ * @param nbits the number of bits in the chunk
+ * @return the success rate of the chunk, or a negative value or NaN if the
+ *         SNR is outside of the table or next to a NaN entry
+ */
+double
+InterpolateChunkSuccessRate(const std::vector<double>& table, double snr, uint64_t nbits)
+{
+    const double x = (10.0 * std::log10(snr) - TABLE_MIN_SNR_DB) * (1.0 / TABLE_SNR_STEP_DB);
+    if (!(x >= 0.0 && x < TABLE_SIZE - 1))
+    {
+        return -1.0;
+    }
+    const auto i = static_cast<std::size_t>(x);
+    const double y = table[i] + (x - i) * (table[i + 1] - table[i]);
+    return std::exp(-static_cast<double>(nbits) * std::exp(y));
+}
+
+/**
+ * Load the tables of a cache file which are not in the store yet. The file
+ * is ignored if it does not exist or if it was saved with another grid.
+ *
+ * @param filename the name of the cache file
+ * @param store the store
+ * @return the number of tables of the file
+ */
+std::size_t
+LoadTables(const std::string& filename, TableStore& store)
+{
+    std::ifstream is(filename);
+    if (!is.is_open())
+    {
+        NS_LOG_INFO("No error rate table cache file " << filename);
+        return 0;
+    }
+    std::string tag;
+    double minSnr;
+    double maxSnr;
+    double step;
+    is >> tag >> minSnr >> maxSnr >> step;
+    if (!is || tag != "grid" || minSnr != TABLE_MIN_SNR_DB || maxSnr != TABLE_MAX_SNR_DB ||
+        step != TABLE_SNR_STEP_DB)
+    {
+        NS_LOG_WARN("Ignoring error rate table cache file " << filename
+                                                            << " saved with another grid");
+        return 0;
+    }
+    std::size_t count = 0;
+    uint32_t key;
+    std::size_t size;
+    while (is >> tag >> key >> size && tag == "table" && size == TABLE_SIZE)
+    {
+        // read the values as strings, since operator>> does not parse "nan"
+        std::vector<double> table(size);
+        std::string value;
+        for (std::size_t i = 0; i < size && is >> value; ++i)
+        {
+            table[i] = std::strtod(value.c_str(), nullptr);
+        }
+        if (!is)
+        {
+            break;
+        }
+        store.tables.emplace(key, std::move(table));
+        ++count;
+    }
+    NS_LOG_INFO("Loaded " << count << " error rate tables from " << filename);
+    return count;
+}
+
+/**
+ * Save all the tables of the store to a cache file.
+ *
+ * @param filename the name of the cache file
+ * @param store the store
+ */
+void
+SaveTables(const std::string& filename, const TableStore& store)
+{
+    std::ofstream os(filename);
+    if (!os.is_open())
+    {
+        NS_FATAL_ERROR("Cannot open error rate table cache file " << filename);
+    }
+    os.precision(17);
+    os << "grid " << TABLE_MIN_SNR_DB << " " << TABLE_MAX_SNR_DB << " " << TABLE_SNR_STEP_DB
+       << "\n";
+    for (const auto& [key, table] : store.tables)
+    {
+        os << "table " << key << " " << table.size();
+        for (auto value : table)
+        {
+            os << " " << value;
+        }
+        os << "\n";
+    }
+}
+
+} // namespace
+
 TypeId
 NistErrorRateModel::GetTypeId()
 {
     static TypeId tid = TypeId("ns3::NistErrorRateModel")
                             .SetParent<ErrorRateModel>()
                             .SetGroupName("Wifi")
-                            .AddConstructor<NistErrorRateModel>();
+                            .AddConstructor<NistErrorRateModel>()
+                            .AddAttribute("UseTables",
+                                          "If true, the chunk success rates are interpolated "
+                                          "from precomputed tables rather than computed from "
+                                          "the analytic expressions.",
+                                          BooleanValue(false),
+                                          MakeBooleanAccessor(&NistErrorRateModel::m_useTables),
+                                          MakeBooleanChecker())
+                            .AddAttribute("TableCacheFile",
+                                          "The file the tables used if UseTables is true are "
+                                          "loaded from, and saved to whenever a table is "
+                                          "computed. The tables are not saved if empty.",
+                                          StringValue(""),
+                                          MakeStringAccessor(&NistErrorRateModel::m_tableCacheFile),
+                                          MakeStringChecker());
     return tid;
 }
 
 NistErrorRateModel::NistErrorRateModel()
+    : m_useTables(false)
 {
 }
 
@@ -190,6 +380,81 @@ NistErrorRateModel::GetBValue(WifiCodeRate codeRate) const
     return 0;
 }
 
+const std::vector<double>&
+NistErrorRateModel::GetTable(WifiMode mode) const
+{
+    const uint32_t uid = mode.GetUid();
+    if (uid < m_tables.size() && m_tables[uid] != nullptr)
+    {
+        return *m_tables[uid];
+    }
+    NS_LOG_FUNCTION(this << mode);
+    uint32_t key;
+    std::function<double(double)> bitSuccessRate;
+    if (mode.GetModulationClass() == WIFI_MOD_CLASS_DSSS ||
+        mode.GetModulationClass() == WIFI_MOD_CLASS_HR_DSSS)
+    {
+        key = TABLE_DSSS_KEY | static_cast<uint32_t>(mode.GetDataRate(MHz_u{22}) / 100000);
+        bitSuccessRate = [this, mode](double snr) {
+            return ErrorRateModel::DoGetDsssChunkSuccessRate(mode, snr, 1);
+        };
+    }
+    else
+    {
+        key = (static_cast<uint32_t>(mode.GetConstellationSize()) << 8) |
+              GetBValue(mode.GetCodeRate());
+        bitSuccessRate = [this, mode](double snr) {
+            return GetOfdmChunkSuccessRate(mode, snr, 1);
+        };
+    }
+
+    TableStore& store = GetTableStore();
+    std::lock_guard lock(store.mutex);
+    if (!m_tableCacheFile.empty() && store.loadedFiles.insert(m_tableCacheFile).second &&
+        LoadTables(m_tableCacheFile, store) < store.tables.size())
+    {
+        // save the tables computed before this file was used
+        SaveTables(m_tableCacheFile, store);
+    }
+    auto it = store.tables.find(key);
+    if (it == store.tables.end())
+    {
+        NS_LOG_DEBUG("Computing the error rate table of " << mode);
+        std::vector<double> table(TABLE_SIZE);
+        for (std::size_t i = 0; i < TABLE_SIZE; ++i)
+        {
+            const double snr = std::pow(10.0, (TABLE_MIN_SNR_DB + i * TABLE_SNR_STEP_DB) / 10.0);
+            table[i] = ToTableValue(bitSuccessRate(snr));
+        }
+        it = store.tables.emplace(key, std::move(table)).first;
+        if (!m_tableCacheFile.empty())
+        {
+            SaveTables(m_tableCacheFile, store);
+        }
+    }
+    if (uid >= m_tables.size())
+    {
+        m_tables.resize(uid + 1, nullptr);
+    }
+    m_tables[uid] = &it->second;
+    return it->second;
+}
+
+double
+NistErrorRateModel::DoGetDsssChunkSuccessRate(WifiMode mode, double snr, uint64_t nbits) const
+{
+    NS_LOG_FUNCTION(this << mode << snr << nbits);
+    if (m_useTables)
+    {
+        const double ps = InterpolateChunkSuccessRate(GetTable(mode), snr, nbits);
+        if (ps >= 0.0)
+        {
+            return ps;
+        }
+    }
+    return ErrorRateModel::DoGetDsssChunkSuccessRate(mode, snr, nbits);
+}
+
 double
 NistErrorRateModel::DoGetChunkSuccessRate(WifiMode mode,
                                           const WifiTxVector& txVector,
@@ -200,6 +465,20 @@ NistErrorRateModel::DoGetChunkSuccessRate(WifiMode mode,
                                           uint16_t staId) const
 {
     NS_LOG_FUNCTION(this << mode << snr << nbits << +numRxAntennas << field << staId);
+    if (m_useTables && mode.GetModulationClass() >= WIFI_MOD_CLASS_ERP_OFDM)
+    {
+        const double ps = InterpolateChunkSuccessRate(GetTable(mode), snr, nbits);
+        if (ps >= 0.0)
+        {
+            return ps;
+        }
+    }
+    return GetOfdmChunkSuccessRate(mode, snr, nbits);
+}
+
+double
+NistErrorRateModel::GetOfdmChunkSuccessRate(WifiMode mode, double snr, uint64_t nbits) const
+{
     if (mode.GetModulationClass() >= WIFI_MOD_CLASS_ERP_OFDM)
     {
         if (mode.GetConstellationSize() == 2)
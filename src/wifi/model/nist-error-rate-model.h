@@ -12,6 +12,9 @@
 #include "error-rate-model.h"
 #include "wifi-mode.h"
 
+#include <string>
+#include <vector>
+
 namespace ns3
 {
 
@@ -22,6 +25,19 @@ namespace ns3
  * the model description and validation can be found in
  * http://www.nsnam.org/~pei/80211ofdm.pdf.  For DSSS modulations (802.11b),
  * the model uses the DsssErrorRateModel.
+ *
+ * If the UseTables attribute is set, the chunk success rates are
+ * interpolated from tables rather than computed from the analytic
+ * expressions.  A table is computed the first time a modulation and coding
+ * rate (or a DSSS rate) is used, and shared by all the models of the
+ * process: it holds ln(-ln(p)), where p is the probability that a bit is
+ * successfully received, for SNRs spaced by a fixed step in dB, so that the
+ * success rate of a chunk of n bits is exp(-n exp(y)), where y is linearly
+ * interpolated between two entries.  The analytic expressions are used for
+ * the SNRs outside of the tables, and for the low SNRs at which the bit
+ * error rate is 1/2 or more.  The tables can be saved to, and loaded
+ * from, the file set by the TableCacheFile attribute, so that they are not
+ * computed again by the next simulations.
  */
 class NistErrorRateModel : public ErrorRateModel
 {
@@ -35,6 +51,7 @@ class NistErrorRateModel : public ErrorRateModel
     NistErrorRateModel();
 
   private:
+    double DoGetDsssChunkSuccessRate(WifiMode mode, double snr, uint64_t nbits) const override;
     double DoGetChunkSuccessRate(WifiMode mode,
                                  const WifiTxVector& txVector,
                                  double snr,
@@ -42,6 +59,27 @@ class NistErrorRateModel : public ErrorRateModel
                                  uint8_t numRxAntennas,
                                  WifiPpduField field,
                                  uint16_t staId) const override;
+    /**
+     * Return the probability that a chunk sent with an OFDM mode is
+     * successfully received, computed by the analytic expressions.
+     *
+     * @param mode the Wi-Fi mode applicable to this chunk
+     * @param snr the SNR of the chunk
+     * @param nbits the number of bits in this chunk
+     *
+     * @return probability of successfully receiving the chunk
+     */
+    double GetOfdmChunkSuccessRate(WifiMode mode, double snr, uint64_t nbits) const;
+    /**
+     * Return the table of a mode, computing it or loading it from the cache
+     * file if needed.
+     *
+     * @param mode the Wi-Fi mode
+     *
+     * @return the table of ln(-ln(p)) for the SNRs of the grid, where p is
+     *         the probability that a bit is successfully received
+     */
+    const std::vector<double>& GetTable(WifiMode mode) const;
     /**
      * Return the bValue such that coding rate = bValue / (bValue + 1).
      *
@@ -117,6 +155,11 @@ class NistErrorRateModel : public ErrorRateModel
                         double snr,
                         uint64_t nbits,
                         uint8_t bValue) const;
+
+    bool m_useTables;             ///< whether to interpolate the success rates from tables
+    std::string m_tableCacheFile; ///< the file the tables are saved to and loaded from
+    /// the tables used by this model, indexed by mode UID, or nullptr if not used yet
+    mutable std::vector<const std::vector<double>*> m_tables;
 };
 
 } // namespace ns3
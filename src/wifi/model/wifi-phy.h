@@ -792,7 +792,7 @@ class WIFI_EXPORT WifiPhy : public Object
      *
      * @param threshold the receive sensitivity threshold
      */
-    void SetRxSensitivity(dBm_u threshold);
+    virtual void SetRxSensitivity(dBm_u threshold);
     /**
      * Return the receive sensitivity threshold.
      *
@@ -886,7 +886,7 @@ class WIFI_EXPORT WifiPhy : public Object
      *
      * @param gain the reception gain
      */
-    void SetRxGain(dB_u gain);
+    virtual void SetRxGain(dB_u gain);
     /**
      * Return the reception gain.
      *
@@ -14,6 +14,8 @@
 #include "wifi-utils.h"
 #include "yans-wifi-phy.h"
 
+#include "ns3/boolean.h"
+#include "ns3/double.h"
 #include "ns3/log.h"
 #include "ns3/mobility-model.h"
 #include "ns3/node.h"
@@ -22,6 +24,10 @@
 #include "ns3/propagation-loss-model.h"
 #include "ns3/simulator.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 namespace ns3
 {
 
@@ -40,17 +46,52 @@ YansWifiChannel::GetTypeId()
             .AddAttribute("PropagationLossModel",
                           "A pointer to the propagation loss model attached to this channel.",
                           PointerValue(),
-                          MakePointerAccessor(&YansWifiChannel::m_loss),
+                          MakePointerAccessor(&YansWifiChannel::SetPropagationLossModel,
+                                              &YansWifiChannel::GetPropagationLossModel),
                           MakePointerChecker<PropagationLossModel>())
             .AddAttribute("PropagationDelayModel",
                           "A pointer to the propagation delay model attached to this channel.",
                           PointerValue(),
                           MakePointerAccessor(&YansWifiChannel::m_delay),
-                          MakePointerChecker<PropagationDelayModel>());
+                          MakePointerChecker<PropagationDelayModel>())
+            .AddAttribute("SpatialIndex",
+                          "If true, the PPDUs are only delivered to the PHYs that are located "
+                          "within the maximum range of the sender, which is determined through "
+                          "a grid-based spatial index over the positions of the PHYs. The PHYs "
+                          "out of range draw no propagation delay, hence the delays drawn by a "
+                          "random propagation delay model differ from those without the index.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&YansWifiChannel::m_spatialIndex),
+                          MakeBooleanChecker())
+            .AddAttribute("MaxRange",
+                          "The maximum range (in meters) beyond which PPDUs are not delivered "
+                          "when the spatial index is enabled. If zero, the maximum range is "
+                          "derived from the propagation loss model and the RX sensitivity and "
+                          "RX gain of the PHYs. A non-zero value is only safe if no receiver "
+                          "beyond this range can sense the signal.",
+                          DoubleValue(0),
+                          MakeDoubleAccessor(&YansWifiChannel::m_maxRange),
+                          MakeDoubleChecker<meter_u>(0))
+            .AddAttribute("SpatialIndexRefreshInterval",
+                          "The interval after which the spatial index is rebuilt from the "
+                          "current positions of the PHYs. The search range is enlarged to "
+                          "account for the distance the PHYs may have travelled since then.",
+                          TimeValue(Seconds(1)),
+                          MakeTimeAccessor(&YansWifiChannel::m_indexRefreshInterval),
+                          MakeTimeChecker(Time{0}));
     return tid;
 }
 
 YansWifiChannel::YansWifiChannel()
+    : m_spatialIndex(false),
+      m_maxRange(0),
+      m_indexValid(false),
+      m_cellSize(0),
+      m_maxSpeed(0),
+      m_minRxThreshold(0),
+      m_lastRangeKey(std::numeric_limits<double>::quiet_NaN(),
+                     std::numeric_limits<double>::quiet_NaN()),
+      m_lastRange(0)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -61,11 +102,40 @@ YansWifiChannel::~YansWifiChannel()
     m_phyList.clear();
 }
 
+void
+YansWifiChannel::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    for (const auto& mobility : m_tracked)
+    {
+        mobility->TraceDisconnectWithoutContext(
+            "CourseChange",
+            MakeCallback(&YansWifiChannel::NotifyCourseChange, this));
+    }
+    m_tracked.clear();
+    m_mobilityIndices.clear();
+    m_entries.clear();
+    m_cells.clear();
+    m_dirty.clear();
+    m_indexValid = false;
+    Channel::DoDispose();
+}
+
 void
 YansWifiChannel::SetPropagationLossModel(const Ptr<PropagationLossModel> loss)
 {
     NS_LOG_FUNCTION(this << loss);
     m_loss = loss;
+    // the range, hence the cell size, depends on the loss model
+    m_lastRangeKey = {std::numeric_limits<double>::quiet_NaN(),
+                      std::numeric_limits<double>::quiet_NaN()};
+    m_cellSize = 0;
+}
+
+Ptr<PropagationLossModel>
+YansWifiChannel::GetPropagationLossModel() const
+{
+    return m_loss;
 }
 
 void
@@ -81,40 +151,321 @@ YansWifiChannel::Send(Ptr<YansWifiPhy> sender, Ptr<const WifiPpdu> ppdu, dBm_u t
     NS_LOG_FUNCTION(this << sender << ppdu << txPower);
     Ptr<MobilityModel> senderMobility = sender->GetMobility();
     NS_ASSERT(senderMobility);
-    for (auto i = m_phyList.begin(); i != m_phyList.end(); i++)
+
+    meter_u range = std::numeric_limits<double>::infinity();
+    if (m_spatialIndex)
+    {
+        if (!m_indexValid)
+        {
+            // compute the RX threshold of the attached PHYs
+            RebuildSpatialIndex(0);
+        }
+        const auto txWidth = ppdu->GetTxChannelWidth();
+        range = GetMaxRange(txPower, m_minRxThreshold + RatioToDb(txWidth / MHz_u{20}));
+    }
+
+    if (std::isinf(range))
+    {
+        for (const auto& phy : m_phyList)
+        {
+            AddReceiver(sender, phy);
+        }
+        DeliverToReceivers(senderMobility, ppdu, txPower);
+        return;
+    }
+
+    if (m_cellSize <= 0 || Simulator::Now() - m_indexBuildTime > m_indexRefreshInterval)
+    {
+        RebuildSpatialIndex(std::max(range, meter_u{1}));
+    }
+    for (auto index : m_dirty)
+    {
+        UpdateSpatialIndex(index);
+    }
+    m_dirty.clear();
+
+    // the indexed PHYs may have moved since the index was built
+    const auto searchRange =
+        range + m_maxSpeed * (Simulator::Now() - m_indexBuildTime).GetSeconds();
+    const auto candidates = GetCandidateReceivers(senderMobility->GetPosition(), searchRange);
+    NS_LOG_DEBUG("Delivering to " << candidates.size() << " out of " << m_phyList.size()
+                                  << " PHYs within " << searchRange << "m");
+    for (auto index : candidates)
+    {
+        AddReceiver(sender, m_phyList[index]);
+    }
+    DeliverToReceivers(senderMobility, ppdu, txPower);
+}
+
+void
+YansWifiChannel::AddReceiver(Ptr<YansWifiPhy> sender, Ptr<YansWifiPhy> receiver) const
+{
+    // For now don't account for inter channel interference nor channel bonding
+    if (sender == receiver || receiver->GetChannelNumber() != sender->GetChannelNumber())
+    {
+        return;
+    }
+    m_receivers.push_back(receiver);
+    m_receiverMobilities.push_back(receiver->GetMobility()->GetObject<MobilityModel>());
+}
+
+void
+YansWifiChannel::DeliverToReceivers(Ptr<MobilityModel> senderMobility,
+                                    Ptr<const WifiPpdu> ppdu,
+                                    dBm_u txPower) const
+{
+    m_loss->CalcRxPowers(txPower,
+                         senderMobility,
+                         m_receiverMobilities,
+                         m_rxPowersDbm,
+                         m_distances);
+    for (std::size_t i = 0; i < m_receivers.size(); ++i)
     {
-        if (sender != (*i))
+        const auto& receiver = m_receivers[i];
+        const auto& receiverMobility = m_receiverMobilities[i];
+        const auto delay = m_delay->GetDelay(senderMobility, receiverMobility);
+        const dBm_u rxPower{m_rxPowersDbm[i]};
+        NS_LOG_DEBUG("propagation: txPower="
+                     << txPower << "dBm, rxPower=" << rxPower << "dBm, "
+                     << "distance=" << m_distances[i]
+                     << "m, delay=" << delay);
+        auto dstNetDevice = receiver->GetDevice();
+        uint32_t dstNode;
+        if (!dstNetDevice)
+        {
+            dstNode = 0xffffffff;
+        }
+        else
         {
-            // For now don't account for inter channel interference nor channel bonding
-            if ((*i)->GetChannelNumber() != sender->GetChannelNumber())
+            dstNode = dstNetDevice->GetNode()->GetId();
+        }
+
+        Simulator::ScheduleWithContext(dstNode,
+                                       delay,
+                                       &YansWifiChannel::Receive,
+                                       receiver,
+                                       ppdu,
+                                       rxPower);
+    }
+    m_receivers.clear();
+    m_receiverMobilities.clear();
+}
+
+meter_u
+YansWifiChannel::GetMaxRange(dBm_u txPower, dBm_u threshold) const
+{
+    NS_LOG_FUNCTION(this << txPower << threshold);
+    if (m_maxRange > 0)
+    {
+        return m_maxRange;
+    }
+
+    const auto bound = [&](meter_u distance) {
+        return m_loss->GetRxPowerUpperBound(txPower, distance);
+    };
+    const meter_u maxSearchRange{1e8};
+    if (m_lastRangeKey == std::make_pair(txPower, threshold))
+    {
+        // the attributes of the loss models may have changed since the range
+        // was computed: check that the bound still crosses the threshold there
+        const bool valid = std::isinf(m_lastRange)
+                               ? bound(maxSearchRange) >= threshold
+                               : bound(m_lastRange) < threshold &&
+                                     (m_lastRange == 0 ||
+                                      bound(m_lastRange * (1 - 1e-3)) >= threshold);
+        if (valid)
+        {
+            return m_lastRange;
+        }
+        NS_LOG_DEBUG("The propagation loss changed, computing the range again");
+        // the cell size of the spatial index depends on the range
+        m_cellSize = 0;
+    }
+
+    // the bound is non-increasing with the distance: find the distance beyond
+    // which the RX power is below the threshold by doubling and bisecting
+    meter_u low{0};
+    meter_u high{1};
+    if (bound(low) < threshold)
+    {
+        high = low;
+    }
+    else
+    {
+        while (bound(high) >= threshold)
+        {
+            low = high;
+            high *= 2;
+            if (high > maxSearchRange)
             {
-                continue;
+                high = std::numeric_limits<double>::infinity();
+                break;
             }
-
-            auto receiverMobility = (*i)->GetMobility()->GetObject<MobilityModel>();
-            const auto delay = m_delay->GetDelay(senderMobility, receiverMobility);
-            const dBm_u rxPower{m_loss->CalcRxPower(txPower, senderMobility, receiverMobility)};
-            NS_LOG_DEBUG("propagation: txPower="
-                         << txPower << "dBm, rxPower=" << rxPower << "dBm, "
-                         << "distance=" << senderMobility->GetDistanceFrom(receiverMobility)
-                         << "m, delay=" << delay);
-            auto dstNetDevice = (*i)->GetDevice();
-            uint32_t dstNode;
-            if (!dstNetDevice)
+        }
+        for (auto i = 0; i < 64 && !std::isinf(high) && high - low > 1e-6 * high; ++i)
+        {
+            const auto mid = (low + high) / 2;
+            if (bound(mid) < threshold)
             {
-                dstNode = 0xffffffff;
+                high = mid;
             }
             else
             {
-                dstNode = dstNetDevice->GetNode()->GetId();
+                low = mid;
+            }
+        }
+    }
+    NS_LOG_DEBUG("Max range for txPower=" << txPower << "dBm and threshold=" << threshold
+                                          << "dBm: " << high << "m");
+    m_lastRangeKey = {txPower, threshold};
+    m_lastRange = high;
+    return high;
+}
+
+uint64_t
+YansWifiChannel::GetCellKey(const Vector& position) const
+{
+    const auto x = static_cast<int32_t>(std::floor(position.x / m_cellSize));
+    const auto y = static_cast<int32_t>(std::floor(position.y / m_cellSize));
+    return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+}
+
+void
+YansWifiChannel::RebuildSpatialIndex(meter_u cellSize) const
+{
+    NS_LOG_FUNCTION(this << cellSize);
+    m_indexValid = true;
+    m_indexBuildTime = Simulator::Now();
+    m_minRxThreshold = std::numeric_limits<double>::infinity();
+    for (const auto& phy : m_phyList)
+    {
+        m_minRxThreshold = std::min(m_minRxThreshold, phy->GetRxSensitivity() - phy->GetRxGain());
+    }
+    m_cellSize = cellSize;
+    m_cells.clear();
+    m_dirty.clear();
+    m_maxSpeed = 0;
+    m_entries.resize(m_phyList.size());
+    for (auto& [mobility, indices] : m_mobilityIndices)
+    {
+        indices.clear();
+    }
+    if (m_cellSize <= 0)
+    {
+        // only the threshold is needed until the cell size is known
+        return;
+    }
+    for (std::size_t index = 0; index < m_phyList.size(); ++index)
+    {
+        auto mobility = m_phyList[index]->GetMobility();
+        NS_ASSERT(mobility);
+        auto [it, inserted] = m_mobilityIndices.try_emplace(PeekPointer(mobility));
+        if (inserted)
+        {
+            mobility->TraceConnectWithoutContext(
+                "CourseChange",
+                MakeCallback(&YansWifiChannel::NotifyCourseChange, this));
+            m_tracked.push_back(mobility);
+        }
+        it->second.push_back(index);
+        m_entries[index].mobility = mobility;
+        m_entries[index].dirty = false;
+        m_entries[index].position = mobility->GetPosition();
+        m_entries[index].cell = GetCellKey(m_entries[index].position);
+        m_cells[m_entries[index].cell].push_back(index);
+        m_maxSpeed = std::max(m_maxSpeed, mobility->GetVelocity().GetLength());
+    }
+}
+
+void
+YansWifiChannel::UpdateSpatialIndex(std::size_t index) const
+{
+    NS_LOG_FUNCTION(this << index);
+    auto& entry = m_entries[index];
+    entry.dirty = false;
+    entry.position = entry.mobility->GetPosition();
+    // the speed of the PHY may have increased
+    m_maxSpeed = std::max(m_maxSpeed, entry.mobility->GetVelocity().GetLength());
+    const auto cell = GetCellKey(entry.position);
+    if (cell == entry.cell)
+    {
+        return;
+    }
+    auto& oldCell = m_cells[entry.cell];
+    oldCell.erase(std::find(oldCell.begin(), oldCell.end(), index));
+    if (oldCell.empty())
+    {
+        m_cells.erase(entry.cell);
+    }
+    entry.cell = cell;
+    m_cells[cell].push_back(index);
+}
+
+std::vector<std::size_t>
+YansWifiChannel::GetCandidateReceivers(const Vector& position, meter_u range) const
+{
+    NS_LOG_FUNCTION(this << position << range);
+    std::vector<std::size_t> candidates;
+    const auto addCell = [&](const std::vector<std::size_t>& indices) {
+        for (auto index : indices)
+        {
+            const auto dx = m_entries[index].position.x - position.x;
+            const auto dy = m_entries[index].position.y - position.y;
+            // the 2D distance does not exceed the 3D distance used by the loss models
+            if (dx * dx + dy * dy <= range * range)
+            {
+                candidates.push_back(index);
             }
+        }
+    };
 
-            Simulator::ScheduleWithContext(dstNode,
-                                           delay,
-                                           &YansWifiChannel::Receive,
-                                           (*i),
-                                           ppdu,
-                                           rxPower);
+    const auto minX = std::floor((position.x - range) / m_cellSize);
+    const auto maxX = std::floor((position.x + range) / m_cellSize);
+    const auto minY = std::floor((position.y - range) / m_cellSize);
+    const auto maxY = std::floor((position.y + range) / m_cellSize);
+    if ((maxX - minX + 1) * (maxY - minY + 1) >= static_cast<double>(m_cells.size()))
+    {
+        // cheaper to visit all the non-empty cells
+        for (const auto& [key, indices] : m_cells)
+        {
+            addCell(indices);
+        }
+    }
+    else
+    {
+        for (auto x = static_cast<int32_t>(minX); x <= static_cast<int32_t>(maxX); ++x)
+        {
+            for (auto y = static_cast<int32_t>(minY); y <= static_cast<int32_t>(maxY); ++y)
+            {
+                const auto key = (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) |
+                                 static_cast<uint32_t>(y);
+                if (auto it = m_cells.find(key); it != m_cells.end())
+                {
+                    addCell(it->second);
+                }
+            }
+        }
+    }
+    // preserve the order in which receptions are scheduled by the brute-force path
+    std::sort(candidates.begin(), candidates.end());
+    return candidates;
+}
+
+void
+YansWifiChannel::NotifyCourseChange(Ptr<const MobilityModel> mobility) const
+{
+    NS_LOG_FUNCTION(this << mobility);
+    auto it = m_mobilityIndices.find(PeekPointer(mobility));
+    if (it == m_mobilityIndices.end())
+    {
+        return;
+    }
+    for (auto index : it->second)
+    {
+        if (!m_entries[index].dirty)
+        {
+            m_entries[index].dirty = true;
+            m_dirty.push_back(index);
         }
     }
 }
@@ -158,6 +509,17 @@ YansWifiChannel::Add(Ptr<YansWifiPhy> phy)
 {
     NS_LOG_FUNCTION(this << phy);
     m_phyList.push_back(phy);
+    m_indexValid = false;
+    m_cellSize = 0;
+}
+
+void
+YansWifiChannel::NotifyRxThresholdChanged()
+{
+    NS_LOG_FUNCTION(this);
+    // the minimum RX threshold is computed again with the index
+    m_indexValid = false;
+    m_cellSize = 0;
 }
 
 int64_t
@@ -12,10 +12,16 @@
 #include "wifi-units.h"
 
 #include "ns3/channel.h"
+#include "ns3/nstime.h"
+#include "ns3/vector.h"
+
+#include <unordered_map>
+#include <vector>
 
 namespace ns3
 {
 
+class MobilityModel;
 class NetDevice;
 class PropagationLossModel;
 class PropagationDelayModel;
@@ -32,6 +38,26 @@ class WifiPpdu;
  * class and supports an ns3::PropagationLossModel and an
  * ns3::PropagationDelayModel.  By default, no propagation models are set;
  * it is the caller's responsibility to set them before using the channel.
+ *
+ * When the SpatialIndex attribute is enabled, the channel keeps the positions
+ * of the attached PHYs in a uniform grid and only delivers a PPDU to the
+ * receivers located within a conservative maximum range of the sender. The
+ * maximum range is either set through the MaxRange attribute or derived from
+ * the upper bound on the received power provided by the propagation loss
+ * model chain (see PropagationLossModel::GetRxPowerUpperBound) and from the
+ * RX sensitivity and RX gain of the receivers. Receivers that are skipped
+ * would have dropped the signal as too weak to process, hence the outcome
+ * is the same as the one obtained by delivering the PPDU to all the PHYs,
+ * with the exception that the SignalArrival trace is not fired for the
+ * skipped receivers and that random variables of the loss models are not
+ * drawn for them. If the loss model chain does not provide a finite bound
+ * (e.g., it includes a fading model) and MaxRange is not set, all the PHYs
+ * are considered. The range is checked against the loss models at each
+ * transmission, so that changes of their attributes are taken into account.
+ * The grid is refreshed lazily: the position of a PHY is
+ * updated upon the next transmission following a course change notified by
+ * its mobility model, and the whole grid is rebuilt every
+ * SpatialIndexRefreshInterval to bound the drift of the moving PHYs.
  */
 class YansWifiChannel : public Channel
 {
@@ -55,10 +81,20 @@ class YansWifiChannel : public Channel
      */
     void Add(Ptr<YansWifiPhy> phy);
 
+    /**
+     * Notify the channel that the RX sensitivity or the RX gain of an attached
+     * PHY changed, so that the range of the spatial index is computed again.
+     */
+    void NotifyRxThresholdChanged();
+
     /**
      * @param loss the new propagation loss model.
      */
     void SetPropagationLossModel(const Ptr<PropagationLossModel> loss);
+    /**
+     * @return the propagation loss model.
+     */
+    Ptr<PropagationLossModel> GetPropagationLossModel() const;
     /**
      * @param delay the new propagation delay model.
      */
@@ -87,12 +123,87 @@ class YansWifiChannel : public Channel
      */
     int64_t AssignStreams(int64_t stream);
 
+  protected:
+    void DoDispose() override;
+
   private:
     /**
      * A vector of pointers to YansWifiPhy.
      */
     typedef std::vector<Ptr<YansWifiPhy>> PhyList;
 
+    /**
+     * Add the given receiver to the list of PHYs the PPDU being sent is
+     * delivered to, unless it is the sender or it operates on another channel.
+     *
+     * @param sender the PHY object from which the packet is originating
+     * @param receiver the candidate receiver
+     */
+    void AddReceiver(Ptr<YansWifiPhy> sender, Ptr<YansWifiPhy> receiver) const;
+
+    /**
+     * Compute the RX power of the given PPDU at all the receivers added by
+     * AddReceiver() at once, then compute the propagation delay to each of
+     * them and schedule the receptions. The list of receivers is cleared.
+     *
+     * @param senderMobility the mobility model of the sender
+     * @param ppdu the PPDU to send
+     * @param txPower the TX power associated to the packet
+     */
+    void DeliverToReceivers(Ptr<MobilityModel> senderMobility,
+                            Ptr<const WifiPpdu> ppdu,
+                            dBm_u txPower) const;
+
+    /**
+     * Get the maximum distance from the sender at which the given PPDU can be
+     * received with a power that is not below the given threshold.
+     *
+     * @param txPower the TX power associated to the packet
+     * @param threshold the RX power below which the PPDU is dropped
+     * @return the maximum range (in meters), possibly infinite
+     */
+    meter_u GetMaxRange(dBm_u txPower, dBm_u threshold) const;
+
+    /**
+     * Get the indices (in the PHY list) of the PHYs located within the given
+     * range of the given position, sorted in increasing order.
+     *
+     * @param position the position of the sender
+     * @param range the maximum range (in meters)
+     * @return the indices of the candidate receivers
+     */
+    std::vector<std::size_t> GetCandidateReceivers(const Vector& position, meter_u range) const;
+
+    /**
+     * Rebuild the spatial index from scratch.
+     *
+     * @param cellSize the size of the side of a grid cell (in meters)
+     */
+    void RebuildSpatialIndex(meter_u cellSize) const;
+
+    /**
+     * Update the cell of the PHY at the given index in the PHY list based on
+     * the current position of its mobility model.
+     *
+     * @param index the index of the PHY in the PHY list
+     */
+    void UpdateSpatialIndex(std::size_t index) const;
+
+    /**
+     * Get the key of the grid cell containing the given position.
+     *
+     * @param position the position
+     * @return the key of the cell
+     */
+    uint64_t GetCellKey(const Vector& position) const;
+
+    /**
+     * Notified by the mobility models of the PHYs when their course changes.
+     *
+     * @param mobility the mobility model whose course changed
+     */
+    void NotifyCourseChange(Ptr<const MobilityModel> mobility) const;
+
     /**
      * This method is scheduled by Send for each associated YansWifiPhy.
      * The method then calls the corresponding YansWifiPhy that the first
@@ -107,6 +218,40 @@ class YansWifiChannel : public Channel
     PhyList m_phyList;                  //!< List of YansWifiPhys connected to this YansWifiChannel
     Ptr<PropagationLossModel> m_loss;   //!< Propagation loss model
     Ptr<PropagationDelayModel> m_delay; //!< Propagation delay model
+
+    bool m_spatialIndex;         //!< whether to skip the receivers that are out of range
+    meter_u m_maxRange;          //!< maximum range set by the user (0 to derive it)
+    Time m_indexRefreshInterval; //!< interval after which the spatial index is rebuilt
+
+    /// Information stored by the spatial index for each PHY in the PHY list
+    struct IndexEntry
+    {
+        Ptr<MobilityModel> mobility; //!< the mobility model the entry refers to
+        Vector position;             //!< the indexed position
+        uint64_t cell;               //!< the key of the cell containing the indexed position
+        bool dirty;                  //!< whether the course changed since last indexed
+    };
+
+    mutable bool m_indexValid;                 //!< whether the spatial index can be used
+    mutable Time m_indexBuildTime;             //!< time the spatial index was last rebuilt
+    mutable meter_u m_cellSize;                //!< size of the side of a grid cell
+    mutable double m_maxSpeed;                 //!< max speed (m/s) of the indexed PHYs
+    mutable dBm_u m_minRxThreshold;            //!< min RX sensitivity minus RX gain of the PHYs
+    mutable std::vector<IndexEntry> m_entries; //!< per-PHY index entries
+    mutable std::vector<std::size_t> m_dirty;  //!< indices of the entries to update
+    mutable std::unordered_map<uint64_t, std::vector<std::size_t>>
+        m_cells;                            //!< PHY indices per grid cell
+    mutable std::unordered_map<const MobilityModel*, std::vector<std::size_t>>
+        m_mobilityIndices; //!< PHY indices per tracked mobility model
+    mutable std::vector<Ptr<MobilityModel>> m_tracked; //!< mobility models being tracked
+    mutable std::pair<dBm_u, dBm_u> m_lastRangeKey;    //!< TX power and threshold of last range
+    mutable meter_u m_lastRange;                       //!< last computed range
+
+    mutable PhyList m_receivers; //!< receivers of the PPDU being sent
+    /// mobility models of the receivers of the PPDU being sent
+    mutable std::vector<Ptr<MobilityModel>> m_receiverMobilities;
+    mutable std::vector<double> m_rxPowersDbm; //!< RX power (dBm) at each receiver
+    mutable std::vector<double> m_distances;   //!< distance (m) to each receiver
 };
 
 } // namespace ns3
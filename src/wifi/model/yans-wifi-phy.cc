@@ -54,6 +54,26 @@ YansWifiPhy::SetInterferenceHelper(const Ptr<InterferenceHelper> helper)
                              }}});
 }
 
+void
+YansWifiPhy::SetRxSensitivity(dBm_u threshold)
+{
+    WifiPhy::SetRxSensitivity(threshold);
+    if (m_channel)
+    {
+        m_channel->NotifyRxThresholdChanged();
+    }
+}
+
+void
+YansWifiPhy::SetRxGain(dB_u gain)
+{
+    WifiPhy::SetRxGain(gain);
+    if (m_channel)
+    {
+        m_channel->NotifyRxThresholdChanged();
+    }
+}
+
 YansWifiPhy::~YansWifiPhy()
 {
     NS_LOG_FUNCTION(this);
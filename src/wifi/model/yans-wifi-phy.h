@@ -46,6 +46,8 @@ class YansWifiPhy : public WifiPhy
     ~YansWifiPhy() override;
 
     void SetInterferenceHelper(const Ptr<InterferenceHelper> helper) override;
+    void SetRxSensitivity(dBm_u threshold) override;
+    void SetRxGain(dB_u gain) override;
     void StartTx(Ptr<const WifiPpdu> ppdu) override;
     Ptr<Channel> GetChannel() const override;
     MHz_u GetGuardBandwidth(MHz_u currentChannelWidth) const override;
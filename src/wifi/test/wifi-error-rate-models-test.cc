@@ -14,17 +14,21 @@
 #include <gsl/gsl_sf_bessel.h>
 #endif
 
+#include "ns3/boolean.h"
 #include "ns3/dsss-error-rate-model.h"
 #include "ns3/he-phy.h" //includes HT and VHT
 #include "ns3/interference-helper.h"
 #include "ns3/log.h"
 #include "ns3/nist-error-rate-model.h"
+#include "ns3/string.h"
 #include "ns3/table-based-error-rate-model.h"
 #include "ns3/test.h"
 #include "ns3/wifi-phy.h"
 #include "ns3/wifi-utils.h"
 #include "ns3/yans-error-rate-model.h"
 
+#include <fstream>
+
 using namespace ns3;
 
 NS_LOG_COMPONENT_DEFINE("WifiErrorRateModelsTest");
@@ -385,6 +389,85 @@ WifiErrorRateModelsTestCaseNist::DoRun()
     NS_TEST_ASSERT_MSG_EQ_TOL(ps, 0.999, 0.001, "Not equal within tolerance");
 }
 
+/**
+ * @ingroup wifi-test
+ * @ingroup tests
+ *
+ * @brief Check that the success rates interpolated from the tables of the
+ * NistErrorRateModel are within an accuracy bound of the analytic ones
+ */
+class WifiErrorRateModelsTestCaseNistTables : public TestCase
+{
+  public:
+    WifiErrorRateModelsTestCaseNistTables();
+
+  private:
+    void DoRun() override;
+};
+
+WifiErrorRateModelsTestCaseNistTables::WifiErrorRateModelsTestCaseNistTables()
+    : TestCase("WifiErrorRateModel test case NIST tables")
+{
+}
+
+void
+WifiErrorRateModelsTestCaseNistTables::DoRun()
+{
+    const auto cacheFile = CreateTempDirFilename("nist-error-rate-tables.txt");
+    Ptr<NistErrorRateModel> nist = CreateObject<NistErrorRateModel>();
+    Ptr<NistErrorRateModel> tables = CreateObject<NistErrorRateModel>();
+    tables->SetAttribute("UseTables", BooleanValue(true));
+    tables->SetAttribute("TableCacheFile", StringValue(cacheFile));
+
+    // The Matlab fits of the CCK error rates used without GSL are discontinuous
+    // at -10 and 10 dB, hence a looser bound for the 802.11b modes
+    const std::vector<std::pair<std::string, double>> modes{
+        {"DsssRate1Mbps", 2e-3},
+        {"DsssRate2Mbps", 2e-3},
+        {"DsssRate5_5Mbps", 2e-3},
+        {"DsssRate11Mbps", 2e-3},
+        {"ErpOfdmRate6Mbps", 1e-4},
+        {"ErpOfdmRate9Mbps", 1e-4},
+        {"ErpOfdmRate12Mbps", 1e-4},
+        {"ErpOfdmRate18Mbps", 1e-4},
+        {"ErpOfdmRate24Mbps", 1e-4},
+        {"ErpOfdmRate36Mbps", 1e-4},
+        {"ErpOfdmRate48Mbps", 1e-4},
+        {"ErpOfdmRate54Mbps", 1e-4},
+        {"OfdmRate6Mbps", 1e-4},
+        {"OfdmRate54Mbps", 1e-4},
+        {"VhtMcs9", 1e-4},
+        {"HeMcs11", 1e-4},
+    };
+    for (const auto& [name, tolerance] : modes)
+    {
+        WifiMode mode(name);
+        WifiTxVector txVector;
+        txVector.SetMode(mode);
+        // the SNRs are not aligned with the grid of the tables, and cover both
+        // the tables and the SNRs outside of them
+        for (dB_u snr{-30}; snr < dB_u{55}; snr += dB_u{0.0173})
+        {
+            for (uint64_t nbits : {8, 100, 1000, 12000, 100000})
+            {
+                const auto expected =
+                    nist->GetChunkSuccessRate(mode, txVector, std::pow(10.0, snr / 10.0), nbits);
+                const auto ps =
+                    tables->GetChunkSuccessRate(mode, txVector, std::pow(10.0, snr / 10.0), nbits);
+                NS_TEST_ASSERT_MSG_EQ_TOL(ps,
+                                          expected,
+                                          tolerance,
+                                          name << ": snr=" << snr << "dB nbits=" << nbits);
+            }
+        }
+    }
+
+    std::ifstream cache(cacheFile);
+    std::string tag;
+    cache >> tag;
+    NS_TEST_EXPECT_MSG_EQ(tag, "grid", "The tables were not saved to " << cacheFile);
+}
+
 class TestInterferenceHelper : public InterferenceHelper
 {
   public:
@@ -1119,6 +1202,7 @@ WifiErrorRateModelsTestSuite::WifiErrorRateModelsTestSuite()
 {
     AddTestCase(new WifiErrorRateModelsTestCaseDsss, TestCase::Duration::QUICK);
     AddTestCase(new WifiErrorRateModelsTestCaseNist, TestCase::Duration::QUICK);
+    AddTestCase(new WifiErrorRateModelsTestCaseNistTables, TestCase::Duration::QUICK);
     AddTestCase(new WifiErrorRateModelsTestCaseMimo, TestCase::Duration::QUICK);
     AddTestCase(new TableBasedErrorRateTestCase("DefaultTableBasedHtMcs0-1458bytes",
                                                 HtPhy::GetHtMcs0(),
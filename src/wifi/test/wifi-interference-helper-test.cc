@@ -0,0 +1,198 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/interference-helper.h"
+#include "ns3/log.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/test.h"
+
+#include <iterator>
+#include <map>
+#include <random>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("InterferenceHelperTest");
+
+/**
+ * @ingroup wifi-test
+ * @ingroup tests
+ *
+ * @brief Make the protected NI change types of the InterferenceHelper
+ * available to the tests
+ */
+class NiChangesTestInterferenceHelper : public InterferenceHelper
+{
+  public:
+    using InterferenceHelper::NiChange;
+    using InterferenceHelper::NiChanges;
+};
+
+/**
+ * @ingroup wifi-test
+ * @ingroup tests
+ *
+ * @brief Check that the sorted vector storing the NI changes of a band behaves
+ * as the std::multimap it replaced, which is used as the reference.
+ *
+ * The same random sequence of the operations performed by the
+ * InterferenceHelper is applied to both containers, whose contents are
+ * compared after each operation. The changes are given a unique power, so
+ * that their order is checked, and many of them are at the same time.
+ */
+class NiChangesEquivalenceTest : public TestCase
+{
+  public:
+    NiChangesEquivalenceTest();
+
+  private:
+    void DoRun() override;
+
+    /// the NI change
+    using NiChange = NiChangesTestInterferenceHelper::NiChange;
+    /// the container under test
+    using NiChanges = NiChangesTestInterferenceHelper::NiChanges;
+    /// the reference container
+    using Reference = std::multimap<Time, NiChange>;
+
+    /**
+     * Check that the container under test has the same contents as the reference.
+     *
+     * @param changes the container under test
+     * @param reference the reference container
+     * @param step the index of the last operation
+     */
+    void CheckEqual(const NiChanges& changes, const Reference& reference, uint32_t step);
+};
+
+NiChangesEquivalenceTest::NiChangesEquivalenceTest()
+    : TestCase("Check that the NiChanges behave as a std::multimap")
+{
+}
+
+void
+NiChangesEquivalenceTest::CheckEqual(const NiChanges& changes,
+                                     const Reference& reference,
+                                     uint32_t step)
+{
+    NS_TEST_ASSERT_MSG_EQ(changes.size(), reference.size(), "Different sizes at step " << step);
+    auto it = changes.cbegin();
+    for (const auto& [time, change] : reference)
+    {
+        NS_TEST_ASSERT_MSG_EQ(it->first, time, "Different times at step " << step);
+        NS_TEST_ASSERT_MSG_EQ(it->second.GetPower(),
+                              change.GetPower(),
+                              "Different powers at step " << step);
+        ++it;
+    }
+}
+
+void
+NiChangesEquivalenceTest::DoRun()
+{
+    std::mt19937 rng(RngSeedManager::GetSeed());
+    auto randomTime = [&rng]() { return MicroSeconds(std::uniform_int_distribution(0, 50)(rng)); };
+
+    // always have a change at time 0, as the InterferenceHelper does
+    NiChanges changes;
+    Reference reference;
+    changes.insert(changes.upper_bound(Time(0)), {Time(0), NiChange(Watt_u{0}, nullptr)});
+    reference.insert(reference.upper_bound(Time(0)), {Time(0), NiChange(Watt_u{0}, nullptr)});
+
+    double nextPower = 1;
+    for (uint32_t step = 0; step < 5000; ++step)
+    {
+        const auto moment = randomTime();
+        switch (std::uniform_int_distribution(0, 5)(rng))
+        {
+        case 0: {
+            // insert with a hint, as AddNiChangeEvent() does
+            const auto it = changes.insert(changes.upper_bound(moment),
+                                           {moment, NiChange(Watt_u{nextPower}, nullptr)});
+            const auto refIt = reference.insert(reference.upper_bound(moment),
+                                                {moment, NiChange(Watt_u{nextPower}, nullptr)});
+            NS_TEST_ASSERT_MSG_EQ(std::distance(changes.begin(), it),
+                                  std::distance(reference.begin(), refIt),
+                                  "Different insertion positions at step " << step);
+            ++nextPower;
+            break;
+        }
+        case 1:
+            // insert without hint, as CalculateNoiseInterferenceW() does
+            changes.insert({moment, NiChange(Watt_u{nextPower}, nullptr)});
+            reference.insert({moment, NiChange(Watt_u{nextPower}, nullptr)});
+            ++nextPower;
+            break;
+        case 2:
+            changes.emplace(moment, NiChange(Watt_u{nextPower}, nullptr));
+            reference.emplace(moment, NiChange(Watt_u{nextPower}, nullptr));
+            ++nextPower;
+            break;
+        case 3: {
+            // add power to the changes of a period, as AppendEvent() and UpdateEvent() do
+            const auto end = moment + randomTime();
+            auto first = std::prev(changes.upper_bound(moment));
+            const auto last = std::prev(changes.upper_bound(end));
+            for (; first != last; ++first)
+            {
+                first->second.AddPower(Watt_u{0.5});
+            }
+            auto refFirst = std::prev(reference.upper_bound(moment));
+            const auto refLast = std::prev(reference.upper_bound(end));
+            for (; refFirst != refLast; ++refFirst)
+            {
+                refFirst->second.AddPower(Watt_u{0.5});
+            }
+            break;
+        }
+        case 4:
+            // erase the changes up to a time but the first one, as AppendEvent() does
+            if (std::uniform_int_distribution(0, 9)(rng) == 0)
+            {
+                changes.erase(++changes.begin(), std::next(std::prev(changes.upper_bound(moment))));
+                reference.erase(++reference.begin(),
+                                std::next(std::prev(reference.upper_bound(moment))));
+            }
+            break;
+        case 5: {
+            const auto it = changes.find(moment);
+            const auto refIt = reference.find(moment);
+            NS_TEST_ASSERT_MSG_EQ((it == changes.end()),
+                                  (refIt == reference.end()),
+                                  "Different results of find() at step " << step);
+            if (it != changes.end())
+            {
+                NS_TEST_ASSERT_MSG_EQ(std::distance(changes.begin(), it),
+                                      std::distance(reference.begin(), refIt),
+                                      "Different results of find() at step " << step);
+            }
+            break;
+        }
+        default:
+            break;
+        }
+        CheckEqual(changes, reference, step);
+    }
+    NS_TEST_EXPECT_MSG_GT(changes.size(), 10, "Too few changes left to test the container");
+}
+
+/**
+ * @ingroup wifi-test
+ * @ingroup tests
+ *
+ * @brief Interference helper test suite
+ */
+class InterferenceHelperTestSuite : public TestSuite
+{
+  public:
+    InterferenceHelperTestSuite();
+};
+
+InterferenceHelperTestSuite::InterferenceHelperTestSuite()
+    : TestSuite("wifi-interference-helper", Type::UNIT)
+{
+    AddTestCase(new NiChangesEquivalenceTest, TestCase::Duration::QUICK);
+}
+
+static InterferenceHelperTestSuite g_interferenceHelperTestSuite; ///< the test suite
@@ -14,6 +14,7 @@
 #include "ns3/config.h"
 #include "ns3/constant-position-mobility-model.h"
 #include "ns3/constant-rate-wifi-manager.h"
+#include "ns3/constant-velocity-mobility-model.h"
 #include "ns3/error-model.h"
 #include "ns3/fcfs-wifi-queue-scheduler.h"
 #include "ns3/he-frame-exchange-manager.h"
@@ -49,6 +50,8 @@
 #include "ns3/yans-wifi-phy.h"
 
 #include <optional>
+#include <tuple>
+#include <vector>
 
 using namespace ns3;
 
@@ -3976,6 +3979,164 @@ DsssModulationTest::DoRun()
     NS_TEST_ASSERT_MSG_EQ(m_received, 4, "Did not receive four DSSS packets");
 }
 
+//-----------------------------------------------------------------------------
+/**
+ * @ingroup wifi-test
+ * @ingroup tests
+ *
+ * @brief Make sure that enabling the spatial index of the YansWifiChannel does not change
+ * the outcome of a simulation in which nodes move and some of them are out of range.
+ *
+ * A grid of ad hoc stations, some of which are moving, take turns in transmitting broadcast
+ * frames, and their RX sensitivity and then the path loss exponent are lowered during the
+ * simulation. The (node, time, RX power) tuples of all the receptions started at the PHY layer
+ * are recorded with and without the spatial index and must be identical.
+ */
+class YansWifiChannelSpatialIndexTest : public TestCase
+{
+  public:
+    YansWifiChannelSpatialIndexTest();
+
+    void DoRun() override;
+
+  private:
+    /// Information about a reception started at the PHY layer
+    using RxInfo = std::tuple<std::string, Time, double>;
+
+    /**
+     * Run the simulation
+     * @param spatialIndex whether the spatial index of the channel is enabled
+     * @return the information about the receptions started at the PHY layer
+     */
+    std::vector<RxInfo> RunOne(bool spatialIndex);
+
+    /**
+     * Callback invoked when a PHY starts receiving a PPDU
+     * @param context the context
+     * @param p the received packet
+     * @param rxPowersW the received power per channel band in watts
+     */
+    void PhyRxBegin(std::string context, Ptr<const Packet> p, RxPowerWattPerChannelBand rxPowersW);
+
+    std::vector<RxInfo> m_rxInfos; ///< information about the receptions
+};
+
+YansWifiChannelSpatialIndexTest::YansWifiChannelSpatialIndexTest()
+    : TestCase("Test that the spatial index of YansWifiChannel does not change the results")
+{
+}
+
+void
+YansWifiChannelSpatialIndexTest::PhyRxBegin(std::string context,
+                                            Ptr<const Packet> p,
+                                            RxPowerWattPerChannelBand rxPowersW)
+{
+    m_rxInfos.emplace_back(context, Simulator::Now(), rxPowersW.begin()->second);
+}
+
+std::vector<YansWifiChannelSpatialIndexTest::RxInfo>
+YansWifiChannelSpatialIndexTest::RunOne(bool spatialIndex)
+{
+    RngSeedManager::SetSeed(1);
+    RngSeedManager::SetRun(1);
+    m_rxInfos.clear();
+
+    const uint32_t nNodes = 30;
+    NodeContainer nodes;
+    nodes.Create(nNodes);
+
+    auto channel = YansWifiChannelHelper::Default().Create();
+    channel->SetAttribute("SpatialIndex", BooleanValue(spatialIndex));
+    YansWifiPhyHelper phy;
+    phy.SetChannel(channel);
+
+    WifiHelper wifi;
+    wifi.SetStandard(WIFI_STANDARD_80211b);
+    wifi.SetRemoteStationManager("ns3::ConstantRateWifiManager",
+                                 "DataMode",
+                                 StringValue("DsssRate1Mbps"),
+                                 "ControlMode",
+                                 StringValue("DsssRate1Mbps"));
+    WifiMacHelper mac;
+    mac.SetType("ns3::AdhocWifiMac");
+    auto devices = wifi.Install(phy, mac, nodes);
+    wifi.AssignStreams(devices, 100);
+
+    MobilityHelper mobility;
+    mobility.SetPositionAllocator("ns3::GridPositionAllocator",
+                                  "MinX",
+                                  DoubleValue(0.0),
+                                  "MinY",
+                                  DoubleValue(0.0),
+                                  "DeltaX",
+                                  DoubleValue(90.0),
+                                  "DeltaY",
+                                  DoubleValue(90.0),
+                                  "GridWidth",
+                                  UintegerValue(6));
+    mobility.SetMobilityModel("ns3::ConstantVelocityMobilityModel");
+    mobility.Install(nodes);
+    for (uint32_t i = 0; i < nNodes; i += 4)
+    {
+        nodes.Get(i)->GetObject<ConstantVelocityMobilityModel>()->SetVelocity(
+            Vector(20.0, (i % 8 == 0) ? 10.0 : -10.0, 0.0));
+    }
+    // change the course of a node during the simulation
+    Simulator::Schedule(Seconds(2.5),
+                        &ConstantVelocityMobilityModel::SetVelocity,
+                        nodes.Get(1)->GetObject<ConstantVelocityMobilityModel>(),
+                        Vector(-60.0, 0.0, 0.0));
+    // increase the range of the PHYs during the simulation
+    Simulator::Schedule(Seconds(3.5), []() {
+        Config::Set("/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/Phy/RxSensitivity",
+                    DoubleValue(-110.0));
+    });
+    // increase the range again by changing the loss model
+    Simulator::Schedule(Seconds(4.5), [channel]() {
+        channel->GetPropagationLossModel()->SetAttribute("Exponent", DoubleValue(2.5));
+    });
+
+    for (uint32_t round = 0; round < 5; ++round)
+    {
+        for (uint32_t i = 0; i < nNodes; ++i)
+        {
+            auto dev = devices.Get(i);
+            Simulator::Schedule(Seconds(round + 1) + MilliSeconds(25 * i), [dev]() {
+                dev->Send(Create<Packet>(100), dev->GetBroadcast(), 1);
+            });
+        }
+    }
+
+    Config::Connect("/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/Phy/PhyRxBegin",
+                    MakeCallback(&YansWifiChannelSpatialIndexTest::PhyRxBegin, this));
+
+    Simulator::Stop(Seconds(6));
+    Simulator::Run();
+    Simulator::Destroy();
+
+    return m_rxInfos;
+}
+
+void
+YansWifiChannelSpatialIndexTest::DoRun()
+{
+    const auto reference = RunOne(false);
+    const auto indexed = RunOne(true);
+
+    // each frame is not received by all the other nodes
+    NS_TEST_EXPECT_MSG_GT(reference.size(), 0, "No reception started");
+    NS_TEST_EXPECT_MSG_LT(reference.size(), 5 * 30 * 29, "All nodes are within range");
+    NS_TEST_ASSERT_MSG_EQ(indexed.size(),
+                          reference.size(),
+                          "Unexpected number of receptions with spatial index");
+    for (std::size_t i = 0; i < reference.size(); ++i)
+    {
+        NS_TEST_EXPECT_MSG_EQ((indexed[i] == reference[i]),
+                              true,
+                              "Reception " << i << " differs with spatial index");
+    }
+}
+
 /**
  * @ingroup wifi-test
  * @ingroup tests
@@ -4010,6 +4171,7 @@ WifiTestSuite::WifiTestSuite()
     AddTestCase(new HeRuMcsDataRateTestCase, TestCase::Duration::QUICK);
     AddTestCase(new WifiMgtHeaderTest, TestCase::Duration::QUICK);
     AddTestCase(new DsssModulationTest, TestCase::Duration::QUICK);
+    AddTestCase(new YansWifiChannelSpatialIndexTest, TestCase::Duration::QUICK);
 }
 
 static WifiTestSuite g_wifiTestSuite; ///< the test suite
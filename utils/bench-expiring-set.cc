@@ -0,0 +1,168 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/expiring-set.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * @file
+ * Benchmark of the duplicate detection performed by routing protocols
+ * (e.g., the AODV RREQ ID cache or the OLSR duplicate set).
+ *
+ * For each cache size, the cache is first filled with that many entries,
+ * then each operation advances the time, purges the expired entries, looks
+ * up an entry that is in the cache and inserts an entry that is not, so that
+ * the number of entries stays constant. The ExpiringSet is compared with the
+ * linear scan over a vector that was used before.
+ */
+
+/** Entry of the linear cache, as in the former aodv::IdCache. */
+struct LinearEntry
+{
+    uint64_t key; //!< the key
+    Time expire;  //!< the expiration time
+};
+
+/**
+ * Generate the keys used by the benchmark.
+ * @param [in] count The number of keys.
+ * @returns The keys.
+ */
+static std::vector<uint64_t>
+GetKeys(uint64_t count)
+{
+    auto rng = CreateObject<UniformRandomVariable>();
+    rng->SetStream(1);
+    std::vector<uint64_t> keys(count);
+    for (auto& key : keys)
+    {
+        key = (static_cast<uint64_t>(rng->GetInteger(0, 0xffffffff)) << 32) |
+              rng->GetInteger(0, 0xffffffff);
+    }
+    return keys;
+}
+
+/**
+ * Run the benchmark with an ExpiringSet.
+ * @param [in] size The number of entries in the cache.
+ * @param [in] ops The number of operations.
+ * @param [in] keys The keys, at least size + ops of them.
+ * @returns The time per operation (ns).
+ */
+static double
+BenchExpiringSet(uint64_t size, uint64_t ops, const std::vector<uint64_t>& keys)
+{
+    ExpiringSet<uint64_t> cache;
+    const Time lifetime = NanoSeconds(size);
+    for (uint64_t i = 0; i < size; ++i)
+    {
+        cache.Insert(keys[i], NanoSeconds(i) + lifetime);
+    }
+    uint64_t hits = 0;
+    SystemWallClockMs timer;
+    timer.Start();
+    for (uint64_t i = size; i < size + ops; ++i)
+    {
+        const Time now = NanoSeconds(i);
+        cache.Purge(now);
+        hits += cache.Contains(keys[i - size / 2 - 1], now);
+        if (!cache.Contains(keys[i], now))
+        {
+            cache.Insert(keys[i], now + lifetime);
+        }
+    }
+    const auto elapsed = std::max<int64_t>(timer.End(), 1);
+    NS_ABORT_MSG_IF(hits != ops, "Unexpected number of hits");
+    return elapsed * 1e6 / ops;
+}
+
+/**
+ * Run the benchmark with a linear scan over a vector.
+ * @param [in] size The number of entries in the cache.
+ * @param [in] ops The number of operations.
+ * @param [in] keys The keys, at least size + ops of them.
+ * @returns The time per operation (ns).
+ */
+static double
+BenchLinear(uint64_t size, uint64_t ops, const std::vector<uint64_t>& keys)
+{
+    std::vector<LinearEntry> cache;
+    const Time lifetime = NanoSeconds(size);
+    for (uint64_t i = 0; i < size; ++i)
+    {
+        cache.push_back({keys[i], NanoSeconds(i) + lifetime});
+    }
+    const auto contains = [&cache](uint64_t key) {
+        return std::find_if(cache.begin(), cache.end(), [key](const LinearEntry& e) {
+                   return e.key == key;
+               }) != cache.end();
+    };
+    uint64_t hits = 0;
+    SystemWallClockMs timer;
+    timer.Start();
+    for (uint64_t i = size; i < size + ops; ++i)
+    {
+        const Time now = NanoSeconds(i);
+        cache.erase(std::remove_if(cache.begin(),
+                                   cache.end(),
+                                   [now](const LinearEntry& e) { return e.expire < now; }),
+                    cache.end());
+        hits += contains(keys[i - size / 2 - 1]);
+        if (!contains(keys[i]))
+        {
+            cache.push_back({keys[i], now + lifetime});
+        }
+    }
+    const auto elapsed = std::max<int64_t>(timer.End(), 1);
+    NS_ABORT_MSG_IF(hits != ops, "Unexpected number of hits");
+    return elapsed * 1e6 / ops;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint64_t ops = 1000000;
+    uint64_t maxSize = 100000;
+    uint64_t linearBudget = 2000000000;
+    bool linear = true;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark duplicate detection with ExpiringSet against a linear scan");
+    cmd.AddValue("ops", "number of operations for each cache size", ops);
+    cmd.AddValue("max-size", "maximum cache size", maxSize);
+    cmd.AddValue("linear", "also benchmark the linear scan", linear);
+    cmd.AddValue("linear-budget",
+                 "maximum number of entries visited by the linear scan for each cache size",
+                 linearBudget);
+    cmd.Parse(argc, argv);
+
+    const int width = 16;
+    std::cout << std::left << std::setw(width) << "Cache size" << std::setw(width)
+              << "ExpiringSet" << std::setw(width) << "Linear scan" << std::endl;
+    std::cout << std::left << std::setw(width) << "(entries)" << std::setw(width) << "(ns/op)"
+              << std::setw(width) << "(ns/op)" << std::endl;
+
+    for (uint64_t size = 10; size <= maxSize; size *= 10)
+    {
+        const auto keys = GetKeys(size + ops);
+        std::cout << std::left << std::setw(width) << size << std::setw(width)
+                  << BenchExpiringSet(size, ops, keys);
+        if (linear)
+        {
+            // the linear scan visits about 2.5 * size entries per operation
+            const auto linearOps = std::clamp<uint64_t>(linearBudget / size, 1, ops);
+            std::cout << std::setw(width) << BenchLinear(size, linearOps, keys);
+        }
+        std::cout << std::endl;
+    }
+
+    return 0;
+}
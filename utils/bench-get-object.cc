@@ -0,0 +1,186 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/network-module.h"
+#include "ns3/wifi-module.h"
+
+#include <iomanip>
+#include <iostream>
+
+using namespace ns3;
+
+/**
+ * @file
+ * Benchmark of Object::GetObject() on the nodes of an ad hoc wifi network
+ * with an IPv4 stack.
+ *
+ * The lookups made by the wifi and internet models (the mobility model, the
+ * IPv4 stack and the UDP protocol of a node, and the IPv6 stack which is not
+ * installed) are timed with GetObject() and with the linear scan of the
+ * aggregates that it performed before it cached its lookups. Then each node
+ * sends broadcast UDP packets, received by all the other nodes, and the
+ * wall clock time of the simulation is reported.
+ */
+
+/**
+ * Find an aggregated Object by scanning the aggregates, as did
+ * Object::GetObject() before it cached its lookups.
+ * @param [in] object The Object.
+ * @param [in] tid The TypeId of the requested Object.
+ * @returns The requested Object, or nullptr.
+ */
+static Ptr<const Object>
+ScanAggregates(Ptr<const Object> object, TypeId tid)
+{
+    const TypeId objectTid = Object::GetTypeId();
+    auto it = object->GetAggregateIterator();
+    while (it.HasNext())
+    {
+        auto current = it.Next();
+        TypeId cur = current->GetInstanceTypeId();
+        while (cur != tid && cur != objectTid)
+        {
+            cur = cur.GetParent();
+        }
+        if (cur == tid)
+        {
+            return current;
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * Time the lookups of an aggregated Object on all the nodes.
+ * @tparam T \explicit The type of the requested Object.
+ * @param [in] nodes The nodes.
+ * @param [in] rounds The number of lookups on each node.
+ * @param [in] scan Whether to scan the aggregates rather than call GetObject().
+ * @returns The time per lookup (ns).
+ */
+template <typename T>
+static double
+BenchLookup(const NodeContainer& nodes, uint32_t rounds, bool scan)
+{
+    uint64_t found = 0;
+    SystemWallClockMs timer;
+    timer.Start();
+    for (uint32_t round = 0; round < rounds; ++round)
+    {
+        for (auto it = nodes.Begin(); it != nodes.End(); ++it)
+        {
+            if (scan)
+            {
+                found += (ScanAggregates(*it, T::GetTypeId()) != nullptr);
+            }
+            else
+            {
+                found += ((*it)->GetObject<T>() != nullptr);
+            }
+        }
+    }
+    const auto elapsed = std::max<int64_t>(timer.End(), 1);
+    NS_ABORT_MSG_IF(found != 0 && found != uint64_t{rounds} * nodes.GetN(),
+                    "Unexpected number of lookups found");
+    return elapsed * 1e6 / (uint64_t{rounds} * nodes.GetN());
+}
+
+/**
+ * Print the times of the lookups of an aggregated Object.
+ * @tparam T \explicit The type of the requested Object.
+ * @param [in] name The name of the requested Object.
+ * @param [in] nodes The nodes.
+ * @param [in] rounds The number of lookups on each node.
+ */
+template <typename T>
+static void
+PrintLookup(const std::string& name, const NodeContainer& nodes, uint32_t rounds)
+{
+    const int width = 16;
+    std::cout << std::left << std::setw(width) << name << std::setw(width)
+              << BenchLookup<T>(nodes, rounds, false) << std::setw(width)
+              << BenchLookup<T>(nodes, rounds, true) << std::endl;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t nNodes = 1000;
+    uint32_t rounds = 1000;
+    uint32_t packets = 1;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark Object::GetObject() on the nodes of a wifi network");
+    cmd.AddValue("nodes", "number of nodes", nNodes);
+    cmd.AddValue("rounds", "number of lookups of each Object on each node", rounds);
+    cmd.AddValue("packets", "number of broadcast packets sent by each node", packets);
+    cmd.Parse(argc, argv);
+
+    NodeContainer nodes;
+    nodes.Create(nNodes);
+
+    WifiHelper wifi;
+    wifi.SetStandard(WIFI_STANDARD_80211a);
+    wifi.SetRemoteStationManager("ns3::ConstantRateWifiManager",
+                                 "DataMode",
+                                 StringValue("OfdmRate6Mbps"));
+    YansWifiPhyHelper phy;
+    phy.SetChannel(YansWifiChannelHelper::Default().Create());
+    WifiMacHelper mac;
+    mac.SetType("ns3::AdhocWifiMac");
+    const auto devices = wifi.Install(phy, mac, nodes);
+
+    MobilityHelper mobility;
+    mobility.SetPositionAllocator("ns3::GridPositionAllocator",
+                                  "DeltaX",
+                                  DoubleValue(1.0),
+                                  "DeltaY",
+                                  DoubleValue(1.0),
+                                  "GridWidth",
+                                  UintegerValue(32));
+    mobility.Install(nodes);
+
+    InternetStackHelper internet;
+    internet.SetIpv6StackInstall(false);
+    internet.Install(nodes);
+    Ipv4AddressHelper ipv4;
+    ipv4.SetBase("10.0.0.0", "255.255.0.0");
+    ipv4.Assign(devices);
+
+    const int width = 16;
+    std::cout << std::left << std::setw(width) << "Lookup" << std::setw(width) << "GetObject"
+              << std::setw(width) << "Linear scan" << std::endl;
+    std::cout << std::left << std::setw(width) << "" << std::setw(width) << "(ns/lookup)"
+              << std::setw(width) << "(ns/lookup)" << std::endl;
+    PrintLookup<MobilityModel>("MobilityModel", nodes, rounds);
+    PrintLookup<Ipv4>("Ipv4", nodes, rounds);
+    PrintLookup<UdpL4Protocol>("UdpL4Protocol", nodes, rounds);
+    PrintLookup<Ipv6>("Ipv6 (missing)", nodes, rounds);
+
+    // the transmissions are spaced so that they do not collide
+    const Time interval = MilliSeconds(1);
+    for (uint32_t i = 0; i < nNodes; ++i)
+    {
+        auto socket = Socket::CreateSocket(nodes.Get(i), UdpSocketFactory::GetTypeId());
+        socket->SetAllowBroadcast(true);
+        socket->Connect(InetSocketAddress(Ipv4Address("255.255.255.255"), 9));
+        for (uint32_t j = 0; j < packets; ++j)
+        {
+            Simulator::Schedule(interval * (j * nNodes + i),
+                                [socket]() { socket->Send(Create<Packet>(100)); });
+        }
+    }
+    SystemWallClockMs timer;
+    timer.Start();
+    Simulator::Run();
+    const auto elapsed = timer.End();
+    std::cout << "Broadcast simulation: " << nNodes * packets << " packets in " << elapsed
+              << " ms" << std::endl;
+    Simulator::Destroy();
+
+    return 0;
+}
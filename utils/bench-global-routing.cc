@@ -0,0 +1,165 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/global-route-manager-impl.h"
+#include "ns3/internet-module.h"
+#include "ns3/network-module.h"
+
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+using namespace ns3;
+
+/**
+ * @file
+ * Benchmark of the computation of the global routes.
+ *
+ * The routers of a square grid are connected by point-to-point links, and a
+ * host is attached to each router. The time to compute the routes of all the
+ * nodes is reported for an increasing number of threads (the
+ * GlobalRoutingThreads global value). Then the metric of a link of the grid
+ * is changed, and a link is brought down, and the time to update the routes
+ * (GlobalRouteManager::UpdateRoutes()) is compared with the time to compute
+ * them again from scratch, as did Ipv4GlobalRoutingHelper::RecomputeRoutingTables().
+ */
+
+/**
+ * Connect two nodes with a point-to-point link.
+ * @param [in] a The first node.
+ * @param [in] b The second node.
+ * @param [in,out] ipv4 The helper assigning the addresses of the link.
+ * @returns The devices of the link.
+ */
+static NetDeviceContainer
+Connect(Ptr<Node> a, Ptr<Node> b, Ipv4AddressHelper& ipv4)
+{
+    SimpleNetDeviceHelper simple;
+    simple.SetNetDevicePointToPointMode(true);
+    auto channel = CreateObject<SimpleChannel>();
+    NetDeviceContainer devices = simple.Install(a, channel);
+    devices.Add(simple.Install(b, channel));
+    ipv4.Assign(devices);
+    ipv4.NewNetwork();
+    return devices;
+}
+
+/**
+ * Time the computation of the routes of all the nodes from scratch.
+ * @param [in,out] manager The global route manager.
+ * @returns The elapsed time (ms).
+ */
+static int64_t
+BenchRecompute(GlobalRouteManagerImpl& manager)
+{
+    SystemWallClockMs timer;
+    timer.Start();
+    manager.DeleteGlobalRoutes();
+    manager.BuildGlobalRoutingDatabase();
+    manager.InitializeRoutes();
+    return timer.End();
+}
+
+/**
+ * Print the times to update the routes after a change of the topology, and to
+ * compute them again from scratch.
+ * @param [in] change The change of the topology.
+ * @param [in,out] manager The global route manager.
+ */
+static void
+PrintUpdate(const std::string& change, GlobalRouteManagerImpl& manager)
+{
+    SystemWallClockMs timer;
+    timer.Start();
+    manager.UpdateRoutes();
+    const auto elapsed = timer.End();
+    const auto updated = manager.GetNUpdatedRouters();
+
+    const int width = 16;
+    std::cout << std::left << std::setw(width) << change << std::setw(width) << elapsed
+              << std::setw(width) << updated << std::setw(width) << BenchRecompute(manager)
+              << std::endl;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t size = 32;
+    uint32_t maxThreads = std::max(std::thread::hardware_concurrency(), 1U);
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the computation of the global routes of a grid of routers");
+    cmd.AddValue("size", "number of routers on each side of the grid", size);
+    cmd.AddValue("threads", "maximum number of threads computing the routes", maxThreads);
+    cmd.Parse(argc, argv);
+
+    NodeContainer routers;
+    routers.Create(size * size);
+    NodeContainer hosts;
+    hosts.Create(size * size);
+
+    InternetStackHelper internet;
+    internet.SetIpv6StackInstall(false);
+    internet.Install(routers);
+    internet.Install(hosts);
+
+    Ipv4AddressHelper ipv4;
+    ipv4.SetBase("10.0.0.0", "255.255.255.252");
+    NetDeviceContainer link;
+    for (uint32_t row = 0; row < size; ++row)
+    {
+        for (uint32_t col = 0; col < size; ++col)
+        {
+            const auto router = routers.Get(row * size + col);
+            if (col + 1 < size)
+            {
+                auto devices = Connect(router, routers.Get(row * size + col + 1), ipv4);
+                if (row == size / 2 && col == size / 2)
+                {
+                    link = devices;
+                }
+            }
+            if (row + 1 < size)
+            {
+                Connect(router, routers.Get((row + 1) * size + col), ipv4);
+            }
+            Connect(hosts.Get(row * size + col), router, ipv4);
+        }
+    }
+    NS_ABORT_MSG_IF(link.GetN() == 0, "The grid needs at least two routers on each side");
+
+    GlobalRouteManagerImpl manager;
+    std::cout << "Routes of " << routers.GetN() + hosts.GetN() << " nodes" << std::endl;
+    const int width = 16;
+    std::cout << std::left << std::setw(width) << "Threads" << std::setw(width)
+              << "Initialization" << std::endl;
+    std::cout << std::left << std::setw(width) << "" << std::setw(width) << "(ms)" << std::endl;
+    for (uint32_t threads = 1; threads <= maxThreads; threads *= 2)
+    {
+        Config::SetGlobal("GlobalRoutingThreads", UintegerValue(threads));
+        std::cout << std::left << std::setw(width) << threads << std::setw(width)
+                  << BenchRecompute(manager) << std::endl;
+    }
+    std::cout << std::endl;
+
+    std::cout << std::left << std::setw(width) << "Change" << std::setw(width) << "Update"
+              << std::setw(width) << "Updated" << std::setw(width) << "Recomputation"
+              << std::endl;
+    std::cout << std::left << std::setw(width) << "" << std::setw(width) << "(ms)"
+              << std::setw(width) << "(routers)" << std::setw(width) << "(ms)" << std::endl;
+    PrintUpdate("None", manager);
+
+    auto ipv4Link = link.Get(0)->GetNode()->GetObject<Ipv4>();
+    const auto interface = ipv4Link->GetInterfaceForDevice(link.Get(0));
+    ipv4Link->SetMetric(interface, 3);
+    PrintUpdate("Metric", manager);
+    ipv4Link->SetDown(interface);
+    PrintUpdate("Link down", manager);
+    ipv4Link->SetUp(interface);
+    PrintUpdate("Link up", manager);
+
+    Simulator::Destroy();
+    return 0;
+}
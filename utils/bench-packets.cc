@@ -11,6 +11,7 @@
 // Sample usage:  ./ns3 run 'bench-packets --n=10000'
 
 #include "ns3/command-line.h"
+#include "ns3/packet-allocator.h"
 #include "ns3/packet-metadata.h"
 #include "ns3/packet.h"
 #include "ns3/system-wall-clock-ms.h"
@@ -21,6 +22,7 @@
 #include <limits>
 #include <sstream>
 #include <string>
+#include <vector>
 
 using namespace ns3;
 
@@ -339,6 +341,37 @@ benchByteTags(uint32_t n)
     }
 }
 
+static void
+benchCreateDestroy(uint32_t n)
+{
+    for (uint32_t i = 0; i < n; i++)
+    {
+        Ptr<Packet> p = Create<Packet>(64);
+    }
+}
+
+static void
+benchBroadcast(uint32_t n)
+{
+    BenchHeader<20> ipv4;
+    BenchHeader<8> udp;
+    std::vector<Ptr<Packet>> copies(16);
+
+    // a broadcast packet is copied for each receiver, which removes its headers
+    for (uint32_t i = 0; i < n; i++)
+    {
+        Ptr<Packet> p = Create<Packet>(64);
+        p->AddHeader(udp);
+        p->AddHeader(ipv4);
+        for (auto& copy : copies)
+        {
+            copy = p->Copy();
+            copy->RemoveHeader(ipv4);
+            copy->RemoveHeader(udp);
+        }
+    }
+}
+
 static uint64_t
 runBenchOneIteration(void (*bench)(uint32_t), uint32_t n)
 {
@@ -353,6 +386,7 @@ static void
 runBench(void (*bench)(uint32_t), uint32_t n, uint32_t minIterations, const char* name)
 {
     uint64_t minDelay = std::numeric_limits<uint64_t>::max();
+    PacketAllocator::ResetStats();
     for (uint32_t i = 0; i < minIterations; i++)
     {
         uint64_t delay = runBenchOneIteration(bench, n);
@@ -361,8 +395,11 @@ runBench(void (*bench)(uint32_t), uint32_t n, uint32_t minIterations, const char
     double ps = n;
     ps *= 1000;
     ps /= minDelay;
+    const auto stats = PacketAllocator::GetStats();
+    const double allocations = static_cast<double>(stats.allocations) / n / minIterations;
     std::cout << ps << " packets/s"
-              << " (" << minDelay << " ms elapsed)\t" << name << std::endl;
+              << " (" << minDelay << " ms elapsed, " << allocations << " allocs/packet, "
+              << stats.heapAllocations << " heap allocs)\t" << name << std::endl;
 }
 
 int
@@ -396,6 +433,8 @@ main(int argc, char* argv[])
     runBench(&benchD, n, minIterations, "Intermixed add/remove headers and tags");
     runBench(&benchFragment, n, minIterations, "Fragmentation and concatenation");
     runBench(&benchByteTags, n, minIterations, "Benchmark byte tags");
+    runBench(&benchCreateDestroy, n, minIterations, "Create and destroy small packets");
+    runBench(&benchBroadcast, n, minIterations, "Copy broadcast packet 16 times");
 
     return 0;
 }
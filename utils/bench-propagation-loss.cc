@@ -0,0 +1,132 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/propagation-module.h"
+
+#include <iomanip>
+#include <iostream>
+
+using namespace ns3;
+
+/**
+ * @file
+ * Benchmark of the computation of the Rx power from one sender to many
+ * receivers, as made by YansWifiChannel::Send().
+ *
+ * The Rx powers are computed with one CalcRxPower() call per receiver, with
+ * one CalcRxPowers() call whose output vectors are allocated for each sender
+ * (as CalcRxPowers() allocated its vector of distances before it took it as
+ * an argument), and with one CalcRxPowers() call reusing the vectors of the
+ * previous call. The time per receiver is reported for a deterministic chain
+ * (log distance loss) and for a chain with fading (log distance and Nakagami
+ * losses).
+ */
+
+/// The ways of computing the Rx powers
+enum class Method
+{
+    SCALAR,     //!< one CalcRxPower() call per receiver
+    BATCH,      //!< one CalcRxPowers() call, with new output vectors
+    BATCH_REUSE //!< one CalcRxPowers() call, reusing the output vectors
+};
+
+/**
+ * Create a chain of propagation loss models.
+ * @param [in] fading Whether to add a Nakagami fading model to the chain.
+ * @returns The first model of the chain.
+ */
+static Ptr<PropagationLossModel>
+CreateChain(bool fading)
+{
+    Ptr<PropagationLossModel> loss = CreateObject<LogDistancePropagationLossModel>();
+    if (fading)
+    {
+        loss->SetNext(CreateObject<NakagamiPropagationLossModel>());
+    }
+    loss->AssignStreams(1);
+    return loss;
+}
+
+/**
+ * Time the computation of the Rx powers.
+ * @param [in] method The way of computing the Rx powers.
+ * @param [in] fading Whether the chain includes a Nakagami fading model.
+ * @param [in] receivers The number of receivers.
+ * @param [in] rounds The number of senders.
+ * @returns The time per receiver (ns).
+ */
+static double
+Bench(Method method, bool fading, uint32_t receivers, uint32_t rounds)
+{
+    auto loss = CreateChain(fading);
+    Ptr<MobilityModel> a = CreateObject<ConstantPositionMobilityModel>();
+    std::vector<Ptr<MobilityModel>> b;
+    for (uint32_t i = 0; i < receivers; ++i)
+    {
+        Ptr<MobilityModel> mobility = CreateObject<ConstantPositionMobilityModel>();
+        mobility->SetPosition(Vector(1.0 + 2.0 * i, (i % 10) * 3.0, 0.0));
+        b.push_back(mobility);
+    }
+
+    double sum = 0;
+    std::vector<double> rxPowerDbm;
+    std::vector<double> distances;
+    SystemWallClockMs timer;
+    timer.Start();
+    for (uint32_t round = 0; round < rounds; ++round)
+    {
+        switch (method)
+        {
+        case Method::SCALAR:
+            for (const auto& mobility : b)
+            {
+                sum += loss->CalcRxPower(16.0, a, mobility);
+            }
+            break;
+        case Method::BATCH: {
+            std::vector<double> newRxPowerDbm;
+            std::vector<double> newDistances;
+            loss->CalcRxPowers(16.0, a, b, newRxPowerDbm, newDistances);
+            sum += newRxPowerDbm.back();
+            break;
+        }
+        case Method::BATCH_REUSE:
+            loss->CalcRxPowers(16.0, a, b, rxPowerDbm, distances);
+            sum += rxPowerDbm.back();
+            break;
+        }
+    }
+    const auto elapsed = timer.End();
+    NS_ABORT_MSG_IF(sum == 0, "No Rx power computed");
+    return 1e6 * elapsed / (static_cast<double>(rounds) * receivers);
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t receivers = 100;
+    uint32_t rounds = 100000;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the computation of the Rx power from one sender to many receivers");
+    cmd.AddValue("receivers", "number of receivers of each sender", receivers);
+    cmd.AddValue("rounds", "number of senders", rounds);
+    cmd.Parse(argc, argv);
+
+    const int width = 16;
+    std::cout << "Rx power of " << receivers << " receivers (ns per receiver)" << std::endl;
+    std::cout << std::left << std::setw(width) << "Chain" << std::setw(width) << "CalcRxPower"
+              << std::setw(width) << "Batch" << std::setw(width) << "Batch (reuse)" << std::endl;
+    for (bool fading : {false, true})
+    {
+        std::cout << std::left << std::setw(width) << (fading ? "LogDistance+Nak" : "LogDistance")
+                  << std::fixed << std::setprecision(1) << std::setw(width)
+                  << Bench(Method::SCALAR, fading, receivers, rounds) << std::setw(width)
+                  << Bench(Method::BATCH, fading, receivers, rounds) << std::setw(width)
+                  << Bench(Method::BATCH_REUSE, fading, receivers, rounds) << std::endl;
+    }
+    return 0;
+}
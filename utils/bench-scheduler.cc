@@ -8,10 +8,13 @@
 
 #include "ns3/core-module.h"
 
+#include <atomic>
 #include <cmath> // sqrt
+#include <cstdlib>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <new>
 #include <string.h>
 #include <vector>
 
@@ -36,6 +39,46 @@ std::string g_me;
 /** Output field width for numeric data. */
 int g_fwidth = 6;
 
+/** Number of heap allocations made by the program so far. */
+std::atomic<uint64_t> g_allocations{0};
+
+/**
+ * Replacement of the global allocation function, counting the allocations.
+ * @param [in] size The number of bytes to allocate.
+ * @returns The allocated memory.
+ */
+void*
+operator new(std::size_t size)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    void* p = std::malloc(size == 0 ? 1 : size);
+    if (p == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+/**
+ * Replacement of the global deallocation function.
+ * @param [in] p The memory to release.
+ */
+void
+operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+/**
+ * Replacement of the global sized deallocation function.
+ * @param [in] p The memory to release.
+ */
+void
+operator delete(void* p, std::size_t /* size */) noexcept
+{
+    std::free(p);
+}
+
 /**
  *  Benchmark instance which can do a single run.
  *
@@ -59,6 +102,19 @@ class Bench
     {
     }
 
+    /**
+     * Set the scheduler used by each run.
+     *
+     * Simulator::Destroy() at the end of a run resets the simulator to the
+     * default scheduler, so the scheduler has to be set again for each run.
+     *
+     * @param [in] factory Factory pre-configured to create the desired Scheduler.
+     */
+    void SetScheduler(const ObjectFactory& factory)
+    {
+        m_factory = factory;
+    }
+
     /**
      * Set the event delay interval random stream.
      *
@@ -92,10 +148,12 @@ class Bench
     /** The output. */
     struct Result
     {
-        double init;     /**< Time (s) for initialization. */
-        double simu;     /**< Time (s) for simulation. */
-        uint64_t pop;    /**< Event population. */
-        uint64_t events; /**< Number of events executed. */
+        double init;         /**< Time (s) for initialization. */
+        double simu;         /**< Time (s) for simulation. */
+        uint64_t pop;        /**< Event population. */
+        uint64_t events;     /**< Number of events executed. */
+        uint64_t initAllocs; /**< Number of heap allocations during initialization. */
+        uint64_t simuAllocs; /**< Number of heap allocations during simulation. */
     };
 
     /**
@@ -112,6 +170,7 @@ class Bench
      */
     void Cb();
 
+    ObjectFactory m_factory;          /**< Factory of the scheduler. */
     Ptr<RandomVariableStream> m_rand; /**< Stream for event delays. */
     uint64_t m_population;            /**< Event population size. */
     uint64_t m_total;                 /**< Total number of events to execute. */
@@ -127,7 +186,9 @@ Bench::Run()
 
     DEB("initializing");
     m_count = 0;
+    Simulator::SetScheduler(m_factory);
 
+    uint64_t allocs = g_allocations;
     timer.Start();
     for (uint64_t i = 0; i < m_population; ++i)
     {
@@ -135,17 +196,20 @@ Bench::Run()
         Simulator::Schedule(at, &Bench::Cb, this);
     }
     init = timer.End() / 1000.0;
+    uint64_t initAllocs = g_allocations - allocs;
     DEB("initialization took " << init << "s");
 
     DEB("running");
+    allocs = g_allocations;
     timer.Start();
     Simulator::Run();
     simu = timer.End() / 1000.0;
+    uint64_t simuAllocs = g_allocations - allocs;
     DEB("run took " << simu << "s");
 
     Simulator::Destroy();
 
-    return Result{init, simu, m_population, m_count};
+    return Result{init, simu, m_population, m_count, initAllocs, simuAllocs};
 }
 
 void
@@ -202,6 +266,7 @@ class BenchSuite
         double time;   /**< Phase run time time (s). */
         double rate;   /**< Phase event rate (events/s). */
         double period; /**< Phase period (s/event). */
+        double allocs; /**< Phase heap allocations per event. */
     };
 
     /** Results from initialization and execution of a single run. */
@@ -236,8 +301,11 @@ class BenchSuite
 BenchSuite::Result
 BenchSuite::Result::Bench(Bench::Result r)
 {
-    return Result{{r.init, r.pop / r.init, r.init / r.pop},
-                  {r.simu, r.events / r.simu, r.simu / r.events}};
+    return Result{{r.init, r.pop / r.init, r.init / r.pop, double(r.initAllocs) / r.pop},
+                  {r.simu,
+                   r.events / r.simu,
+                   r.simu / r.events,
+                   double(r.simuAllocs) / r.events}};
 }
 
 template <typename T>
@@ -248,8 +316,9 @@ BenchSuite::Result::Log(T label) const
 
     LOG(std::left << std::setw(g_fwidth) << label << std::setw(g_fwidth) << init.time
                   << std::setw(g_fwidth) << init.rate << std::setw(g_fwidth) << init.period
-                  << std::setw(g_fwidth) << run.time << std::setw(g_fwidth) << run.rate
-                  << std::setw(g_fwidth) << run.period);
+                  << std::setw(g_fwidth) << init.allocs << std::setw(g_fwidth) << run.time
+                  << std::setw(g_fwidth) << run.rate << std::setw(g_fwidth) << run.period
+                  << std::setw(g_fwidth) << run.allocs);
 }
 
 BenchSuite::BenchSuite(ObjectFactory& factory,
@@ -259,8 +328,6 @@ BenchSuite::BenchSuite(ObjectFactory& factory,
                        Ptr<RandomVariableStream> eventStream,
                        bool calRev)
 {
-    Simulator::SetScheduler(factory);
-
     m_scheduler = factory.GetTypeId().GetName();
     if (m_scheduler == "ns3::CalendarScheduler")
     {
@@ -272,6 +339,7 @@ BenchSuite::BenchSuite(ObjectFactory& factory,
     }
 
     Bench bench(pop, total);
+    bench.SetScheduler(factory);
     bench.SetRandomStream(eventStream);
     bench.SetPopulation(pop);
     bench.SetTotal(total);
@@ -301,18 +369,21 @@ BenchSuite::Header() const
     // table header
     LOG("");
     LOG(m_scheduler);
-    LOG(std::left << std::setw(g_fwidth) << "Run #" << std::left << std::setw(3 * g_fwidth)
+    LOG(std::left << std::setw(g_fwidth) << "Run #" << std::left << std::setw(4 * g_fwidth)
                   << "Initialization:" << std::left << "Simulation:");
     LOG(std::left << std::setw(g_fwidth) << "" << std::left << std::setw(g_fwidth) << "Time (s)"
                   << std::left << std::setw(g_fwidth) << "Rate (ev/s)" << std::left
                   << std::setw(g_fwidth) << "Per (s/ev)" << std::left << std::setw(g_fwidth)
-                  << "Time (s)" << std::left << std::setw(g_fwidth) << "Rate (ev/s)" << std::left
-                  << "Per (s/ev)");
+                  << "Alloc/ev" << std::left << std::setw(g_fwidth) << "Time (s)" << std::left
+                  << std::setw(g_fwidth) << "Rate (ev/s)" << std::left << std::setw(g_fwidth)
+                  << "Per (s/ev)" << std::left << "Alloc/ev");
     LOG(std::setfill('-') << std::right << std::setw(g_fwidth) << " " << std::right
                           << std::setw(g_fwidth) << " " << std::right << std::setw(g_fwidth) << " "
                           << std::right << std::setw(g_fwidth) << " " << std::right
                           << std::setw(g_fwidth) << " " << std::right << std::setw(g_fwidth) << " "
-                          << std::right << std::setw(g_fwidth) << " " << std::setfill(' '));
+                          << std::right << std::setw(g_fwidth) << " " << std::right
+                          << std::setw(g_fwidth) << " " << std::right << std::setw(g_fwidth) << " "
+                          << std::setfill(' '));
 }
 
 void
@@ -332,8 +403,8 @@ BenchSuite::Log() const
 
     uint64_t n{0};                // number of samples
     Result average{m_results[0]}; // average
-    Result moment2{{0, 0, 0},     // 2nd moment, to calculate stdev
-                   {0, 0, 0}};
+    Result moment2{{0, 0, 0, 0},  // 2nd moment, to calculate stdev
+                   {0, 0, 0, 0}};
 
     for (; n < m_results.size(); ++n)
     {
@@ -351,9 +422,11 @@ BenchSuite::Log() const
         ACCUMULATE(init, time);
         ACCUMULATE(init, rate);
         ACCUMULATE(init, period);
+        ACCUMULATE(init, allocs);
         ACCUMULATE(run, time);
         ACCUMULATE(run, rate);
         ACCUMULATE(run, period);
+        ACCUMULATE(run, allocs);
 
 #undef ACCUMULATE
     }
@@ -361,10 +434,12 @@ BenchSuite::Log() const
     auto stdev = Result{
         {std::sqrt(moment2.init.time / n),
          std::sqrt(moment2.init.rate / n),
-         std::sqrt(moment2.init.period / n)},
+         std::sqrt(moment2.init.period / n),
+         std::sqrt(moment2.init.allocs / n)},
         {std::sqrt(moment2.run.time / n),
          std::sqrt(moment2.run.rate / n),
-         std::sqrt(moment2.run.period / n)},
+         std::sqrt(moment2.run.period / n),
+         std::sqrt(moment2.run.allocs / n)},
     };
 
     average.Log("average");
@@ -443,6 +518,7 @@ main(int argc, char* argv[])
     bool allSched = false;
     bool schedCal = false;
     bool schedHeap = false;
+    bool schedLadder = false;
     bool schedList = false;
     bool schedMap = false; // default scheduler
     bool schedPQ = false;
@@ -463,11 +539,15 @@ main(int argc, char* argv[])
               "In the case of either --file form, the input is expected\n"
               "to be ascii, giving the relative event times in ns.\n"
               "\n"
+              "The Alloc/ev columns report the number of heap allocations\n"
+              "made per event.\n"
+              "\n"
               "If no scheduler is specified the MapScheduler will be run.");
     cmd.AddValue("all", "use all schedulers", allSched);
     cmd.AddValue("cal", "use CalendarScheduler", schedCal);
     cmd.AddValue("calrev", "reverse ordering in the CalendarScheduler", calRev);
     cmd.AddValue("heap", "use HeapScheduler", schedHeap);
+    cmd.AddValue("ladder", "use LadderScheduler", schedLadder);
     cmd.AddValue("list", "use ListScheduler", schedList);
     cmd.AddValue("map", "use MapScheduler (default)", schedMap);
     cmd.AddValue("pri", "use PriorityQueue", schedPQ);
@@ -491,10 +571,10 @@ main(int argc, char* argv[])
 
     if (allSched)
     {
-        schedCal = schedHeap = schedList = schedMap = schedPQ = true;
+        schedCal = schedHeap = schedLadder = schedList = schedMap = schedPQ = true;
     }
     // Set the default case if nothing else is set
-    if (!(schedCal || schedHeap || schedList || schedMap || schedPQ))
+    if (!(schedCal || schedHeap || schedLadder || schedList || schedMap || schedPQ))
     {
         schedMap = true;
     }
@@ -539,6 +619,11 @@ main(int argc, char* argv[])
         factory.SetTypeId("ns3::PriorityQueueScheduler");
         BenchSuite(factory, pop, total, runs, eventStream, calRev).Log();
     }
+    if (schedLadder)
+    {
+        factory.SetTypeId("ns3::LadderScheduler");
+        BenchSuite(factory, pop, total, runs, eventStream, calRev).Log();
+    }
 
     return 0;
 }
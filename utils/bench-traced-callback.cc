@@ -0,0 +1,127 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+
+#include <iomanip>
+#include <iostream>
+#include <list>
+
+using namespace ns3;
+
+/**
+ * @file
+ * Benchmark of the per-packet overhead of the trace sources, such as the
+ * PHY, MAC and IP trace sources fired for each packet.
+ *
+ * A TracedCallback taking a packet is invoked with 0, 1 and 4 connected
+ * sinks. It is compared with the chain of callbacks stored in a std::list
+ * that was used before.
+ */
+
+/** The chain of callbacks stored in a std::list, as in the former TracedCallback. */
+class ListTracedCallback
+{
+  public:
+    /**
+     * Append a callback to the chain.
+     * @param [in] callback The callback.
+     */
+    void ConnectWithoutContext(const Callback<void, Ptr<const Packet>>& callback)
+    {
+        m_callbackList.push_back(callback);
+    }
+
+    /**
+     * Invoke the chain.
+     * @param [in] packet The packet.
+     */
+    void operator()(Ptr<const Packet> packet) const
+    {
+        for (auto i = m_callbackList.begin(); i != m_callbackList.end(); i++)
+        {
+            (*i)(packet);
+        }
+    }
+
+  private:
+    std::list<Callback<void, Ptr<const Packet>>> m_callbackList; //!< the chain
+};
+
+/** The number of packets seen by the sinks. */
+static uint64_t g_count = 0;
+
+/**
+ * The trace sink.
+ * @param [in] packet The packet.
+ */
+static void
+Sink(Ptr<const Packet> packet)
+{
+    g_count += packet != nullptr;
+}
+
+/**
+ * Run the benchmark with a chain of callbacks.
+ * @tparam T \deduced The type of the chain.
+ * @param [in] trace The chain.
+ * @param [in] sinks The number of sinks to connect.
+ * @param [in] calls The number of invocations.
+ * @returns The time per invocation (ns).
+ */
+template <typename T>
+static double
+Bench(T& trace, uint32_t sinks, uint64_t calls)
+{
+    for (uint32_t i = 0; i < sinks; ++i)
+    {
+        trace.ConnectWithoutContext(MakeCallback(&Sink));
+    }
+    Ptr<const Packet> packet = Create<Packet>(100);
+    g_count = 0;
+    SystemWallClockMs timer;
+    timer.Start();
+    for (uint64_t i = 0; i < calls; ++i)
+    {
+        trace(packet);
+    }
+    const auto elapsed = std::max<int64_t>(timer.End(), 1);
+    NS_ABORT_MSG_IF(g_count != sinks * calls, "Unexpected number of sink calls");
+    return elapsed * 1e6 / calls;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint64_t calls = 10000000;
+    bool list = true;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the invocation of a TracedCallback against a std::list of callbacks");
+    cmd.AddValue("calls", "number of invocations for each number of sinks", calls);
+    cmd.AddValue("list", "also benchmark the std::list of callbacks", list);
+    cmd.Parse(argc, argv);
+
+    const int width = 16;
+    std::cout << std::left << std::setw(width) << "Sinks" << std::setw(width) << "TracedCallback"
+              << std::setw(width) << "std::list" << std::endl;
+    std::cout << std::left << std::setw(width) << "" << std::setw(width) << "(ns/call)"
+              << std::setw(width) << "(ns/call)" << std::endl;
+
+    for (uint32_t sinks : {0, 1, 4})
+    {
+        TracedCallback<Ptr<const Packet>> trace;
+        std::cout << std::left << std::setw(width) << sinks << std::setw(width)
+                  << Bench(trace, sinks, calls);
+        if (list)
+        {
+            ListTracedCallback listTrace;
+            std::cout << std::setw(width) << Bench(listTrace, sinks, calls);
+        }
+        std::cout << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,60 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/animation-trace-writer.h"
+#include "ns3/core-module.h"
+
+#include <fstream>
+#include <iostream>
+
+using namespace ns3;
+
+/**
+ * @file
+ * Convert a binary animation trace, written by an AnimationInterface
+ * constructed with the AnimationTraceWriter::BINARY format, into the XML
+ * trace read by NetAnim.
+ *
+ * @code
+ *   ./ns3 run "netanim-convert --input=trace.bin --output=trace.xml"
+ * @endcode
+ */
+
+int
+main(int argc, char* argv[])
+{
+    std::string input;
+    std::string output;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Convert a binary NetAnim trace into the XML trace read by NetAnim.");
+    cmd.AddValue("input", "The binary trace file", input);
+    cmd.AddValue("output", "The XML trace file", output);
+    cmd.Parse(argc, argv);
+
+    if (input.empty() || output.empty())
+    {
+        std::cerr << "Both --input and --output are required" << std::endl;
+        return 1;
+    }
+
+    std::ifstream is(input, std::ios::binary);
+    if (!is)
+    {
+        std::cerr << "Unable to open " << input << std::endl;
+        return 1;
+    }
+    std::ofstream os(output);
+    if (!os)
+    {
+        std::cerr << "Unable to open " << output << std::endl;
+        return 1;
+    }
+    if (!AnimationTraceWriter::ConvertToXml(is, os))
+    {
+        std::cerr << input << " is not a binary NetAnim trace, or is truncated" << std::endl;
+        return 1;
+    }
+    return 0;
+}